@@ -32,6 +32,7 @@ from six import text_type
 from gi.repository import GLib
 
 import datetime
+import json
 
 Modulemd = get_introspection_module('Modulemd')
 
@@ -114,21 +115,44 @@ class ModulemdUtil(object):
         else:
             raise TypeError('Cannot convert unknown type')
 
+    @staticmethod
+    def check_xmd(obj):
+        """ Raises TypeError for the values that python_to_variant() cannot
+        convert, which json.dumps() would otherwise store as strings
+        """
+        if isinstance(obj, (str, text_type, bool)):
+            return
+
+        elif isinstance(obj, list):
+            for item in obj:
+                if item is not None:
+                    ModulemdUtil.check_xmd(item)
+
+        elif isinstance(obj, dict):
+            for k, v in obj.items():
+                if not isinstance(k, (str, text_type)):
+                    raise TypeError('Only strings are supported for keys')
+                if v is not None:
+                    ModulemdUtil.check_xmd(v)
+
+        else:
+            raise TypeError('Cannot convert unknown type')
+
 
 if float(Modulemd._version) >= 2:
 
     class ModuleStreamV2(Modulemd.ModuleStreamV2):
 
         def set_xmd(self, xmd):
-            super(
-                ModuleStreamV2, self).set_xmd(
-                ModulemdUtil.python_to_variant(xmd))
+            # The conversion is done in C from the JSON document
+            ModulemdUtil.check_xmd(xmd)
+            super(ModuleStreamV2, self).set_xmd_from_json(json.dumps(xmd))
 
         def get_xmd(self):
-            variant_xmd = super(ModuleStreamV2, self).get_xmd()
-            if variant_xmd is None:
+            xmd_json = super(ModuleStreamV2, self).get_xmd_as_json()
+            if xmd_json is None:
                 return {}
-            return variant_xmd.unpack()
+            return json.loads(xmd_json)
 
     ModuleStreamV2 = override(ModuleStreamV2)
     __all__.append(ModuleStreamV2)
@@ -136,15 +160,15 @@ if float(Modulemd._version) >= 2:
     class ModuleStreamV1(Modulemd.ModuleStreamV1):
 
         def set_xmd(self, xmd):
-            super(
-                ModuleStreamV1, self).set_xmd(
-                ModulemdUtil.python_to_variant(xmd))
+            # The conversion is done in C from the JSON document
+            ModulemdUtil.check_xmd(xmd)
+            super(ModuleStreamV1, self).set_xmd_from_json(json.dumps(xmd))
 
         def get_xmd(self):
-            variant_xmd = super(ModuleStreamV1, self).get_xmd()
-            if variant_xmd is None:
+            xmd_json = super(ModuleStreamV1, self).get_xmd_as_json()
+            if xmd_json is None:
                 return {}
-            return variant_xmd.unpack()
+            return json.loads(xmd_json)
 
     ModuleStreamV1 = override(ModuleStreamV1)
     __all__.append(ModuleStreamV1)
@@ -176,3 +200,15 @@ if float(Modulemd._version) >= 2:
 
     ServiceLevel = override(ServiceLevel)
     __all__.append(ServiceLevel)
+
+    class ModuleIndex(Modulemd.ModuleIndex):
+
+        def export_streams(self):
+            """ Returns a list with a dictionary describing each stream of
+            the index. See Modulemd.ModuleIndex.export_streams_as_json().
+            """
+            return json.loads(
+                super(ModuleIndex, self).export_streams_as_json())
+
+    ModuleIndex = override(ModuleIndex)
+    __all__.append(ModuleIndex)
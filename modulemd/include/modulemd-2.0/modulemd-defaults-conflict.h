@@ -0,0 +1,151 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * SECTION: modulemd-defaults-conflict
+ * @title: Modulemd.DefaultsConflict
+ * @stability: stable
+ * @short_description: A conflict found while merging #ModulemdDefaults.
+ *
+ * A #ModulemdDefaultsConflict describes a single field of the
+ * #ModulemdDefaults for a module that two or more of the merged documents set
+ * to different values with the same modified value. They are returned by
+ * modulemd_module_index_merger_resolve_with_conflicts(), whether or not the
+ * conflicts could be resolved.
+ *
+ * It is expected to be used as follows (python example):
+ *
+ * |[<!-- language="Python" -->
+ * merger = Modulemd.ModuleIndexMerger.new()
+ * merger.associate_index(fedora_index, 0)
+ * merger.associate_index(updates_index, 0)
+ *
+ * merged, conflicts = merger.resolve_with_conflicts(False)
+ *
+ * for conflict in conflicts:
+ *     print("%s: %s" % (conflict.get_module_name(),
+ *                       " != ".join(conflict.peek_values())))
+ * ]|
+ */
+
+
+/**
+ * ModulemdDefaultsConflictTypeEnum:
+ * @MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM: Two or more participants set a
+ * different default stream (generic or for an intent) with the same modified
+ * value.
+ * @MODULEMD_DEFAULTS_CONFLICT_PROFILES: Two or more participants set a
+ * different set of default profiles for the same stream (generic or for an
+ * intent) with the same modified value.
+ *
+ * Since: 2.9
+ */
+typedef enum
+{
+  MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM,
+  MODULEMD_DEFAULTS_CONFLICT_PROFILES
+} ModulemdDefaultsConflictTypeEnum;
+
+
+#define MODULEMD_TYPE_DEFAULTS_CONFLICT (modulemd_defaults_conflict_get_type ())
+
+G_DECLARE_FINAL_TYPE (ModulemdDefaultsConflict,
+                      modulemd_defaults_conflict,
+                      MODULEMD,
+                      DEFAULTS_CONFLICT,
+                      GObject)
+
+
+/**
+ * modulemd_defaults_conflict_get_conflict_type:
+ * @self: (in): This #ModulemdDefaultsConflict object.
+ *
+ * Returns: The kind of field that conflicted.
+ *
+ * Since: 2.9
+ */
+ModulemdDefaultsConflictTypeEnum
+modulemd_defaults_conflict_get_conflict_type (ModulemdDefaultsConflict *self);
+
+
+/**
+ * modulemd_defaults_conflict_get_module_name:
+ * @self: (in): This #ModulemdDefaultsConflict object.
+ *
+ * Returns: (transfer none): The module whose defaults conflicted.
+ *
+ * Since: 2.9
+ */
+const gchar *
+modulemd_defaults_conflict_get_module_name (ModulemdDefaultsConflict *self);
+
+
+/**
+ * modulemd_defaults_conflict_get_intent:
+ * @self: (in): This #ModulemdDefaultsConflict object.
+ *
+ * Returns: (transfer none) (nullable): The intent the conflict occurred in, or
+ * NULL for the generic defaults.
+ *
+ * Since: 2.9
+ */
+const gchar *
+modulemd_defaults_conflict_get_intent (ModulemdDefaultsConflict *self);
+
+
+/**
+ * modulemd_defaults_conflict_get_stream_name:
+ * @self: (in): This #ModulemdDefaultsConflict object.
+ *
+ * Returns: (transfer none) (nullable): For
+ * %MODULEMD_DEFAULTS_CONFLICT_PROFILES, the stream whose default profiles
+ * conflicted. NULL otherwise.
+ *
+ * Since: 2.9
+ */
+const gchar *
+modulemd_defaults_conflict_get_stream_name (ModulemdDefaultsConflict *self);
+
+
+/**
+ * modulemd_defaults_conflict_get_modified:
+ * @self: (in): This #ModulemdDefaultsConflict object.
+ *
+ * Returns: The modified value shared by all of the conflicting values.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_defaults_conflict_get_modified (ModulemdDefaultsConflict *self);
+
+
+/**
+ * modulemd_defaults_conflict_peek_values:
+ * @self: (in): This #ModulemdDefaultsConflict object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The distinct
+ * conflicting values, in the order in which they were merged. Sets of
+ * profiles are represented as a sorted, comma-separated string.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_defaults_conflict_peek_values (ModulemdDefaultsConflict *self);
+
+G_END_DECLS
@@ -97,6 +97,25 @@ GStrv
 modulemd_defaults_v1_get_streams_with_default_profiles_as_strv (
   ModulemdDefaultsV1 *self, const gchar *intent);
 
+/**
+ * modulemd_defaults_v1_peek_streams_with_default_profiles:
+ * @self: (in): This #ModulemdDefaultsV1 object.
+ * @intent: (in) (nullable): The name of the system intent whose stream
+ * profiles will be retrieved, as for
+ * modulemd_defaults_v1_get_streams_with_default_profiles_as_strv().
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The same list as
+ * modulemd_defaults_v1_get_streams_with_default_profiles_as_strv(), without
+ * copying it. Like that of
+ * modulemd_defaults_v1_peek_default_profiles_for_stream(), it is sorted once
+ * and cached on @self until @self is next modified.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_defaults_v1_peek_streams_with_default_profiles (
+  ModulemdDefaultsV1 *self, const gchar *intent);
+
 
 /**
  * modulemd_defaults_v1_add_default_profile_for_stream:
@@ -174,4 +193,22 @@ GStrv
 modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
   ModulemdDefaultsV1 *self, const gchar *stream_name, const gchar *intent);
 
+/**
+ * modulemd_defaults_v1_peek_default_profiles_for_stream:
+ * @self: (in): This #ModulemdDefaultsV1 object.
+ * @stream_name: (in): The name of the string to retrieve the default profiles
+ * for.
+ * @intent: (in) (nullable): The name of the system intent from which to
+ * retrieve the profile defaults for this stream.
+ *
+ * Returns: (transfer none) (array zero-terminated=1) (nullable): The sorted
+ * profiles installed by default for this stream, owned by @self until it is
+ * next modified, or NULL if this stream_name is not present in the defaults.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_defaults_v1_peek_default_profiles_for_stream (
+  ModulemdDefaultsV1 *self, const gchar *stream_name, const gchar *intent);
+
 G_END_DECLS
@@ -127,6 +127,24 @@ gboolean
 modulemd_defaults_equals (ModulemdDefaults *self_1, ModulemdDefaults *self_2);
 
 
+/**
+ * modulemd_defaults_get_fingerprint:
+ * @self: (in): This #ModulemdDefaults object.
+ *
+ * Returns: A 64-bit hash of the content of @self. Defaults that are equal
+ * according to modulemd_defaults_equals() always have the same fingerprint,
+ * so it can be used as a cache key for their content. It is computed on first
+ * use and kept until @self is modified.
+ *
+ * Fingerprints are not meant to be stored: they may change between releases
+ * of libmodulemd.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_defaults_get_fingerprint (ModulemdDefaults *self);
+
+
 /**
  * modulemd_defaults_upgrade:
  * @self: (in): This #ModulemdDefaults object.
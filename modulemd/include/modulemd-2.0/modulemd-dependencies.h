@@ -130,6 +130,20 @@ GStrv
 modulemd_dependencies_get_buildtime_modules_as_strv (
   ModulemdDependencies *self);
 
+/**
+ * modulemd_dependencies_peek_buildtime_modules:
+ * @self: This #ModulemdDependencies object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The same list as
+ * modulemd_dependencies_get_buildtime_modules_as_strv(), without copying it.
+ * Like the lists of the other `peek` functions of #ModulemdDependencies, it
+ * is sorted once and cached on @self until @self is next modified.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_dependencies_peek_buildtime_modules (ModulemdDependencies *self);
+
 
 /**
  * modulemd_dependencies_get_buildtime_streams_as_strv: (rename-to modulemd_dependencies_get_buildtime_streams)
@@ -146,6 +160,22 @@ GStrv
 modulemd_dependencies_get_buildtime_streams_as_strv (
   ModulemdDependencies *self, const gchar *module);
 
+/**
+ * modulemd_dependencies_peek_buildtime_streams:
+ * @self: This #ModulemdDependencies object.
+ * @module: The name of the module.
+ *
+ * Returns: (transfer none) (array zero-terminated=1) (nullable): The streams
+ * of @module required at build-time, as
+ * modulemd_dependencies_get_buildtime_streams_as_strv() but not copied. See
+ * modulemd_dependencies_peek_buildtime_modules().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_dependencies_peek_buildtime_streams (ModulemdDependencies *self,
+                                              const gchar *module);
+
 
 /**
  * modulemd_dependencies_add_runtime_stream:
@@ -204,6 +234,19 @@ modulemd_dependencies_clear_runtime_dependencies (ModulemdDependencies *self);
 GStrv
 modulemd_dependencies_get_runtime_modules_as_strv (ModulemdDependencies *self);
 
+/**
+ * modulemd_dependencies_peek_runtime_modules:
+ * @self: This #ModulemdDependencies object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The module names of
+ * run-time dependencies, sorted and owned by @self. See
+ * modulemd_dependencies_peek_buildtime_modules().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_dependencies_peek_runtime_modules (ModulemdDependencies *self);
+
 
 /**
  * modulemd_dependencies_get_runtime_streams_as_strv: (rename-to modulemd_dependencies_get_runtime_streams)
@@ -219,4 +262,19 @@ GStrv
 modulemd_dependencies_get_runtime_streams_as_strv (ModulemdDependencies *self,
                                                    const gchar *module);
 
+/**
+ * modulemd_dependencies_peek_runtime_streams:
+ * @self: This #ModulemdDependencies object.
+ * @module: The name of the module.
+ *
+ * Returns: (transfer none) (array zero-terminated=1) (nullable): The streams
+ * of @module required at run-time, sorted and owned by @self. See
+ * modulemd_dependencies_peek_buildtime_modules().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_dependencies_peek_runtime_streams (ModulemdDependencies *self,
+                                            const gchar *module);
+
 G_END_DECLS
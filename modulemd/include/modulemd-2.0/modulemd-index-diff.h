@@ -0,0 +1,244 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * SECTION: modulemd-index-diff
+ * @title: Modulemd.IndexDiff
+ * @stability: stable
+ * @short_description: The differences between two versions of a
+ * #ModulemdModuleIndex.
+ *
+ * A #ModulemdIndexDiff is returned by modulemd_module_index_diff(). It lists
+ * the module streams, defaults and translations that were added, removed or
+ * changed from one #ModulemdModuleIndex to another, and which of their fields
+ * changed.
+ *
+ * It is expected to be used as follows (python example):
+ *
+ * |[<!-- language="Python" -->
+ * diff = old_index.diff(new_index)
+ *
+ * for stream in diff.get_added_streams():
+ *     print("New: %s" % stream.get_NSVCA())
+ *
+ * for stream in diff.get_changed_streams():
+ *     print("Changed: %s (%s)" % (
+ *         stream.get_NSVCA(),
+ *         ", ".join(diff.get_changed_stream_fields(stream.get_NSVCA()))))
+ * ]|
+ *
+ * Module streams are identified by their NSVCA, defaults by their module name
+ * and translations by their module and stream names. The field names are
+ * those of the properties of the corresponding objects, such as "summary" or
+ * "rpm_components". The fields of a #ModulemdTranslation are its "version",
+ * "modified" and one field per locale.
+ *
+ * Each #ModulemdIndexDiff keeps references to the objects it lists, which are
+ * shared with the indexes they came from and must not be modified.
+ */
+
+#define MODULEMD_TYPE_INDEX_DIFF (modulemd_index_diff_get_type ())
+
+G_DECLARE_FINAL_TYPE (
+  ModulemdIndexDiff, modulemd_index_diff, MODULEMD, INDEX_DIFF, GObject)
+
+
+/**
+ * modulemd_index_diff_is_empty:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: TRUE if both indexes had the same content, FALSE otherwise.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_index_diff_is_empty (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_added_streams:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdModuleStream): The module
+ * streams of the new index whose NSVCA was not in the old one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_added_streams (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_removed_streams:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdModuleStream): The module
+ * streams of the old index whose NSVCA is not in the new one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_removed_streams (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_changed_streams:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdModuleStream): The module
+ * streams of the new index whose NSVCA was in the old one with different
+ * content.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_changed_streams (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_changed_stream_fields_as_strv: (rename-to modulemd_index_diff_get_changed_stream_fields)
+ * @self: (in): This #ModulemdIndexDiff object.
+ * @nsvca: (in): The NSVCA of a changed module stream.
+ *
+ * Returns: (transfer full): The names of the fields that differ between the
+ * two versions of the module stream @nsvca, or NULL if it did not change.
+ *
+ * Since: 2.9
+ */
+GStrv
+modulemd_index_diff_get_changed_stream_fields_as_strv (
+  ModulemdIndexDiff *self, const gchar *nsvca);
+
+
+/**
+ * modulemd_index_diff_get_added_defaults:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdDefaults): The defaults of
+ * the new index for modules that had none in the old one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_added_defaults (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_removed_defaults:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdDefaults): The defaults of
+ * the old index for modules that have none in the new one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_removed_defaults (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_changed_defaults:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdDefaults): The defaults of
+ * the new index that differ from those of the same module in the old one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_changed_defaults (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_changed_defaults_fields_as_strv: (rename-to modulemd_index_diff_get_changed_defaults_fields)
+ * @self: (in): This #ModulemdIndexDiff object.
+ * @module_name: (in): The name of the module whose defaults changed.
+ *
+ * Returns: (transfer full): The names of the fields that differ between the
+ * two versions of the defaults for @module_name, or NULL if they did not
+ * change.
+ *
+ * Since: 2.9
+ */
+GStrv
+modulemd_index_diff_get_changed_defaults_fields_as_strv (
+  ModulemdIndexDiff *self, const gchar *module_name);
+
+
+/**
+ * modulemd_index_diff_get_added_translations:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdTranslation): The
+ * translations of the new index for module streams that had none in the old
+ * one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_added_translations (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_removed_translations:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdTranslation): The
+ * translations of the old index for module streams that have none in the new
+ * one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_removed_translations (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_changed_translations:
+ * @self: (in): This #ModulemdIndexDiff object.
+ *
+ * Returns: (transfer none) (element-type ModulemdTranslation): The
+ * translations of the new index that differ from those of the same module
+ * stream in the old one.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_index_diff_get_changed_translations (ModulemdIndexDiff *self);
+
+
+/**
+ * modulemd_index_diff_get_changed_translation_fields_as_strv: (rename-to modulemd_index_diff_get_changed_translation_fields)
+ * @self: (in): This #ModulemdIndexDiff object.
+ * @module_name: (in): The module name of a changed translation.
+ * @module_stream: (in): The stream name of a changed translation.
+ *
+ * Returns: (transfer full): The names of the fields that differ between the
+ * two versions of the translation for @module_name:@module_stream, or NULL if
+ * it did not change.
+ *
+ * Since: 2.9
+ */
+GStrv
+modulemd_index_diff_get_changed_translation_fields_as_strv (
+  ModulemdIndexDiff *self,
+  const gchar *module_name,
+  const gchar *module_stream);
+
+G_END_DECLS
@@ -0,0 +1,133 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+#include "modulemd-module-index.h"
+
+G_BEGIN_DECLS
+
+/**
+ * SECTION: modulemd-index-snapshot
+ * @title: Modulemd.IndexSnapshot
+ * @stability: stable
+ * @short_description: Shares the latest version of a #ModulemdModuleIndex
+ * between threads.
+ *
+ * A #ModulemdIndexSnapshot holds the current version of the module metadata
+ * for long-running programs that keep serving it while it is refreshed. Any
+ * number of reader threads take the current version with
+ * modulemd_index_snapshot_acquire(), and a writer replaces it with
+ * modulemd_index_snapshot_publish() without ever making the readers wait.
+ *
+ * It is expected to be used as follows (python example):
+ *
+ * |[<!-- language="Python" -->
+ * snapshot = Modulemd.IndexSnapshot.new(index)
+ *
+ * # In any reader thread
+ * index = snapshot.acquire()
+ * stream = index.get_module("nodejs").get_stream_by_NSVCA(...)
+ *
+ * # In the thread refreshing the repodata
+ * new_index = Modulemd.ModuleIndex.new()
+ * new_index.update_from_file("modules.yaml", True)
+ * snapshot.publish(new_index)
+ * ]|
+ *
+ * Every version is frozen with modulemd_module_index_freeze() when it is
+ * handed to the #ModulemdIndexSnapshot, so a reader can keep using the
+ * version it acquired for as long as it likes without any locking, even
+ * after a newer one was published. Each version is freed once the
+ * #ModulemdIndexSnapshot and every reader have dropped their references to
+ * it.
+ */
+
+#define MODULEMD_TYPE_INDEX_SNAPSHOT (modulemd_index_snapshot_get_type ())
+
+G_DECLARE_FINAL_TYPE (ModulemdIndexSnapshot,
+                      modulemd_index_snapshot,
+                      MODULEMD,
+                      INDEX_SNAPSHOT,
+                      GObject)
+
+
+/**
+ * modulemd_index_snapshot_new:
+ * @index: (in) (transfer none): The first version of the metadata. It is
+ * frozen, and the caller must not modify it afterwards.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdIndexSnapshot whose
+ * current version is @index.
+ *
+ * Since: 2.9
+ */
+ModulemdIndexSnapshot *
+modulemd_index_snapshot_new (ModulemdModuleIndex *index);
+
+
+/**
+ * modulemd_index_snapshot_acquire:
+ * @self: (in): This #ModulemdIndexSnapshot object.
+ *
+ * Takes a reference on the current version of the metadata. This never
+ * blocks, and may be called from any number of threads at once, including
+ * while another thread calls modulemd_index_snapshot_publish().
+ *
+ * Returns: (transfer full): The current, frozen #ModulemdModuleIndex. It
+ * stays valid and unchanged until it is released with g_object_unref(),
+ * whatever is published in the meantime.
+ *
+ * Since: 2.9
+ */
+ModulemdModuleIndex *
+modulemd_index_snapshot_acquire (ModulemdIndexSnapshot *self);
+
+
+/**
+ * modulemd_index_snapshot_publish:
+ * @self: (in): This #ModulemdIndexSnapshot object.
+ * @index: (in) (transfer none): The new version of the metadata. It is
+ * frozen, and the caller must not modify it afterwards.
+ *
+ * Makes @index the current version. Readers that call
+ * modulemd_index_snapshot_acquire() after this returns get @index, while
+ * those still holding an earlier version keep it until they release it.
+ *
+ * Concurrent calls to this function are serialized. Before returning, it
+ * waits for any modulemd_index_snapshot_acquire() calls that may still be
+ * taking a reference on the previous version, which only takes as long as
+ * incrementing a reference count.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_index_snapshot_publish (ModulemdIndexSnapshot *self,
+                                 ModulemdModuleIndex *index);
+
+
+/**
+ * modulemd_index_snapshot_get_generation:
+ * @self: (in): This #ModulemdIndexSnapshot object.
+ *
+ * Returns: The number of versions published to @self with
+ * modulemd_index_snapshot_publish(), which readers can compare to find out
+ * whether there is a newer version than the one they hold.
+ *
+ * Since: 2.9
+ */
+guint
+modulemd_index_snapshot_get_generation (ModulemdIndexSnapshot *self);
+
+G_END_DECLS
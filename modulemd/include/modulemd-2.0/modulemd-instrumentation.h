@@ -0,0 +1,161 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * SECTION: modulemd-instrumentation
+ * @title: Modulemd Instrumentation
+ * @stability: stable
+ * @short_description: Runtime controls for function tracing and per-phase
+ * timing counters.
+ *
+ * libmodulemd can report which of its functions are entered and exited, and
+ * how much time it has spent in each of the major phases of its work. Both are
+ * disabled by default and cost only a single atomic read per instrumented
+ * function while disabled.
+ *
+ * When tracing is enabled with modulemd_set_tracing_enabled(), entering and
+ * leaving an instrumented function writes a g_debug() message. These are only
+ * displayed if the `G_MESSAGES_DEBUG` environment variable is set
+ * accordingly.
+ *
+ * When phase timing is enabled with modulemd_set_phase_timing_enabled(),
+ * libmodulemd counts the calls into each #ModulemdPhaseEnum and the wall-clock
+ * time spent in them. When work for a phase runs on several threads at once,
+ * the time from each thread is added up.
+ *
+ * On platforms providing `<sys/sdt.h>`, libmodulemd additionally contains
+ * USDT probes (`libmodulemd:function__entry`, `libmodulemd:function__return`,
+ * `libmodulemd:phase__start` and `libmodulemd:phase__end`) which can be
+ * attached to with tools such as SystemTap, bpftrace or perf without enabling
+ * anything at runtime.
+ */
+
+
+/**
+ * ModulemdPhaseEnum:
+ * @MODULEMD_PHASE_PARSE: Reading YAML into a #ModulemdModuleIndex or
+ * #ModulemdModuleStream.
+ * @MODULEMD_PHASE_VALIDATE: Validating #ModulemdModuleStream and
+ * #ModulemdDefaults objects.
+ * @MODULEMD_PHASE_MERGE: Merging #ModulemdModuleIndex objects.
+ * @MODULEMD_PHASE_EMIT: Writing a #ModulemdModuleIndex out as YAML.
+ * @MODULEMD_PHASE_SENTINEL: Enum list terminator
+ *
+ * The phases for which libmodulemd keeps timing counters. A phase that is
+ * entered from within another one (such as the validation performed while
+ * parsing) is counted in both.
+ *
+ * Since: 2.9
+ */
+typedef enum
+{
+  MODULEMD_PHASE_PARSE,
+  MODULEMD_PHASE_VALIDATE,
+  MODULEMD_PHASE_MERGE,
+  MODULEMD_PHASE_EMIT,
+  MODULEMD_PHASE_SENTINEL,
+} ModulemdPhaseEnum;
+
+
+/**
+ * modulemd_set_tracing_enabled:
+ * @enabled: (in): Whether to write trace messages.
+ *
+ * Enables or disables the g_debug() messages written when entering and
+ * leaving instrumented functions. This may be called from any thread.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_set_tracing_enabled (gboolean enabled);
+
+
+/**
+ * modulemd_get_tracing_enabled:
+ *
+ * Returns: Whether trace messages are currently being written.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_get_tracing_enabled (void);
+
+
+/**
+ * modulemd_set_phase_timing_enabled:
+ * @enabled: (in): Whether to update the per-phase timing counters.
+ *
+ * Enables or disables the per-phase timing counters. Disabling them leaves
+ * their current values in place. This may be called from any thread.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_set_phase_timing_enabled (gboolean enabled);
+
+
+/**
+ * modulemd_get_phase_timing_enabled:
+ *
+ * Returns: Whether the per-phase timing counters are currently being updated.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_get_phase_timing_enabled (void);
+
+
+/**
+ * modulemd_get_phase_calls:
+ * @phase: (in): A #ModulemdPhaseEnum.
+ *
+ * Returns: The number of times @phase was entered while phase timing was
+ * enabled.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_get_phase_calls (ModulemdPhaseEnum phase);
+
+
+/**
+ * modulemd_get_phase_time:
+ * @phase: (in): A #ModulemdPhaseEnum.
+ *
+ * Returns: The total time, in microseconds, spent in @phase while phase timing
+ * was enabled.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_get_phase_time (ModulemdPhaseEnum phase);
+
+
+/**
+ * modulemd_reset_phase_timings:
+ *
+ * Resets the call count and time of every phase to zero.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_reset_phase_timings (void);
+
+
+G_END_DECLS
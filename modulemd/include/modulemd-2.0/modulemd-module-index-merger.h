@@ -79,6 +79,14 @@ G_BEGIN_DECLS
  *     modulemd_module_index_merger_resolve_ext() and setting
  *     `strict_default_streams` to #TRUE. In that case, an error will be
  *     returned if conflicting default streams have been provided.
+ *   - When more than two #ModulemdModuleIndex objects share a priority, all
+ *     of their defaults for a module are merged at once: only the values with
+ *     the highest `modified` value are considered, so the result does not
+ *     depend on the order in which the objects were associated.
+ *   - If the default stream of a module was already unset by an earlier
+ *     conflicting merge, it stays unset when merged with defaults that have
+ *     the same `modified` value. Defaults with a higher `modified` value set
+ *     the default stream again. (Before 2.9, it stayed unset in both cases.)
  * - and for profile defaults:
  *   - If both #ModulemdModuleIndex objects specify a set of default profiles
  *     for a particular module and stream and the sets are equivalent, use that
@@ -96,6 +104,11 @@ G_BEGIN_DECLS
  *   - Intents behave in exactly the same manner as described for the top-level
  *     defaults, except that they merge beneath each intent name.
  *
+ * Every conflict found while merging #ModulemdDefaults, whether it was
+ * resolved by unsetting the default stream or made the merge fail, can be
+ * retrieved as a #ModulemdDefaultsConflict with
+ * modulemd_module_index_merger_resolve_with_conflicts().
+ *
  * Merging #ModulemdTranslations entries behaves as follows:
  *
  * - For each translated summary, description and profile description, compare
@@ -217,4 +230,39 @@ modulemd_module_index_merger_resolve_ext (ModulemdModuleIndexMerger *self,
                                           gboolean strict_default_streams,
                                           GError **error);
 
+
+/**
+ * modulemd_module_index_merger_resolve_with_conflicts:
+ * @self: (in): This #ModulemdModuleIndexMerger object.
+ * @strict_default_streams: (in): If TRUE, merging two #ModulemdDefaults with
+ * conflicting default streams will raise an error. If FALSE, the module will
+ * have its default stream blocked.
+ * @conflicts: (out) (optional) (element-type ModulemdDefaultsConflict)
+ * (transfer container): Every conflict found while merging the
+ * #ModulemdDefaults, whether it could be resolved or not. It is set even if
+ * the merge fails.
+ * @error: (out): A #GError containing the reason for a failure to resolve the
+ * merges.
+ *
+ * Merges all added #ModulemdModuleIndex objects like
+ * modulemd_module_index_merger_resolve_ext() and also reports the conflicts
+ * between their #ModulemdDefaults.
+ *
+ * Once this function has been called, the internal state of the
+ * #ModulemdModuleIndexMerger is undefined. The only valid action on it after
+ * that point is g_object_unref().
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdModuleIndex object
+ * containing the merged results. If this function encounters an unresolvable
+ * merge conflict, it will return NULL and set @error appropriately.
+ *
+ * Since: 2.9
+ */
+ModulemdModuleIndex *
+modulemd_module_index_merger_resolve_with_conflicts (
+  ModulemdModuleIndexMerger *self,
+  gboolean strict_default_streams,
+  GPtrArray **conflicts,
+  GError **error);
+
 G_END_DECLS
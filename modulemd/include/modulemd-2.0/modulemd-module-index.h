@@ -14,7 +14,9 @@
 #pragma once
 
 #include <glib-object.h>
+#include "modulemd-index-diff.h"
 #include "modulemd-module.h"
+#include "modulemd-rpm-map-entry.h"
 #include "modulemd-translation.h"
 #include "modulemd-subdocument-info.h"
 
@@ -126,6 +128,29 @@ typedef gint (*ModulemdWriteHandler) (void *data,
                                       size_t size);
 
 
+/**
+ * ModulemdDocumentTypeFlags:
+ * @MODULEMD_DOCUMENT_TYPE_NONE: No document types
+ * @MODULEMD_DOCUMENT_TYPE_MODULE_STREAM: #ModulemdModuleStream documents
+ * @MODULEMD_DOCUMENT_TYPE_DEFAULTS: #ModulemdDefaults documents
+ * @MODULEMD_DOCUMENT_TYPE_TRANSLATIONS: #ModulemdTranslation documents
+ * @MODULEMD_DOCUMENT_TYPE_ALL: All of the above document types
+ *
+ * The kinds of documents a #ModulemdModuleIndex can hold, for use with
+ * modulemd_module_index_filter() and modulemd_module_index_prune().
+ *
+ * Since: 2.9
+ */
+typedef enum
+{
+  MODULEMD_DOCUMENT_TYPE_NONE = 0,
+  MODULEMD_DOCUMENT_TYPE_MODULE_STREAM = 1 << 0,
+  MODULEMD_DOCUMENT_TYPE_DEFAULTS = 1 << 1,
+  MODULEMD_DOCUMENT_TYPE_TRANSLATIONS = 1 << 2,
+  MODULEMD_DOCUMENT_TYPE_ALL = (1 << 3) - 1,
+} ModulemdDocumentTypeFlags;
+
+
 /**
  * modulemd_module_index_new:
  *
@@ -297,6 +322,188 @@ gchar *
 modulemd_module_index_dump_to_string (ModulemdModuleIndex *self,
                                       GError **error);
 
+
+/**
+ * modulemd_module_index_dump_to_string_parallel:
+ * @self: This #ModulemdModuleIndex object.
+ * @max_threads: The maximum number of threads to use. Pass 0 to use one
+ * thread per available processor.
+ * @error: (out): A #GError containing the reason the function failed, NULL if
+ * the function succeeded.
+ *
+ * Like modulemd_module_index_dump_to_string(), but each module is validated
+ * and serialized on a pool of up to @max_threads threads. The per-module
+ * output is then concatenated in module name order, so the result is
+ * identical to that of modulemd_module_index_dump_to_string().
+ *
+ * The index must not be modified by any other thread while this function is
+ * running.
+ *
+ * Returns: (transfer full): A YAML representation of the index as a string. In
+ * the event of an error, sets @error appropriately and returns NULL. If more
+ * than one module fails to validate, @error describes the first of them in
+ * module name order.
+ *
+ * Since: 2.9
+ */
+gchar *
+modulemd_module_index_dump_to_string_parallel (ModulemdModuleIndex *self,
+                                               guint max_threads,
+                                               GError **error);
+
+
+/**
+ * modulemd_module_index_set_force_validation:
+ * @self: This #ModulemdModuleIndex object.
+ * @force_validation: Whether every stream must be validated when dumped.
+ *
+ * By default, the dump functions skip validating module streams that have
+ * already passed validation (for example, while being read from YAML) and
+ * have not been modified since. Setting @force_validation to TRUE makes every
+ * dump validate every stream, as older versions of libmodulemd did.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_index_set_force_validation (ModulemdModuleIndex *self,
+                                            gboolean force_validation);
+
+
+/**
+ * modulemd_module_index_get_force_validation:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Returns: Whether the dump functions validate every stream. See
+ * modulemd_module_index_set_force_validation().
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_index_get_force_validation (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_set_passthrough:
+ * @self: This #ModulemdModuleIndex object.
+ * @passthrough: Whether to keep the YAML of the module streams read.
+ *
+ * In passthrough mode, every module stream document read into this index
+ * keeps the YAML it was read from. When the index is dumped, streams that have
+ * not been modified since are written out as that YAML instead of being
+ * re-serialized, which is considerably faster and preserves the ordering of
+ * their keys. Reading a stream or its children leaves it as it was read;
+ * streams that were modified, either directly or through one of their
+ * children, renamed or upgraded to a newer metadata version are serialized as
+ * usual.
+ *
+ * The YAML kept is the document as tokenized by libyaml, so comments and some
+ * details of the original formatting, such as quoting and indentation, are
+ * not preserved.
+ *
+ * Passthrough mode only affects documents read after it is enabled. Module
+ * defaults and translations are always serialized.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_index_set_passthrough (ModulemdModuleIndex *self,
+                                       gboolean passthrough);
+
+
+/**
+ * modulemd_module_index_get_passthrough:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Returns: Whether this index is in passthrough mode. See
+ * modulemd_module_index_set_passthrough().
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_index_get_passthrough (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_set_collect_stats:
+ * @self: This #ModulemdModuleIndex object.
+ * @collect_stats: Whether this index should collect performance statistics.
+ *
+ * Enables or disables the collection of performance statistics about reading,
+ * merging and dumping this index. Statistics are not collected by default.
+ * The overhead of collecting them is a handful of clock reads per document
+ * and per call, so they can be left enabled in production. Disabling the
+ * collection keeps the statistics gathered so far.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_index_set_collect_stats (ModulemdModuleIndex *self,
+                                         gboolean collect_stats);
+
+
+/**
+ * modulemd_module_index_get_collect_stats:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Returns: Whether this index is collecting performance statistics. See
+ * modulemd_module_index_set_collect_stats().
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_index_get_collect_stats (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_get_stats:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Returns the performance statistics collected by this index since
+ * collection was enabled or last reset. The result is a dictionary of type
+ * `a{st}`, with the following keys:
+ *
+ * - `bytes-read`: Bytes of YAML consumed by the update functions, after any
+ *   decompression.
+ * - `documents-modulemd`, `documents-modulemd-defaults` and
+ *   `documents-modulemd-translations`: Subdocuments successfully added to
+ *   the index, by document type.
+ * - `failures`: Subdocuments that could not be added to the index.
+ * - `streams-added`: Module streams copied into the index, whether read from
+ *   YAML, merged or added directly.
+ * - `time-detect-compression`: Time spent determining the compression type of
+ *   files in modulemd_module_index_update_from_file().
+ * - `time-update-from-file`: Total time spent in
+ *   modulemd_module_index_update_from_file(), including decompression.
+ * - `time-update-from-parser`: Total time spent reading YAML documents, by any
+ *   of the update functions.
+ * - `time-parse-documents`: The part of `time-update-from-parser` spent
+ *   re-parsing individual subdocuments into objects and adding them to the
+ *   index.
+ * - `time-merge`: Time spent merging other indexes into this one.
+ * - `time-dump`: Time spent writing this index out as YAML.
+ *
+ * All times are in microseconds. Other keys may be added in the future.
+ *
+ * Returns: (transfer full): A floating #GVariant containing the statistics.
+ *
+ * Since: 2.9
+ */
+GVariant *
+modulemd_module_index_get_stats (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_reset_stats:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Resets every statistic returned by modulemd_module_index_get_stats() to
+ * zero.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_index_reset_stats (ModulemdModuleIndex *self);
+
 /**
  * modulemd_module_index_dump_to_stream: (skip)
  * @self: This #ModulemdModuleIndex object.
@@ -364,6 +571,85 @@ modulemd_module_index_get_module (ModulemdModuleIndex *self,
                                   const gchar *module_name);
 
 
+/**
+ * modulemd_module_index_search_streams_by_rpm_artifact:
+ * @self: This #ModulemdModuleIndex object.
+ * @nevra: (in): The NEVRA of an RPM package, such as
+ * "foo-0:1.2-3.module_f29+123.x86_64".
+ *
+ * Finds the module streams that list @nevra among their RPM artifacts.
+ *
+ * The first search of this kind builds a lookup table from all of the
+ * artifacts in the index, after which each search takes constant time. The
+ * table is kept up to date as streams are added to the index with
+ * modulemd_module_index_add_module_stream() and as modules are removed with
+ * modulemd_module_index_remove_module(). Changing the artifacts of a
+ * #ModulemdModuleStream after it was added to the index is not detected.
+ *
+ * Returns: (transfer container) (element-type ModulemdModuleStream): The
+ * matching streams in no particular order. This function cannot fail, but it
+ * may return a zero-length list if no matches were found.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_module_index_search_streams_by_rpm_artifact (
+  ModulemdModuleIndex *self, const gchar *nevra);
+
+
+/**
+ * modulemd_module_index_search_streams_by_package_name:
+ * @self: This #ModulemdModuleIndex object.
+ * @package_name: (in): The name of an RPM package, such as "foo".
+ *
+ * Finds the module streams that list any version or architecture of
+ * @package_name among their RPM artifacts. See
+ * modulemd_module_index_search_streams_by_rpm_artifact() for how the lookup
+ * table behind this function is maintained.
+ *
+ * Returns: (transfer container) (element-type ModulemdModuleStream): The
+ * matching streams in no particular order. This function cannot fail, but it
+ * may return a zero-length list if no matches were found.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_module_index_search_streams_by_package_name (
+  ModulemdModuleIndex *self, const gchar *package_name);
+
+
+/**
+ * modulemd_module_index_search_streams_by_rpm_checksum:
+ * @self: This #ModulemdModuleIndex object.
+ * @digest: (in): A string representing the digest algorithm used to generate
+ * the @checksum, such as "sha256".
+ * @checksum: (in): An RPM artifact checksum.
+ * @entry: (out) (optional) (transfer none): The #ModulemdRpmMapEntry that the
+ * first matching stream has for @checksum, or NULL if there were no matches.
+ *
+ * Finds the module streams whose RPM artifact map, as set with
+ * modulemd_module_stream_v2_set_rpm_artifact_map_entry(), lists @checksum
+ * for @digest.
+ *
+ * The first search of this kind builds a lookup table from the artifact maps
+ * of all of the streams in the index, after which each search takes constant
+ * time. The table is maintained in the same way as the one behind
+ * modulemd_module_index_search_streams_by_rpm_artifact().
+ *
+ * Returns: (transfer container) (element-type ModulemdModuleStream): The
+ * matching streams in no particular order. This function cannot fail, but it
+ * may return a zero-length list if no matches were found.
+ *
+ * Since: 2.9
+ */
+GPtrArray *
+modulemd_module_index_search_streams_by_rpm_checksum (
+  ModulemdModuleIndex *self,
+  const gchar *digest,
+  const gchar *checksum,
+  ModulemdRpmMapEntry **entry);
+
+
 /**
  * modulemd_module_index_remove_module:
  * @self: This #ModulemdModuleIndex object.
@@ -382,6 +668,83 @@ gboolean
 modulemd_module_index_remove_module (ModulemdModuleIndex *self,
                                      const gchar *module_name);
 
+
+/**
+ * modulemd_module_index_filter:
+ * @self: This #ModulemdModuleIndex object.
+ * @module_name: (nullable): A glob pattern, as accepted by
+ * g_pattern_match_simple(), that module names must match. If NULL, all
+ * modules match.
+ * @stream_name: (nullable): A glob pattern that stream names must match. It
+ * applies to module streams and translations. If NULL, all streams match.
+ * @version: The version module streams must have. If set to zero, the version
+ * is not included in the search.
+ * @context: (nullable): A glob pattern that the context of module streams
+ * must match. If NULL, the context is not included in the search.
+ * @arch: (nullable): A glob pattern that the processor architecture of module
+ * streams must match. If NULL, the architecture is not included in the
+ * search.
+ * @doctypes: The #ModulemdDocumentTypeFlags of the documents to keep.
+ *
+ * Creates a new index holding the subset of @self that matches all of the
+ * requested parameters. Defaults are kept whole for every matching module.
+ * Modules left with no streams, defaults or translations are omitted.
+ *
+ * If @self is frozen, no metadata is copied: the new index holds references
+ * to the same #ModulemdModuleStream, #ModulemdDefaults and
+ * #ModulemdTranslation objects, which cannot change any more. Otherwise the
+ * matching documents are copied, so that changing or freezing either index
+ * afterwards never affects the other one.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdModuleIndex containing
+ * the matching documents. It may be empty, but is never NULL.
+ *
+ * Since: 2.9
+ */
+ModulemdModuleIndex *
+modulemd_module_index_filter (ModulemdModuleIndex *self,
+                              const gchar *module_name,
+                              const gchar *stream_name,
+                              guint64 version,
+                              const gchar *context,
+                              const gchar *arch,
+                              ModulemdDocumentTypeFlags doctypes);
+
+
+/**
+ * modulemd_module_index_prune:
+ * @self: This #ModulemdModuleIndex object.
+ * @module_name: (nullable): A glob pattern, as accepted by
+ * g_pattern_match_simple(), that module names must match. If NULL, all
+ * modules match.
+ * @stream_name: (nullable): A glob pattern that stream names must match. It
+ * applies to module streams and translations. If NULL, all streams match.
+ * @version: The version module streams must have. If set to zero, the version
+ * is not included in the search.
+ * @context: (nullable): A glob pattern that the context of module streams
+ * must match. If NULL, the context is not included in the search.
+ * @arch: (nullable): A glob pattern that the processor architecture of module
+ * streams must match. If NULL, the architecture is not included in the
+ * search.
+ * @doctypes: The #ModulemdDocumentTypeFlags of the documents to keep.
+ *
+ * Removes everything from @self that modulemd_module_index_filter() would not
+ * have returned for the same parameters. This avoids holding the original and
+ * the filtered index in memory at the same time.
+ *
+ * Returns: The number of documents removed from @self.
+ *
+ * Since: 2.9
+ */
+guint
+modulemd_module_index_prune (ModulemdModuleIndex *self,
+                             const gchar *module_name,
+                             const gchar *stream_name,
+                             guint64 version,
+                             const gchar *context,
+                             const gchar *arch,
+                             ModulemdDocumentTypeFlags doctypes);
+
 /**
  * modulemd_module_index_add_module_stream:
  * @self: This #ModulemdModuleIndex object.
@@ -438,10 +801,14 @@ modulemd_module_index_add_defaults (ModulemdModuleIndex *self,
  *
  * This function cannot fail, but may return an empty (non-NULL) #GHashTable.
  *
+ * The dictionary is a copy of the one returned by
+ * modulemd_module_index_peek_default_streams(), which should be preferred by
+ * callers that only read it.
+ *
  * Returns: (transfer container) (element-type utf8 utf8): A #GHashTable with
  * the module name as the key and the default stream as the value for all
  * modules with a default stream in the index. Modules without a default stream
- * will not appear in this table.
+ * will not appear in this table. Release it with g_hash_table_unref().
  *
  * Since: 2.5
  */
@@ -450,6 +817,35 @@ modulemd_module_index_get_default_streams_as_hash_table (
   ModulemdModuleIndex *self, const gchar *intent);
 
 
+/**
+ * modulemd_module_index_peek_default_streams:
+ * @self: (in): This #ModulemdModuleIndex object.
+ * @intent: (in) (nullable): The name of the system intent whose default stream
+ * will be retrieved. If left NULL or the specified intent has no separate
+ * default, it will return the generic default stream for this module.
+ *
+ * Get a dictionary of all modules in the index that have a default stream,
+ * without copying it.
+ *
+ * The dictionary for each @intent is built on first use and kept until
+ * defaults are added to or removed from @self, or until any
+ * #ModulemdDefaults object is modified, so repeated calls do not allocate.
+ * Once @self is frozen with modulemd_module_index_freeze(), the dictionaries
+ * for every intent are built up front and never change again.
+ *
+ * Returns: (transfer none) (element-type utf8 utf8): A #GHashTable with the
+ * module name as the key and the default stream as the value for all modules
+ * with a default stream in the index. It is owned by @self and must not be
+ * modified. It is only valid until the next change to the defaults of an
+ * index that is not frozen.
+ *
+ * Since: 2.9
+ */
+GHashTable *
+modulemd_module_index_peek_default_streams (ModulemdModuleIndex *self,
+                                            const gchar *intent);
+
+
 /**
  * modulemd_module_index_add_translation:
  * @self: This #ModulemdModuleIndex object.
@@ -503,6 +899,12 @@ modulemd_module_index_get_stream_mdversion (ModulemdModuleIndex *self);
  * Upgrades all #ModulemdModuleStream objects in this index to @mdversion if
  * they are not already at that version.
  *
+ * The streams of different modules are upgraded in parallel, on up to one
+ * thread per processor. Each stream is replaced as soon as it is upgraded,
+ * and one that is not also referenced from outside of the index hands its
+ * contents over to its replacement instead of having them copied, so the
+ * index does not need twice its memory while it is being upgraded.
+ *
  * Since: 2.0
  */
 gboolean
@@ -529,4 +931,143 @@ modulemd_module_index_upgrade_defaults (ModulemdModuleIndex *self,
                                         ModulemdDefaultsVersionEnum mdversion,
                                         GError **error);
 
+
+/**
+ * modulemd_module_index_freeze:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Makes this index read-only so that it can be shared between threads without
+ * any locking.
+ *
+ * Everything that readers would otherwise compute and cache on first use is
+ * built here instead: the streams of every module are put in the order they
+ * are dumped in, the module names are sorted, the tables returned by
+ * modulemd_module_index_peek_default_streams() for the generic defaults and
+ * for every intent with defaults of its own and the lookup tables for
+ * modulemd_module_index_search_streams_by_rpm_artifact() and its siblings
+ * are filled in, every stream is validated and the fingerprints of the
+ * streams and defaults are computed. The string sets of the streams, such
+ * as their RPM API and artifacts, are also packed into
+ * sorted arrays, which the matching `_as_strv()` getters copy rather than
+ * sort again, and the lists returned by `peek` functions such as
+ * modulemd_module_stream_v2_peek_profile_names() are cached. After that,
+ * dumping, searching and the getters of the index, its modules and their
+ * streams only read from it.
+ *
+ * The documents of @self are frozen in place. References that the
+ * application or a #ModulemdIndexDiff still holds to them become read-only
+ * as well. Other indexes never share documents with an unfrozen index, as
+ * modulemd_module_index_filter() copies them, so they are not affected.
+ *
+ * Once frozen, the functions that would modify the index, its modules, their
+ * streams, defaults and translations, or the children handed out by their
+ * getters, such as the #ModulemdBuildopts returned by
+ * modulemd_module_stream_v2_get_buildopts() or the #ModulemdTranslationEntry
+ * objects of a #ModulemdTranslation, fail with a critical warning and leave
+ * them unchanged. An index cannot be thawed. The streams that the results of
+ * filtering a frozen index share with it are frozen as well.
+ *
+ * Freezing is not itself thread-safe: freeze the index before handing it to
+ * other threads, for example before creating them or by publishing it with
+ * g_atomic_pointer_set().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_index_freeze (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_is_frozen:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Returns: TRUE if modulemd_module_index_freeze() was called on this index.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_index_is_frozen (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_diff:
+ * @from: This #ModulemdModuleIndex object, holding the old version of the
+ * metadata.
+ * @to: (in): A #ModulemdModuleIndex holding the new version of the metadata.
+ *
+ * Lists the module streams, defaults and translations that were added,
+ * removed or changed from @from to @to, along with the names of the fields
+ * that changed. See #ModulemdIndexDiff for how they are matched up.
+ *
+ * Every document carries a fingerprint of its content, so the documents that
+ * are the same in both indexes are skipped after comparing their fingerprints
+ * and only those that changed are compared field by field. The fingerprints
+ * of the streams and defaults of a frozen index are computed once by
+ * modulemd_module_index_freeze(), so comparing successive frozen versions of
+ * large repositories is cheap.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdIndexDiff. It shares
+ * the objects it lists with @from and @to.
+ *
+ * Since: 2.9
+ */
+ModulemdIndexDiff *
+modulemd_module_index_diff (ModulemdModuleIndex *from,
+                            ModulemdModuleIndex *to);
+
+
+/**
+ * modulemd_module_index_export_streams:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Exports a summary of every module stream in this index, for tools that
+ * scan a whole repository and would otherwise query each stream, and each of
+ * its dependencies, one call at a time.
+ *
+ * The streams are listed in the order they are dumped in, sorted by module
+ * name and then as in modulemd_module_get_all_streams(). Each of them is
+ * described by a dictionary of type `a{sv}` holding:
+ *
+ * - "module_name", "stream_name" and "nsvca": strings.
+ * - "version": a `uint64`.
+ * - "context" and "arch": maybe strings, which are nothing when unset.
+ * - "rpm_artifacts": the sorted NEVRAs of the RPM artifacts, as an `as`.
+ * - "dependencies": an `aa{sa{sas}}` with one dictionary for each
+ *   #ModulemdDependencies of the stream. Its "buildrequires" and "requires"
+ *   entries map each module name to its sorted list of streams, which is
+ *   empty if any stream will do. The requirements of a
+ *   #ModulemdModuleStreamV1 are exported as a single such dictionary, with
+ *   one stream for each module.
+ *
+ * Like the other getters, this only reads from a frozen index.
+ *
+ * Returns: (transfer full): A #GVariant of type `aa{sv}` describing the
+ * streams of @self.
+ *
+ * Since: 2.9
+ */
+GVariant *
+modulemd_module_index_export_streams (ModulemdModuleIndex *self);
+
+
+/**
+ * modulemd_module_index_export_streams_as_json:
+ * @self: This #ModulemdModuleIndex object.
+ *
+ * Returns the summary built by modulemd_module_index_export_streams() as a
+ * JSON array of objects, in which unset contexts and architectures are null.
+ * It is meant for language bindings, which can decode the whole summary with
+ * their native JSON parser instead of visiting the #GVariant one value at a
+ * time. The Python bindings use it to implement
+ * `Modulemd.ModuleIndex.export_streams()`, which returns a list of
+ * dictionaries.
+ *
+ * Returns: (transfer full): A newly-allocated JSON string describing the
+ * streams of @self.
+ *
+ * Since: 2.9
+ */
+gchar *
+modulemd_module_index_export_streams_as_json (ModulemdModuleIndex *self);
+
 G_END_DECLS
@@ -959,4 +959,51 @@ GVariant *
 modulemd_module_stream_v1_get_xmd (ModulemdModuleStreamV1 *self);
 
 
+/**
+ * modulemd_module_stream_v1_set_xmd_from_json:
+ * @self: (in): This #ModulemdModuleStreamV1 object.
+ * @json: (in): A JSON document holding the XMD, normally an object.
+ * @error: (out): A #GError that will return the reason for failing to parse
+ * @json.
+ *
+ * Sets the eXtensible MetaData (XMD) for this module from JSON, without
+ * building the #GVariant one value at a time. This is how the Python bindings
+ * implement `set_xmd()`.
+ *
+ * JSON objects become dictionaries and arrays become lists, as when the XMD
+ * is read from YAML. Numbers are stored as strings holding their text, which
+ * is what YAML would give for the same value, and null as an empty string.
+ *
+ * Returns: TRUE if the XMD was set. FALSE if @json is not valid JSON and sets
+ * @error appropriately, leaving the XMD unchanged.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_stream_v1_set_xmd_from_json (ModulemdModuleStreamV1 *self,
+                                             const gchar *json,
+                                             GError **error);
+
+
+/**
+ * modulemd_module_stream_v1_get_xmd_as_json:
+ * @self: (in): This #ModulemdModuleStreamV1 object.
+ *
+ * Returns the eXtensible MetaData (XMD) for this module as a compact JSON
+ * document, which language bindings can decode with their native JSON parser
+ * instead of visiting the #GVariant one value at a time. This is how the
+ * Python bindings implement `get_xmd()`.
+ *
+ * The keys of objects are in the order of the XMD dictionaries, which keep
+ * the order of the JSON they were set from.
+ *
+ * Returns: (transfer full) (nullable): A newly-allocated JSON document, or
+ * NULL if no XMD is set.
+ *
+ * Since: 2.9
+ */
+gchar *
+modulemd_module_stream_v1_get_xmd_as_json (ModulemdModuleStreamV1 *self);
+
+
 G_END_DECLS
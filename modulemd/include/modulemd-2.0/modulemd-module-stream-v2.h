@@ -340,6 +340,36 @@ GStrv
 modulemd_module_stream_v2_get_module_component_names_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_module_component_names:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Iterates over the module component names without allocating anything, for
+ * example:
+ * |[<!-- language="C" -->
+ * const gchar *const *names =
+ *   modulemd_module_stream_v2_peek_module_component_names (stream);
+ *
+ * for (guint i = 0; names[i]; i++)
+ *   do_something (modulemd_module_stream_v2_get_module_component (stream,
+ *                                                                 names[i]));
+ * ]|
+ *
+ * The list is sorted once and cached on @self, as are those of the other
+ * `peek` functions of #ModulemdModuleStreamV2. Getters that return a child
+ * of @self, such as modulemd_module_stream_v2_get_module_component(), leave
+ * it in place, but any function that modifies @self itself frees it.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The same list as
+ * modulemd_module_stream_v2_get_module_component_names_as_strv(), owned by
+ * @self.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_module_component_names (
+  ModulemdModuleStreamV2 *self);
+
 /**
  * modulemd_module_stream_v2_get_rpm_component_names_as_strv: (rename-to modulemd_module_stream_v2_get_rpm_component_names)
  * @self: (in): This #ModulemdModuleStreamV2 object.
@@ -353,6 +383,20 @@ GStrv
 modulemd_module_stream_v2_get_rpm_component_names_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_rpm_component_names:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The RPM component names
+ * of this stream, sorted and owned by @self until it is next modified. See
+ * modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_component_names (
+  ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_get_module_component:
@@ -473,6 +517,20 @@ GStrv
 modulemd_module_stream_v2_get_content_licenses_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_content_licenses:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The licenses under which
+ * the components of this stream are distributed, sorted and owned by @self
+ * until it is next modified. See
+ * modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_content_licenses (ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_get_module_licenses_as_strv: (rename-to modulemd_module_stream_v2_get_module_licenses)
@@ -487,6 +545,19 @@ GStrv
 modulemd_module_stream_v2_get_module_licenses_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_module_licenses:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The licenses under which
+ * this module stream is distributed, sorted and owned by @self until it is
+ * next modified. See modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_module_licenses (ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_add_profile:
@@ -527,6 +598,19 @@ GStrv
 modulemd_module_stream_v2_get_profile_names_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_profile_names:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The names of the
+ * profiles of this stream, sorted and owned by @self until it is next
+ * modified. See modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_profile_names (ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_get_profile:
@@ -592,6 +676,20 @@ modulemd_module_stream_v2_clear_rpm_api (ModulemdModuleStreamV2 *self);
 GStrv
 modulemd_module_stream_v2_get_rpm_api_as_strv (ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_rpm_api:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The binary RPM names
+ * that form the public API of this stream, sorted and owned by @self until it
+ * is next modified. See
+ * modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_api (ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_add_rpm_artifact:
@@ -642,6 +740,19 @@ GStrv
 modulemd_module_stream_v2_get_rpm_artifacts_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_rpm_artifacts:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The NEVRs of the binary
+ * RPMs in this stream, sorted and owned by @self until it is next modified.
+ * See modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_artifacts (ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_set_rpm_artifact_map_entry:
@@ -727,6 +838,19 @@ GStrv
 modulemd_module_stream_v2_get_rpm_filters_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_rpm_filters:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The binary RPM names
+ * filtered out of this stream, sorted and owned by @self until it is next
+ * modified. See modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_filters (ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_add_servicelevel:
@@ -767,6 +891,20 @@ GStrv
 modulemd_module_stream_v2_get_servicelevel_names_as_strv (
   ModulemdModuleStreamV2 *self);
 
+/**
+ * modulemd_module_stream_v2_peek_servicelevel_names:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The names of the service
+ * levels of this stream, sorted and owned by @self until it is next modified.
+ * See modulemd_module_stream_v2_peek_module_component_names().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_v2_peek_servicelevel_names (
+  ModulemdModuleStreamV2 *self);
+
 
 /**
  * modulemd_module_stream_v2_get_servicelevel:
@@ -869,4 +1007,51 @@ GVariant *
 modulemd_module_stream_v2_get_xmd (ModulemdModuleStreamV2 *self);
 
 
+/**
+ * modulemd_module_stream_v2_set_xmd_from_json:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ * @json: (in): A JSON document holding the XMD, normally an object.
+ * @error: (out): A #GError that will return the reason for failing to parse
+ * @json.
+ *
+ * Sets the eXtensible MetaData (XMD) for this module from JSON, without
+ * building the #GVariant one value at a time. This is how the Python bindings
+ * implement `set_xmd()`.
+ *
+ * JSON objects become dictionaries and arrays become lists, as when the XMD
+ * is read from YAML. Numbers are stored as strings holding their text, which
+ * is what YAML would give for the same value, and null as an empty string.
+ *
+ * Returns: TRUE if the XMD was set. FALSE if @json is not valid JSON and sets
+ * @error appropriately, leaving the XMD unchanged.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_stream_v2_set_xmd_from_json (ModulemdModuleStreamV2 *self,
+                                             const gchar *json,
+                                             GError **error);
+
+
+/**
+ * modulemd_module_stream_v2_get_xmd_as_json:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Returns the eXtensible MetaData (XMD) for this module as a compact JSON
+ * document, which language bindings can decode with their native JSON parser
+ * instead of visiting the #GVariant one value at a time. This is how the
+ * Python bindings implement `get_xmd()`.
+ *
+ * The keys of objects are in the order of the XMD dictionaries, which keep
+ * the order of the JSON they were set from.
+ *
+ * Returns: (transfer full) (nullable): A newly-allocated JSON document, or
+ * NULL if no XMD is set.
+ *
+ * Since: 2.9
+ */
+gchar *
+modulemd_module_stream_v2_get_xmd_as_json (ModulemdModuleStreamV2 *self);
+
+
 G_END_DECLS
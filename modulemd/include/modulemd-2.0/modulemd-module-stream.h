@@ -221,6 +221,26 @@ modulemd_module_stream_equals (ModulemdModuleStream *self_1,
                                ModulemdModuleStream *self_2);
 
 
+/**
+ * modulemd_module_stream_get_fingerprint:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Returns: A 64-bit hash of the content of @self. Streams that are equal
+ * according to modulemd_module_stream_equals() always have the same
+ * fingerprint, so it can be used as a cache key for their content. It is
+ * computed on first use and kept until @self is modified, directly or through
+ * one of its children. Streams of a frozen #ModulemdModuleIndex have it
+ * computed by modulemd_module_index_freeze().
+ *
+ * Fingerprints are not meant to be stored: they may change between releases
+ * of libmodulemd.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_module_stream_get_fingerprint (ModulemdModuleStream *self);
+
+
 /**
  * modulemd_module_stream_copy:
  * @self: (in): This #ModulemdModuleStream object.
@@ -161,4 +161,17 @@ modulemd_profile_clear_rpms (ModulemdProfile *self);
 GStrv
 modulemd_profile_get_rpms_as_strv (ModulemdProfile *self);
 
+/**
+ * modulemd_profile_peek_rpms:
+ * @self: This #ModulemdProfile object.
+ *
+ * Returns: (transfer none) (array zero-terminated=1): The same list as
+ * modulemd_profile_get_rpms_as_strv(), without copying it. It is sorted once
+ * and cached on @self until the next call that adds or removes RPMs.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_profile_peek_rpms (ModulemdProfile *self);
+
 G_END_DECLS
@@ -131,4 +131,21 @@ ModulemdTranslationEntry *
 modulemd_translation_get_translation_entry (ModulemdTranslation *self,
                                             const gchar *locale);
 
+
+/**
+ * modulemd_translation_get_fingerprint:
+ * @self: This #ModulemdTranslation object.
+ *
+ * Returns: A 64-bit hash of the content of @self, including all of its
+ * translation entries. It is computed on each call, as the entries returned
+ * by modulemd_translation_get_translation_entry() may be modified in place.
+ *
+ * Fingerprints are not meant to be stored: they may change between releases
+ * of libmodulemd.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_translation_get_fingerprint (ModulemdTranslation *self);
+
 G_END_DECLS
@@ -19,10 +19,14 @@
 #include "modulemd-component-rpm.h"
 #include "modulemd-compression.h"
 #include "modulemd-defaults.h"
+#include "modulemd-defaults-conflict.h"
 #include "modulemd-defaults-v1.h"
 #include "modulemd-dependencies.h"
 #include "modulemd-deprecated.h"
 #include "modulemd-errors.h"
+#include "modulemd-index-diff.h"
+#include "modulemd-index-snapshot.h"
+#include "modulemd-instrumentation.h"
 #include "modulemd-module.h"
 #include "modulemd-module-index.h"
 #include "modulemd-module-index-merger.h"
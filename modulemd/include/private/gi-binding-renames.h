@@ -278,4 +278,28 @@ modulemd_module_index_get_default_streams (ModulemdModuleIndex *self,
 gchar *
 modulemd_rpm_map_entry_get_nevra (ModulemdRpmMapEntry *self);
 
+
+/**
+ * modulemd_index_diff_get_changed_stream_fields: (skip)
+ */
+GStrv
+modulemd_index_diff_get_changed_stream_fields (ModulemdIndexDiff *self,
+                                               const gchar *nsvca);
+
+/**
+ * modulemd_index_diff_get_changed_defaults_fields: (skip)
+ */
+GStrv
+modulemd_index_diff_get_changed_defaults_fields (ModulemdIndexDiff *self,
+                                                 const gchar *module_name);
+
+/**
+ * modulemd_index_diff_get_changed_translation_fields: (skip)
+ */
+GStrv
+modulemd_index_diff_get_changed_translation_fields (
+  ModulemdIndexDiff *self,
+  const gchar *module_name,
+  const gchar *module_stream);
+
 G_END_DECLS
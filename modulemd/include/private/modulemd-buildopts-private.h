@@ -17,6 +17,7 @@
 #include <yaml.h>
 
 #include "modulemd-buildopts.h"
+#include "private/modulemd-util.h"
 
 /**
  * SECTION: modulemd-buildopts-private
@@ -63,3 +64,32 @@ gboolean
 modulemd_buildopts_emit_yaml (ModulemdBuildopts *self,
                               yaml_emitter_t *emitter,
                               GError **error);
+
+
+/**
+ * modulemd_buildopts_set_owner:
+ * @self: This #ModulemdBuildopts object.
+ * @owner: (nullable): The #ModulemdOwner link of the #ModulemdModuleStream
+ * these buildopts are stored in, as returned by
+ * modulemd_module_stream_as_owner(), or NULL.
+ *
+ * Makes every change to @self mark that stream as modified, and makes the
+ * setters of @self fail once that stream is frozen.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_buildopts_set_owner (ModulemdBuildopts *self, ModulemdOwner *owner);
+
+
+/**
+ * modulemd_buildopts_fingerprint:
+ * @self: (nullable): This #ModulemdBuildopts object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add().
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_buildopts_fingerprint (ModulemdBuildopts *self);
@@ -64,3 +64,18 @@ gboolean
 modulemd_component_module_emit_yaml (ModulemdComponentModule *self,
                                      yaml_emitter_t *emitter,
                                      GError **error);
+
+
+/**
+ * modulemd_component_module_add_fingerprint:
+ * @self: This #ModulemdComponentModule object.
+ * @fingerprint: The fingerprint of the #ModulemdComponent content of @self.
+ *
+ * Returns: @fingerprint extended with the content specific to a
+ * #ModulemdComponentModule.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_component_module_add_fingerprint (ModulemdComponentModule *self,
+                                           guint64 fingerprint);
@@ -17,6 +17,7 @@
 #include <yaml.h>
 
 #include "modulemd-component.h"
+#include "private/modulemd-util.h"
 
 /**
  * SECTION: modulemd-component-private
@@ -132,3 +133,61 @@ modulemd_component_emit_yaml_build_common (ModulemdComponent *self,
  */
 gboolean
 modulemd_component_equals_wrapper (const void *a, const void *b);
+
+
+/**
+ * modulemd_component_set_owner:
+ * @self: This #ModulemdComponent object.
+ * @owner: (nullable): The #ModulemdOwner link of the #ModulemdModuleStream
+ * this component is stored in, as returned by
+ * modulemd_module_stream_as_owner(), or NULL.
+ *
+ * Makes every change to @self mark that stream as modified, and makes the
+ * setters of @self fail once that stream is frozen.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_component_set_owner (ModulemdComponent *self, ModulemdOwner *owner);
+
+
+/**
+ * modulemd_component_changed:
+ * @self: This #ModulemdComponent object.
+ *
+ * Tells the stream @self is stored in, if any, that @self is being modified.
+ * Called by the setters of #ModulemdComponentRpm and
+ * #ModulemdComponentModule; see modulemd_component_set_owner().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_component_changed (ModulemdComponent *self);
+
+
+/**
+ * modulemd_component_is_frozen:
+ * @self: This #ModulemdComponent object.
+ *
+ * Returns: TRUE if @self is stored in a frozen #ModulemdModuleStream. The
+ * setters of #ModulemdComponentRpm and #ModulemdComponentModule refuse to
+ * modify it then.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_component_is_frozen (ModulemdComponent *self);
+
+
+/**
+ * modulemd_component_fingerprint:
+ * @self: (nullable): This #ModulemdComponent object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add(), including the
+ * content specific to #ModulemdComponentRpm and #ModulemdComponentModule.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_component_fingerprint (ModulemdComponent *self);
@@ -64,3 +64,18 @@ gboolean
 modulemd_component_rpm_emit_yaml (ModulemdComponentRpm *self,
                                   yaml_emitter_t *emitter,
                                   GError **error);
+
+
+/**
+ * modulemd_component_rpm_add_fingerprint:
+ * @self: This #ModulemdComponentRpm object.
+ * @fingerprint: The fingerprint of the #ModulemdComponent content of @self.
+ *
+ * Returns: @fingerprint extended with the content specific to a
+ * #ModulemdComponentRpm.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_component_rpm_add_fingerprint (ModulemdComponentRpm *self,
+                                        guint64 fingerprint);
@@ -0,0 +1,55 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+#include "modulemd-defaults-conflict.h"
+
+G_BEGIN_DECLS
+
+/**
+ * SECTION: modulemd-defaults-conflict-private
+ * @title: Modulemd.DefaultsConflict (Private)
+ * @stability: private
+ * @short_description: #ModulemdDefaultsConflict methods that should only be
+ * used by internal consumers.
+ */
+
+
+/**
+ * modulemd_defaults_conflict_new:
+ * @conflict_type: (in): The kind of field that conflicted.
+ * @module_name: (in): The module whose defaults conflicted.
+ * @intent: (in) (nullable): The intent the conflict occurred in, or NULL for
+ * the generic defaults.
+ * @stream_name: (in) (nullable): The stream whose default profiles
+ * conflicted, or NULL for a default stream conflict.
+ * @modified: (in): The modified value shared by all of the conflicting
+ * values.
+ * @values: (in) (transfer full): A NULL-terminated list of at least two
+ * distinct conflicting values.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdDefaultsConflict.
+ *
+ * Since: 2.9
+ */
+ModulemdDefaultsConflict *
+modulemd_defaults_conflict_new (ModulemdDefaultsConflictTypeEnum conflict_type,
+                                const gchar *module_name,
+                                const gchar *intent,
+                                const gchar *stream_name,
+                                guint64 modified,
+                                GStrv values);
+
+G_END_DECLS
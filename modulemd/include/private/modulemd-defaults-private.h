@@ -14,6 +14,7 @@
 #pragma once
 
 #include <glib-object.h>
+#include "private/modulemd-util.h"
 
 G_BEGIN_DECLS
 
@@ -66,4 +67,105 @@ modulemd_defaults_merge (ModulemdDefaults *from,
                          gboolean strict_default_streams,
                          GError **error);
 
+
+/**
+ * modulemd_defaults_merge_n:
+ * @defaults: (in) (element-type ModulemdDefaults): The #ModulemdDefaults
+ * objects to merge. All of them must describe the same module name and share
+ * the same mdversion. Must contain at least one entry.
+ * @strict_default_streams: (in): Whether a stream conflict should throw an
+ * error or just unset the default stream.
+ * @conflicts: (out) (optional) (element-type ModulemdDefaultsConflict)
+ * (transfer full): Every conflict encountered during the merge.
+ * @error: (out): A #GError containing the reason for an unresolvable merge
+ * conflict.
+ *
+ * Performs a single-pass merge of any number of #ModulemdDefaults objects.
+ * See modulemd_defaults_v1_merge_n() for the rules used.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdDefaults object
+ * containing the merged values of @defaults. If this function encounters an
+ * unresolvable merge conflict, it will return NULL and set @error
+ * appropriately.
+ *
+ * Since: 2.9
+ */
+ModulemdDefaults *
+modulemd_defaults_merge_n (GPtrArray *defaults,
+                           gboolean strict_default_streams,
+                           GPtrArray **conflicts,
+                           GError **error);
+
+
+/**
+ * modulemd_defaults_fingerprint_fields:
+ * @self: (in): This #ModulemdDefaults object.
+ * @func: (scope call): The function receiving the fingerprints.
+ * @user_data: The data to pass to @func.
+ *
+ * Calls @func with the content fingerprint of each field of @self that
+ * modulemd_defaults_equals() compares, always in the same order for defaults
+ * of the same metadata version.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_defaults_fingerprint_fields (ModulemdDefaults *self,
+                                      ModulemdFingerprintFieldFunc func,
+                                      gpointer user_data);
+
+
+/**
+ * modulemd_defaults_clear_fingerprint:
+ * @self: (in): This #ModulemdDefaults object.
+ *
+ * Forgets the fingerprint cached by modulemd_defaults_get_fingerprint(). Must
+ * be called by every function that changes the content of @self.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_defaults_clear_fingerprint (ModulemdDefaults *self);
+
+
+/**
+ * modulemd_defaults_get_generation:
+ *
+ * Returns: A counter that changes every time
+ * modulemd_defaults_clear_fingerprint() is called on any #ModulemdDefaults
+ * object. Caches built from defaults that may still be modified can compare
+ * it with the value they were built at to tell whether they are stale.
+ *
+ * Since: 2.9
+ */
+guint
+modulemd_defaults_get_generation (void);
+
+
+/**
+ * modulemd_defaults_freeze:
+ * @self: (in): This #ModulemdDefaults object.
+ *
+ * Marks @self as part of a frozen #ModulemdModuleIndex. Its fingerprint and
+ * the sorted lists returned by its `peek` functions are computed first, so
+ * that readers on many threads at once never write to @self. From then on
+ * the setters of @self fail with a critical warning and leave it unchanged.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_defaults_freeze (ModulemdDefaults *self);
+
+
+/**
+ * modulemd_defaults_is_frozen:
+ * @self: (in): This #ModulemdDefaults object.
+ *
+ * Returns: TRUE if modulemd_defaults_freeze() was called on @self.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_defaults_is_frozen (ModulemdDefaults *self);
+
 G_END_DECLS
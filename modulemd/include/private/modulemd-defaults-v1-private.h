@@ -17,6 +17,7 @@
 #include <yaml.h>
 #include "modulemd-defaults-v1.h"
 #include "modulemd-subdocument-info.h"
+#include "private/modulemd-util.h"
 
 G_BEGIN_DECLS
 
@@ -96,4 +97,91 @@ modulemd_defaults_v1_merge (ModulemdDefaultsV1 *from,
                             gboolean strict_default_streams,
                             GError **error);
 
+
+/**
+ * modulemd_defaults_v1_merge_n:
+ * @defaults: (in) (element-type ModulemdDefaultsV1): The #ModulemdDefaultsV1
+ * objects to merge. All of them must describe the same module name. Must
+ * contain at least one entry.
+ * @strict_default_streams: (in): Whether a generic default stream conflict
+ * should throw an error or just unset the default stream.
+ * @conflicts: (out) (optional) (element-type ModulemdDefaultsConflict)
+ * (transfer full): Every conflict encountered during the merge, whether it
+ * was resolvable or not.
+ * @error: (out): A #GError containing the reason for an unresolvable merge
+ * conflict.
+ *
+ * Merges any number of #ModulemdDefaultsV1 objects in a single pass. For each
+ * field (the default stream, each stream's default profiles and each intent's
+ * values), the value from the participant with the highest modified value
+ * wins. Participants sharing that modified value but disagreeing produce a
+ * conflict. Because only the newest values matter, the result does not depend
+ * on the order of @defaults. The winning values are copied exactly once,
+ * rather than once per intermediate pairwise merge.
+ *
+ * A conflicting generic default stream is replaced by a merge conflict marker
+ * unless @strict_default_streams is set. Any other conflict is fatal. A
+ * participant that carries the marker from an earlier merge keeps the
+ * conflict alive against values with the same modified value, but like any
+ * other value, the marker is superseded by a default stream with a higher
+ * modified value.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdDefaultsV1 object
+ * containing the merged values. If this function encounters an unresolvable
+ * merge conflict, it will return NULL and set @error appropriately. @conflicts
+ * is populated in either case.
+ *
+ * Since: 2.9
+ */
+ModulemdDefaultsV1 *
+modulemd_defaults_v1_merge_n (GPtrArray *defaults,
+                              gboolean strict_default_streams,
+                              GPtrArray **conflicts,
+                              GError **error);
+
+
+/**
+ * modulemd_defaults_v1_fingerprint_fields:
+ * @self: (in): This #ModulemdDefaultsV1 object.
+ * @func: (scope call): The function receiving the fingerprints.
+ * @user_data: The data to pass to @func.
+ *
+ * Calls @func with the content fingerprint of each field specific to
+ * #ModulemdDefaultsV1. See modulemd_defaults_fingerprint_fields().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_defaults_v1_fingerprint_fields (ModulemdDefaultsV1 *self,
+                                         ModulemdFingerprintFieldFunc func,
+                                         gpointer user_data);
+
+
+/**
+ * modulemd_defaults_v1_sort_collections:
+ * @self: (in): This #ModulemdDefaultsV1 object.
+ *
+ * Fills in the sorted lists returned by the `peek` functions of @self for
+ * every stream and intent, so that later calls only read them.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_defaults_v1_sort_collections (ModulemdDefaultsV1 *self);
+
+
+/**
+ * modulemd_defaults_v1_add_intents:
+ * @self: (in): This #ModulemdDefaultsV1 object.
+ * @intents: (in): A #GHashTable set of intent names that owns its keys.
+ *
+ * Adds the name of every intent that has its own default stream in @self to
+ * @intents.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_defaults_v1_add_intents (ModulemdDefaultsV1 *self,
+                                  GHashTable *intents);
+
 G_END_DECLS
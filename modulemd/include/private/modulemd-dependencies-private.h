@@ -17,6 +17,7 @@
 #include <yaml.h>
 
 #include "modulemd-dependencies.h"
+#include "private/modulemd-util.h"
 
 /**
  * SECTION: modulemd-dependencies-private
@@ -120,3 +121,46 @@ modulemd_dependencies_buildrequires_module_and_stream (
   ModulemdDependencies *self,
   const gchar *module_name,
   const gchar *stream_name);
+
+
+/**
+ * modulemd_dependencies_fingerprint:
+ * @self: (nullable): This #ModulemdDependencies object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add().
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_dependencies_fingerprint (ModulemdDependencies *self);
+
+
+/**
+ * modulemd_dependencies_set_owner:
+ * @self: This #ModulemdDependencies object.
+ * @owner: (nullable): The #ModulemdOwner link of the #ModulemdModuleStream
+ * these dependencies are stored in, as returned by
+ * modulemd_module_stream_as_owner(), or NULL.
+ *
+ * Makes every change to @self mark that stream as modified, and makes the
+ * setters of @self fail once that stream is frozen.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_dependencies_set_owner (ModulemdDependencies *self,
+                                 ModulemdOwner *owner);
+
+
+/**
+ * modulemd_dependencies_sort_collections:
+ * @self: This #ModulemdDependencies object.
+ *
+ * Fills in the sorted lists returned by the `peek` functions of @self for
+ * every module, so that later calls only read them.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_dependencies_sort_collections (ModulemdDependencies *self);
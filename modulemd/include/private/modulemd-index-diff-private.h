@@ -0,0 +1,48 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+#include "modulemd-index-diff.h"
+#include "modulemd-module-index.h"
+
+G_BEGIN_DECLS
+
+/**
+ * SECTION: modulemd-index-diff-private
+ * @title: Modulemd.IndexDiff (Private)
+ * @stability: private
+ * @short_description: #ModulemdIndexDiff methods that should only be used by
+ * internal consumers.
+ */
+
+
+/**
+ * modulemd_index_diff_new:
+ * @from: (in): The old version of the metadata.
+ * @to: (in): The new version of the metadata.
+ *
+ * Compares every module stream, defaults and translation of @from and @to.
+ * Those with the same content fingerprint are skipped without looking any
+ * further; only the documents that changed are compared field by field.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdIndexDiff listing the
+ * differences from @from to @to.
+ *
+ * Since: 2.9
+ */
+ModulemdIndexDiff *
+modulemd_index_diff_new (ModulemdModuleIndex *from, ModulemdModuleIndex *to);
+
+G_END_DECLS
@@ -90,4 +90,41 @@ modulemd_module_index_merge (ModulemdModuleIndex *from,
                              gboolean strict_default_streams,
                              GError **error);
 
+
+/**
+ * modulemd_module_index_merge_all:
+ * @from_indexes: (in) (transfer none) (element-type ModulemdModuleIndex): The
+ * #ModulemdModuleIndex objects whose contents are being merged in.
+ * @into: (inout) (transfer none): The #ModulemdModuleIndex whose contents are
+ * being updated by those from @from_indexes.
+ * @override: (in): Whether the merged contents of @from_indexes supersede
+ * those from @into. See modulemd_module_index_merge().
+ * @strict_default_streams: (in): When merging #ModulemdDefaults, treat
+ * conflicting stream defaults as an error if this is True. Otherwise, on a
+ * conflict, the default stream will be unset.
+ * @conflicts: (in) (nullable) (element-type ModulemdDefaultsConflict): An
+ * array that every #ModulemdDefaultsConflict found is appended to, or NULL.
+ * @error: (out): If the merge fails, this will return a #GError explaining the
+ * reason for it.
+ *
+ * Merges any number of #ModulemdModuleIndex objects into @into at the same
+ * priority. Unlike repeated calls to modulemd_module_index_merge(), the
+ * #ModulemdDefaults for each module are collected from every index first and
+ * then merged once with modulemd_defaults_merge_n(), so they are copied only
+ * once regardless of how many indexes provide them. Any conflicts found are
+ * logged with g_info() and appended to @conflicts, even if the merge fails.
+ *
+ * Returns: TRUE if all of the #ModulemdModuleIndex objects could be merged
+ * without conflicts. FALSE and sets @error appropriately if the merge fails.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_index_merge_all (GPtrArray *from_indexes,
+                                 ModulemdModuleIndex *into,
+                                 gboolean override,
+                                 gboolean strict_default_streams,
+                                 GPtrArray *conflicts,
+                                 GError **error);
+
 G_END_DECLS
@@ -16,6 +16,7 @@
 #include <glib-object.h>
 #include <yaml.h>
 
+#include "modulemd-module-index.h"
 #include "modulemd-module.h"
 #include "modulemd-translation.h"
 
@@ -136,12 +137,44 @@ modulemd_module_add_stream (ModulemdModule *self,
                             GError **error);
 
 
+/**
+ * modulemd_module_add_stream_shared:
+ * @self: This #ModulemdModule object.
+ * @stream: A #ModulemdModuleStream object to associate with this
+ * #ModulemdModule.
+ * @index_mdversion: (in): The #ModulemdModuleStreamVersionEnum of the highest
+ * stream version added so far in the #ModulemdModuleIndex.
+ * @error: (out): A #GError containing information about why this function
+ * failed.
+ *
+ * Like modulemd_module_add_stream(), but when @stream does not need to be
+ * upgraded, @self keeps a reference to it instead of a copy. This is meant for
+ * streams that were just parsed and have no other user; the caller must not
+ * modify @stream afterwards.
+ *
+ * Returns: The same as modulemd_module_add_stream().
+ *
+ * Since: 2.9
+ */
+ModulemdModuleStreamVersionEnum
+modulemd_module_add_stream_shared (
+  ModulemdModule *self,
+  ModulemdModuleStream *stream,
+  ModulemdModuleStreamVersionEnum index_mdversion,
+  GError **error);
+
+
 /**
  * modulemd_module_upgrade_streams:
  * @self: This #ModulemdModule object.
  * @mdversion: The metadata version to upgrade to.
  * @error: (out): A #GError containing the reason a stream failed to upgrade.
  *
+ * Replaces each stream of @self by its upgraded version in turn. Streams that
+ * are not shared outside of @self are taken apart to build their replacement;
+ * see modulemd_module_stream_upgrade_owned(). If an upgrade fails, the
+ * streams before it have already been replaced.
+ *
  * Returns: TRUE if all upgrades completed successfully. FALSE and sets @error
  * if an upgrade error occurs, including attempts to downgrade a stream.
  *
@@ -152,4 +185,82 @@ modulemd_module_upgrade_streams (ModulemdModule *self,
                                  ModulemdModuleStreamVersionEnum mdversion,
                                  GError **error);
 
+
+/**
+ * modulemd_module_filter:
+ * @self: This #ModulemdModule object.
+ * @stream_name: (nullable): A glob pattern that stream names must match.
+ * @version: The version module streams must have, or zero for any.
+ * @context: (nullable): A glob pattern that stream contexts must match.
+ * @arch: (nullable): A glob pattern that stream architectures must match.
+ * @doctypes: The #ModulemdDocumentTypeFlags of the documents to keep.
+ *
+ * See modulemd_module_index_filter() for the meaning of the parameters.
+ *
+ * Returns: (transfer full): A new #ModulemdModule holding the matching
+ * streams, defaults and translations of @self, or NULL if nothing matched.
+ * They are shared with @self if it is frozen, and copied otherwise.
+ *
+ * Since: 2.9
+ */
+ModulemdModule *
+modulemd_module_filter (ModulemdModule *self,
+                        const gchar *stream_name,
+                        guint64 version,
+                        const gchar *context,
+                        const gchar *arch,
+                        ModulemdDocumentTypeFlags doctypes);
+
+
+/**
+ * modulemd_module_prune:
+ * @self: This #ModulemdModule object.
+ * @stream_name: (nullable): A glob pattern that stream names must match.
+ * @version: The version module streams must have, or zero for any.
+ * @context: (nullable): A glob pattern that stream contexts must match.
+ * @arch: (nullable): A glob pattern that stream architectures must match.
+ * @doctypes: The #ModulemdDocumentTypeFlags of the documents to keep.
+ *
+ * Removes the streams, defaults and translations from @self that
+ * modulemd_module_filter() would not have kept.
+ *
+ * Returns: The number of documents removed.
+ *
+ * Since: 2.9
+ */
+guint
+modulemd_module_prune (ModulemdModule *self,
+                       const gchar *stream_name,
+                       guint64 version,
+                       const gchar *context,
+                       const gchar *arch,
+                       ModulemdDocumentTypeFlags doctypes);
+
+
+/**
+ * modulemd_module_count_documents:
+ * @self: This #ModulemdModule object.
+ *
+ * Returns: The number of streams, defaults and translations in @self.
+ *
+ * Since: 2.9
+ */
+guint
+modulemd_module_count_documents (ModulemdModule *self);
+
+
+/**
+ * modulemd_module_freeze:
+ * @self: This #ModulemdModule object.
+ *
+ * Freezes the defaults and translations of @self, and makes the functions
+ * that add or remove its documents fail with a critical warning from now on.
+ * The streams of @self are frozen by modulemd_module_index_freeze() itself,
+ * which sorts them first.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_freeze (ModulemdModule *self);
+
 G_END_DECLS
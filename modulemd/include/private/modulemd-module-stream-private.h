@@ -20,6 +20,7 @@
 #include "private/modulemd-yaml.h"
 #include "private/modulemd-module-stream-v1-private.h"
 #include "private/modulemd-module-stream-v2-private.h"
+#include "private/modulemd-util.h"
 
 G_BEGIN_DECLS
 
@@ -55,6 +56,204 @@ void
 modulemd_module_stream_set_stream_name (ModulemdModuleStream *self,
                                         const gchar *stream_name);
 
+/**
+ * modulemd_module_stream_is_validated:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Returns: TRUE if @self passed modulemd_module_stream_validate() and has not
+ * been modified since. Every setter clears this state, and so does modifying
+ * a child object (such as a component or profile) stored in @self; see
+ * modulemd_module_stream_as_owner().
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_stream_is_validated (ModulemdModuleStream *self);
+
+/**
+ * modulemd_module_stream_set_validated:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @validated: Whether @self is known to be valid.
+ *
+ * Records whether @self is known to be valid. Only pass TRUE if @self has
+ * actually been validated, for example to carry the state over to an exact
+ * copy.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_set_validated (ModulemdModuleStream *self,
+                                      gboolean validated);
+
+/**
+ * modulemd_module_stream_clear_validated:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Marks @self as modified, so that the next dump validates it again and no
+ * longer writes it out as its original YAML. @self must not be frozen: the
+ * setters refuse to modify frozen streams.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_clear_validated (ModulemdModuleStream *self);
+
+/**
+ * modulemd_module_stream_as_owner:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Returns: (transfer none): The #ModulemdOwner link to pass to the set_owner()
+ * functions of the children the subclasses store, such as their
+ * #ModulemdProfile objects. Modifying such a child then marks @self as
+ * modified like modulemd_module_stream_clear_validated() does, except that
+ * the lists returned by modulemd_module_stream_peek_sorted_keys() stay valid:
+ * a child cannot change the key it is stored under. Merely reading a child
+ * leaves @self untouched.
+ *
+ * Since: 2.9
+ */
+ModulemdOwner *
+modulemd_module_stream_as_owner (ModulemdModuleStream *self);
+
+/**
+ * modulemd_module_stream_move_owner:
+ * @self: (in): This #ModulemdModuleStream object, which has no children yet.
+ * @from: (in): The #ModulemdModuleStream whose children are being moved to
+ * @self.
+ *
+ * Hands the #ModulemdOwner link of @from over to @self, so that the children
+ * moved from @from to @self report their changes to @self.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_move_owner (ModulemdModuleStream *self,
+                                   ModulemdModuleStream *from);
+
+/**
+ * modulemd_module_stream_peek_sorted_keys:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @table: (in): A #GHashTable with string keys belonging to @self.
+ *
+ * Returns: (transfer none): The keys of @table, sorted. The list is cached on
+ * @self until modulemd_module_stream_clear_validated() is next called. See
+ * modulemd_sorted_keys_peek().
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_module_stream_peek_sorted_keys (ModulemdModuleStream *self,
+                                         GHashTable *table);
+
+/**
+ * modulemd_module_stream_set_raw_yaml:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @raw_yaml: (in) (nullable): The complete YAML document @self was read from,
+ * or NULL.
+ *
+ * Attaches the YAML document @self was read from, so that it can be written
+ * out as-is as long as @self is not modified. Any later modification drops
+ * it; see modulemd_module_stream_clear_validated().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_set_raw_yaml (ModulemdModuleStream *self,
+                                     GBytes *raw_yaml);
+
+/**
+ * modulemd_module_stream_get_raw_yaml:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Returns: (transfer none) (nullable): The YAML document attached with
+ * modulemd_module_stream_set_raw_yaml(), if @self has not been modified since.
+ *
+ * Since: 2.9
+ */
+GBytes *
+modulemd_module_stream_get_raw_yaml (ModulemdModuleStream *self);
+
+/**
+ * modulemd_module_stream_freeze:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Marks @self as part of a frozen #ModulemdModuleIndex. From then on its
+ * validation state, original YAML and fingerprint are fixed, so that getters
+ * and copies made from many threads at once never write to @self. Its string
+ * sets are also replaced with compact ones, see
+ * modulemd_module_stream_compact_set(), and the sorted keys of its other
+ * collections are cached. From then on the setters of @self and of its
+ * children, such as its profiles and components, fail with a critical warning
+ * and leave them unchanged.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_freeze (ModulemdModuleStream *self);
+
+/**
+ * modulemd_module_stream_compact_set:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @set: (inout): A pointer to a string set of @self.
+ *
+ * Replaces the #GHashTable string set at @set with one whose keys all live in
+ * a single sorted, NULL-terminated array owned by @self, for use by
+ * modulemd_module_stream_set_as_strv(). The new set must never be modified,
+ * so this is only meant for modulemd_module_stream_freeze().
+ *
+ * The new set does not own its keys, which go away with @self. It must never
+ * be handed to another object: copies and upgrades of @self have to build
+ * sets of their own with modulemd_hash_table_deep_set_copy().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_compact_set (ModulemdModuleStream *self,
+                                    GHashTable **set);
+
+/**
+ * modulemd_module_stream_set_as_strv:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @set: (in): A string set of @self.
+ *
+ * Returns: (transfer full): A #GStrv of the strings in @set, sorted. For a
+ * set passed through modulemd_module_stream_compact_set() this is a copy of
+ * the array kept there, otherwise the set is sorted again.
+ *
+ * Since: 2.9
+ */
+GStrv
+modulemd_module_stream_set_as_strv (ModulemdModuleStream *self,
+                                    GHashTable *set);
+
+/**
+ * modulemd_module_stream_is_frozen:
+ * @self: (in): This #ModulemdModuleStream object.
+ *
+ * Returns: TRUE if modulemd_module_stream_freeze() was called on @self.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_module_stream_is_frozen (ModulemdModuleStream *self);
+
+/**
+ * modulemd_module_stream_fingerprint_fields:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @func: (scope call): The function receiving the fingerprints.
+ * @user_data: The data to pass to @func.
+ *
+ * Calls @func with the content fingerprint of each field of @self that
+ * modulemd_module_stream_equals() compares, always in the same order for
+ * streams of the same metadata version.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_fingerprint_fields (ModulemdModuleStream *self,
+                                           ModulemdFingerprintFieldFunc func,
+                                           gpointer user_data);
+
 /**
  * modulemd_module_stream_associate_translation:
  * @self: (in): This #ModulemdModuleStream object.
@@ -112,6 +311,32 @@ modulemd_module_stream_validate_components (GHashTable *components,
                                             GError **error);
 
 
+/**
+ * modulemd_module_stream_upgrade_owned:
+ * @self: (in): This #ModulemdModuleStream object.
+ * @mdversion: (in): The version to upgrade to.
+ * @error: (out): A #GError that will return the reason for an upgrade error.
+ *
+ * Does the same as modulemd_module_stream_upgrade(), for a caller that drops
+ * @self once it has the upgraded stream. If that caller holds the only
+ * reference to @self, as told by modulemd_object_is_unshared(), nobody else
+ * can see its contents, so the hash tables and buildopts of @self are moved
+ * into the upgraded stream instead of being copied, and @self is left without
+ * them.
+ *
+ * Returns: (transfer full): A newly-allocated #ModulemdModuleStream object of
+ * the requested version, or a new reference to @self if it already is of
+ * that version. Returns NULL and sets @error appropriately if the upgrade
+ * could not be completed.
+ *
+ * Since: 2.9
+ */
+ModulemdModuleStream *
+modulemd_module_stream_upgrade_owned (ModulemdModuleStream *self,
+                                      guint64 mdversion,
+                                      GError **error);
+
+
 /* Some macros used for copy operations */
 /**
  * STREAM_UPGRADE_IF_SET_FULL:
@@ -306,6 +531,33 @@ modulemd_module_stream_validate_components (GHashTable *components,
     }                                                                         \
   while (0)
 
+/**
+ * STREAM_MOVE_HASHTABLE:
+ * @dest: (inout): A #ModulemdModuleStreamV1 or #ModulemdModuleStreamV2 object
+ * that is the destination to which @property is moved.
+ * @src: (inout): A #ModulemdModuleStreamV1 or #ModulemdModuleStreamV2 object
+ * that is the source from which @property is moved.
+ * @property: The name of the #GHashTable property to move. Must be the literal
+ * property name, in lower case, without quotes.
+ *
+ * This is a convenience macro to hand the #GHashTable properties of a stream
+ * that is about to be dropped over to its replacement, instead of copying
+ * them with STREAM_REPLACE_HASHTABLE() or COPY_HASHTABLE_BY_VALUE_ADDER().
+ * The two tables are swapped, so @src is left holding the (usually empty)
+ * table of @dest and both objects remain valid. Both tables must have been
+ * created with the same hash, equality and destroy functions.
+ *
+ * Since: 2.9
+ */
+#define STREAM_MOVE_HASHTABLE(dest, src, property)                            \
+  do                                                                          \
+    {                                                                         \
+      GHashTable *moved = dest->property;                                     \
+      dest->property = src->property;                                         \
+      src->property = moved;                                                  \
+    }                                                                         \
+  while (0)
+
 /**
  * modulemd_module_stream_emit_yaml_base:
  * @self: This #ModulemdModuleStream object.
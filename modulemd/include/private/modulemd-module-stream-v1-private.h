@@ -17,6 +17,7 @@
 #include <yaml.h>
 #include "modulemd-module-stream-v1.h"
 #include "modulemd-subdocument-info.h"
+#include "private/modulemd-util.h"
 
 
 G_BEGIN_DECLS
@@ -106,4 +107,34 @@ modulemd_module_stream_v1_emit_yaml (ModulemdModuleStreamV1 *self,
                                      GError **error);
 
 
+/**
+ * modulemd_module_stream_v1_compact_sets:
+ * @self: (in): This #ModulemdModuleStreamV1 object.
+ *
+ * Calls modulemd_module_stream_compact_set() on each string set of @self.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_v1_compact_sets (ModulemdModuleStreamV1 *self);
+
+
+/**
+ * modulemd_module_stream_v1_fingerprint_fields:
+ * @self: (in): This #ModulemdModuleStreamV1 object.
+ * @func: (scope call): The function receiving the fingerprints.
+ * @user_data: The data to pass to @func.
+ *
+ * Calls @func with the content fingerprint of each field specific to
+ * #ModulemdModuleStreamV1. See modulemd_module_stream_fingerprint_fields().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_v1_fingerprint_fields (
+  ModulemdModuleStreamV1 *self,
+  ModulemdFingerprintFieldFunc func,
+  gpointer user_data);
+
+
 G_END_DECLS
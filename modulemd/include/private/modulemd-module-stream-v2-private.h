@@ -17,6 +17,7 @@
 #include <yaml.h>
 #include "modulemd-module-stream-v2.h"
 #include "modulemd-subdocument-info.h"
+#include "private/modulemd-util.h"
 
 
 G_BEGIN_DECLS
@@ -198,4 +199,47 @@ modulemd_module_stream_v2_replace_dependencies (ModulemdModuleStreamV2 *self,
                                                 GPtrArray *array);
 
 
+/**
+ * modulemd_module_stream_v2_compact_sets:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Calls modulemd_module_stream_compact_set() on each string set of @self.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_v2_compact_sets (ModulemdModuleStreamV2 *self);
+
+
+/**
+ * modulemd_module_stream_v2_sort_collections:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ *
+ * Fills in the sorted lists returned by the `peek` functions of @self, its
+ * profiles and its dependencies, so that later calls only read them.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_v2_sort_collections (ModulemdModuleStreamV2 *self);
+
+
+/**
+ * modulemd_module_stream_v2_fingerprint_fields:
+ * @self: (in): This #ModulemdModuleStreamV2 object.
+ * @func: (scope call): The function receiving the fingerprints.
+ * @user_data: The data to pass to @func.
+ *
+ * Calls @func with the content fingerprint of each field specific to
+ * #ModulemdModuleStreamV2. See modulemd_module_stream_fingerprint_fields().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_module_stream_v2_fingerprint_fields (
+  ModulemdModuleStreamV2 *self,
+  ModulemdFingerprintFieldFunc func,
+  gpointer user_data);
+
+
 G_END_DECLS
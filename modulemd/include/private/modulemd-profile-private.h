@@ -18,6 +18,7 @@
 
 #include "modulemd-module-stream.h"
 #include "modulemd-profile.h"
+#include "private/modulemd-util.h"
 
 /**
  * SECTION: modulemd-profile-private
@@ -84,11 +85,26 @@ modulemd_profile_equals_wrapper (const void *a, const void *b);
 /**
  * modulemd_profile_set_owner:
  * @self: This #ModulemdProfile object.
- * @owner: A #ModulemdModuleStream that will own this profile. Used to look up
- * translations internally.
+ * @owner: (nullable): The #ModulemdOwner link of the #ModulemdModuleStream
+ * that will own this profile, as returned by
+ * modulemd_module_stream_as_owner(). Used to look up translations internally
+ * and to tell the stream when this profile is modified. The setters of @self
+ * fail once that stream is frozen.
  *
  * Since: 2.6
  */
 void
-modulemd_profile_set_owner (ModulemdProfile *self,
-                            ModulemdModuleStream *owner);
+modulemd_profile_set_owner (ModulemdProfile *self, ModulemdOwner *owner);
+
+
+/**
+ * modulemd_profile_fingerprint:
+ * @self: (nullable): This #ModulemdProfile object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add().
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_profile_fingerprint (ModulemdProfile *self);
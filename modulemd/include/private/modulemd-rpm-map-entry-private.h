@@ -14,6 +14,9 @@
 #include <glib.h>
 #include <yaml.h>
 
+#include "modulemd-rpm-map-entry.h"
+#include "private/modulemd-util.h"
+
 /**
  * SECTION: modulemd-rpm-map-entry-private
  * @title: Modulemd.RpmMapEntry (Private)
@@ -87,3 +90,33 @@ modulemd_rpm_map_entry_equals_wrapper (const void *a, const void *b);
  */
 gboolean
 modulemd_RpmMapEntry_hash_table_equals_wrapper (const void *a, const void *b);
+
+
+/**
+ * modulemd_rpm_map_entry_fingerprint:
+ * @self: (nullable): This #ModulemdRpmMapEntry object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add().
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_rpm_map_entry_fingerprint (ModulemdRpmMapEntry *self);
+
+
+/**
+ * modulemd_rpm_map_entry_set_owner:
+ * @self: This #ModulemdRpmMapEntry object.
+ * @owner: (nullable): The #ModulemdOwner link of the #ModulemdModuleStream
+ * this entry is stored in, as returned by modulemd_module_stream_as_owner(),
+ * or NULL.
+ *
+ * Makes every change to @self mark that stream as modified, and makes the
+ * setters of @self fail once that stream is frozen.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_rpm_map_entry_set_owner (ModulemdRpmMapEntry *self,
+                                  ModulemdOwner *owner);
@@ -17,6 +17,7 @@
 #include <yaml.h>
 
 #include "modulemd-service-level.h"
+#include "private/modulemd-util.h"
 
 /**
  * SECTION: modulemd-service-level-private
@@ -78,3 +79,33 @@ modulemd_service_level_emit_yaml (ModulemdServiceLevel *self,
  */
 gboolean
 modulemd_service_level_equals_wrapper (const void *a, const void *b);
+
+
+/**
+ * modulemd_service_level_set_owner:
+ * @self: This #ModulemdServiceLevel object.
+ * @owner: (nullable): The #ModulemdOwner link of the #ModulemdModuleStream
+ * this service level is stored in, as returned by
+ * modulemd_module_stream_as_owner(), or NULL.
+ *
+ * Makes every change to @self mark that stream as modified, and makes the
+ * setters of @self fail once that stream is frozen.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_service_level_set_owner (ModulemdServiceLevel *self,
+                                  ModulemdOwner *owner);
+
+
+/**
+ * modulemd_service_level_fingerprint:
+ * @self: (nullable): This #ModulemdServiceLevel object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add().
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_service_level_fingerprint (ModulemdServiceLevel *self);
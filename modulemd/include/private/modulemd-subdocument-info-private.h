@@ -112,6 +112,21 @@ modulemd_subdocument_info_set_yaml (ModulemdSubdocumentInfo *self,
                                     const gchar *contents);
 
 
+/**
+ * modulemd_subdocument_info_take_yaml:
+ * @self: This #ModulemdSubdocumentInfo object.
+ * @contents: (transfer full): The contents of the document.
+ *
+ * Like modulemd_subdocument_info_set_yaml(), but @self takes ownership of
+ * @contents instead of copying it.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_subdocument_info_take_yaml (ModulemdSubdocumentInfo *self,
+                                     gchar *contents);
+
+
 /**
  * modulemd_subdocument_info_set_gerror:
  * @self: This #ModulemdSubdocumentInfo object.
@@ -65,3 +65,29 @@ gboolean
 modulemd_translation_entry_emit_yaml (ModulemdTranslationEntry *self,
                                       yaml_emitter_t *emitter,
                                       GError **error);
+
+
+/**
+ * modulemd_translation_entry_fingerprint:
+ * @self: (nullable): This #ModulemdTranslationEntry object.
+ *
+ * Returns: The content fingerprint of @self, as described for
+ * modulemd_fingerprint_add().
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_translation_entry_fingerprint (ModulemdTranslationEntry *self);
+
+
+/**
+ * modulemd_translation_entry_freeze:
+ * @self: (in): This #ModulemdTranslationEntry object.
+ *
+ * Makes the setters of @self fail with a critical warning and leave it
+ * unchanged from now on. Called by modulemd_translation_freeze().
+ *
+ * Since: 2.9
+ */
+void
+modulemd_translation_entry_freeze (ModulemdTranslationEntry *self);
@@ -18,6 +18,7 @@
 
 #include "modulemd-profile.h"
 #include "modulemd-subdocument-info.h"
+#include "private/modulemd-util.h"
 
 /**
  * SECTION: modulemd-translation-private
@@ -111,3 +112,33 @@ gboolean
 modulemd_translation_emit_yaml (ModulemdTranslation *self,
                                 yaml_emitter_t *emitter,
                                 GError **error);
+
+/**
+ * modulemd_translation_fingerprint_fields:
+ * @self: (in): This #ModulemdTranslation object.
+ * @func: (scope call): The function receiving the fingerprints.
+ * @user_data: The data to pass to @func.
+ *
+ * Calls @func with the content fingerprint of each field of @self. Every
+ * #ModulemdTranslationEntry is reported as a field named after its locale,
+ * in alphabetical order.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_translation_fingerprint_fields (ModulemdTranslation *self,
+                                         ModulemdFingerprintFieldFunc func,
+                                         gpointer user_data);
+
+/**
+ * modulemd_translation_freeze:
+ * @self: (in): This #ModulemdTranslation object.
+ *
+ * Marks @self as part of a frozen #ModulemdModuleIndex. From then on the
+ * setters of @self and of its #ModulemdTranslationEntry objects fail with a
+ * critical warning and leave them unchanged.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_translation_freeze (ModulemdTranslation *self);
@@ -13,7 +13,14 @@
 
 #pragma once
 
+#include "config.h"
+#include "modulemd-instrumentation.h"
 #include <glib.h>
+#include <glib-object.h>
+
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+#endif
 
 G_BEGIN_DECLS
 
@@ -44,72 +51,193 @@ G_BEGIN_DECLS
 GQuark
 modulemd_error_quark (void);
 
+/**
+ * MODULEMD_PROBE:
+ * @_name: The name of the probe.
+ * @_arg: The single argument passed to the probe.
+ *
+ * Places a USDT probe named @_name in the `libmodulemd` provider when the
+ * platform provides `<sys/sdt.h>`. Otherwise, this expands to nothing.
+ *
+ * Since: 2.9
+ */
+#ifdef HAVE_SYS_SDT_H
+#define MODULEMD_PROBE(_name, _arg) DTRACE_PROBE1 (libmodulemd, _name, _arg)
+#else
+#define MODULEMD_PROBE(_name, _arg)                                           \
+  do                                                                          \
+    {                                                                         \
+    }                                                                         \
+  while (0)
+#endif
+
+#define MODULEMD_INSTRUMENT_TRACE (1 << 0)
+#define MODULEMD_INSTRUMENT_TIMING (1 << 1)
+
+/* Bitwise OR of the MODULEMD_INSTRUMENT_* flags currently enabled. Only
+ * access this with the g_atomic_int_*() functions.
+ */
+extern gint modulemd_instrumentation_flags;
+
+/**
+ * modulemd_instrumentation_enabled:
+ * @flag: One of the MODULEMD_INSTRUMENT_* flags.
+ *
+ * Returns: TRUE if @flag is currently enabled.
+ *
+ * Since: 2.9
+ */
+static inline gboolean
+modulemd_instrumentation_enabled (gint flag)
+{
+  return (g_atomic_int_get (&modulemd_instrumentation_flags) & flag) != 0;
+}
+
 /**
  * modulemd_tracer:
  * @function_name: The name of the function to be tracked by this
  * #modulemd_tracer.
+ * @traced: Whether the entry into @function_name was traced, in which case
+ * the exit from it will be traced as well.
  *
  * Since: 2.0
  */
 typedef struct _modulemd_tracer
 {
-  gchar *function_name;
+  const gchar *function_name;
+  gboolean traced;
 } modulemd_tracer;
 
 /**
- * modulemd_trace_init:
+ * modulemd_trace_enter:
  * @function_name: The name of the function being traced.
  *
- * Returns: (transfer full): A newly-allocated #modulemd_tracer object.
- *
- * Allocates and returns a new #modulemd_tracer that tracks the provided
- * @function_name. Also writes a g_debug() trace message indicating
- * @function_name has been entered.
+ * Writes a g_debug() trace message indicating @function_name has been
+ * entered.
  *
  * DIRECT USE OF THIS FUNCTION SHOULD BE AVOIDED. Instead use
  * %MODULEMD_INIT_TRACE--which makes use of this function as part of its
  * internal implementation.
  *
- * Since: 2.0
+ * Since: 2.9
  */
-modulemd_tracer *
-modulemd_trace_init (const gchar *function_name);
+void
+modulemd_trace_enter (const gchar *function_name);
 
 /**
- * modulemd_trace_free:
- * @tracer: A #modulemd_tracer object representing a function being traced.
+ * modulemd_trace_exit:
+ * @function_name: The name of the function being traced.
  *
- * Writes a g_debug() trace message indicating the function name associated
- * with @tracer is being exited and frees @tracer.
+ * Writes a g_debug() trace message indicating @function_name is being
+ * exited.
  *
  * DIRECT USE OF THIS FUNCTION SHOULD BE AVOIDED. Instead use
  * %MODULEMD_INIT_TRACE--which makes use of this function as part of its
  * internal implementation.
  *
- * Since: 2.0
+ * Since: 2.9
  */
 void
-modulemd_trace_free (modulemd_tracer *tracer);
+modulemd_trace_exit (const gchar *function_name);
+
+static inline void
+modulemd_tracer_clear (modulemd_tracer *tracer)
+{
+  MODULEMD_PROBE (function__return, tracer->function_name);
+  if (G_UNLIKELY (tracer->traced))
+    modulemd_trace_exit (tracer->function_name);
+}
 
-G_DEFINE_AUTOPTR_CLEANUP_FUNC (modulemd_tracer, modulemd_trace_free);
+G_DEFINE_AUTO_CLEANUP_CLEAR_FUNC (modulemd_tracer, modulemd_tracer_clear);
 
 /**
  * MODULEMD_INIT_TRACE:
  *
  * When used at the beginning of a function, automatically writes g_debug()
- * trace messages when entering and leaving that function. Makes use of
- * modulemd_trace_init() and modulemd_trace_free().
+ * trace messages when entering and leaving that function, if tracing has been
+ * enabled with modulemd_set_tracing_enabled(). Also places USDT probes at
+ * those points where the platform supports them.
  *
- * This macro manages the memory of the hidden #modulemd_tracer object it
- * creates, so the caller should not attempt to modify that object in any way.
+ * The hidden #modulemd_tracer object lives on the stack, so this costs no
+ * allocation and only a single atomic read when tracing is disabled. The
+ * caller should not attempt to modify that object in any way.
  *
  * Since: 2.0
  */
 #define MODULEMD_INIT_TRACE()                                                 \
-  g_autoptr (modulemd_tracer) tracer = modulemd_trace_init (__func__);        \
+  g_auto (modulemd_tracer) tracer = { __func__, FALSE };                      \
+  do                                                                          \
+    {                                                                         \
+      MODULEMD_PROBE (function__entry, __func__);                             \
+      if (G_UNLIKELY (                                                        \
+            modulemd_instrumentation_enabled (MODULEMD_INSTRUMENT_TRACE)))    \
+        {                                                                     \
+          tracer.traced = TRUE;                                               \
+          modulemd_trace_enter (__func__);                                    \
+        }                                                                     \
+    }                                                                         \
+  while (0)
+
+/**
+ * modulemd_phase_timer:
+ * @phase: The #ModulemdPhaseEnum being timed.
+ * @start: The monotonic time at which @phase was entered, or -1 if phase
+ * timing was disabled at that point.
+ *
+ * Since: 2.9
+ */
+typedef struct _modulemd_phase_timer
+{
+  ModulemdPhaseEnum phase;
+  gint64 start;
+} modulemd_phase_timer;
+
+/**
+ * modulemd_phase_timer_record:
+ * @phase: The #ModulemdPhaseEnum being left.
+ * @start: The monotonic time at which @phase was entered.
+ *
+ * Adds one call and the time elapsed since @start to the counters of @phase.
+ *
+ * DIRECT USE OF THIS FUNCTION SHOULD BE AVOIDED. Instead use
+ * %MODULEMD_PHASE_TIMER--which makes use of this function as part of its
+ * internal implementation.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_phase_timer_record (ModulemdPhaseEnum phase, gint64 start);
+
+static inline void
+modulemd_phase_timer_clear (modulemd_phase_timer *timer)
+{
+  MODULEMD_PROBE (phase__end, timer->phase);
+  if (G_UNLIKELY (timer->start >= 0))
+    modulemd_phase_timer_record (timer->phase, timer->start);
+}
+
+G_DEFINE_AUTO_CLEANUP_CLEAR_FUNC (modulemd_phase_timer,
+                                  modulemd_phase_timer_clear);
+
+/**
+ * MODULEMD_PHASE_TIMER:
+ * @_phase: The #ModulemdPhaseEnum covered by the rest of the enclosing scope.
+ *
+ * When used after the declarations of a function, attributes the time until
+ * the function returns to @_phase, if phase timing has been enabled with
+ * modulemd_set_phase_timing_enabled(). Like %MODULEMD_INIT_TRACE, this costs
+ * a single atomic read when disabled.
+ *
+ * Since: 2.9
+ */
+#define MODULEMD_PHASE_TIMER(_phase)                                          \
+  g_auto (modulemd_phase_timer) phase_timer = { (_phase), -1 };               \
   do                                                                          \
     {                                                                         \
-      (void)(tracer);                                                         \
+      MODULEMD_PROBE (phase__start, (_phase));                                \
+      if (G_UNLIKELY (                                                        \
+            modulemd_instrumentation_enabled (MODULEMD_INSTRUMENT_TIMING)))   \
+        phase_timer.start = g_get_monotonic_time ();                          \
     }                                                                         \
   while (0)
 
@@ -257,6 +385,200 @@ modulemd_ordered_str_keys (GHashTable *htable, GCompareFunc compare_func);
 GStrv
 modulemd_ordered_str_keys_as_strv (GHashTable *htable);
 
+/**
+ * modulemd_ordered_str_keys_borrowed:
+ * @htable: A #GHashTable with string keys.
+ *
+ * Returns: (transfer container): A NULL-terminated list of the keys of
+ * @htable sorted according to modulemd_strcmp_sort(). The keys themselves are
+ * not copied, so the list must be freed with g_free() before @htable is
+ * modified.
+ *
+ * Since: 2.9
+ */
+const gchar **
+modulemd_ordered_str_keys_borrowed (GHashTable *htable);
+
+/**
+ * modulemd_sorted_keys_peek:
+ * @cache: (inout): A pointer to a #GHashTable created by this function on
+ * first use, which maps tables to the sorted lists of their keys.
+ * @htable: A #GHashTable with string keys.
+ *
+ * Returns: (transfer none): A NULL-terminated list of the keys of @htable,
+ * sorted according to modulemd_strcmp_sort(). The list is kept in @cache, and
+ * points to the keys of @htable rather than copying them, so it remains valid
+ * only until @htable is modified or modulemd_sorted_keys_clear() is called on
+ * @cache.
+ *
+ * Since: 2.9
+ */
+const gchar *const *
+modulemd_sorted_keys_peek (GHashTable **cache, GHashTable *htable);
+
+/**
+ * modulemd_sorted_keys_clear:
+ * @cache: (nullable): A #GHashTable filled by modulemd_sorted_keys_peek().
+ *
+ * Drops every list held in @cache, which must be done whenever one of the
+ * tables passed with it to modulemd_sorted_keys_peek() is modified or freed.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_sorted_keys_clear (GHashTable *cache);
+
+/**
+ * ModulemdOwner:
+ *
+ * A reference-counted link from the children that an object hands out from
+ * its getters, such as the #ModulemdProfile objects of a
+ * #ModulemdModuleStream, back to that object. The setters of the children
+ * report every change through it. The link is released rather than freed
+ * with the object, so children that outlive it simply have no owner any
+ * more.
+ *
+ * Since: 2.9
+ */
+typedef struct _ModulemdOwner ModulemdOwner;
+
+/**
+ * ModulemdOwnerChangedFunc:
+ * @object: The object owning the child that changed.
+ *
+ * Called by modulemd_owner_changed() whenever one of the children of @object
+ * is modified.
+ *
+ * Since: 2.9
+ */
+typedef void (*ModulemdOwnerChangedFunc) (gpointer object);
+
+/**
+ * modulemd_owner_new:
+ * @object: The object that owns the children.
+ * @changed: (nullable) (scope forever): The function to call on @object when
+ * one of its children is modified.
+ *
+ * Returns: (transfer full): A new #ModulemdOwner for @object.
+ *
+ * Since: 2.9
+ */
+ModulemdOwner *
+modulemd_owner_new (gpointer object, ModulemdOwnerChangedFunc changed);
+
+/**
+ * modulemd_owner_ref:
+ * @owner: A #ModulemdOwner.
+ *
+ * Returns: (transfer full): @owner, with its reference count increased.
+ *
+ * Since: 2.9
+ */
+ModulemdOwner *
+modulemd_owner_ref (ModulemdOwner *owner);
+
+/**
+ * modulemd_owner_unref:
+ * @owner: (nullable): A #ModulemdOwner.
+ *
+ * Decreases the reference count of @owner, freeing it when it drops to zero.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_owner_unref (ModulemdOwner *owner);
+
+/**
+ * modulemd_owner_replace:
+ * @slot: (inout): The location of the #ModulemdOwner of a child.
+ * @owner: (nullable): The new #ModulemdOwner of the child, or NULL.
+ *
+ * Takes a reference on @owner, stores it in @slot and releases the link
+ * @slot held before. Used by the set_owner() functions of the children.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_owner_replace (ModulemdOwner **slot, ModulemdOwner *owner);
+
+/**
+ * modulemd_owner_set_object:
+ * @owner: A #ModulemdOwner.
+ * @object: (nullable): The new object owning the children linked to @owner.
+ *
+ * Hands the children linked to @owner over to @object, for instance when
+ * their tables are moved to another object. The object must set it to NULL
+ * when it is finalized.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_owner_set_object (ModulemdOwner *owner, gpointer object);
+
+/**
+ * modulemd_owner_get_object:
+ * @owner: (nullable): A #ModulemdOwner.
+ *
+ * Returns: (transfer none): The object owning the children linked to @owner,
+ * or NULL if @owner is NULL or the object was finalized.
+ *
+ * Since: 2.9
+ */
+gpointer
+modulemd_owner_get_object (ModulemdOwner *owner);
+
+/**
+ * modulemd_owner_changed:
+ * @owner: (nullable): The #ModulemdOwner of the child being modified.
+ *
+ * Tells the object owning the child, if any, that the child is being
+ * modified.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_owner_changed (ModulemdOwner *owner);
+
+/**
+ * modulemd_owner_freeze:
+ * @owner: A #ModulemdOwner.
+ *
+ * Makes the setters of the children linked to @owner fail from now on. This
+ * cannot be undone.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_owner_freeze (ModulemdOwner *owner);
+
+/**
+ * modulemd_owner_is_frozen:
+ * @owner: (nullable): A #ModulemdOwner.
+ *
+ * Returns: TRUE if modulemd_owner_freeze() was called on @owner. The setters
+ * of children check it before changing anything.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_owner_is_frozen (ModulemdOwner *owner);
+
+/**
+ * modulemd_object_is_unshared:
+ * @object: A #GObject the caller holds a reference to.
+ *
+ * Checks, without reading the private reference count of @object, whether
+ * the reference of the caller is the only one. Objects that already have a
+ * toggle reference, such as those wrapped by language bindings, are always
+ * reported as shared.
+ *
+ * Returns: TRUE if nothing but the caller references @object.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_object_is_unshared (GObject *object);
+
 /**
  * modulemd_variant_deep_copy:
  * @variant: A #GVariant opaque data structure.
@@ -268,6 +590,43 @@ modulemd_ordered_str_keys_as_strv (GHashTable *htable);
 GVariant *
 modulemd_variant_deep_copy (GVariant *variant);
 
+/**
+ * modulemd_variant_to_json:
+ * @variant: A #GVariant opaque data structure.
+ *
+ * Serializes @variant as compact JSON. Dictionaries become objects, with keys
+ * that are not strings written out as strings, while other arrays and tuples
+ * become arrays. Maybe types are written as their value or as null, and
+ * variants as the value they hold.
+ *
+ * Returns: (transfer full): A newly-allocated JSON string.
+ *
+ * Since: 2.9
+ */
+gchar *
+modulemd_variant_to_json (GVariant *variant);
+
+/**
+ * modulemd_variant_from_json:
+ * @json: (in): A JSON document.
+ * @error: (out): A #GError that will return the reason for failing to parse
+ * @json.
+ *
+ * Reads @json into a #GVariant holding the same types as XMD read from YAML.
+ * Objects become `a{sv}` dictionaries keeping the order of their keys, the
+ * last value winning for duplicate keys. Arrays become arrays of their
+ * elements, or `av` when empty or when their elements have different types.
+ * Strings and booleans are kept as they are, numbers become strings holding
+ * their text and null becomes an empty string.
+ *
+ * Returns: (transfer full): A newly-allocated #GVariant read from @json. NULL
+ * if @json is not valid JSON and sets @error appropriately.
+ *
+ * Since: 2.9
+ */
+GVariant *
+modulemd_variant_from_json (const gchar *json, GError **error);
+
 /**
  * modulemd_hash_table_unref:
  * @table: (nullable): A void pointer.
@@ -284,6 +643,58 @@ modulemd_variant_deep_copy (GVariant *variant);
 void
 modulemd_hash_table_unref (void *table);
 
+/**
+ * ModulemdNevra:
+ * @nevra: The NEVRA string that was parsed. It is not copied.
+ * @epoch: The offset of the epoch in @nevra.
+ * @version: The offset of the version in @nevra.
+ * @release: The offset of the release in @nevra.
+ * @arch: The offset of the architecture in @nevra.
+ *
+ * The components of a NEVRA string in N-E:V-R.A format, as offsets into it.
+ * The name starts at offset zero. Every component except the architecture is
+ * followed by a one-character separator, so its length is the offset of the
+ * next component minus the offset of its own, minus one.
+ *
+ * Since: 2.9
+ */
+typedef struct
+{
+  const gchar *nevra;
+  gsize epoch;
+  gsize version;
+  gsize release;
+  gsize arch;
+} ModulemdNevra;
+
+
+/**
+ * MODULEMD_NEVRA_NAME_LEN:
+ * @parsed: A #ModulemdNevra.
+ *
+ * Returns: The length of the name at the start of @parsed->nevra.
+ *
+ * Since: 2.9
+ */
+#define MODULEMD_NEVRA_NAME_LEN(parsed) ((parsed)->epoch - 1)
+
+
+/**
+ * modulemd_nevra_parse:
+ * @nevra: A NEVRA (Name, Epoch, Version, Release, Architecture) string.
+ * @parsed: (out) (optional): The components of @nevra, if it is valid.
+ *
+ * Splits @nevra into its components in a single pass and without allocating
+ * memory.
+ *
+ * Returns: TRUE if @nevra is in proper N-E:V-R.A format and @parsed was
+ * filled in, FALSE otherwise.
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_nevra_parse (const gchar *nevra, ModulemdNevra *parsed);
+
 /**
  * modulemd_validate_nevra:
  * @nevra: A NEVRA (Name, Epoch, Version, Release, Architecture) string.
@@ -310,6 +721,138 @@ modulemd_validate_nevra (const gchar *nevra);
 gboolean
 modulemd_boolean_equals (gboolean a, gboolean b);
 
+/**
+ * MODULEMD_FINGERPRINT_INIT:
+ *
+ * The fingerprint of no content, from which fingerprints are built up with
+ * modulemd_fingerprint_add() and its variants.
+ *
+ * Since: 2.9
+ */
+#define MODULEMD_FINGERPRINT_INIT G_GUINT64_CONSTANT (0xcbf29ce484222325)
+
+/**
+ * ModulemdFingerprintFunc:
+ * @data: (nullable): The value to fingerprint.
+ *
+ * Returns: A 64-bit hash of the content of @data.
+ *
+ * Since: 2.9
+ */
+typedef guint64 (*ModulemdFingerprintFunc) (gconstpointer data);
+
+/**
+ * ModulemdFingerprintFieldFunc:
+ * @field: The name of a field of a document.
+ * @fingerprint: The fingerprint of the content of @field.
+ * @user_data: The data passed along with this function.
+ *
+ * Receives the fingerprints of the fields of a document one at a time, so
+ * that two versions of a document can be compared field by field.
+ *
+ * Since: 2.9
+ */
+typedef void (*ModulemdFingerprintFieldFunc) (const gchar *field,
+                                              guint64 fingerprint,
+                                              gpointer user_data);
+
+/**
+ * modulemd_fingerprint_add:
+ * @fingerprint: The fingerprint built up so far.
+ * @value: A 64-bit value to add to it.
+ *
+ * Content fingerprints are 64-bit hashes that can be compared in constant
+ * time: two objects with the same content always have the same fingerprint,
+ * and objects with different content are all but guaranteed not to. They are
+ * not cryptographic and must not be relied upon against crafted input.
+ *
+ * Returns: The fingerprint of @value following the content of @fingerprint.
+ * The order in which values are added matters.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_fingerprint_add (guint64 fingerprint, guint64 value);
+
+/**
+ * modulemd_fingerprint_string:
+ * @str: (nullable): A string.
+ *
+ * Returns: The fingerprint of @str. NULL and the empty string have different
+ * fingerprints.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_fingerprint_string (gconstpointer str);
+
+/**
+ * modulemd_fingerprint_add_string:
+ * @fingerprint: The fingerprint built up so far.
+ * @str: (nullable): A string to add to it.
+ *
+ * Returns: modulemd_fingerprint_add() of the fingerprint of @str.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_fingerprint_add_string (guint64 fingerprint, const gchar *str);
+
+/**
+ * modulemd_fingerprint_set:
+ * @set: (nullable): A #GHashTable of strings used as a set.
+ *
+ * Returns: The fingerprint of the strings in @set, which does not depend on
+ * the order in which they were added to it.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_fingerprint_set (gconstpointer set);
+
+/**
+ * modulemd_fingerprint_hash_table:
+ * @table: (nullable): A #GHashTable with string keys.
+ * @value_func: The #ModulemdFingerprintFunc for the values of @table.
+ *
+ * Returns: The fingerprint of the pairs of keys and values in @table, which
+ * does not depend on the order in which they were added to it.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_fingerprint_hash_table (GHashTable *table,
+                                 ModulemdFingerprintFunc value_func);
+
+/**
+ * modulemd_fingerprint_variant:
+ * @variant: (nullable): A #GVariant.
+ *
+ * Returns: The fingerprint of the type and value of @variant. Variants that
+ * are equal according to g_variant_equal() have the same fingerprint.
+ *
+ * Since: 2.9
+ */
+guint64
+modulemd_fingerprint_variant (GVariant *variant);
+
+/**
+ * modulemd_fingerprint_add_field:
+ * @field: The name of a field of a document.
+ * @fingerprint: The fingerprint of the content of @field.
+ * @user_data: (inout): A pointer to the #guint64 fingerprint of the whole
+ * document built up so far.
+ *
+ * A #ModulemdFingerprintFieldFunc that combines the fingerprints of all of
+ * the fields of a document into one.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_fingerprint_add_field (const gchar *field,
+                                guint64 fingerprint,
+                                gpointer user_data);
+
 /**
  * MODULEMD_REPLACE_SET:
  * @_dest: A reference to a #GHashTable.
@@ -338,6 +881,36 @@ modulemd_boolean_equals (gboolean a, gboolean b);
     }                                                                         \
   while (0)
 
+/**
+ * MODULEMD_TAKE_SET:
+ * @_dest: A reference to a #GHashTable.
+ * @_set: (nullable) (transfer full): A #GHashTable set of strings, as created
+ * by modulemd_yaml_parse_string_set().
+ *
+ * Frees the existing #GHashTable at @_dest. If @_set is not NULL, it is
+ * assigned to @_dest as-is, without copying its keys. Otherwise @_dest is
+ * emptied.
+ *
+ * This helper is intended for storing sets that were just built by a parser
+ * and have no other owner.
+ *
+ * Since: 2.9
+ */
+#define MODULEMD_TAKE_SET(_dest, _set)                                        \
+  do                                                                          \
+    {                                                                         \
+      if (_set)                                                               \
+        {                                                                     \
+          g_clear_pointer (&_dest, g_hash_table_unref);                       \
+          _dest = (_set);                                                     \
+        }                                                                     \
+      else                                                                    \
+        {                                                                     \
+          g_hash_table_remove_all (_dest);                                    \
+        }                                                                     \
+    }                                                                         \
+  while (0)
+
 
 /**
  * MODULEMD_SETTER_GETTER_STRING_EXT:
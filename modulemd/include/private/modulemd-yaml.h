@@ -75,6 +75,7 @@ typedef enum
  * modulemd_yaml_string:
  * @str: A pointer to a block of memory containing YAML.
  * @len: The number of bytes currently in use in @str.
+ * @alloc: The number of bytes allocated for @str. Since 2.9.
  *
  * #modulemd_yaml_string is an internal representation of an arbitrary length
  * YAML string.
@@ -85,6 +86,7 @@ typedef struct _modulemd_yaml_string
 {
   char *str;
   size_t len;
+  size_t alloc;
 } modulemd_yaml_string;
 
 /**
@@ -93,13 +95,45 @@ typedef struct _modulemd_yaml_string
  * @buffer: (in): YAML text to append to @data.
  * @size: (in): The number of bytes from @buffer to append to @data.
  *
- * Additionally memory for @data is automatically allocated if necessary.
+ * Additionally memory for @data is automatically allocated if necessary. The
+ * allocation grows geometrically, so the number of reallocations is
+ * logarithmic in the length of the output rather than one per libyaml flush.
  *
  * Since: 2.0
  */
 int
 write_yaml_string (void *data, unsigned char *buffer, size_t size);
 
+/**
+ * modulemd_yaml_string_reserve:
+ * @yaml_string: (inout): A #modulemd_yaml_string.
+ * @size: (in): The total number of bytes of YAML expected to be written.
+ *
+ * Grows the allocation backing @yaml_string so that at least @size bytes
+ * (plus the terminating NUL) can be appended by write_yaml_string() without
+ * reallocating. This is only an optimization; writing more than @size bytes
+ * is still permitted.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_yaml_string_reserve (modulemd_yaml_string *yaml_string, gsize size);
+
+/**
+ * modulemd_yaml_string_shrink:
+ * @yaml_string: (inout): A #modulemd_yaml_string.
+ *
+ * Gives back the unused part of the allocation backing @yaml_string when it
+ * is more than an eighth of the length of the YAML. Must be called before
+ * the string is handed over to a caller that keeps it, since reservations
+ * and geometric growth may otherwise leave it up to twice as large as
+ * needed.
+ *
+ * Since: 2.9
+ */
+void
+modulemd_yaml_string_shrink (modulemd_yaml_string *yaml_string);
+
 /**
  * modulemd_yaml_string_free:
  * @yaml_string: (inout): A pointer to a #modulemd_yaml_string to be freed.
@@ -236,15 +270,6 @@ mmd_yaml_get_event_name (yaml_event_type_t type);
                                "Parser error");                               \
           return _returnval;                                                  \
         }                                                                     \
-      if ((_event)->type == YAML_SCALAR_EVENT)                                \
-        g_debug ("Parser event: %s: %s",                                      \
-                 mmd_yaml_get_event_name ((_event)->type),                    \
-                 (const gchar *)event.data.scalar.value);                     \
-      else                                                                    \
-        {                                                                     \
-          g_debug ("Parser event: %s",                                        \
-                   mmd_yaml_get_event_name ((_event)->type));                 \
-        }                                                                     \
     }                                                                         \
   while (0)
 
@@ -461,7 +486,8 @@ mmd_yaml_get_event_name (yaml_event_type_t type);
  *
  * This convenience macro can be used when a YAML string (scalar) event is
  * expected, and that string is to be stored in a property of libmodulemd
- * object @_obj via setter method @_fn.
+ * object @_obj via setter method @_fn. The scalar is passed to @_fn straight
+ * from the libyaml event, so the only copy made is the one kept by @_obj.
  *
  * Returns: Continues on if parsing of the event was successful. Returns
  * NULL if a parse error occurred and sets @_error appropriately.
@@ -471,16 +497,14 @@ mmd_yaml_get_event_name (yaml_event_type_t type);
 #define MMD_SET_PARSED_YAML_STRING(_parser, _error, _fn, _obj)                \
   do                                                                          \
     {                                                                         \
-      GError *_nested_error = NULL;                                           \
-      g_autofree gchar *_scalar =                                             \
-        modulemd_yaml_parse_string (_parser, &_nested_error);                 \
-      if (!_scalar)                                                           \
+      MMD_INIT_YAML_EVENT (_scalar_event);                                    \
+      YAML_PARSER_PARSE_WITH_EXIT (_parser, &_scalar_event, _error);          \
+      if (_scalar_event.type != YAML_SCALAR_EVENT)                            \
         {                                                                     \
-          g_propagate_error (_error, _nested_error);                          \
-          return NULL;                                                        \
+          MMD_YAML_ERROR_EVENT_EXIT (                                         \
+            _error, _scalar_event, "String was not a scalar");                \
         }                                                                     \
-      _fn (_obj, _scalar);                                                    \
-      g_clear_pointer (&_scalar, g_free);                                     \
+      _fn (_obj, (const gchar *)_scalar_event.data.scalar.value);             \
     }                                                                         \
   while (0)
 
@@ -545,6 +569,28 @@ mmd_emitter_start_document (yaml_emitter_t *emitter, GError **error);
 gboolean
 mmd_emitter_end_document (yaml_emitter_t *emitter, GError **error);
 
+/**
+ * mmd_emitter_raw_document:
+ * @emitter: (inout): A libyaml emitter object that is positioned between two
+ * documents.
+ * @yaml: (in): A complete YAML document, starting with its `---` header and
+ * ending with its `...` terminator and a newline.
+ * @error: (out): A #GError that will return the reason for any error.
+ *
+ * Writes @yaml to the output of @emitter verbatim, bypassing the emitter
+ * itself. Any output still pending in @emitter is flushed first.
+ *
+ * Returns: TRUE if @yaml was written successfully. Returns FALSE if @emitter
+ * is not positioned between documents or the output failed, and sets @error
+ * appropriately.
+ *
+ * Since: 2.9
+ */
+gboolean
+mmd_emitter_raw_document (yaml_emitter_t *emitter,
+                          GBytes *yaml,
+                          GError **error);
+
 
 /**
  * mmd_emitter_start_mapping:
@@ -731,6 +777,29 @@ guint64
 modulemd_yaml_parse_uint64 (yaml_parser_t *parser, GError **error);
 
 
+/**
+ * modulemd_yaml_scalar_to_uint64:
+ * @scalar: (in): The text of a YAML scalar. It need not be NUL-terminated.
+ * @length: (in): The length of @scalar in bytes.
+ * @value: (out): The number @scalar represents.
+ *
+ * Parses a scalar consisting only of decimal digits without allocating or
+ * rescanning it, converting eight digits at a time. This is the fast path for
+ * version numbers and timestamps, which make up most numeric scalars.
+ *
+ * Returns: TRUE and sets @value if @scalar is between one and nineteen ASCII
+ * digits long, which is the most that always fits in a #guint64. FALSE if it
+ * contains anything else, in which case callers should fall back to
+ * g_ascii_strtoull().
+ *
+ * Since: 2.9
+ */
+gboolean
+modulemd_yaml_scalar_to_uint64 (const gchar *scalar,
+                                gsize length,
+                                guint64 *value);
+
+
 /**
  * modulemd_yaml_parse_string_set:
  * @parser: (inout): A libyaml parser object positioned at the beginning of a
@@ -840,7 +909,7 @@ modulemd_yaml_emit_document_headers (yaml_emitter_t *emitter,
  * @emitter: (inout): A libyaml emitter object that is positioned where the
  * variant should occur.
  * @variant: (in): The variant to emit. It must be either a boolean, string,
- * array or dictionary.
+ * array or dictionary, or a variant holding one of those.
  * @error: (out): A #GError that will return the reason for failing to emit.
  *
  * Returns: TRUE if the variant emitted successfully. FALSE if an error was
@@ -29,6 +29,9 @@ struct _ModulemdBuildopts
   gchar *rpm_macros;
 
   GHashTable *whitelist;
+
+  /* The stream these buildopts belong to, if any */
+  ModulemdOwner *owner;
 };
 
 G_DEFINE_TYPE (ModulemdBuildopts, modulemd_buildopts, G_TYPE_OBJECT)
@@ -87,8 +90,11 @@ modulemd_buildopts_copy (ModulemdBuildopts *self)
   modulemd_buildopts_set_rpm_macros (b,
                                      modulemd_buildopts_get_rpm_macros (self));
 
+  /* A shared set would let changes to the copy reach the original behind
+   * the back of the stream owning it.
+   */
   g_hash_table_unref (b->whitelist);
-  b->whitelist = g_hash_table_ref (self->whitelist);
+  b->whitelist = modulemd_hash_table_deep_set_copy (self->whitelist);
 
   return g_steal_pointer (&b);
 }
@@ -101,6 +107,7 @@ modulemd_buildopts_finalize (GObject *object)
 
   g_clear_pointer (&self->rpm_macros, g_free);
   g_clear_pointer (&self->whitelist, g_hash_table_unref);
+  g_clear_pointer (&self->owner, modulemd_owner_unref);
 
   G_OBJECT_CLASS (modulemd_buildopts_parent_class)->finalize (object);
 }
@@ -111,6 +118,9 @@ modulemd_buildopts_set_rpm_macros (ModulemdBuildopts *self,
                                    const gchar *rpm_macros)
 {
   g_return_if_fail (MODULEMD_IS_BUILDOPTS (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
 
   g_clear_pointer (&self->rpm_macros, g_free);
   self->rpm_macros = g_strdup (rpm_macros);
@@ -133,6 +143,8 @@ modulemd_buildopts_add_rpm_to_whitelist (ModulemdBuildopts *self,
                                          const gchar *rpm)
 {
   g_return_if_fail (MODULEMD_IS_BUILDOPTS (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
   g_hash_table_add (self->whitelist, g_strdup (rpm));
 }
 
@@ -142,6 +154,8 @@ modulemd_buildopts_remove_rpm_from_whitelist (ModulemdBuildopts *self,
                                               const gchar *rpm)
 {
   g_return_if_fail (MODULEMD_IS_BUILDOPTS (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
   g_hash_table_remove (self->whitelist, rpm);
 }
 
@@ -149,6 +163,8 @@ void
 modulemd_buildopts_clear_rpm_whitelist (ModulemdBuildopts *self)
 {
   g_return_if_fail (MODULEMD_IS_BUILDOPTS (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
   g_hash_table_remove_all (self->whitelist);
 }
 
@@ -477,3 +493,31 @@ modulemd_buildopts_emit_yaml (ModulemdBuildopts *self,
     }
   return TRUE;
 }
+
+
+guint64
+modulemd_buildopts_fingerprint (ModulemdBuildopts *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_BUILDOPTS (self), 0);
+
+  fingerprint =
+    modulemd_fingerprint_add_string (fingerprint, self->rpm_macros);
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint, modulemd_fingerprint_set (self->whitelist));
+
+  return fingerprint;
+}
+
+
+void
+modulemd_buildopts_set_owner (ModulemdBuildopts *self, ModulemdOwner *owner)
+{
+  g_return_if_fail (MODULEMD_IS_BUILDOPTS (self));
+
+  modulemd_owner_replace (&self->owner, owner);
+}
@@ -115,6 +115,9 @@ modulemd_component_module_set_ref (ModulemdComponentModule *self,
                                    const gchar *ref)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_MODULE (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_clear_pointer (&self->ref, g_free);
   self->ref = g_strdup (ref);
@@ -137,6 +140,9 @@ modulemd_component_module_set_repository (ModulemdComponentModule *self,
                                           const gchar *repository)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_MODULE (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_clear_pointer (&self->repository, g_free);
   self->repository = g_strdup (repository);
@@ -411,3 +417,17 @@ modulemd_component_module_parse_yaml (yaml_parser_t *parser,
 
   return g_steal_pointer (&m);
 }
+
+
+guint64
+modulemd_component_module_add_fingerprint (ModulemdComponentModule *self,
+                                           guint64 fingerprint)
+{
+  g_return_val_if_fail (MODULEMD_IS_COMPONENT_MODULE (self), 0);
+
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->ref);
+  fingerprint =
+    modulemd_fingerprint_add_string (fingerprint, self->repository);
+
+  return fingerprint;
+}
@@ -198,6 +198,9 @@ modulemd_component_rpm_set_name (ModulemdComponent *self, const gchar *name)
       return;
     }
 
+  g_return_if_fail (!modulemd_component_is_frozen (self));
+  modulemd_component_changed (self);
+
   /* We're changing the value, so clear the existing version */
   g_clear_pointer (&rpm_self->override_name, g_free);
 
@@ -236,6 +239,9 @@ void
 modulemd_component_rpm_set_ref (ModulemdComponentRpm *self, const gchar *ref)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_clear_pointer (&self->ref, g_free);
   self->ref = g_strdup (ref);
@@ -258,6 +264,9 @@ modulemd_component_rpm_set_cache (ModulemdComponentRpm *self,
                                   const gchar *cache)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_clear_pointer (&self->cache, g_free);
   self->cache = g_strdup (cache);
@@ -280,6 +289,9 @@ modulemd_component_rpm_set_repository (ModulemdComponentRpm *self,
                                        const gchar *repository)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_clear_pointer (&self->repository, g_free);
   self->repository = g_strdup (repository);
@@ -302,6 +314,9 @@ modulemd_component_rpm_set_buildroot (ModulemdComponentRpm *self,
                                       gboolean buildroot)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   self->buildroot = buildroot;
 
@@ -323,6 +338,9 @@ modulemd_component_rpm_set_srpm_buildroot (ModulemdComponentRpm *self,
                                            gboolean srpm_buildroot)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   self->srpm_buildroot = srpm_buildroot;
 
@@ -344,6 +362,9 @@ modulemd_component_rpm_add_restricted_arch (ModulemdComponentRpm *self,
                                             const gchar *arch)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_hash_table_add (self->arches, g_strdup (arch));
 }
@@ -353,6 +374,9 @@ void
 modulemd_component_rpm_reset_arches (ModulemdComponentRpm *self)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_hash_table_remove_all (self->arches);
 }
@@ -373,6 +397,9 @@ modulemd_component_rpm_add_multilib_arch (ModulemdComponentRpm *self,
                                           const gchar *arch)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_hash_table_add (self->multilib, g_strdup (arch));
 }
@@ -382,6 +409,9 @@ void
 modulemd_component_rpm_reset_multilib_arches (ModulemdComponentRpm *self)
 {
   g_return_if_fail (MODULEMD_IS_COMPONENT_RPM (self));
+  g_return_if_fail (!modulemd_component_is_frozen (MODULEMD_COMPONENT (self)));
+
+  modulemd_component_changed (MODULEMD_COMPONENT (self));
 
   g_hash_table_remove_all (self->multilib);
 }
@@ -822,3 +852,26 @@ modulemd_component_rpm_parse_yaml (yaml_parser_t *parser,
 
   return g_steal_pointer (&r);
 }
+
+
+guint64
+modulemd_component_rpm_add_fingerprint (ModulemdComponentRpm *self,
+                                        guint64 fingerprint)
+{
+  g_return_val_if_fail (MODULEMD_IS_COMPONENT_RPM (self), 0);
+
+  fingerprint =
+    modulemd_fingerprint_add_string (fingerprint, self->override_name);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->ref);
+  fingerprint =
+    modulemd_fingerprint_add_string (fingerprint, self->repository);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->cache);
+  fingerprint = modulemd_fingerprint_add (fingerprint, !!self->buildroot);
+  fingerprint = modulemd_fingerprint_add (fingerprint, !!self->srpm_buildroot);
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint, modulemd_fingerprint_set (self->arches));
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint, modulemd_fingerprint_set (self->multilib));
+
+  return fingerprint;
+}
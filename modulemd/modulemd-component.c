@@ -15,7 +15,9 @@
 
 #include "modulemd-component.h"
 #include "modulemd-errors.h"
+#include "private/modulemd-component-module-private.h"
 #include "private/modulemd-component-private.h"
+#include "private/modulemd-component-rpm-private.h"
 #include "private/modulemd-util.h"
 #include "private/modulemd-yaml.h"
 
@@ -28,6 +30,9 @@ typedef struct
   gboolean buildonly;
   gchar *name;
   gchar *rationale;
+
+  /* The stream this component belongs to, if any */
+  ModulemdOwner *owner;
 } ModulemdComponentPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (ModulemdComponent,
@@ -92,6 +97,7 @@ modulemd_component_finalize (GObject *object)
   g_clear_pointer (&priv->name, g_free);
   g_clear_pointer (&priv->rationale, g_free);
   g_clear_pointer (&priv->buildafter, g_hash_table_unref);
+  g_clear_pointer (&priv->owner, modulemd_owner_unref);
 
   G_OBJECT_CLASS (modulemd_component_parent_class)->finalize (object);
 }
@@ -221,6 +227,8 @@ modulemd_component_add_buildafter (ModulemdComponent *self, const gchar *key)
   ModulemdComponentPrivate *priv =
     modulemd_component_get_instance_private (self);
 
+  g_return_if_fail (!modulemd_owner_is_frozen (priv->owner));
+  modulemd_owner_changed (priv->owner);
   g_hash_table_add (priv->buildafter, g_strdup (key));
 }
 
@@ -232,6 +240,8 @@ modulemd_component_clear_buildafter (ModulemdComponent *self)
   ModulemdComponentPrivate *priv =
     modulemd_component_get_instance_private (self);
 
+  g_return_if_fail (!modulemd_owner_is_frozen (priv->owner));
+  modulemd_owner_changed (priv->owner);
   g_hash_table_remove_all (priv->buildafter);
 }
 
@@ -280,6 +290,8 @@ modulemd_component_set_buildonly (ModulemdComponent *self, gboolean buildonly)
   ModulemdComponentPrivate *priv =
     modulemd_component_get_instance_private (self);
 
+  g_return_if_fail (!modulemd_owner_is_frozen (priv->owner));
+  modulemd_owner_changed (priv->owner);
   priv->buildonly = buildonly;
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_BUILDONLY]);
@@ -306,6 +318,8 @@ modulemd_component_set_buildorder (ModulemdComponent *self, gint64 buildorder)
   ModulemdComponentPrivate *priv =
     modulemd_component_get_instance_private (self);
 
+  g_return_if_fail (!modulemd_owner_is_frozen (priv->owner));
+  modulemd_owner_changed (priv->owner);
   priv->buildorder = buildorder;
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_BUILDORDER]);
@@ -333,6 +347,9 @@ modulemd_component_set_key (ModulemdComponent *self, const gchar *name)
 
   ModulemdComponentPrivate *priv =
     modulemd_component_get_instance_private (self);
+
+  g_return_if_fail (!modulemd_owner_is_frozen (priv->owner));
+  modulemd_owner_changed (priv->owner);
   g_clear_pointer (&priv->name, g_free);
   priv->name = g_strdup (name);
 
@@ -385,6 +402,9 @@ modulemd_component_set_rationale (ModulemdComponent *self,
 
   ModulemdComponentPrivate *priv =
     modulemd_component_get_instance_private (self);
+
+  g_return_if_fail (!modulemd_owner_is_frozen (priv->owner));
+  modulemd_owner_changed (priv->owner);
   g_clear_pointer (&priv->rationale, g_free);
   priv->rationale = g_strdup (rationale);
 
@@ -392,6 +412,42 @@ modulemd_component_set_rationale (ModulemdComponent *self,
 }
 
 
+void
+modulemd_component_set_owner (ModulemdComponent *self, ModulemdOwner *owner)
+{
+  g_return_if_fail (MODULEMD_IS_COMPONENT (self));
+
+  ModulemdComponentPrivate *priv =
+    modulemd_component_get_instance_private (self);
+
+  modulemd_owner_replace (&priv->owner, owner);
+}
+
+
+void
+modulemd_component_changed (ModulemdComponent *self)
+{
+  g_return_if_fail (MODULEMD_IS_COMPONENT (self));
+
+  ModulemdComponentPrivate *priv =
+    modulemd_component_get_instance_private (self);
+
+  modulemd_owner_changed (priv->owner);
+}
+
+
+gboolean
+modulemd_component_is_frozen (ModulemdComponent *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_COMPONENT (self), FALSE);
+
+  ModulemdComponentPrivate *priv =
+    modulemd_component_get_instance_private (self);
+
+  return modulemd_owner_is_frozen (priv->owner);
+}
+
+
 const gchar *
 modulemd_component_get_rationale (ModulemdComponent *self)
 {
@@ -677,3 +733,38 @@ modulemd_component_emit_yaml_build_common (ModulemdComponent *self,
 
   return TRUE;
 }
+
+
+guint64
+modulemd_component_fingerprint (ModulemdComponent *self)
+{
+  ModulemdComponentPrivate *priv = NULL;
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_COMPONENT (self), 0);
+
+  priv = modulemd_component_get_instance_private (self);
+
+  /* Components of different types never compare equal */
+  fingerprint =
+    modulemd_fingerprint_add_string (fingerprint, G_OBJECT_TYPE_NAME (self));
+  fingerprint = modulemd_fingerprint_add (fingerprint, priv->buildorder);
+  fingerprint = modulemd_fingerprint_add (fingerprint, !!priv->buildonly);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, priv->name);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, priv->rationale);
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint, modulemd_fingerprint_set (priv->buildafter));
+
+  if (MODULEMD_IS_COMPONENT_RPM (self))
+    return modulemd_component_rpm_add_fingerprint (
+      MODULEMD_COMPONENT_RPM (self), fingerprint);
+
+  if (MODULEMD_IS_COMPONENT_MODULE (self))
+    return modulemd_component_module_add_fingerprint (
+      MODULEMD_COMPONENT_MODULE (self), fingerprint);
+
+  return fingerprint;
+}
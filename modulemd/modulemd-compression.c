@@ -14,6 +14,7 @@
 #include <errno.h>
 #include <glib.h>
 #include <inttypes.h>
+#include <string.h>
 #include <unistd.h>
 
 
@@ -29,59 +30,140 @@
 
 #ifdef HAVE_LIBMAGIC
 #include <magic.h>
-G_DEFINE_AUTO_CLEANUP_FREE_FUNC (magic_t, magic_close, NULL)
 #endif
 
 
-ModulemdCompressionTypeEnum
-modulemd_detect_compression (const gchar *filename, int fd, GError **error)
+/* The longest signature checked by sniff_compression() */
+#define MMD_COMPRESSION_MAGIC_LEN 6
+
+
+/* Identifies the compression from the first bytes of the file. This only
+ * reads through @fd without moving its offset, so it costs one system call.
+ */
+static ModulemdCompressionTypeEnum
+sniff_compression (int fd)
 {
-  ModulemdCompressionTypeEnum type =
-    MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION;
+  guchar magic[MMD_COMPRESSION_MAGIC_LEN];
+  ssize_t len;
 
-  g_return_val_if_fail (filename, MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED);
-  g_return_val_if_fail (!error || *error == NULL,
-                        MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED);
+  do
+    len = pread (fd, magic, sizeof (magic), 0);
+  while (len < 0 && errno == EINTR);
 
-  if (!g_file_test (filename, G_FILE_TEST_IS_REGULAR))
+  if (len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+    return MODULEMD_COMPRESSION_TYPE_GZ_COMPRESSION;
+
+  if (len >= 4 && memcmp (magic, "BZh", 3) == 0 && magic[3] >= '1' &&
+      magic[3] <= '9')
+    return MODULEMD_COMPRESSION_TYPE_BZ2_COMPRESSION;
+
+  if (len >= 6 && memcmp (magic, "\xfd" "7zXZ\0", 6) == 0)
+    return MODULEMD_COMPRESSION_TYPE_XZ_COMPRESSION;
+
+  return MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION;
+}
+
+
+#ifdef HAVE_LIBMAGIC
+/* Loading the magic database takes far longer than looking up a file, so a
+ * single cookie is opened on first use and kept for the life of the process.
+ * A cookie may only be used by one thread at a time.
+ */
+static magic_t magic_cookie = NULL;
+static gchar *magic_cookie_error = NULL;
+static GMutex magic_cookie_lock;
+
+
+static magic_t
+get_magic_cookie (GError **error)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized))
+    {
+      magic_cookie = magic_open (MAGIC_MIME);
+      if (magic_cookie == NULL)
+        {
+          magic_cookie_error = g_strdup (
+            "magic_open() failed: Cannot allocate the magic cookie");
+        }
+      else if (magic_load (magic_cookie, NULL) == -1)
+        {
+          magic_cookie_error = g_strdup_printf ("magic_load() failed: %s",
+                                                magic_error (magic_cookie));
+          g_clear_pointer (&magic_cookie, magic_close);
+        }
+
+      g_once_init_leave (&initialized, 1);
+    }
+
+  if (magic_cookie == NULL)
     {
       g_set_error (error,
                    MODULEMD_ERROR,
-                   MODULEMD_ERROR_FILE_ACCESS,
-                   "File %s does not exist or is not a regular file",
-                   filename);
-      return MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
+                   MODULEMD_ERROR_MAGIC,
+                   "%s",
+                   magic_cookie_error);
     }
 
+  return magic_cookie;
+}
 
-  /* If the filename has a known suffix, assume it is accurate */
-  if (g_str_has_suffix (filename, ".gz") ||
-      g_str_has_suffix (filename, ".gzip") ||
-      g_str_has_suffix (filename, ".gunzip"))
+
+static ModulemdCompressionTypeEnum
+compression_from_mime_type (const char *mime_type)
+{
+  if (g_str_has_prefix (mime_type, "application/x-gzip") ||
+      g_str_has_prefix (mime_type, "application/gzip") ||
+      g_str_has_prefix (mime_type, "application/gzip-compressed") ||
+      g_str_has_prefix (mime_type, "application/gzipped") ||
+      g_str_has_prefix (mime_type, "application/x-gzip-compressed") ||
+      g_str_has_prefix (mime_type, "application/x-compress") ||
+      g_str_has_prefix (mime_type, "application/x-gzip") ||
+      g_str_has_prefix (mime_type, "application/x-gunzip") ||
+      g_str_has_prefix (mime_type, "multipart/x-gzip"))
     {
       return MODULEMD_COMPRESSION_TYPE_GZ_COMPRESSION;
     }
-  else if (g_str_has_suffix (filename, ".bz2") ||
-           g_str_has_suffix (filename, ".bzip2"))
+
+  else if (g_str_has_prefix (mime_type, "application/x-bzip2") ||
+           g_str_has_prefix (mime_type, "application/x-bz2") ||
+           g_str_has_prefix (mime_type, "application/bzip2") ||
+           g_str_has_prefix (mime_type, "application/bz2"))
     {
       return MODULEMD_COMPRESSION_TYPE_BZ2_COMPRESSION;
     }
-  else if (g_str_has_suffix (filename, ".xz"))
+
+  else if (g_str_has_prefix (mime_type, "application/x-xz"))
     {
       return MODULEMD_COMPRESSION_TYPE_XZ_COMPRESSION;
     }
-  else if (g_str_has_suffix (filename, ".yaml") ||
-           g_str_has_suffix (filename, ".yml") ||
-           g_str_has_suffix (filename, ".txt"))
+
+  else if (g_str_has_prefix (mime_type, "text/plain") ||
+           g_str_has_prefix (mime_type, "text/x-yaml") ||
+           g_str_has_prefix (mime_type, "application/x-yaml"))
     {
       return MODULEMD_COMPRESSION_TYPE_NO_COMPRESSION;
     }
 
-#ifdef HAVE_LIBMAGIC
-  /* No known suffix? Try using libmagic from file-utils */
+  return MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION;
+}
+
+
+static ModulemdCompressionTypeEnum
+magic_compression (const gchar *filename, int fd, GError **error)
+{
+  ModulemdCompressionTypeEnum type;
   const char *mime_type;
-  g_auto (magic_t) magic = NULL;
-  int magic_fd = dup (fd);
+  magic_t magic;
+  int magic_fd;
+
+  magic = get_magic_cookie (error);
+  if (magic == NULL)
+    return MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
+
+  /* Some versions of libmagic close the descriptor they are given */
+  magic_fd = dup (fd);
   if (magic_fd < 0)
     {
       g_set_error (error,
@@ -91,82 +173,91 @@ modulemd_detect_compression (const gchar *filename, int fd, GError **error)
       return MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
     }
 
-  magic = magic_open (MAGIC_MIME);
-  if (magic == NULL)
+  g_mutex_lock (&magic_cookie_lock);
+
+  /* The result is owned by the cookie, so it must be used before unlocking */
+  mime_type = magic_descriptor (magic, magic_fd);
+  if (mime_type)
     {
-      g_set_error (error,
-                   MODULEMD_ERROR,
-                   MODULEMD_ERROR_MAGIC,
-                   "magic_open() failed: Cannot allocate the magic cookie");
-      close (magic_fd);
-      return MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
+      g_debug (
+        "%s: Detected mime type: %s (%s)", __func__, mime_type, filename);
+      type = compression_from_mime_type (mime_type);
     }
-
-  if (magic_load (magic, NULL) == -1)
+  else
     {
       g_set_error (error,
                    MODULEMD_ERROR,
                    MODULEMD_ERROR_MAGIC,
-                   "magic_load() failed: %s",
+                   "mime_type() detection failed: %s",
                    magic_error (magic));
-      close (magic_fd);
-      return MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
+      type = MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
     }
 
-  mime_type = magic_descriptor (magic, magic_fd);
+  g_mutex_unlock (&magic_cookie_lock);
+
   close (magic_fd);
+
   /* Reset the file descriptor to the start of the file, if it has moved */
   lseek (fd, 0, SEEK_SET);
 
-  if (mime_type)
-    {
-      g_debug (
-        "%s: Detected mime type: %s (%s)", __func__, mime_type, filename);
+  return type;
+}
+#endif /* HAVE_LIBMAGIC */
 
-      if (g_str_has_prefix (mime_type, "application/x-gzip") ||
-          g_str_has_prefix (mime_type, "application/gzip") ||
-          g_str_has_prefix (mime_type, "application/gzip-compressed") ||
-          g_str_has_prefix (mime_type, "application/gzipped") ||
-          g_str_has_prefix (mime_type, "application/x-gzip-compressed") ||
-          g_str_has_prefix (mime_type, "application/x-compress") ||
-          g_str_has_prefix (mime_type, "application/x-gzip") ||
-          g_str_has_prefix (mime_type, "application/x-gunzip") ||
-          g_str_has_prefix (mime_type, "multipart/x-gzip"))
-        {
-          type = MODULEMD_COMPRESSION_TYPE_GZ_COMPRESSION;
-        }
 
-      else if (g_str_has_prefix (mime_type, "application/x-bzip2") ||
-               g_str_has_prefix (mime_type, "application/x-bz2") ||
-               g_str_has_prefix (mime_type, "application/bzip2") ||
-               g_str_has_prefix (mime_type, "application/bz2"))
-        {
-          type = MODULEMD_COMPRESSION_TYPE_BZ2_COMPRESSION;
-        }
+ModulemdCompressionTypeEnum
+modulemd_detect_compression (const gchar *filename, int fd, GError **error)
+{
+  ModulemdCompressionTypeEnum type;
 
-      else if (g_str_has_prefix (mime_type, "application/x-xz"))
-        {
-          type = MODULEMD_COMPRESSION_TYPE_XZ_COMPRESSION;
-        }
+  g_return_val_if_fail (filename, MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED);
+  g_return_val_if_fail (!error || *error == NULL,
+                        MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED);
 
-      else if (g_str_has_prefix (mime_type, "text/plain") ||
-               g_str_has_prefix (mime_type, "text/x-yaml") ||
-               g_str_has_prefix (mime_type, "application/x-yaml"))
-        {
-          type = MODULEMD_COMPRESSION_TYPE_NO_COMPRESSION;
-        }
-    }
-  else
+  if (!g_file_test (filename, G_FILE_TEST_IS_REGULAR))
     {
       g_set_error (error,
                    MODULEMD_ERROR,
-                   MODULEMD_ERROR_MAGIC,
-                   "mime_type() detection failed: %s",
-                   magic_error (magic));
+                   MODULEMD_ERROR_FILE_ACCESS,
+                   "File %s does not exist or is not a regular file",
+                   filename);
       return MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED;
     }
-  /* Reset the file descriptor to the start of the file, if it has moved */
-  lseek (fd, 0, SEEK_SET);
+
+
+  /* If the filename has a known suffix, assume it is accurate */
+  if (g_str_has_suffix (filename, ".gz") ||
+      g_str_has_suffix (filename, ".gzip") ||
+      g_str_has_suffix (filename, ".gunzip"))
+    {
+      return MODULEMD_COMPRESSION_TYPE_GZ_COMPRESSION;
+    }
+  else if (g_str_has_suffix (filename, ".bz2") ||
+           g_str_has_suffix (filename, ".bzip2"))
+    {
+      return MODULEMD_COMPRESSION_TYPE_BZ2_COMPRESSION;
+    }
+  else if (g_str_has_suffix (filename, ".xz"))
+    {
+      return MODULEMD_COMPRESSION_TYPE_XZ_COMPRESSION;
+    }
+  else if (g_str_has_suffix (filename, ".yaml") ||
+           g_str_has_suffix (filename, ".yml") ||
+           g_str_has_suffix (filename, ".txt"))
+    {
+      return MODULEMD_COMPRESSION_TYPE_NO_COMPRESSION;
+    }
+
+  /* No known suffix? Check the file for a known compression signature */
+  type = sniff_compression (fd);
+  if (type != MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION)
+    return type;
+
+#ifdef HAVE_LIBMAGIC
+  /* Still nothing? Ask libmagic from file-utils, which can also recognize
+   * uncompressed text.
+   */
+  type = magic_compression (filename, fd, error);
 #endif /* HAVE_LIBMAGIC */
 
   return type;
@@ -0,0 +1,142 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include "modulemd-defaults-conflict.h"
+#include "private/modulemd-defaults-conflict-private.h"
+
+
+struct _ModulemdDefaultsConflict
+{
+  GObject parent_instance;
+
+  ModulemdDefaultsConflictTypeEnum conflict_type;
+  gchar *module_name;
+  gchar *intent;
+  gchar *stream_name;
+  guint64 modified;
+  GStrv values;
+};
+
+G_DEFINE_TYPE (ModulemdDefaultsConflict,
+               modulemd_defaults_conflict,
+               G_TYPE_OBJECT)
+
+
+ModulemdDefaultsConflict *
+modulemd_defaults_conflict_new (ModulemdDefaultsConflictTypeEnum conflict_type,
+                                const gchar *module_name,
+                                const gchar *intent,
+                                const gchar *stream_name,
+                                guint64 modified,
+                                GStrv values)
+{
+  ModulemdDefaultsConflict *self = NULL;
+
+  g_return_val_if_fail (module_name, NULL);
+  g_return_val_if_fail (values && g_strv_length (values) > 1, NULL);
+
+  self = g_object_new (MODULEMD_TYPE_DEFAULTS_CONFLICT, NULL);
+  self->conflict_type = conflict_type;
+  self->module_name = g_strdup (module_name);
+  self->intent = g_strdup (intent);
+  self->stream_name = g_strdup (stream_name);
+  self->modified = modified;
+  self->values = values;
+
+  return self;
+}
+
+
+static void
+modulemd_defaults_conflict_finalize (GObject *object)
+{
+  ModulemdDefaultsConflict *self = (ModulemdDefaultsConflict *)object;
+
+  g_clear_pointer (&self->module_name, g_free);
+  g_clear_pointer (&self->intent, g_free);
+  g_clear_pointer (&self->stream_name, g_free);
+  g_clear_pointer (&self->values, g_strfreev);
+
+  G_OBJECT_CLASS (modulemd_defaults_conflict_parent_class)->finalize (object);
+}
+
+
+static void
+modulemd_defaults_conflict_class_init (ModulemdDefaultsConflictClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = modulemd_defaults_conflict_finalize;
+}
+
+
+static void
+modulemd_defaults_conflict_init (ModulemdDefaultsConflict *self)
+{
+}
+
+
+ModulemdDefaultsConflictTypeEnum
+modulemd_defaults_conflict_get_conflict_type (ModulemdDefaultsConflict *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_CONFLICT (self),
+                        MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM);
+
+  return self->conflict_type;
+}
+
+
+const gchar *
+modulemd_defaults_conflict_get_module_name (ModulemdDefaultsConflict *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_CONFLICT (self), NULL);
+
+  return self->module_name;
+}
+
+
+const gchar *
+modulemd_defaults_conflict_get_intent (ModulemdDefaultsConflict *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_CONFLICT (self), NULL);
+
+  return self->intent;
+}
+
+
+const gchar *
+modulemd_defaults_conflict_get_stream_name (ModulemdDefaultsConflict *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_CONFLICT (self), NULL);
+
+  return self->stream_name;
+}
+
+
+guint64
+modulemd_defaults_conflict_get_modified (ModulemdDefaultsConflict *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_CONFLICT (self), 0);
+
+  return self->modified;
+}
+
+
+const gchar *const *
+modulemd_defaults_conflict_peek_values (ModulemdDefaultsConflict *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_CONFLICT (self), NULL);
+
+  return (const gchar *const *)self->values;
+}
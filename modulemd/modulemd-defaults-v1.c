@@ -13,8 +13,10 @@
 
 #include <glib.h>
 #include <inttypes.h>
+#include "modulemd-defaults-conflict.h"
 #include "modulemd-defaults-v1.h"
 #include "modulemd-errors.h"
+#include "private/modulemd-defaults-conflict-private.h"
 #include "private/modulemd-defaults-private.h"
 #include "private/modulemd-defaults-v1-private.h"
 #include "private/modulemd-subdocument-info-private.h"
@@ -41,6 +43,11 @@ struct _ModulemdDefaultsV1
    * @value: #GHashTable set of profile names
    */
   GHashTable *intent_default_profiles;
+
+  /* The lists returned by the peek functions, keyed by the profile tables and
+   * sets above. Dropped whenever the profile defaults change.
+   */
+  GHashTable *sorted_keys;
 };
 
 G_DEFINE_TYPE (ModulemdDefaultsV1,
@@ -119,6 +126,7 @@ modulemd_defaults_v1_finalize (GObject *object)
   g_clear_pointer (&self->profile_defaults, g_hash_table_unref);
   g_clear_pointer (&self->intent_default_streams, g_hash_table_unref);
   g_clear_pointer (&self->intent_default_profiles, g_hash_table_unref);
+  g_clear_pointer (&self->sorted_keys, g_hash_table_unref);
 
   G_OBJECT_CLASS (modulemd_defaults_v1_parent_class)->finalize (object);
 }
@@ -190,6 +198,9 @@ modulemd_defaults_v1_set_default_stream (ModulemdDefaultsV1 *self,
                                          const gchar *intent)
 {
   g_return_if_fail (MODULEMD_IS_DEFAULTS_V1 (self));
+  g_return_if_fail (!modulemd_defaults_is_frozen (MODULEMD_DEFAULTS (self)));
+
+  modulemd_defaults_clear_fingerprint (MODULEMD_DEFAULTS (self));
 
   if (default_stream)
     {
@@ -264,27 +275,47 @@ modulemd_defaults_v1_get_default_stream (ModulemdDefaultsV1 *self,
 }
 
 
-GStrv
-modulemd_defaults_v1_get_streams_with_default_profiles_as_strv (
-  ModulemdDefaultsV1 *self, const gchar *intent)
+static GHashTable *
+modulemd_defaults_v1_get_profile_table (ModulemdDefaultsV1 *self,
+                                        const gchar *intent)
 {
   GHashTable *profile_set = NULL;
 
-  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_V1 (self), NULL);
-
   if (!intent)
     {
-      return modulemd_ordered_str_keys_as_strv (self->profile_defaults);
+      return self->profile_defaults;
     }
 
   profile_set = g_hash_table_lookup (self->intent_default_profiles, intent);
   if (profile_set)
     {
-      return modulemd_ordered_str_keys_as_strv (profile_set);
+      return profile_set;
     }
 
   /* No intent-specific default. Return the fallback defaults */
-  return modulemd_ordered_str_keys_as_strv (self->profile_defaults);
+  return self->profile_defaults;
+}
+
+
+GStrv
+modulemd_defaults_v1_get_streams_with_default_profiles_as_strv (
+  ModulemdDefaultsV1 *self, const gchar *intent)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_V1 (self), NULL);
+
+  return modulemd_ordered_str_keys_as_strv (
+    modulemd_defaults_v1_get_profile_table (self, intent));
+}
+
+
+const gchar *const *
+modulemd_defaults_v1_peek_streams_with_default_profiles (
+  ModulemdDefaultsV1 *self, const gchar *intent)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_V1 (self), NULL);
+
+  return modulemd_sorted_keys_peek (
+    &self->sorted_keys, modulemd_defaults_v1_get_profile_table (self, intent));
 }
 
 
@@ -332,7 +363,10 @@ modulemd_defaults_v1_add_or_clear_default_profile_for_stream (
   g_autoptr (GHashTable) profiles = NULL;
   g_return_if_fail (MODULEMD_IS_DEFAULTS_V1 (self));
   g_return_if_fail (stream_name);
+  g_return_if_fail (!modulemd_defaults_is_frozen (MODULEMD_DEFAULTS (self)));
 
+  modulemd_defaults_clear_fingerprint (MODULEMD_DEFAULTS (self));
+  modulemd_sorted_keys_clear (self->sorted_keys);
 
   profile_table = g_hash_table_ref (
     modulemd_defaults_v1_get_or_create_profile_table (self, intent));
@@ -405,6 +439,10 @@ modulemd_defaults_v1_remove_default_profiles_for_stream (
 
   g_return_if_fail (MODULEMD_IS_DEFAULTS_V1 (self));
   g_return_if_fail (stream_name);
+  g_return_if_fail (!modulemd_defaults_is_frozen (MODULEMD_DEFAULTS (self)));
+
+  modulemd_defaults_clear_fingerprint (MODULEMD_DEFAULTS (self));
+  modulemd_sorted_keys_clear (self->sorted_keys);
 
   profile_table = g_hash_table_ref (
     modulemd_defaults_v1_get_or_create_profile_table (self, intent));
@@ -413,15 +451,13 @@ modulemd_defaults_v1_remove_default_profiles_for_stream (
 }
 
 
-GStrv
-modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
-  ModulemdDefaultsV1 *self, const gchar *stream_name, const gchar *intent)
+static GHashTable *
+modulemd_defaults_v1_get_profile_set (ModulemdDefaultsV1 *self,
+                                      const gchar *stream_name,
+                                      const gchar *intent)
 {
   GHashTable *profile_table = NULL;
   GHashTable *profiles = NULL;
-  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_V1 (self), NULL);
-  g_return_val_if_fail (stream_name, NULL);
-
 
   if (intent)
     {
@@ -438,7 +474,7 @@ modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
 
       if (profiles)
         {
-          return modulemd_ordered_str_keys_as_strv (profiles);
+          return profiles;
         }
 
       /* We didn't find this profile in the intents, try the fallback
@@ -448,7 +484,19 @@ modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
 
 
   /* These are the fallback defaults */
-  profiles = g_hash_table_lookup (self->profile_defaults, stream_name);
+  return g_hash_table_lookup (self->profile_defaults, stream_name);
+}
+
+
+GStrv
+modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
+  ModulemdDefaultsV1 *self, const gchar *stream_name, const gchar *intent)
+{
+  GHashTable *profiles = NULL;
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_V1 (self), NULL);
+  g_return_val_if_fail (stream_name, NULL);
+
+  profiles = modulemd_defaults_v1_get_profile_set (self, stream_name, intent);
   if (!profiles)
     return NULL;
 
@@ -456,6 +504,22 @@ modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
 }
 
 
+const gchar *const *
+modulemd_defaults_v1_peek_default_profiles_for_stream (
+  ModulemdDefaultsV1 *self, const gchar *stream_name, const gchar *intent)
+{
+  GHashTable *profiles = NULL;
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS_V1 (self), NULL);
+  g_return_val_if_fail (stream_name, NULL);
+
+  profiles = modulemd_defaults_v1_get_profile_set (self, stream_name, intent);
+  if (!profiles)
+    return NULL;
+
+  return modulemd_sorted_keys_peek (&self->sorted_keys, profiles);
+}
+
+
 static void
 modulemd_defaults_v1_get_property (GObject *object,
                                    guint prop_id,
@@ -1193,299 +1257,519 @@ modulemd_defaults_v1_emit_intents (ModulemdDefaultsV1 *self,
   return TRUE;
 }
 
-static gboolean
-modulemd_defaults_v1_merge_default_profiles (
-  GHashTable *from_profile_defaults,
-  GHashTable *merged_profile_defaults,
-  guint64 from_modified,
-  guint64 into_modified,
-  GError **error);
-static GHashTable *
-modulemd_defaults_v1_copy_intent_profiles (GHashTable *intent_profiles);
-
-
 ModulemdDefaults *
 modulemd_defaults_v1_merge (ModulemdDefaultsV1 *from,
                             ModulemdDefaultsV1 *into,
                             gboolean strict_default_streams,
                             GError **error)
 {
-  g_autoptr (ModulemdDefaultsV1) merged = NULL;
-  GHashTableIter iter;
-  gpointer key, value;
-  GHashTable *intent_profiles = NULL;
-  GHashTable *merged_intent_profiles = NULL;
-  guint64 from_modified;
-  guint64 into_modified;
-  g_autoptr (GHashTable) intent_profile_defaults = NULL;
-  gchar *intent_name = NULL;
-  gchar *intent_default_stream = NULL;
-  gchar *merged_default_stream = NULL;
-  g_autoptr (GError) nested_error = NULL;
-  const gchar *module_name =
-    modulemd_defaults_get_module_name (MODULEMD_DEFAULTS (into));
+  g_autoptr (GPtrArray) defaults = g_ptr_array_sized_new (2);
+
+  /* A pairwise merge is just the N-way merge with two participants */
+  g_ptr_array_add (defaults, into);
+  g_ptr_array_add (defaults, from);
+
+  return MODULEMD_DEFAULTS (modulemd_defaults_v1_merge_n (
+    defaults, strict_default_streams, NULL, error));
+}
+
+
+/* Tracks the competing values for a single field across all of the
+ * ModulemdDefaultsV1 objects being merged. Only the values carrying the
+ * highest "modified" seen so far are retained. The values themselves are
+ * borrowed from the objects being merged and are only copied once the winner
+ * is known.
+ */
+typedef struct _MergeCandidate
+{
+  guint64 modified;
+  GPtrArray *values;
+} MergeCandidate;
+
 
-  from_modified = modulemd_defaults_get_modified (MODULEMD_DEFAULTS (from));
-  into_modified = modulemd_defaults_get_modified (MODULEMD_DEFAULTS (into));
+static MergeCandidate *
+merge_candidate_new (void)
+{
+  MergeCandidate *candidate = g_new0 (MergeCandidate, 1);
+  candidate->values = g_ptr_array_new ();
+  return candidate;
+}
 
-  /* Start from a copy of "into" */
-  merged =
-    MODULEMD_DEFAULTS_V1 (modulemd_defaults_copy (MODULEMD_DEFAULTS (into)));
 
-  /* Merge the default streams */
-  if (from->default_stream && !merged->default_stream)
+static void
+merge_candidate_free (gpointer data)
+{
+  MergeCandidate *candidate = (MergeCandidate *)data;
+
+  if (!candidate)
+    return;
+
+  g_clear_pointer (&candidate->values, g_ptr_array_unref);
+  g_free (candidate);
+}
+
+
+static void
+merge_candidate_offer (MergeCandidate *candidate,
+                       guint64 modified,
+                       gpointer value,
+                       GEqualFunc equal_func)
+{
+  if (candidate->values->len == 0 || modified > candidate->modified)
     {
-      modulemd_defaults_v1_set_default_stream (
-        merged, from->default_stream, NULL);
+      /* First value for this field, or a newer one that supersedes all of
+       * the values seen so far.
+       */
+      g_ptr_array_set_size (candidate->values, 0);
+      candidate->modified = modified;
+      g_ptr_array_add (candidate->values, value);
+      return;
     }
-  else if (merged->default_stream && from->default_stream)
+
+  if (modified < candidate->modified)
+    return;
+
+  /* Same modified value: remember it only if it differs from the ones we
+   * already have, since that is a conflict.
+   */
+  if (!g_ptr_array_find_with_equal_func (
+        candidate->values, value, equal_func, NULL))
+    g_ptr_array_add (candidate->values, value);
+}
+
+
+static void
+merge_candidate_table_offer (GHashTable *candidates,
+                             const gchar *key,
+                             guint64 modified,
+                             gpointer value,
+                             GEqualFunc equal_func)
+{
+  MergeCandidate *candidate = g_hash_table_lookup (candidates, key);
+
+  if (!candidate)
     {
-      if (g_str_equal (merged->default_stream, DEFAULT_MERGE_CONFLICT))
-        {
-          /* A previous pass over this same module encountered a merge
-           * conflict, so keep it.
-           */
-        }
-      else if (!g_str_equal (merged->default_stream, from->default_stream))
+      candidate = merge_candidate_new ();
+      g_hash_table_insert (candidates, (gpointer)key, candidate);
+    }
+
+  merge_candidate_offer (candidate, modified, value, equal_func);
+}
+
+
+static ModulemdDefaultsConflict *
+merge_candidate_to_conflict (MergeCandidate *candidate,
+                             ModulemdDefaultsConflictTypeEnum type,
+                             const gchar *module_name,
+                             const gchar *intent,
+                             const gchar *stream_name)
+{
+  GStrv values = g_new0 (gchar *, candidate->values->len + 1);
+  g_auto (GStrv) profiles = NULL;
+
+  for (guint i = 0; i < candidate->values->len; i++)
+    {
+      if (type == MODULEMD_DEFAULTS_CONFLICT_PROFILES)
         {
-          if (from_modified > into_modified)
-            {
-              modulemd_defaults_v1_set_default_stream (
-                merged, from->default_stream, NULL);
-            }
-          else if (from_modified == into_modified)
-            {
-              /* They have conflicting default streams */
-              g_info ("Module stream mismatch in merge: %s != %s",
-                      into->default_stream,
-                      from->default_stream);
-              if (strict_default_streams)
-                {
-                  g_set_error (
-                    error,
-                    MODULEMD_ERROR,
-                    MODULEMD_ERROR_VALIDATE,
-                    "Default stream mismatch in module %s: %s != %s",
-                    module_name,
-                    into->default_stream,
-                    from->default_stream);
-                  return NULL;
-                }
-              modulemd_defaults_v1_set_default_stream (
-                merged, DEFAULT_MERGE_CONFLICT, NULL);
-            }
+          profiles = modulemd_ordered_str_keys_as_strv (
+            g_ptr_array_index (candidate->values, i));
+          values[i] = g_strjoinv (",", profiles);
+          g_clear_pointer (&profiles, g_strfreev);
         }
       else
         {
-          /* They're the same, so change nothing */
+          values[i] = g_strdup (g_ptr_array_index (candidate->values, i));
         }
     }
-  else
+
+  return modulemd_defaults_conflict_new (
+    type, module_name, intent, stream_name, candidate->modified, values);
+}
+
+
+static void
+merge_profile_candidates (GHashTable *candidates,
+                          GHashTable *merged_profiles,
+                          const gchar *module_name,
+                          const gchar *intent,
+                          GPtrArray *conflicts)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+  MergeCandidate *candidate = NULL;
+
+  g_hash_table_iter_init (&iter, candidates);
+  while (g_hash_table_iter_next (&iter, &key, &value))
     {
-      /* The 'from' default stream was NULL. Make no changes. */
+      candidate = (MergeCandidate *)value;
+
+      if (candidate->values->len > 1)
+        {
+          g_ptr_array_add (
+            conflicts,
+            merge_candidate_to_conflict (candidate,
+                                         MODULEMD_DEFAULTS_CONFLICT_PROFILES,
+                                         module_name,
+                                         intent,
+                                         (const gchar *)key));
+          continue;
+        }
+
+      g_hash_table_replace (merged_profiles,
+                            g_strdup ((const gchar *)key),
+                            modulemd_hash_table_deep_set_copy (
+                              g_ptr_array_index (candidate->values, 0)));
     }
+}
 
 
-  /* == Merge profile defaults == */
+ModulemdDefaultsV1 *
+modulemd_defaults_v1_merge_n (GPtrArray *defaults,
+                              gboolean strict_default_streams,
+                              GPtrArray **conflicts,
+                              GError **error)
+{
+  MODULEMD_INIT_TRACE ();
+  g_autoptr (ModulemdDefaultsV1) merged = NULL;
+  g_autoptr (GPtrArray) found_conflicts = NULL;
+  g_autoptr (GHashTable) profile_candidates = NULL;
+  g_autoptr (GHashTable) intent_stream_candidates = NULL;
+  g_autoptr (GHashTable) intent_profile_candidates = NULL;
+  g_autoptr (GError) nested_error = NULL;
+  MergeCandidate *stream_candidate = NULL;
+  MergeCandidate *candidate = NULL;
+  ModulemdDefaultsV1 *current = NULL;
+  ModulemdDefaultsConflict *conflict = NULL;
+  const gchar *const *values = NULL;
+  GHashTable *intent_candidates = NULL;
+  GHashTableIter iter, profile_iter;
+  gpointer key, value, profile_key, profile_value;
+  const gchar *module_name = NULL;
+  guint64 modified = 0;
+  guint64 merged_modified = 0;
+  gboolean stream_conflict = FALSE;
+  guint i;
+
+  g_return_val_if_fail (defaults && defaults->len > 0, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-  /* Iterate through 'from' and see if there are additions or conflicts */
-  if (!modulemd_defaults_v1_merge_default_profiles (from->profile_defaults,
-                                                    merged->profile_defaults,
-                                                    from_modified,
-                                                    into_modified,
-                                                    &nested_error))
+  for (i = 0; i < defaults->len; i++)
     {
-      g_propagate_error (error, g_steal_pointer (&nested_error));
-      return NULL;
+      g_return_val_if_fail (
+        MODULEMD_IS_DEFAULTS_V1 (g_ptr_array_index (defaults, i)), NULL);
     }
 
-  /* == Merge intent defaults == */
+  module_name = modulemd_defaults_get_module_name (
+    MODULEMD_DEFAULTS (g_ptr_array_index (defaults, 0)));
+
+  found_conflicts = g_ptr_array_new_with_free_func (g_object_unref);
 
-  /* Merge intent default stream values */
+  profile_candidates = g_hash_table_new_full (
+    g_str_hash, g_str_equal, NULL, merge_candidate_free);
+  intent_stream_candidates = g_hash_table_new_full (
+    g_str_hash, g_str_equal, NULL, merge_candidate_free);
+  intent_profile_candidates = g_hash_table_new_full (
+    g_str_hash, g_str_equal, NULL, modulemd_hash_table_unref);
 
-  /* Iterate through 'from', adding any new values and checking the existing
-   * ones for equivalence.
+  for (i = 0; i < defaults->len; i++)
+    {
+      current = g_ptr_array_index (defaults, i);
+
+      if (!g_str_equal (
+            module_name,
+            modulemd_defaults_get_module_name (MODULEMD_DEFAULTS (current))))
+        {
+          g_set_error (
+            error,
+            MODULEMD_ERROR,
+            MODULEMD_ERROR_VALIDATE,
+            "Module name mismatch in merge: %s != %s",
+            module_name,
+            modulemd_defaults_get_module_name (MODULEMD_DEFAULTS (current)));
+          return NULL;
+        }
+    }
+
+  /* Single pass over every participant, recording the newest value(s) for
+   * each field without copying anything.
    */
-  g_hash_table_iter_init (&iter, from->intent_default_streams);
-  while (g_hash_table_iter_next (&iter, &key, &value))
+  stream_candidate = merge_candidate_new ();
+
+  for (i = 0; i < defaults->len; i++)
     {
-      intent_name = (gchar *)key;
-      intent_default_stream = (gchar *)value;
-      merged_default_stream =
-        g_hash_table_lookup (merged->intent_default_streams, intent_name);
+      current = g_ptr_array_index (defaults, i);
 
-      /* If there is no new default stream, just jump to the next item */
-      if (!intent_default_stream)
-        continue;
+      modified = modulemd_defaults_get_modified (MODULEMD_DEFAULTS (current));
+      merged_modified = MAX (merged_modified, modified);
 
-      if (!merged_default_stream)
+      if (current->default_stream)
+        merge_candidate_offer (
+          stream_candidate, modified, current->default_stream, g_str_equal);
+
+      g_hash_table_iter_init (&iter, current->profile_defaults);
+      while (g_hash_table_iter_next (&iter, &key, &value))
         {
-          /* New entry, just add it */
-          g_hash_table_insert (merged->intent_default_streams,
-                               g_strdup (intent_name),
-                               g_strdup (intent_default_stream));
+          merge_candidate_table_offer (
+            profile_candidates,
+            key,
+            modified,
+            value,
+            modulemd_hash_table_sets_are_equal_wrapper);
         }
 
-      else if (!g_str_equal (intent_default_stream, merged_default_stream))
+      g_hash_table_iter_init (&iter, current->intent_default_streams);
+      while (g_hash_table_iter_next (&iter, &key, &value))
         {
-          if (from_modified > into_modified)
+          if (!value)
+            continue;
+          merge_candidate_table_offer (
+            intent_stream_candidates, key, modified, value, g_str_equal);
+        }
+
+      g_hash_table_iter_init (&iter, current->intent_default_profiles);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+          intent_candidates =
+            g_hash_table_lookup (intent_profile_candidates, key);
+          if (!intent_candidates)
             {
-              g_hash_table_replace (merged->intent_default_streams,
-                                    g_strdup (intent_name),
-                                    g_strdup (intent_default_stream));
+              intent_candidates = g_hash_table_new_full (
+                g_str_hash, g_str_equal, NULL, merge_candidate_free);
+              g_hash_table_insert (
+                intent_profile_candidates, key, intent_candidates);
             }
-          else if (into_modified == from_modified)
+
+          g_hash_table_iter_init (&profile_iter, (GHashTable *)value);
+          while (g_hash_table_iter_next (
+            &profile_iter, &profile_key, &profile_value))
             {
-              g_set_error (
-                error,
-                MODULEMD_ERROR,
-                MODULEMD_ERROR_VALIDATE,
-                "Profile default stream mismatch in intents: %s != %s",
-                intent_default_stream,
-                merged_default_stream);
-              return NULL;
+              merge_candidate_table_offer (
+                intent_candidates,
+                profile_key,
+                modified,
+                profile_value,
+                modulemd_hash_table_sets_are_equal_wrapper);
             }
         }
     }
 
+  /* Now build the result, copying each winning value exactly once */
+  merged = modulemd_defaults_v1_new (module_name);
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (merged), merged_modified);
+
+  /* == Default stream == */
+  if (stream_candidate->values->len > 0)
+    {
+      /* A participant that already carries the merge conflict marker came out
+       * of an earlier non-strict merge and keeps that conflict alive.
+       */
+      if (g_ptr_array_find_with_equal_func (stream_candidate->values,
+                                            DEFAULT_MERGE_CONFLICT,
+                                            g_str_equal,
+                                            &i))
+        {
+          stream_conflict = TRUE;
+          g_ptr_array_remove_index (stream_candidate->values, i);
+        }
+
+      if (stream_candidate->values->len > 1)
+        {
+          stream_conflict = TRUE;
+          g_ptr_array_add (found_conflicts,
+                           merge_candidate_to_conflict (
+                             stream_candidate,
+                             MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM,
+                             module_name,
+                             NULL,
+                             NULL));
+        }
 
-  /* Merge intent default profile values */
+      if (stream_conflict)
+        {
+          modulemd_defaults_v1_set_default_stream (
+            merged, DEFAULT_MERGE_CONFLICT, NULL);
+        }
+      else
+        {
+          modulemd_defaults_v1_set_default_stream (
+            merged, g_ptr_array_index (stream_candidate->values, 0), NULL);
+        }
+    }
+  g_clear_pointer (&stream_candidate, merge_candidate_free);
 
-  /* Now copy 'from' into merged, checking for conflicts */
-  g_hash_table_iter_init (&iter, from->intent_default_profiles);
+  /* == Profile defaults == */
+  merge_profile_candidates (profile_candidates,
+                            merged->profile_defaults,
+                            module_name,
+                            NULL,
+                            found_conflicts);
+
+  /* == Intent default streams == */
+  g_hash_table_iter_init (&iter, intent_stream_candidates);
   while (g_hash_table_iter_next (&iter, &key, &value))
     {
-      intent_name = (gchar *)key;
-      intent_profiles = (GHashTable *)value;
-      merged_intent_profiles =
-        g_hash_table_lookup (merged->intent_default_profiles, intent_name);
+      candidate = (MergeCandidate *)value;
 
-      if (!merged_intent_profiles)
+      if (candidate->values->len > 1)
         {
-          intent_profile_defaults =
-            modulemd_defaults_v1_copy_intent_profiles (intent_profiles);
-
-          /* This wasn't in 'merged', so just add it */
-          g_hash_table_insert (merged->intent_default_profiles,
-                               g_strdup (intent_name),
-                               g_steal_pointer (&intent_profile_defaults));
+          g_ptr_array_add (found_conflicts,
+                           merge_candidate_to_conflict (
+                             candidate,
+                             MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM,
+                             module_name,
+                             (const gchar *)key,
+                             NULL));
           continue;
         }
 
-      /* Go through each of the profile defaults and see if they're additive or
-       * conflicting
+      g_hash_table_replace (
+        merged->intent_default_streams,
+        g_strdup ((const gchar *)key),
+        g_strdup (g_ptr_array_index (candidate->values, 0)));
+    }
+
+  /* == Intent default profiles == */
+  g_hash_table_iter_init (&iter, intent_profile_candidates);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      /* Create the table even if it ends up empty, so that the intent is
+       * preserved the same way the parser would have stored it.
        */
-      if (!modulemd_defaults_v1_merge_default_profiles (intent_profiles,
-                                                        merged_intent_profiles,
-                                                        from_modified,
-                                                        into_modified,
-                                                        &nested_error))
+      merge_profile_candidates (
+        (GHashTable *)value,
+        modulemd_defaults_v1_get_or_create_profile_table (merged, key),
+        module_name,
+        (const gchar *)key,
+        found_conflicts);
+    }
+
+  /* Decide whether any of the conflicts are fatal. A conflicting generic
+   * default stream is resolved by unsetting it unless the caller asked for
+   * strict handling. Nothing else can be resolved automatically.
+   */
+  for (i = 0; i < found_conflicts->len && !nested_error; i++)
+    {
+      conflict = g_ptr_array_index (found_conflicts, i);
+      values = modulemd_defaults_conflict_peek_values (conflict);
+
+      if (modulemd_defaults_conflict_get_conflict_type (conflict) ==
+            MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM &&
+          !modulemd_defaults_conflict_get_intent (conflict))
         {
-          g_propagate_error (error, g_steal_pointer (&nested_error));
-          return NULL;
+          g_info ("Module stream mismatch in merge: %s != %s",
+                  values[0],
+                  values[1]);
+          if (strict_default_streams)
+            {
+              g_set_error (&nested_error,
+                           MODULEMD_ERROR,
+                           MODULEMD_ERROR_VALIDATE,
+                           "Default stream mismatch in module %s: %s != %s",
+                           module_name,
+                           values[0],
+                           values[1]);
+            }
+        }
+      else if (modulemd_defaults_conflict_get_conflict_type (conflict) ==
+               MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM)
+        {
+          g_set_error (&nested_error,
+                       MODULEMD_ERROR,
+                       MODULEMD_ERROR_VALIDATE,
+                       "Profile default stream mismatch in intents: %s != %s",
+                       values[0],
+                       values[1]);
+        }
+      else
+        {
+          g_set_error (&nested_error,
+                       MODULEMD_ERROR,
+                       MODULEMD_ERROR_VALIDATE,
+                       "Profile default mismatch in stream: %s",
+                       modulemd_defaults_conflict_get_stream_name (conflict));
         }
     }
 
-  /* Set the modified value to the higher of the two provided */
-  if (from_modified > into_modified)
-    modulemd_defaults_set_modified (MODULEMD_DEFAULTS (merged), from_modified);
+  if (conflicts)
+    *conflicts = g_steal_pointer (&found_conflicts);
+
+  if (nested_error)
+    {
+      g_propagate_error (error, g_steal_pointer (&nested_error));
+      return NULL;
+    }
 
-  return MODULEMD_DEFAULTS (g_steal_pointer (&merged));
+  return g_steal_pointer (&merged);
 }
 
 
-static GHashTable *
-modulemd_defaults_v1_copy_intent_profiles (GHashTable *intent_profiles)
+static void
+sort_profile_table (ModulemdDefaultsV1 *self, GHashTable *profile_table)
 {
-  g_autoptr (GHashTable) intent_profile_defaults = NULL;
-  gchar *stream_name = NULL;
-  GHashTable *profile_defaults = NULL;
   GHashTableIter iter;
-  gpointer key, value;
+  gpointer value;
 
+  modulemd_sorted_keys_peek (&self->sorted_keys, profile_table);
 
-  intent_profile_defaults = g_hash_table_new_full (
-    g_str_hash, g_str_equal, g_free, modulemd_hash_table_unref);
+  g_hash_table_iter_init (&iter, profile_table);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    modulemd_sorted_keys_peek (&self->sorted_keys, value);
+}
 
-  g_hash_table_iter_init (&iter, intent_profiles);
-  while (g_hash_table_iter_next (&iter, &key, &value))
-    {
-      stream_name = (gchar *)key;
-      profile_defaults = (GHashTable *)value;
-
-      /* Copy the profile defaults */
-      g_hash_table_insert (
-        intent_profile_defaults,
-        g_strdup (stream_name),
-        modulemd_hash_table_deep_set_copy (profile_defaults));
-    }
 
-  return g_steal_pointer (&intent_profile_defaults);
+void
+modulemd_defaults_v1_sort_collections (ModulemdDefaultsV1 *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_if_fail (MODULEMD_IS_DEFAULTS_V1 (self));
+
+  sort_profile_table (self, self->profile_defaults);
+
+  g_hash_table_iter_init (&iter, self->intent_default_profiles);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    sort_profile_table (self, value);
 }
 
-static gboolean
-modulemd_defaults_v1_merge_default_profiles (
-  GHashTable *from_profile_defaults,
-  GHashTable *merged_profile_defaults,
-  guint64 from_modified,
-  guint64 into_modified,
-  GError **error)
+
+void
+modulemd_defaults_v1_add_intents (ModulemdDefaultsV1 *self,
+                                  GHashTable *intents)
 {
   GHashTableIter iter;
-  gpointer key, value;
-  gchar *stream_name = NULL;
-  GHashTable *from_profiles = NULL;
-  GHashTable *merged_profiles = NULL;
-
-  g_hash_table_iter_init (&iter, from_profile_defaults);
-  while (g_hash_table_iter_next (&iter, &key, &value))
-    {
-      stream_name = (gchar *)key;
-      from_profiles = (GHashTable *)value;
-      merged_profiles =
-        g_hash_table_lookup (merged_profile_defaults, stream_name);
+  gpointer key;
 
-      if (!merged_profiles)
-        {
-          /* Didn't appear in the profiles list, so just add it to merged */
-          g_hash_table_insert (
-            merged_profile_defaults,
-            g_strdup (stream_name),
-            modulemd_hash_table_deep_set_copy (from_profiles));
-          continue;
-        }
+  g_return_if_fail (MODULEMD_IS_DEFAULTS_V1 (self));
+  g_return_if_fail (intents);
 
-      /* Check to see if they match */
-      if (!modulemd_hash_table_sets_are_equal (from_profiles, merged_profiles))
-        {
-          if (from_modified > into_modified)
-            {
-              g_hash_table_replace (
-                merged_profile_defaults,
-                g_strdup (stream_name),
-                modulemd_hash_table_deep_set_copy (from_profiles));
-            }
-          else if (into_modified > from_modified)
-            {
-              /* Already there, so just continue */
-              continue;
-            }
-          else
-            {
-              /* The profile sets differed. This is an unresolvable merge
-               * conflict
-               */
-              g_set_error (error,
-                           MODULEMD_ERROR,
-                           MODULEMD_ERROR_VALIDATE,
-                           "Profile default mismatch in stream: %s",
-                           stream_name);
-              return FALSE;
-            }
-        }
+  g_hash_table_iter_init (&iter, self->intent_default_streams);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_hash_table_add (intents, g_strdup (key));
+}
 
-      /* They were a complete match, so no need to add it a second time */
-    }
 
-  return TRUE;
+void
+modulemd_defaults_v1_fingerprint_fields (ModulemdDefaultsV1 *self,
+                                         ModulemdFingerprintFieldFunc func,
+                                         gpointer user_data)
+{
+  g_return_if_fail (MODULEMD_IS_DEFAULTS_V1 (self));
+  g_return_if_fail (func);
+
+  func ("default_stream",
+        modulemd_fingerprint_string (self->default_stream),
+        user_data);
+  func ("profile_defaults",
+        modulemd_fingerprint_hash_table (self->profile_defaults,
+                                         modulemd_fingerprint_set),
+        user_data);
+  func ("intent_default_streams",
+        modulemd_fingerprint_hash_table (self->intent_default_streams,
+                                         modulemd_fingerprint_string),
+        user_data);
+  func ("intent_default_profiles",
+        modulemd_fingerprint_hash_table (self->intent_default_profiles,
+                                         modulemd_fingerprint_set),
+        user_data);
 }
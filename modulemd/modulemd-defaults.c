@@ -22,10 +22,23 @@
 
 #define DEF_DEFAULT_NAME_STRING "__NAME_UNSET__"
 
+/* Bumped whenever any ModulemdDefaults object changes. See
+ * modulemd_defaults_get_generation().
+ */
+static gint defaults_generation;
+
 typedef struct
 {
   gchar *module_name;
   guint64 modified;
+
+  /* The cached result of modulemd_defaults_get_fingerprint(), or 0 */
+  guint64 fingerprint;
+
+  /* Set once the defaults belong to a frozen index. The setters refuse to
+   * modify them after that, so the fingerprint above no longer changes.
+   */
+  gboolean frozen;
 } ModulemdDefaultsPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (ModulemdDefaults,
@@ -59,6 +72,16 @@ modulemd_defaults_equals (ModulemdDefaults *self_1, ModulemdDefaults *self_2)
   g_return_val_if_fail (MODULEMD_IS_DEFAULTS (self_1), FALSE);
   g_return_val_if_fail (MODULEMD_IS_DEFAULTS (self_2), FALSE);
 
+  if (self_1 == self_2)
+    return TRUE;
+
+  /* Equal defaults always have the same fingerprint, and those are cached,
+   * so this only has to compare them field by field when they match.
+   */
+  if (modulemd_defaults_get_fingerprint (self_1) !=
+      modulemd_defaults_get_fingerprint (self_2))
+    return FALSE;
+
   klass = MODULEMD_DEFAULTS_GET_CLASS (self_1);
   g_return_val_if_fail (klass->equals, FALSE);
 
@@ -108,6 +131,7 @@ modulemd_defaults_finalize (GObject *object)
   ModulemdDefaults *self = (ModulemdDefaults *)object;
   ModulemdDefaultsPrivate *priv =
     modulemd_defaults_get_instance_private (self);
+  g_return_if_fail (!priv->frozen);
 
   g_clear_pointer (&priv->module_name, g_free);
 
@@ -150,6 +174,7 @@ gboolean
 modulemd_defaults_validate (ModulemdDefaults *self, GError **error)
 {
   ModulemdDefaultsClass *klass;
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_VALIDATE);
 
   if (!self)
     return FALSE;
@@ -262,7 +287,10 @@ modulemd_defaults_set_modified (ModulemdDefaults *self, guint64 modified)
 
   ModulemdDefaultsPrivate *priv =
     modulemd_defaults_get_instance_private (self);
+  g_return_if_fail (!priv->frozen);
+
   priv->modified = modified;
+  modulemd_defaults_clear_fingerprint (self);
 }
 
 
@@ -292,9 +320,11 @@ modulemd_defaults_set_module_name (ModulemdDefaults *self,
 
   ModulemdDefaultsPrivate *priv =
     modulemd_defaults_get_instance_private (self);
+  g_return_if_fail (!priv->frozen);
 
   g_clear_pointer (&priv->module_name, g_free);
   priv->module_name = g_strdup (module_name);
+  modulemd_defaults_clear_fingerprint (self);
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_MODULE_NAME]);
 }
@@ -438,3 +468,136 @@ modulemd_defaults_merge (ModulemdDefaults *from,
 
   return g_steal_pointer (&merged_defaults);
 }
+
+
+ModulemdDefaults *
+modulemd_defaults_merge_n (GPtrArray *defaults,
+                           gboolean strict_default_streams,
+                           GPtrArray **conflicts,
+                           GError **error)
+{
+  g_autoptr (ModulemdDefaultsV1) merged_defaults = NULL;
+  ModulemdDefaults *current = NULL;
+  g_autoptr (GError) nested_error = NULL;
+
+  g_return_val_if_fail (defaults && defaults->len > 0, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  /* TODO: Upgrade defaults if they have differing mdversions. See
+   * modulemd_defaults_merge().
+   */
+  for (guint i = 0; i < defaults->len; i++)
+    {
+      current = g_ptr_array_index (defaults, i);
+      g_return_val_if_fail (MODULEMD_IS_DEFAULTS (current), NULL);
+      g_return_val_if_fail (
+        modulemd_defaults_get_mdversion (current) == MD_DEFAULTS_VERSION_ONE,
+        NULL);
+    }
+
+  merged_defaults = modulemd_defaults_v1_merge_n (
+    defaults, strict_default_streams, conflicts, &nested_error);
+  if (!merged_defaults)
+    {
+      g_propagate_error (error, g_steal_pointer (&nested_error));
+      return NULL;
+    }
+
+  return MODULEMD_DEFAULTS (g_steal_pointer (&merged_defaults));
+}
+
+
+void
+modulemd_defaults_fingerprint_fields (ModulemdDefaults *self,
+                                      ModulemdFingerprintFieldFunc func,
+                                      gpointer user_data)
+{
+  g_return_if_fail (MODULEMD_IS_DEFAULTS (self));
+  g_return_if_fail (func);
+
+  ModulemdDefaultsPrivate *priv =
+    modulemd_defaults_get_instance_private (self);
+
+  func ("mdversion", modulemd_defaults_get_mdversion (self), user_data);
+  func ("module_name",
+        modulemd_fingerprint_string (priv->module_name),
+        user_data);
+  func ("modified", priv->modified, user_data);
+
+  if (MODULEMD_IS_DEFAULTS_V1 (self))
+    modulemd_defaults_v1_fingerprint_fields (
+      MODULEMD_DEFAULTS_V1 (self), func, user_data);
+}
+
+
+guint64
+modulemd_defaults_get_fingerprint (ModulemdDefaults *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS (self), 0);
+
+  ModulemdDefaultsPrivate *priv =
+    modulemd_defaults_get_instance_private (self);
+
+  if (priv->fingerprint)
+    return priv->fingerprint;
+
+  modulemd_defaults_fingerprint_fields (
+    self, modulemd_fingerprint_add_field, &fingerprint);
+  priv->fingerprint = fingerprint;
+
+  return fingerprint;
+}
+
+
+void
+modulemd_defaults_clear_fingerprint (ModulemdDefaults *self)
+{
+  g_return_if_fail (MODULEMD_IS_DEFAULTS (self));
+
+  ModulemdDefaultsPrivate *priv =
+    modulemd_defaults_get_instance_private (self);
+
+  priv->fingerprint = 0;
+  g_atomic_int_inc (&defaults_generation);
+}
+
+
+guint
+modulemd_defaults_get_generation (void)
+{
+  return (guint)g_atomic_int_get (&defaults_generation);
+}
+
+
+void
+modulemd_defaults_freeze (ModulemdDefaults *self)
+{
+  g_return_if_fail (MODULEMD_IS_DEFAULTS (self));
+
+  ModulemdDefaultsPrivate *priv =
+    modulemd_defaults_get_instance_private (self);
+
+  if (priv->frozen)
+    return;
+
+  /* Cache everything that readers would otherwise write */
+  modulemd_defaults_get_fingerprint (self);
+  if (MODULEMD_IS_DEFAULTS_V1 (self))
+    modulemd_defaults_v1_sort_collections (MODULEMD_DEFAULTS_V1 (self));
+
+  priv->frozen = TRUE;
+}
+
+
+gboolean
+modulemd_defaults_is_frozen (ModulemdDefaults *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEFAULTS (self), FALSE);
+
+  ModulemdDefaultsPrivate *priv =
+    modulemd_defaults_get_instance_private (self);
+
+  return priv->frozen;
+}
@@ -34,6 +34,14 @@ struct _ModulemdDependencies
    * @value: #GHashTable set of compatible streams
    */
   GHashTable *runtime_deps;
+
+  /* The lists returned by the peek functions, keyed by the tables above and
+   * the sets of streams in them. Dropped whenever any of those changes.
+   */
+  GHashTable *sorted_keys;
+
+  /* The stream these dependencies belong to, if any */
+  ModulemdOwner *owner;
 };
 
 G_DEFINE_TYPE (ModulemdDependencies, modulemd_dependencies, G_TYPE_OBJECT)
@@ -80,10 +88,12 @@ modulemd_dependencies_copy (ModulemdDependencies *self)
 
   d = modulemd_dependencies_new ();
 
+  /* Shared tables would change the sorted lists cached on the other object */
   g_hash_table_unref (d->buildtime_deps);
-  d->buildtime_deps = g_hash_table_ref (self->buildtime_deps);
+  d->buildtime_deps =
+    modulemd_hash_table_deep_str_set_copy (self->buildtime_deps);
   g_hash_table_unref (d->runtime_deps);
-  d->runtime_deps = g_hash_table_ref (self->runtime_deps);
+  d->runtime_deps = modulemd_hash_table_deep_str_set_copy (self->runtime_deps);
 
   return g_steal_pointer (&d);
 }
@@ -96,6 +106,8 @@ modulemd_dependencies_finalize (GObject *object)
 
   g_clear_pointer (&self->buildtime_deps, g_hash_table_unref);
   g_clear_pointer (&self->runtime_deps, g_hash_table_unref);
+  g_clear_pointer (&self->sorted_keys, g_hash_table_unref);
+  g_clear_pointer (&self->owner, modulemd_owner_unref);
 
   G_OBJECT_CLASS (modulemd_dependencies_parent_class)->finalize (object);
 }
@@ -149,6 +161,21 @@ modulemd_dependencies_nested_table_values_as_strv (GHashTable *table,
 }
 
 
+static const gchar *const *
+modulemd_dependencies_nested_table_peek_values (ModulemdDependencies *self,
+                                                GHashTable *table,
+                                                const gchar *key)
+{
+  GHashTable *inner = g_hash_table_lookup (table, key);
+  if (inner == NULL)
+    {
+      g_warning ("Streams requested for unknown module: %s", key);
+      return NULL;
+    }
+  return modulemd_sorted_keys_peek (&self->sorted_keys, inner);
+}
+
+
 void
 modulemd_dependencies_add_buildtime_stream (ModulemdDependencies *self,
                                             const gchar *module_name,
@@ -157,6 +184,9 @@ modulemd_dependencies_add_buildtime_stream (ModulemdDependencies *self,
   g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
   g_return_if_fail (module_name);
   g_return_if_fail (module_stream);
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  modulemd_sorted_keys_clear (self->sorted_keys);
   modulemd_dependencies_nested_table_add (
     self->buildtime_deps, module_name, module_stream);
 }
@@ -168,6 +198,9 @@ modulemd_dependencies_set_empty_buildtime_dependencies_for_module (
 {
   g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
   g_return_if_fail (module_name);
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  modulemd_sorted_keys_clear (self->sorted_keys);
   modulemd_dependencies_nested_table_add (
     self->buildtime_deps, module_name, NULL);
 }
@@ -177,6 +210,9 @@ void
 modulemd_dependencies_clear_buildtime_dependencies (ModulemdDependencies *self)
 {
   g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  modulemd_sorted_keys_clear (self->sorted_keys);
   g_hash_table_remove_all (self->buildtime_deps);
 }
 
@@ -190,6 +226,14 @@ modulemd_dependencies_get_buildtime_modules_as_strv (
 }
 
 
+const gchar *const *
+modulemd_dependencies_peek_buildtime_modules (ModulemdDependencies *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEPENDENCIES (self), NULL);
+  return modulemd_sorted_keys_peek (&self->sorted_keys, self->buildtime_deps);
+}
+
+
 GStrv
 modulemd_dependencies_get_buildtime_streams_as_strv (
   ModulemdDependencies *self, const gchar *module)
@@ -200,6 +244,16 @@ modulemd_dependencies_get_buildtime_streams_as_strv (
 }
 
 
+const gchar *const *
+modulemd_dependencies_peek_buildtime_streams (ModulemdDependencies *self,
+                                              const gchar *module)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEPENDENCIES (self), NULL);
+  return modulemd_dependencies_nested_table_peek_values (
+    self, self->buildtime_deps, module);
+}
+
+
 void
 modulemd_dependencies_add_runtime_stream (ModulemdDependencies *self,
                                           const gchar *module_name,
@@ -208,6 +262,9 @@ modulemd_dependencies_add_runtime_stream (ModulemdDependencies *self,
   g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
   g_return_if_fail (module_name);
   g_return_if_fail (module_stream);
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  modulemd_sorted_keys_clear (self->sorted_keys);
   modulemd_dependencies_nested_table_add (
     self->runtime_deps, module_name, module_stream);
 }
@@ -219,6 +276,9 @@ modulemd_dependencies_set_empty_runtime_dependencies_for_module (
 {
   g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
   g_return_if_fail (module_name);
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  modulemd_sorted_keys_clear (self->sorted_keys);
   modulemd_dependencies_nested_table_add (
     self->runtime_deps, module_name, NULL);
 }
@@ -228,6 +288,9 @@ void
 modulemd_dependencies_clear_runtime_dependencies (ModulemdDependencies *self)
 {
   g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  modulemd_sorted_keys_clear (self->sorted_keys);
   g_hash_table_remove_all (self->runtime_deps);
 }
 
@@ -240,6 +303,14 @@ modulemd_dependencies_get_runtime_modules_as_strv (ModulemdDependencies *self)
 }
 
 
+const gchar *const *
+modulemd_dependencies_peek_runtime_modules (ModulemdDependencies *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEPENDENCIES (self), NULL);
+  return modulemd_sorted_keys_peek (&self->sorted_keys, self->runtime_deps);
+}
+
+
 GStrv
 modulemd_dependencies_get_runtime_streams_as_strv (ModulemdDependencies *self,
                                                    const gchar *module)
@@ -250,6 +321,16 @@ modulemd_dependencies_get_runtime_streams_as_strv (ModulemdDependencies *self,
 }
 
 
+const gchar *const *
+modulemd_dependencies_peek_runtime_streams (ModulemdDependencies *self,
+                                            const gchar *module)
+{
+  g_return_val_if_fail (MODULEMD_IS_DEPENDENCIES (self), NULL);
+  return modulemd_dependencies_nested_table_peek_values (
+    self, self->runtime_deps, module);
+}
+
+
 static gboolean
 modulemd_dependencies_validate_deps (GHashTable *deps, GError **error)
 {
@@ -735,3 +816,60 @@ modulemd_dependencies_buildrequires_module_and_stream (
   return requires_module_and_stream (
     self->buildtime_deps, module_name, stream_name);
 }
+
+
+guint64
+modulemd_dependencies_fingerprint (ModulemdDependencies *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_DEPENDENCIES (self), 0);
+
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint,
+    modulemd_fingerprint_hash_table (self->buildtime_deps,
+                                     modulemd_fingerprint_set));
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint,
+    modulemd_fingerprint_hash_table (self->runtime_deps,
+                                     modulemd_fingerprint_set));
+
+  return fingerprint;
+}
+
+
+static void
+sort_nested_table (ModulemdDependencies *self, GHashTable *table)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  modulemd_sorted_keys_peek (&self->sorted_keys, table);
+
+  g_hash_table_iter_init (&iter, table);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    modulemd_sorted_keys_peek (&self->sorted_keys, value);
+}
+
+
+void
+modulemd_dependencies_set_owner (ModulemdDependencies *self,
+                                 ModulemdOwner *owner)
+{
+  g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
+
+  modulemd_owner_replace (&self->owner, owner);
+}
+
+
+void
+modulemd_dependencies_sort_collections (ModulemdDependencies *self)
+{
+  g_return_if_fail (MODULEMD_IS_DEPENDENCIES (self));
+
+  sort_nested_table (self, self->buildtime_deps);
+  sort_nested_table (self, self->runtime_deps);
+}
@@ -0,0 +1,581 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include "modulemd-defaults.h"
+#include "modulemd-index-diff.h"
+#include "modulemd-module-index.h"
+#include "modulemd-module-stream.h"
+#include "modulemd-translation.h"
+#include "private/modulemd-defaults-private.h"
+#include "private/modulemd-index-diff-private.h"
+#include "private/modulemd-module-stream-private.h"
+#include "private/modulemd-translation-private.h"
+#include "private/modulemd-util.h"
+
+
+/* The differences for one type of document */
+typedef struct
+{
+  GPtrArray *added;
+  GPtrArray *removed;
+  GPtrArray *changed;
+
+  /* @key: The identifier of a changed document
+   * @value: A #GStrv of the names of its changed fields
+   */
+  GHashTable *changed_fields;
+} DocumentChanges;
+
+struct _ModulemdIndexDiff
+{
+  GObject parent_instance;
+
+  DocumentChanges streams;
+  DocumentChanges defaults;
+  DocumentChanges translations;
+};
+
+G_DEFINE_TYPE (ModulemdIndexDiff, modulemd_index_diff, G_TYPE_OBJECT)
+
+
+typedef void (*FingerprintFieldsFunc) (gpointer document,
+                                       ModulemdFingerprintFieldFunc func,
+                                       gpointer user_data);
+
+typedef struct
+{
+  gchar *name;
+  guint64 fingerprint;
+} FieldFingerprint;
+
+
+static void
+document_changes_init (DocumentChanges *changes)
+{
+  changes->added = g_ptr_array_new_with_free_func (g_object_unref);
+  changes->removed = g_ptr_array_new_with_free_func (g_object_unref);
+  changes->changed = g_ptr_array_new_with_free_func (g_object_unref);
+  changes->changed_fields = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_strfreev);
+}
+
+
+static void
+document_changes_clear (DocumentChanges *changes)
+{
+  g_clear_pointer (&changes->added, g_ptr_array_unref);
+  g_clear_pointer (&changes->removed, g_ptr_array_unref);
+  g_clear_pointer (&changes->changed, g_ptr_array_unref);
+  g_clear_pointer (&changes->changed_fields, g_hash_table_unref);
+}
+
+
+static gboolean
+document_changes_is_empty (DocumentChanges *changes)
+{
+  return changes->added->len == 0 && changes->removed->len == 0 &&
+         changes->changed->len == 0;
+}
+
+
+static void
+field_fingerprint_clear (gpointer data)
+{
+  g_free (((FieldFingerprint *)data)->name);
+}
+
+
+static void
+collect_field_fingerprint (const gchar *field,
+                           guint64 fingerprint,
+                           gpointer user_data)
+{
+  GArray *fields = (GArray *)user_data;
+  FieldFingerprint entry = { g_strdup (field), fingerprint };
+
+  g_array_append_val (fields, entry);
+}
+
+
+static GArray *
+get_field_fingerprints (gpointer document, FingerprintFieldsFunc fields_func)
+{
+  GArray *fields = g_array_new (FALSE, FALSE, sizeof (FieldFingerprint));
+
+  g_array_set_clear_func (fields, field_fingerprint_clear);
+  fields_func (document, collect_field_fingerprint, fields);
+
+  return fields;
+}
+
+
+static FieldFingerprint *
+find_field (GArray *fields, const gchar *name)
+{
+  FieldFingerprint *field = NULL;
+
+  /* Documents only have a few dozen fields, in the same order on both sides */
+  for (guint i = 0; i < fields->len; i++)
+    {
+      field = &g_array_index (fields, FieldFingerprint, i);
+      if (g_str_equal (field->name, name))
+        return field;
+    }
+
+  return NULL;
+}
+
+
+/* Records @to as changed from @from, along with the fields that differ. Does
+ * nothing if they have the same content.
+ */
+static void
+compare_documents (DocumentChanges *changes,
+                   const gchar *id,
+                   gpointer from,
+                   gpointer to,
+                   guint64 from_fingerprint,
+                   guint64 to_fingerprint,
+                   FingerprintFieldsFunc fields_func)
+{
+  g_autoptr (GArray) from_fields = NULL;
+  g_autoptr (GArray) to_fields = NULL;
+  g_autoptr (GPtrArray) changed = NULL;
+  FieldFingerprint *field = NULL;
+  FieldFingerprint *other = NULL;
+
+  if (from_fingerprint == to_fingerprint)
+    return;
+
+  from_fields = get_field_fingerprints (from, fields_func);
+  to_fields = get_field_fingerprints (to, fields_func);
+  changed = g_ptr_array_new ();
+
+  for (guint i = 0; i < to_fields->len; i++)
+    {
+      field = &g_array_index (to_fields, FieldFingerprint, i);
+      other = find_field (from_fields, field->name);
+      if (!other || other->fingerprint != field->fingerprint)
+        g_ptr_array_add (changed, g_strdup (field->name));
+    }
+
+  for (guint i = 0; i < from_fields->len; i++)
+    {
+      field = &g_array_index (from_fields, FieldFingerprint, i);
+      if (!find_field (to_fields, field->name))
+        g_ptr_array_add (changed, g_strdup (field->name));
+    }
+
+  g_ptr_array_add (changed, NULL);
+
+  g_ptr_array_add (changes->changed, g_object_ref (to));
+  g_hash_table_replace (changes->changed_fields,
+                        g_strdup (id),
+                        g_ptr_array_free (g_steal_pointer (&changed), FALSE));
+}
+
+
+static void
+diff_streams (ModulemdIndexDiff *self,
+              ModulemdModule *from_module,
+              ModulemdModule *to_module)
+{
+  g_autoptr (GHashTable) from_streams = NULL;
+  GPtrArray *streams = NULL;
+  ModulemdModuleStream *stream = NULL;
+  ModulemdModuleStream *previous = NULL;
+  gchar *nsvca = NULL;
+
+  /* @key: NSVCA
+   * @value: A stream of @from_module not yet found in @to_module
+   */
+  from_streams = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  if (from_module)
+    {
+      streams = modulemd_module_get_all_streams (from_module);
+      for (guint i = 0; i < streams->len; i++)
+        {
+          stream = g_ptr_array_index (streams, i);
+          g_hash_table_replace (from_streams,
+                                modulemd_module_stream_get_NSVCA_as_string (
+                                  stream),
+                                stream);
+        }
+    }
+
+  if (to_module)
+    {
+      streams = modulemd_module_get_all_streams (to_module);
+      for (guint i = 0; i < streams->len; i++)
+        {
+          stream = g_ptr_array_index (streams, i);
+          nsvca = modulemd_module_stream_get_NSVCA_as_string (stream);
+
+          previous = g_hash_table_lookup (from_streams, nsvca);
+          if (!previous)
+            {
+              g_ptr_array_add (self->streams.added, g_object_ref (stream));
+              g_free (nsvca);
+              continue;
+            }
+
+          /* Stream fingerprints are cached, so unchanged streams cost a
+           * lookup and a comparison once they have been computed.
+           */
+          compare_documents (
+            &self->streams,
+            nsvca,
+            previous,
+            stream,
+            modulemd_module_stream_get_fingerprint (previous),
+            modulemd_module_stream_get_fingerprint (stream),
+            (FingerprintFieldsFunc)modulemd_module_stream_fingerprint_fields);
+
+          g_hash_table_remove (from_streams, nsvca);
+          g_free (nsvca);
+        }
+    }
+
+  if (!from_module || g_hash_table_size (from_streams) == 0)
+    return;
+
+  /* Report the removed streams in the order of @from_module */
+  streams = modulemd_module_get_all_streams (from_module);
+  for (guint i = 0; i < streams->len; i++)
+    {
+      stream = g_ptr_array_index (streams, i);
+      nsvca = modulemd_module_stream_get_NSVCA_as_string (stream);
+      if (g_hash_table_contains (from_streams, nsvca))
+        g_ptr_array_add (self->streams.removed, g_object_ref (stream));
+      g_free (nsvca);
+    }
+}
+
+
+static void
+diff_defaults (ModulemdIndexDiff *self,
+               ModulemdModule *from_module,
+               ModulemdModule *to_module)
+{
+  ModulemdDefaults *from = NULL;
+  ModulemdDefaults *to = NULL;
+
+  if (from_module)
+    from = modulemd_module_get_defaults (from_module);
+  if (to_module)
+    to = modulemd_module_get_defaults (to_module);
+
+  if (!from && !to)
+    return;
+
+  if (!from)
+    {
+      g_ptr_array_add (self->defaults.added, g_object_ref (to));
+      return;
+    }
+
+  if (!to)
+    {
+      g_ptr_array_add (self->defaults.removed, g_object_ref (from));
+      return;
+    }
+
+  compare_documents (
+    &self->defaults,
+    modulemd_defaults_get_module_name (to),
+    from,
+    to,
+    modulemd_defaults_get_fingerprint (from),
+    modulemd_defaults_get_fingerprint (to),
+    (FingerprintFieldsFunc)modulemd_defaults_fingerprint_fields);
+}
+
+
+static gchar *
+translation_id (const gchar *module_name, const gchar *module_stream)
+{
+  return g_strdup_printf ("%s:%s", module_name, module_stream);
+}
+
+
+static void
+diff_translations (ModulemdIndexDiff *self,
+                   ModulemdModule *from_module,
+                   ModulemdModule *to_module)
+{
+  g_auto (GStrv) stream_names = NULL;
+  g_autofree gchar *id = NULL;
+  ModulemdTranslation *from = NULL;
+  ModulemdTranslation *to = NULL;
+
+  if (to_module)
+    {
+      stream_names = modulemd_module_get_translated_streams (to_module);
+      for (guint i = 0; stream_names[i]; i++)
+        {
+          to = modulemd_module_get_translation (to_module, stream_names[i]);
+          from = from_module ? modulemd_module_get_translation (
+                                 from_module, stream_names[i]) :
+                               NULL;
+          if (!from)
+            {
+              g_ptr_array_add (self->translations.added, g_object_ref (to));
+              continue;
+            }
+
+          g_clear_pointer (&id, g_free);
+          id = translation_id (modulemd_module_get_module_name (to_module),
+                               stream_names[i]);
+          compare_documents (
+            &self->translations,
+            id,
+            from,
+            to,
+            modulemd_translation_get_fingerprint (from),
+            modulemd_translation_get_fingerprint (to),
+            (FingerprintFieldsFunc)modulemd_translation_fingerprint_fields);
+        }
+      g_clear_pointer (&stream_names, g_strfreev);
+    }
+
+  if (!from_module)
+    return;
+
+  stream_names = modulemd_module_get_translated_streams (from_module);
+  for (guint i = 0; stream_names[i]; i++)
+    {
+      if (to_module &&
+          modulemd_module_get_translation (to_module, stream_names[i]))
+        continue;
+
+      from = modulemd_module_get_translation (from_module, stream_names[i]);
+      g_ptr_array_add (self->translations.removed, g_object_ref (from));
+    }
+}
+
+
+static void
+diff_modules (ModulemdIndexDiff *self,
+              ModulemdModule *from_module,
+              ModulemdModule *to_module)
+{
+  diff_streams (self, from_module, to_module);
+  diff_defaults (self, from_module, to_module);
+  diff_translations (self, from_module, to_module);
+}
+
+
+ModulemdIndexDiff *
+modulemd_index_diff_new (ModulemdModuleIndex *from, ModulemdModuleIndex *to)
+{
+  MODULEMD_INIT_TRACE ();
+  g_autoptr (ModulemdIndexDiff) self = NULL;
+  g_auto (GStrv) module_names = NULL;
+  ModulemdModule *from_module = NULL;
+  ModulemdModule *to_module = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (from), NULL);
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (to), NULL);
+
+  self = g_object_new (MODULEMD_TYPE_INDEX_DIFF, NULL);
+
+  module_names = modulemd_module_index_get_module_names_as_strv (to);
+  for (guint i = 0; module_names[i]; i++)
+    {
+      from_module = modulemd_module_index_get_module (from, module_names[i]);
+      to_module = modulemd_module_index_get_module (to, module_names[i]);
+      diff_modules (self, from_module, to_module);
+    }
+  g_clear_pointer (&module_names, g_strfreev);
+
+  /* Then the modules that are gone altogether */
+  module_names = modulemd_module_index_get_module_names_as_strv (from);
+  for (guint i = 0; module_names[i]; i++)
+    {
+      if (modulemd_module_index_get_module (to, module_names[i]))
+        continue;
+
+      from_module = modulemd_module_index_get_module (from, module_names[i]);
+      diff_modules (self, from_module, NULL);
+    }
+
+  return g_steal_pointer (&self);
+}
+
+
+static void
+modulemd_index_diff_finalize (GObject *object)
+{
+  ModulemdIndexDiff *self = (ModulemdIndexDiff *)object;
+
+  document_changes_clear (&self->streams);
+  document_changes_clear (&self->defaults);
+  document_changes_clear (&self->translations);
+
+  G_OBJECT_CLASS (modulemd_index_diff_parent_class)->finalize (object);
+}
+
+
+static void
+modulemd_index_diff_class_init (ModulemdIndexDiffClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = modulemd_index_diff_finalize;
+}
+
+
+static void
+modulemd_index_diff_init (ModulemdIndexDiff *self)
+{
+  document_changes_init (&self->streams);
+  document_changes_init (&self->defaults);
+  document_changes_init (&self->translations);
+}
+
+
+gboolean
+modulemd_index_diff_is_empty (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), FALSE);
+
+  return document_changes_is_empty (&self->streams) &&
+         document_changes_is_empty (&self->defaults) &&
+         document_changes_is_empty (&self->translations);
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_added_streams (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->streams.added;
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_removed_streams (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->streams.removed;
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_changed_streams (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->streams.changed;
+}
+
+
+GStrv
+modulemd_index_diff_get_changed_stream_fields_as_strv (
+  ModulemdIndexDiff *self, const gchar *nsvca)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+  g_return_val_if_fail (nsvca, NULL);
+
+  return g_strdupv (
+    g_hash_table_lookup (self->streams.changed_fields, nsvca));
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_added_defaults (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->defaults.added;
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_removed_defaults (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->defaults.removed;
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_changed_defaults (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->defaults.changed;
+}
+
+
+GStrv
+modulemd_index_diff_get_changed_defaults_fields_as_strv (
+  ModulemdIndexDiff *self, const gchar *module_name)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+  g_return_val_if_fail (module_name, NULL);
+
+  return g_strdupv (
+    g_hash_table_lookup (self->defaults.changed_fields, module_name));
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_added_translations (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->translations.added;
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_removed_translations (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->translations.removed;
+}
+
+
+GPtrArray *
+modulemd_index_diff_get_changed_translations (ModulemdIndexDiff *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+
+  return self->translations.changed;
+}
+
+
+GStrv
+modulemd_index_diff_get_changed_translation_fields_as_strv (
+  ModulemdIndexDiff *self,
+  const gchar *module_name,
+  const gchar *module_stream)
+{
+  g_autofree gchar *id = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_INDEX_DIFF (self), NULL);
+  g_return_val_if_fail (module_name, NULL);
+  g_return_val_if_fail (module_stream, NULL);
+
+  id = translation_id (module_name, module_stream);
+
+  return g_strdupv (
+    g_hash_table_lookup (self->translations.changed_fields, id));
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include "modulemd-index-snapshot.h"
+#include "modulemd-module-index.h"
+
+
+struct _ModulemdIndexSnapshot
+{
+  GObject parent_instance;
+
+  /* The current version. Only read and written with atomic operations. */
+  ModulemdModuleIndex *index;
+
+  /* Readers announce themselves in one of two counters while they load and
+   * reference @index, picking the counter from the low bit of @phase. A
+   * writer that replaced @index flips @phase twice and waits for each
+   * counter in turn to drain: once both have been empty, no reader can still
+   * be about to take a reference on the previous version. New readers go to
+   * the other counter, so a steady stream of them cannot hold up the writer.
+   */
+  gint phase;
+  gint readers[2];
+
+  /* Serializes writers */
+  GMutex publish_lock;
+  gint generation;
+};
+
+G_DEFINE_TYPE (ModulemdIndexSnapshot, modulemd_index_snapshot, G_TYPE_OBJECT)
+
+
+ModulemdIndexSnapshot *
+modulemd_index_snapshot_new (ModulemdModuleIndex *index)
+{
+  ModulemdIndexSnapshot *self = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (index), NULL);
+
+  self = g_object_new (MODULEMD_TYPE_INDEX_SNAPSHOT, NULL);
+
+  modulemd_module_index_freeze (index);
+  self->index = g_object_ref (index);
+
+  return self;
+}
+
+
+static void
+modulemd_index_snapshot_finalize (GObject *object)
+{
+  ModulemdIndexSnapshot *self = (ModulemdIndexSnapshot *)object;
+
+  g_clear_object (&self->index);
+  g_mutex_clear (&self->publish_lock);
+
+  G_OBJECT_CLASS (modulemd_index_snapshot_parent_class)->finalize (object);
+}
+
+
+static void
+modulemd_index_snapshot_class_init (ModulemdIndexSnapshotClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = modulemd_index_snapshot_finalize;
+}
+
+
+static void
+modulemd_index_snapshot_init (ModulemdIndexSnapshot *self)
+{
+  g_mutex_init (&self->publish_lock);
+}
+
+
+ModulemdModuleIndex *
+modulemd_index_snapshot_acquire (ModulemdIndexSnapshot *self)
+{
+  ModulemdModuleIndex *index = NULL;
+  guint phase;
+
+  g_return_val_if_fail (MODULEMD_IS_INDEX_SNAPSHOT (self), NULL);
+
+  phase = (guint)g_atomic_int_get (&self->phase) & 1;
+  g_atomic_int_inc (&self->readers[phase]);
+
+  index = g_object_ref (g_atomic_pointer_get (&self->index));
+
+  g_atomic_int_add (&self->readers[phase], -1);
+
+  return index;
+}
+
+
+static void
+wait_for_readers (ModulemdIndexSnapshot *self)
+{
+  guint phase;
+
+  for (guint i = 0; i < 2; i++)
+    {
+      phase = (guint)g_atomic_int_add (&self->phase, 1) & 1;
+      while (g_atomic_int_get (&self->readers[phase]) != 0)
+        g_thread_yield ();
+    }
+}
+
+
+void
+modulemd_index_snapshot_publish (ModulemdIndexSnapshot *self,
+                                 ModulemdModuleIndex *index)
+{
+  g_autoptr (ModulemdModuleIndex) previous = NULL;
+
+  g_return_if_fail (MODULEMD_IS_INDEX_SNAPSHOT (self));
+  g_return_if_fail (MODULEMD_IS_MODULE_INDEX (index));
+
+  g_mutex_lock (&self->publish_lock);
+
+  modulemd_module_index_freeze (index);
+
+  /* Only writers change the pointer, and they hold the lock */
+  previous = self->index;
+  g_atomic_pointer_set (&self->index, g_object_ref (index));
+  g_atomic_int_inc (&self->generation);
+
+  wait_for_readers (self);
+
+  g_mutex_unlock (&self->publish_lock);
+
+  /* Readers that took their own reference keep the previous version alive
+   * until they are done with it.
+   */
+}
+
+
+guint
+modulemd_index_snapshot_get_generation (ModulemdIndexSnapshot *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_INDEX_SNAPSHOT (self), 0);
+
+  return (guint)g_atomic_int_get (&self->generation);
+}
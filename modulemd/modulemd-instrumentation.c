@@ -0,0 +1,142 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include "modulemd-instrumentation.h"
+
+#include "private/modulemd-util.h"
+
+
+gint modulemd_instrumentation_flags = 0;
+
+typedef struct
+{
+  guint64 calls;
+  guint64 time;
+} PhaseCounter;
+
+/* The counters are only touched while phase timing is enabled, so a plain
+ * lock is cheaper overall than 64-bit atomics, which GLib does not provide
+ * portably.
+ */
+G_LOCK_DEFINE_STATIC (phase_counters);
+static PhaseCounter phase_counters[MODULEMD_PHASE_SENTINEL];
+
+
+static void
+set_instrumentation_flag (gint flag, gboolean enabled)
+{
+  guint *flags = (guint *)&modulemd_instrumentation_flags;
+
+  if (enabled)
+    g_atomic_int_or (flags, (guint)flag);
+  else
+    g_atomic_int_and (flags, ~(guint)flag);
+}
+
+
+void
+modulemd_set_tracing_enabled (gboolean enabled)
+{
+  set_instrumentation_flag (MODULEMD_INSTRUMENT_TRACE, enabled);
+}
+
+
+gboolean
+modulemd_get_tracing_enabled (void)
+{
+  return modulemd_instrumentation_enabled (MODULEMD_INSTRUMENT_TRACE);
+}
+
+
+void
+modulemd_set_phase_timing_enabled (gboolean enabled)
+{
+  set_instrumentation_flag (MODULEMD_INSTRUMENT_TIMING, enabled);
+}
+
+
+gboolean
+modulemd_get_phase_timing_enabled (void)
+{
+  return modulemd_instrumentation_enabled (MODULEMD_INSTRUMENT_TIMING);
+}
+
+
+guint64
+modulemd_get_phase_calls (ModulemdPhaseEnum phase)
+{
+  guint64 calls;
+
+  g_return_val_if_fail (phase < MODULEMD_PHASE_SENTINEL, 0);
+
+  G_LOCK (phase_counters);
+  calls = phase_counters[phase].calls;
+  G_UNLOCK (phase_counters);
+
+  return calls;
+}
+
+
+guint64
+modulemd_get_phase_time (ModulemdPhaseEnum phase)
+{
+  guint64 time;
+
+  g_return_val_if_fail (phase < MODULEMD_PHASE_SENTINEL, 0);
+
+  G_LOCK (phase_counters);
+  time = phase_counters[phase].time;
+  G_UNLOCK (phase_counters);
+
+  return time;
+}
+
+
+void
+modulemd_reset_phase_timings (void)
+{
+  G_LOCK (phase_counters);
+  memset (phase_counters, 0, sizeof (phase_counters));
+  G_UNLOCK (phase_counters);
+}
+
+
+void
+modulemd_trace_enter (const gchar *function_name)
+{
+  g_debug ("TRACE: Entering %s", function_name);
+}
+
+
+void
+modulemd_trace_exit (const gchar *function_name)
+{
+  g_debug ("TRACE: Exiting %s", function_name);
+}
+
+
+void
+modulemd_phase_timer_record (ModulemdPhaseEnum phase, gint64 start)
+{
+  gint64 elapsed = g_get_monotonic_time () - start;
+
+  g_return_if_fail (phase < MODULEMD_PHASE_SENTINEL);
+
+  G_LOCK (phase_counters);
+  phase_counters[phase].calls++;
+  phase_counters[phase].time += MAX (elapsed, 0);
+  G_UNLOCK (phase_counters);
+}
@@ -178,17 +178,30 @@ ModulemdModuleIndex *
 modulemd_module_index_merger_resolve_ext (ModulemdModuleIndexMerger *self,
                                           gboolean strict_default_streams,
                                           GError **error)
+{
+  return modulemd_module_index_merger_resolve_with_conflicts (
+    self, strict_default_streams, NULL, error);
+}
+
+
+ModulemdModuleIndex *
+modulemd_module_index_merger_resolve_with_conflicts (
+  ModulemdModuleIndexMerger *self,
+  gboolean strict_default_streams,
+  GPtrArray **conflicts,
+  GError **error)
 {
   MODULEMD_INIT_TRACE ();
-  g_autoptr (ModulemdModuleIndex) thislevel = NULL;
   g_autoptr (ModulemdModuleIndex) final = NULL;
+  g_autoptr (GPtrArray) found_conflicts = NULL;
   g_autoptr (GError) nested_error = NULL;
-  GPtrArray *indexes = NULL;
   MergerPriorities *priority_level;
 
   g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX_MERGER (self), NULL);
 
   final = modulemd_module_index_new ();
+  if (conflicts)
+    found_conflicts = g_ptr_array_new_with_free_func (g_object_unref);
 
   for (guint i = 0; i < self->priority_levels->len; i++)
     {
@@ -196,36 +209,24 @@ modulemd_module_index_merger_resolve_ext (ModulemdModuleIndexMerger *self,
       g_debug ("Handling Priority Level: %" G_GINT32_FORMAT,
                priority_level->priority);
 
-      /* At each level, process through the attached ModuleIndex objects and
-       * merge them together, then into the lower levels.
+      /* At each level, merge all of the attached ModuleIndex objects together
+       * in a single pass, then over the lower levels with override=True.
        */
-      thislevel = modulemd_module_index_new ();
-      indexes = priority_level->index_array;
-
-      for (guint j = 0; j < indexes->len; j++)
-        {
-          /* Merge each ModuleIndex at this priority level into 'thislevel' */
-          if (!modulemd_module_index_merge (g_ptr_array_index (indexes, j),
-                                            thislevel,
-                                            FALSE,
+      if (!modulemd_module_index_merge_all (priority_level->index_array,
+                                            final,
+                                            TRUE,
                                             strict_default_streams,
+                                            found_conflicts,
                                             &nested_error))
-            {
-              g_propagate_error (error, g_steal_pointer (&nested_error));
-              return NULL;
-            }
-        }
-
-
-      /* Merge 'thislevel' into 'final' with override=True */
-      if (!modulemd_module_index_merge (
-            thislevel, final, TRUE, strict_default_streams, &nested_error))
         {
+          if (conflicts)
+            *conflicts = g_steal_pointer (&found_conflicts);
           g_propagate_error (error, g_steal_pointer (&nested_error));
           return NULL;
         }
-
-      g_clear_object (&thislevel);
     }
+
+  if (conflicts)
+    *conflicts = g_steal_pointer (&found_conflicts);
   return g_steal_pointer (&final);
 }
@@ -15,6 +15,7 @@
 #include <glib.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 #include <yaml.h>
 
 #ifdef HAVE_RPMIO
@@ -23,6 +24,7 @@
 
 #include "modulemd-errors.h"
 #include "modulemd-compression.h"
+#include "modulemd-defaults-conflict.h"
 #include "modulemd-module-index.h"
 #include "modulemd-subdocument-info.h"
 #include "private/glib-extensions.h"
@@ -30,6 +32,7 @@
 #include "private/modulemd-compression-private.h"
 #include "private/modulemd-defaults-private.h"
 #include "private/modulemd-defaults-v1-private.h"
+#include "private/modulemd-index-diff-private.h"
 #include "private/modulemd-subdocument-info-private.h"
 #include "private/modulemd-module-index-private.h"
 #include "private/modulemd-module-stream-private.h"
@@ -43,14 +46,101 @@
 #define MMD_YAML_SUFFIX ".yaml"
 
 
+/* Statistics collected by an index when its collect_stats is TRUE. Times are
+ * in microseconds. See modulemd_module_index_get_stats() for their meaning.
+ */
+typedef enum
+{
+  INDEX_STAT_BYTES_READ,
+  INDEX_STAT_DOCUMENTS_MODULESTREAM,
+  INDEX_STAT_DOCUMENTS_DEFAULTS,
+  INDEX_STAT_DOCUMENTS_TRANSLATIONS,
+  INDEX_STAT_FAILURES,
+  INDEX_STAT_STREAMS_ADDED,
+  INDEX_STAT_TIME_DETECT_COMPRESSION,
+  INDEX_STAT_TIME_UPDATE_FROM_FILE,
+  INDEX_STAT_TIME_UPDATE_FROM_PARSER,
+  INDEX_STAT_TIME_PARSE_DOCUMENTS,
+  INDEX_STAT_TIME_MERGE,
+  INDEX_STAT_TIME_DUMP,
+  INDEX_STAT_COUNT
+} IndexStat;
+
+static const gchar *const index_stat_names[INDEX_STAT_COUNT] = {
+  "bytes-read",
+  "documents-modulemd",
+  "documents-modulemd-defaults",
+  "documents-modulemd-translations",
+  "failures",
+  "streams-added",
+  "time-detect-compression",
+  "time-update-from-file",
+  "time-update-from-parser",
+  "time-parse-documents",
+  "time-merge",
+  "time-dump",
+};
+
+
 struct _ModulemdModuleIndex
 {
   GObject parent_instance;
 
   GHashTable *modules;
 
+  /* Cached module name -> default stream views, built on demand by
+   * modulemd_module_index_peek_default_streams() and dropped whenever
+   * defaults are added to or removed from the index. The defaults it holds
+   * can also be modified through its modules, so the views are dropped as
+   * well once modulemd_defaults_get_generation() moves past
+   * @defaults_generation. A frozen index builds every view up front and
+   * keeps them for good.
+   *
+   * @default_streams: The view for the NULL (generic) intent.
+   * @intent_default_streams: @key: intent name, @value: #GHashTable view for
+   * that intent.
+   * @defaults_generation: The defaults generation the views were built at.
+   */
+  GHashTable *default_streams;
+  GHashTable *intent_default_streams;
+  guint defaults_generation;
+
+  /* Inverted views of the rpm_artifacts and rpm_artifact_map of every
+   * stream, built on demand by the modulemd_module_index_search_streams_by_*()
+   * functions and kept up to date as streams are added and modules removed.
+   *
+   * @artifact_streams: @key: NEVRA, @value: #GPtrArray of the
+   * #ModulemdModuleStream objects listing that artifact.
+   * @package_streams: @key: package name, @value: #GPtrArray of the
+   * #ModulemdModuleStream objects listing any artifact of that package.
+   * @checksum_streams: @key: digest, @value: #GHashTable with @key: checksum,
+   * @value: #ChecksumStreams.
+   */
+  GHashTable *artifact_streams;
+  GHashTable *package_streams;
+  GHashTable *checksum_streams;
+
   ModulemdDefaultsVersionEnum defaults_mdversion;
   ModulemdModuleStreamVersionEnum stream_mdversion;
+
+  /* Revalidate every stream on dump, even unmodified ones */
+  gboolean force_validation;
+
+  /* Keep the YAML of each stream read, to write unmodified ones back out */
+  gboolean passthrough;
+
+  /* Set by modulemd_module_index_freeze(). From then on nothing above
+   * changes, so readers on any number of threads need no locking.
+   *
+   * @module_names: The sorted module names, in the order they are dumped in.
+   */
+  gboolean frozen;
+  GPtrArray *module_names;
+
+  gboolean collect_stats;
+  /* Protects stats, which may be updated by concurrent dumps */
+  GMutex stats_lock;
+  guint64 stats[INDEX_STAT_COUNT];
 };
 
 G_DEFINE_TYPE (ModulemdModuleIndex, modulemd_module_index, G_TYPE_OBJECT)
@@ -69,6 +159,13 @@ modulemd_module_index_finalize (GObject *object)
   ModulemdModuleIndex *self = (ModulemdModuleIndex *)object;
 
   g_clear_pointer (&self->modules, g_hash_table_unref);
+  g_clear_pointer (&self->default_streams, g_hash_table_unref);
+  g_clear_pointer (&self->intent_default_streams, g_hash_table_unref);
+  g_clear_pointer (&self->artifact_streams, g_hash_table_unref);
+  g_clear_pointer (&self->package_streams, g_hash_table_unref);
+  g_clear_pointer (&self->checksum_streams, g_hash_table_unref);
+  g_clear_pointer (&self->module_names, g_ptr_array_unref);
+  g_mutex_clear (&self->stats_lock);
 
   G_OBJECT_CLASS (modulemd_module_index_parent_class)->finalize (object);
 }
@@ -115,6 +212,311 @@ modulemd_module_index_init (ModulemdModuleIndex *self)
 {
   self->modules =
     g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+  self->intent_default_streams = g_hash_table_new_full (
+    g_str_hash, g_str_equal, g_free, modulemd_hash_table_unref);
+  g_mutex_init (&self->stats_lock);
+}
+
+
+static void
+record_stat (ModulemdModuleIndex *self, IndexStat stat, guint64 value)
+{
+  if (!self->collect_stats)
+    return;
+
+  g_mutex_lock (&self->stats_lock);
+  self->stats[stat] += value;
+  g_mutex_unlock (&self->stats_lock);
+}
+
+
+typedef struct
+{
+  ModulemdModuleIndex *index;
+  IndexStat stat;
+  gint64 start;
+} IndexStatTimer;
+
+static void
+index_stat_timer_clear (IndexStatTimer *timer)
+{
+  if (timer->start >= 0)
+    record_stat (
+      timer->index, timer->stat, g_get_monotonic_time () - timer->start);
+}
+
+G_DEFINE_AUTO_CLEANUP_CLEAR_FUNC (IndexStatTimer, index_stat_timer_clear);
+
+/* Adds the time until the end of the enclosing scope to the @_stat of
+ * @_self, if it is collecting statistics.
+ */
+#define INDEX_STAT_TIMER(_self, _stat)                                        \
+  g_auto (IndexStatTimer) stat_timer = {                                      \
+    (_self), (_stat), (_self)->collect_stats ? g_get_monotonic_time () : -1   \
+  }
+
+
+static void
+invalidate_default_streams (ModulemdModuleIndex *self)
+{
+  g_clear_pointer (&self->default_streams, g_hash_table_unref);
+  g_hash_table_remove_all (self->intent_default_streams);
+  self->defaults_generation = modulemd_defaults_get_generation ();
+}
+
+
+static void
+invalidate_artifact_streams (ModulemdModuleIndex *self)
+{
+  g_clear_pointer (&self->artifact_streams, g_hash_table_unref);
+  g_clear_pointer (&self->package_streams, g_hash_table_unref);
+  g_clear_pointer (&self->checksum_streams, g_hash_table_unref);
+}
+
+
+static GHashTable *
+get_stream_rpm_artifacts (ModulemdModuleStream *stream)
+{
+  if (MODULEMD_IS_MODULE_STREAM_V2 (stream))
+    return MODULEMD_MODULE_STREAM_V2 (stream)->rpm_artifacts;
+
+  if (MODULEMD_IS_MODULE_STREAM_V1 (stream))
+    return MODULEMD_MODULE_STREAM_V1 (stream)->rpm_artifacts;
+
+  return NULL;
+}
+
+
+static void
+stream_map_add (GHashTable *map,
+                const gchar *key,
+                gsize key_len,
+                ModulemdModuleStream *stream)
+{
+  g_autofree gchar *owned_key = g_strndup (key, key_len);
+  GPtrArray *streams = g_hash_table_lookup (map, owned_key);
+
+  if (streams == NULL)
+    {
+      streams = g_ptr_array_new_with_free_func (g_object_unref);
+      g_hash_table_insert (map, g_steal_pointer (&owned_key), streams);
+    }
+  else if (g_ptr_array_find (streams, stream, NULL))
+    {
+      /* Several artifacts of the same package map to a stream only once */
+      return;
+    }
+
+  g_ptr_array_add (streams, g_object_ref (stream));
+}
+
+
+static void
+stream_map_remove (GHashTable *map,
+                   const gchar *key,
+                   gsize key_len,
+                   ModulemdModuleStream *stream)
+{
+  g_autofree gchar *owned_key = g_strndup (key, key_len);
+  GPtrArray *streams = g_hash_table_lookup (map, owned_key);
+
+  if (streams == NULL || !g_ptr_array_remove_fast (streams, stream))
+    return;
+
+  if (streams->len == 0)
+    g_hash_table_remove (map, owned_key);
+}
+
+
+static void
+update_nevra_streams (ModulemdModuleIndex *self,
+                      ModulemdModuleStream *stream,
+                      gboolean add)
+{
+  GHashTable *artifacts = get_stream_rpm_artifacts (stream);
+  GHashTableIter iter;
+  gpointer key;
+  const gchar *nevra = NULL;
+  ModulemdNevra parsed;
+  gboolean valid;
+
+  if (artifacts == NULL)
+    return;
+
+  g_hash_table_iter_init (&iter, artifacts);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      nevra = (const gchar *)key;
+      valid = modulemd_nevra_parse (nevra, &parsed);
+
+      if (add)
+        {
+          stream_map_add (
+            self->artifact_streams, nevra, strlen (nevra), stream);
+          if (valid)
+            stream_map_add (self->package_streams,
+                            nevra,
+                            MODULEMD_NEVRA_NAME_LEN (&parsed),
+                            stream);
+        }
+      else
+        {
+          stream_map_remove (
+            self->artifact_streams, nevra, strlen (nevra), stream);
+          if (valid)
+            stream_map_remove (self->package_streams,
+                               nevra,
+                               MODULEMD_NEVRA_NAME_LEN (&parsed),
+                               stream);
+        }
+    }
+}
+
+
+/* The streams whose rpm_artifact_map lists a particular checksum, and the
+ * entry the first of them has for it.
+ */
+typedef struct
+{
+  ModulemdRpmMapEntry *entry;
+  GPtrArray *streams;
+} ChecksumStreams;
+
+
+static void
+checksum_streams_free (gpointer data)
+{
+  ChecksumStreams *checksum_streams = data;
+
+  g_clear_object (&checksum_streams->entry);
+  g_clear_pointer (&checksum_streams->streams, g_ptr_array_unref);
+  g_free (checksum_streams);
+}
+
+
+static void
+update_checksum_streams (ModulemdModuleIndex *self,
+                         ModulemdModuleStream *stream,
+                         gboolean add)
+{
+  GHashTableIter digest_iter;
+  GHashTableIter checksum_iter;
+  gpointer digest, digest_table;
+  gpointer checksum, entry;
+  GHashTable *digests = NULL;
+  GHashTable *checksums = NULL;
+  ChecksumStreams *checksum_streams = NULL;
+
+  if (!MODULEMD_IS_MODULE_STREAM_V2 (stream))
+    return;
+
+  digests = MODULEMD_MODULE_STREAM_V2 (stream)->rpm_artifact_map;
+  g_hash_table_iter_init (&digest_iter, digests);
+  while (g_hash_table_iter_next (&digest_iter, &digest, &digest_table))
+    {
+      checksums = g_hash_table_lookup (self->checksum_streams, digest);
+      if (checksums == NULL)
+        {
+          if (!add)
+            continue;
+
+          checksums = g_hash_table_new_full (
+            g_str_hash, g_str_equal, g_free, checksum_streams_free);
+          g_hash_table_insert (
+            self->checksum_streams, g_strdup (digest), checksums);
+        }
+
+      g_hash_table_iter_init (&checksum_iter, digest_table);
+      while (g_hash_table_iter_next (&checksum_iter, &checksum, &entry))
+        {
+          checksum_streams = g_hash_table_lookup (checksums, checksum);
+
+          if (!add)
+            {
+              if (checksum_streams == NULL ||
+                  !g_ptr_array_remove_fast (checksum_streams->streams, stream))
+                continue;
+
+              if (checksum_streams->streams->len == 0)
+                g_hash_table_remove (checksums, checksum);
+              continue;
+            }
+
+          if (checksum_streams == NULL)
+            {
+              checksum_streams = g_new0 (ChecksumStreams, 1);
+              checksum_streams->entry = g_object_ref (entry);
+              checksum_streams->streams =
+                g_ptr_array_new_with_free_func (g_object_unref);
+              g_hash_table_insert (
+                checksums, g_strdup (checksum), checksum_streams);
+            }
+
+          g_ptr_array_add (checksum_streams->streams, g_object_ref (stream));
+        }
+    }
+}
+
+
+static void
+update_artifact_streams (ModulemdModuleIndex *self,
+                         ModulemdModuleStream *stream,
+                         gboolean add)
+{
+  if (self->artifact_streams != NULL)
+    update_nevra_streams (self, stream, add);
+
+  if (self->checksum_streams != NULL)
+    update_checksum_streams (self, stream, add);
+}
+
+
+static gboolean
+have_artifact_streams (ModulemdModuleIndex *self)
+{
+  return self->artifact_streams != NULL || self->checksum_streams != NULL;
+}
+
+
+static void
+ensure_artifact_streams (ModulemdModuleIndex *self, gboolean checksums)
+{
+  GHashTableIter iter;
+  gpointer value;
+  GPtrArray *streams = NULL;
+  ModulemdModuleStream *stream = NULL;
+  gboolean nevras = !checksums;
+
+  if (nevras && self->artifact_streams == NULL)
+    {
+      self->artifact_streams = g_hash_table_new_full (
+        g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_ptr_array_unref);
+      self->package_streams = g_hash_table_new_full (
+        g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_ptr_array_unref);
+    }
+  else if (checksums && self->checksum_streams == NULL)
+    {
+      self->checksum_streams = g_hash_table_new_full (
+        g_str_hash, g_str_equal, g_free, modulemd_hash_table_unref);
+    }
+  else
+    {
+      return;
+    }
+
+  g_hash_table_iter_init (&iter, self->modules);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      streams = modulemd_module_get_all_streams (MODULEMD_MODULE (value));
+      for (guint i = 0; i < streams->len; i++)
+        {
+          stream = g_ptr_array_index (streams, i);
+          if (nevras)
+            update_nevra_streams (self, stream, TRUE);
+          else
+            update_checksum_streams (self, stream, TRUE);
+        }
+    }
 }
 
 
@@ -131,6 +533,13 @@ get_or_create_module (ModulemdModuleIndex *self, const gchar *module_name)
 }
 
 
+static gboolean
+add_module_stream (ModulemdModuleIndex *self,
+                   ModulemdModuleStream *stream,
+                   gboolean copy,
+                   GError **error);
+
+
 static gboolean
 add_subdoc (ModulemdModuleIndex *self,
             ModulemdSubdocumentInfo *subdoc,
@@ -141,7 +550,10 @@ add_subdoc (ModulemdModuleIndex *self,
   g_autoptr (ModulemdModuleStream) stream = NULL;
   g_autoptr (ModulemdTranslation) translation = NULL;
   g_autoptr (ModulemdDefaults) defaults = NULL;
+  g_autoptr (GBytes) raw_yaml = NULL;
   g_autofree gchar *name = NULL;
+  const gchar *yaml = NULL;
+  INDEX_STAT_TIMER (self, INDEX_STAT_TIME_PARSE_DOCUMENTS);
 
   switch (modulemd_subdocument_info_get_doctype (subdoc))
     {
@@ -170,6 +582,14 @@ add_subdoc (ModulemdModuleIndex *self,
       if (stream == NULL)
         return FALSE;
 
+      /* Attached before any names are generated below, which discards it */
+      if (self->passthrough)
+        {
+          yaml = modulemd_subdocument_info_get_yaml (subdoc);
+          raw_yaml = g_bytes_new (yaml, strlen (yaml));
+          modulemd_module_stream_set_raw_yaml (stream, raw_yaml);
+        }
+
       if (autogen_module_name &&
           !modulemd_module_stream_get_module_name (stream))
         {
@@ -189,9 +609,13 @@ add_subdoc (ModulemdModuleIndex *self,
         }
 
 
-      if (!modulemd_module_index_add_module_stream (self, stream, error))
+      /* Nothing else holds the freshly parsed stream, so it can be stored
+       * as-is rather than copied.
+       */
+      if (!add_module_stream (self, stream, FALSE, error))
         return FALSE;
 
+      record_stat (self, INDEX_STAT_DOCUMENTS_MODULESTREAM, 1);
       break;
 
     case MODULEMD_YAML_DOC_DEFAULTS:
@@ -204,6 +628,7 @@ add_subdoc (ModulemdModuleIndex *self,
             return FALSE;
           if (!modulemd_module_index_add_defaults (self, defaults, error))
             return FALSE;
+          record_stat (self, INDEX_STAT_DOCUMENTS_DEFAULTS, 1);
           break;
 
         default:
@@ -221,6 +646,7 @@ add_subdoc (ModulemdModuleIndex *self,
         return FALSE;
       if (!modulemd_module_index_add_translation (self, translation, error))
         return FALSE;
+      record_stat (self, INDEX_STAT_DOCUMENTS_TRANSLATIONS, 1);
       break;
 
     default:
@@ -247,6 +673,11 @@ modulemd_module_index_update_from_parser (ModulemdModuleIndex *self,
   gboolean all_passed = TRUE;
   g_autoptr (ModulemdSubdocumentInfo) subdoc = NULL;
   MMD_INIT_YAML_EVENT (event);
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_PARSE);
+  INDEX_STAT_TIMER (self, INDEX_STAT_TIME_UPDATE_FROM_PARSER);
+  gsize start_offset = parser->offset;
+
+  g_return_val_if_fail (!self->frozen, FALSE);
 
   if (*failures == NULL)
     *failures = g_ptr_array_new_with_free_func (g_object_unref);
@@ -269,6 +700,7 @@ modulemd_module_index_update_from_parser (ModulemdModuleIndex *self,
             {
               /* Add to failures and ignore */
               g_ptr_array_add (*failures, g_steal_pointer (&subdoc));
+              record_stat (self, INDEX_STAT_FAILURES, 1);
               all_passed = FALSE;
             }
           else
@@ -281,6 +713,7 @@ modulemd_module_index_update_from_parser (ModulemdModuleIndex *self,
                   g_clear_pointer (error, g_error_free);
                   /* Add to failures and ignore */
                   g_ptr_array_add (*failures, g_steal_pointer (&subdoc));
+                  record_stat (self, INDEX_STAT_FAILURES, 1);
                   all_passed = FALSE;
                 }
             }
@@ -298,6 +731,8 @@ modulemd_module_index_update_from_parser (ModulemdModuleIndex *self,
       yaml_event_delete (&event);
     }
 
+  record_stat (self, INDEX_STAT_BYTES_READ, parser->offset - start_offset);
+
   return all_passed;
 }
 
@@ -373,7 +808,11 @@ compare_stream_SVCA (gconstpointer a, gconstpointer b)
 
 
 static gboolean
-dump_streams (ModulemdModule *module, yaml_emitter_t *emitter, GError **error)
+dump_streams (ModulemdModule *module,
+              gboolean force_validation,
+              gboolean frozen,
+              yaml_emitter_t *emitter,
+              GError **error)
 {
   ModulemdModuleStream *stream = NULL;
   gsize i = 0;
@@ -381,15 +820,24 @@ dump_streams (ModulemdModule *module, yaml_emitter_t *emitter, GError **error)
   g_autoptr (GError) nested_error = NULL;
 
   /*
-   * Make sure we get a stable sorting by sorting just before dumping.
+   * Make sure we get a stable sorting by sorting just before dumping. The
+   * streams of a frozen index were sorted once when it was frozen, and must
+   * not be touched by the threads that may be dumping it concurrently.
    */
-  g_ptr_array_sort (streams, compare_stream_SVCA);
+  if (!frozen)
+    g_ptr_array_sort (streams, compare_stream_SVCA);
 
   for (i = 0; i < streams->len; i++)
     {
       stream = (ModulemdModuleStream *)g_ptr_array_index (streams, i);
 
-      if (!modulemd_module_stream_validate (stream, &nested_error))
+      /* Streams that were validated (for instance while being parsed) and
+       * have not been modified since, either directly or through one of
+       * their children, don't need to be checked again.
+       */
+      if ((force_validation ||
+           !modulemd_module_stream_is_validated (stream)) &&
+          !modulemd_module_stream_validate (stream, &nested_error))
         {
           g_propagate_prefixed_error (error,
                                       g_steal_pointer (&nested_error),
@@ -397,6 +845,15 @@ dump_streams (ModulemdModule *module, yaml_emitter_t *emitter, GError **error)
           return FALSE;
         }
 
+      /* Unmodified streams read by an index in passthrough mode */
+      if (modulemd_module_stream_get_raw_yaml (stream) != NULL)
+        {
+          if (!mmd_emitter_raw_document (
+                emitter, modulemd_module_stream_get_raw_yaml (stream), error))
+            return FALSE;
+          continue;
+        }
+
       if (modulemd_module_stream_get_mdversion (stream) ==
           MD_MODULESTREAM_VERSION_ONE)
         {
@@ -425,6 +882,36 @@ dump_streams (ModulemdModule *module, yaml_emitter_t *emitter, GError **error)
 }
 
 
+static gboolean
+dump_module (ModulemdModule *module,
+             gboolean force_validation,
+             gboolean frozen,
+             yaml_emitter_t *emitter,
+             GError **error)
+{
+  if (!dump_defaults (module, emitter, error))
+    return FALSE;
+
+  if (!dump_translations (module, emitter, error))
+    return FALSE;
+
+  if (!dump_streams (module, force_validation, frozen, emitter, error))
+    return FALSE;
+
+  return TRUE;
+}
+
+
+static GPtrArray *
+get_ordered_module_names (ModulemdModuleIndex *self)
+{
+  if (self->module_names)
+    return g_ptr_array_ref (self->module_names);
+
+  return modulemd_ordered_str_keys (self->modules, modulemd_strcmp_sort);
+}
+
+
 static gboolean
 modulemd_module_index_dump_to_emitter (ModulemdModuleIndex *self,
                                        yaml_emitter_t *emitter,
@@ -432,8 +919,9 @@ modulemd_module_index_dump_to_emitter (ModulemdModuleIndex *self,
 {
   ModulemdModule *module = NULL;
   gsize i;
-  g_autoptr (GPtrArray) modules =
-    modulemd_ordered_str_keys (self->modules, modulemd_strcmp_sort);
+  g_autoptr (GPtrArray) modules = get_ordered_module_names (self);
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_EMIT);
+  INDEX_STAT_TIMER (self, INDEX_STAT_TIME_DUMP);
 
   if (modules->len == 0)
     {
@@ -452,13 +940,8 @@ modulemd_module_index_dump_to_emitter (ModulemdModuleIndex *self,
       module = modulemd_module_index_get_module (
         self, g_ptr_array_index (modules, i));
 
-      if (!dump_defaults (module, emitter, error))
-        return FALSE;
-
-      if (!dump_translations (module, emitter, error))
-        return FALSE;
-
-      if (!dump_streams (module, emitter, error))
+      if (!dump_module (
+            module, self->force_validation, self->frozen, emitter, error))
         return FALSE;
     }
 
@@ -487,6 +970,8 @@ modulemd_module_index_update_from_file (ModulemdModuleIndex *self,
   int fd;
   ModulemdCompressionTypeEnum comtype;
   g_autofree gchar *fmode = NULL;
+  gint64 detect_start;
+  INDEX_STAT_TIMER (self, INDEX_STAT_TIME_UPDATE_FROM_FILE);
 
   yaml_stream = g_fopen (yaml_file, "rb");
   saved_errno = errno;
@@ -507,7 +992,11 @@ modulemd_module_index_update_from_file (ModulemdModuleIndex *self,
   fd = fileno (yaml_stream);
 
   /* Determine if the file is compressed */
+  detect_start = self->collect_stats ? g_get_monotonic_time () : 0;
   comtype = modulemd_detect_compression (yaml_file, fd, &nested_error);
+  record_stat (self,
+               INDEX_STAT_TIME_DETECT_COMPRESSION,
+               g_get_monotonic_time () - detect_start);
   if (comtype == MODULEMD_COMPRESSION_TYPE_DETECTION_FAILED)
     {
       g_propagate_error (error, g_steal_pointer (&nested_error));
@@ -692,10 +1181,12 @@ modules_from_directory (const gchar *path,
   g_autofree gchar *filepath = NULL;
   g_autoptr (ModulemdModuleIndex) index = NULL;
   g_autoptr (ModulemdModuleIndex) intermediate = NULL;
+  g_autoptr (GPtrArray) intermediates = NULL;
   g_autoptr (GPtrArray) failures = NULL;
   g_autoptr (GError) nested_error = NULL;
 
   index = modulemd_module_index_new ();
+  intermediates = g_ptr_array_new_with_free_func (g_object_unref);
 
   /* Open the directory */
   dir = g_dir_open (path, 0, &nested_error);
@@ -719,22 +1210,27 @@ modules_from_directory (const gchar *path,
               return FALSE;
             }
 
-          if (!modulemd_module_index_merge (intermediate,
-                                            index,
-                                            FALSE,
-                                            strict_default_streams,
-                                            &nested_error))
-            {
-              g_propagate_error (error, g_steal_pointer (&nested_error));
-              return FALSE;
-            }
+          g_ptr_array_add (intermediates, g_steal_pointer (&intermediate));
 
           g_clear_pointer (&failures, g_ptr_array_unref);
           g_clear_pointer (&filepath, g_free);
-          g_clear_object (&intermediate);
         }
     }
 
+  /* Merge all of the files at once so that the defaults for each module are
+   * only merged (and copied) a single time.
+   */
+  if (!modulemd_module_index_merge_all (intermediates,
+                                        index,
+                                        FALSE,
+                                        strict_default_streams,
+                                        NULL,
+                                        &nested_error))
+    {
+      g_propagate_error (error, g_steal_pointer (&nested_error));
+      return FALSE;
+    }
+
   return g_steal_pointer (&index);
 }
 
@@ -794,6 +1290,50 @@ modulemd_module_index_update_from_defaults_directory (
 }
 
 
+/* Rough sizes of the YAML for a single document, based on the median
+ * document in the Fedora 29 repodata. A handful of very large streams are
+ * left to the geometric growth of the output buffer rather than being
+ * reserved for every stream, and the reservation is capped so a huge index
+ * doesn't commit memory that will never be written.
+ */
+#define ESTIMATED_STREAM_YAML_SIZE 4096
+#define ESTIMATED_OTHER_YAML_SIZE 512
+#define MAX_ESTIMATED_YAML_SIZE (16 * 1024 * 1024)
+
+static gsize
+estimate_module_dump_size (ModulemdModule *module)
+{
+  gsize estimate;
+
+  estimate = modulemd_module_get_all_streams (module)->len *
+             ESTIMATED_STREAM_YAML_SIZE;
+
+  if (modulemd_module_get_defaults (module))
+    estimate += ESTIMATED_OTHER_YAML_SIZE;
+
+  return MIN (estimate, MAX_ESTIMATED_YAML_SIZE);
+}
+
+
+static gsize
+estimate_dump_size (ModulemdModuleIndex *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+  gsize estimate = 0;
+
+  g_hash_table_iter_init (&iter, self->modules);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      estimate += estimate_module_dump_size (MODULEMD_MODULE (value));
+      if (estimate >= MAX_ESTIMATED_YAML_SIZE)
+        return MAX_ESTIMATED_YAML_SIZE;
+    }
+
+  return estimate;
+}
+
+
 gchar *
 modulemd_module_index_dump_to_string (ModulemdModuleIndex *self,
                                       GError **error)
@@ -803,79 +1343,513 @@ modulemd_module_index_dump_to_string (ModulemdModuleIndex *self,
   MMD_INIT_YAML_EMITTER (emitter);
   MMD_INIT_YAML_STRING (&emitter, yaml_string);
 
+  /* Size the output once up front instead of growing it as libyaml flushes */
+  modulemd_yaml_string_reserve (yaml_string, estimate_dump_size (self));
+
   if (!modulemd_module_index_dump_to_emitter (self, &emitter, error))
     return NULL;
 
+  /* Don't hand the unused part of the reservation over to the caller */
+  modulemd_yaml_string_shrink (yaml_string);
+
   return g_steal_pointer (&yaml_string->str);
 }
 
 
-gboolean
-modulemd_module_index_dump_to_stream (ModulemdModuleIndex *self,
-                                      FILE *yaml_stream,
-                                      GError **error)
+/* One module's worth of output for
+ * modulemd_module_index_dump_to_string_parallel()
+ */
+typedef struct _DumpModuleJob
 {
-  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  ModulemdModule *module;
+  gboolean force_validation;
+  gboolean frozen;
+  modulemd_yaml_string *yaml_string;
+  GError *error;
+} DumpModuleJob;
 
-  MMD_INIT_YAML_EMITTER (emitter);
-  yaml_emitter_set_output_file (&emitter, yaml_stream);
 
-  return modulemd_module_index_dump_to_emitter (self, &emitter, error);
+static void
+dump_module_job_clear (DumpModuleJob *job)
+{
+  g_clear_pointer (&job->yaml_string, modulemd_yaml_string_free);
+  g_clear_error (&job->error);
 }
 
 
-gboolean
-modulemd_module_index_dump_to_custom (ModulemdModuleIndex *self,
-                                      ModulemdWriteHandler custom_write_fn,
-                                      void *custom_pvt_data,
-                                      GError **error)
+static void
+dump_module_job_run (gpointer data, gpointer user_data)
 {
-  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
-
+  DumpModuleJob *job = (DumpModuleJob *)data;
   MMD_INIT_YAML_EMITTER (emitter);
-  yaml_emitter_set_output (&emitter, custom_write_fn, custom_pvt_data);
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_EMIT);
 
-  return modulemd_module_index_dump_to_emitter (self, &emitter, error);
+  /* Each module is written as a YAML stream of its own. Every document is
+   * explicitly started and ended, so concatenating these streams is
+   * byte-for-byte the same as emitting all of the documents in one stream.
+   */
+  job->yaml_string = g_malloc0_n (1, sizeof (modulemd_yaml_string));
+  modulemd_yaml_string_reserve (job->yaml_string,
+                                estimate_module_dump_size (job->module));
+  yaml_emitter_set_output (&emitter, write_yaml_string, job->yaml_string);
+
+  if (!mmd_emitter_start_stream (&emitter, &job->error))
+    return;
+
+  if (!dump_module (job->module,
+                    job->force_validation,
+                    job->frozen,
+                    &emitter,
+                    &job->error))
+    return;
+
+  mmd_emitter_end_stream (&emitter, &job->error);
 }
 
 
-GStrv
-modulemd_module_index_get_module_names_as_strv (ModulemdModuleIndex *self)
+gchar *
+modulemd_module_index_dump_to_string_parallel (ModulemdModuleIndex *self,
+                                               guint max_threads,
+                                               GError **error)
 {
-  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+  MODULEMD_INIT_TRACE ();
+  g_autoptr (GPtrArray) modules = NULL;
+  g_autofree DumpModuleJob *jobs = NULL;
+  GThreadPool *pool = NULL;
+  g_autoptr (GError) nested_error = NULL;
+  gchar *output = NULL;
+  gsize total = 0;
+  gsize offset = 0;
+  guint i;
 
-  return modulemd_ordered_str_keys_as_strv (self->modules);
-}
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
 
+  if (max_threads == 0)
+    max_threads = g_get_num_processors ();
 
-ModulemdModule *
-modulemd_module_index_get_module (ModulemdModuleIndex *self,
-                                  const gchar *module_name)
-{
-  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+  modules = get_ordered_module_names (self);
 
-  return g_hash_table_lookup (self->modules, module_name);
-}
+  /* Not worth spinning up any threads */
+  if (max_threads < 2 || modules->len < 2)
+    return modulemd_module_index_dump_to_string (self, error);
 
+  INDEX_STAT_TIMER (self, INDEX_STAT_TIME_DUMP);
 
-gboolean
-modulemd_module_index_remove_module (ModulemdModuleIndex *self,
-                                     const gchar *module_name)
-{
-  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  jobs = g_new0 (DumpModuleJob, modules->len);
 
-  return g_hash_table_remove (self->modules, module_name);
+  pool = g_thread_pool_new (dump_module_job_run,
+                            NULL,
+                            (gint)MIN (max_threads, modules->len),
+                            FALSE,
+                            &nested_error);
+  if (!pool)
+    {
+      g_propagate_error (error, g_steal_pointer (&nested_error));
+      return NULL;
+    }
+
+  for (i = 0; i < modules->len; i++)
+    {
+      jobs[i].module = modulemd_module_index_get_module (
+        self, g_ptr_array_index (modules, i));
+      jobs[i].force_validation = self->force_validation;
+      jobs[i].frozen = self->frozen;
+      g_thread_pool_push (pool, &jobs[i], NULL);
+    }
+
+  /* Wait for every job to finish */
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  /* Report the same error the serial dump would have hit first */
+  for (i = 0; i < modules->len && !nested_error; i++)
+    {
+      if (jobs[i].error)
+        nested_error = g_steal_pointer (&jobs[i].error);
+      else
+        total += jobs[i].yaml_string->len;
+    }
+
+  if (!nested_error)
+    {
+      output = g_malloc (total + 1);
+      for (i = 0; i < modules->len; i++)
+        {
+          memcpy (output + offset,
+                  jobs[i].yaml_string->str,
+                  jobs[i].yaml_string->len);
+          offset += jobs[i].yaml_string->len;
+        }
+      output[offset] = '\0';
+    }
+
+  for (i = 0; i < modules->len; i++)
+    dump_module_job_clear (&jobs[i]);
+
+  if (nested_error)
+    {
+      g_propagate_error (error, g_steal_pointer (&nested_error));
+      return NULL;
+    }
+
+  return output;
+}
+
+
+void
+modulemd_module_index_set_force_validation (ModulemdModuleIndex *self,
+                                            gboolean force_validation)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_INDEX (self));
+  g_return_if_fail (!self->frozen);
+
+  self->force_validation = force_validation;
 }
 
 
 gboolean
-modulemd_module_index_add_module_stream (ModulemdModuleIndex *self,
-                                         ModulemdModuleStream *stream,
-                                         GError **error)
+modulemd_module_index_get_force_validation (ModulemdModuleIndex *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+
+  return self->force_validation;
+}
+
+
+void
+modulemd_module_index_set_passthrough (ModulemdModuleIndex *self,
+                                       gboolean passthrough)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_INDEX (self));
+  g_return_if_fail (!self->frozen);
+
+  self->passthrough = passthrough;
+}
+
+
+gboolean
+modulemd_module_index_get_passthrough (ModulemdModuleIndex *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+
+  return self->passthrough;
+}
+
+
+void
+modulemd_module_index_set_collect_stats (ModulemdModuleIndex *self,
+                                         gboolean collect_stats)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_INDEX (self));
+
+  self->collect_stats = collect_stats;
+}
+
+
+gboolean
+modulemd_module_index_get_collect_stats (ModulemdModuleIndex *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+
+  return self->collect_stats;
+}
+
+
+GVariant *
+modulemd_module_index_get_stats (ModulemdModuleIndex *self)
+{
+  GVariantBuilder builder;
+  gsize i;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{st}"));
+
+  g_mutex_lock (&self->stats_lock);
+  for (i = 0; i < INDEX_STAT_COUNT; i++)
+    g_variant_builder_add (
+      &builder, "{st}", index_stat_names[i], self->stats[i]);
+  g_mutex_unlock (&self->stats_lock);
+
+  return g_variant_builder_end (&builder);
+}
+
+
+void
+modulemd_module_index_reset_stats (ModulemdModuleIndex *self)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_INDEX (self));
+
+  g_mutex_lock (&self->stats_lock);
+  memset (self->stats, 0, sizeof (self->stats));
+  g_mutex_unlock (&self->stats_lock);
+}
+
+
+gboolean
+modulemd_module_index_dump_to_stream (ModulemdModuleIndex *self,
+                                      FILE *yaml_stream,
+                                      GError **error)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+
+  MMD_INIT_YAML_EMITTER (emitter);
+  yaml_emitter_set_output_file (&emitter, yaml_stream);
+
+  return modulemd_module_index_dump_to_emitter (self, &emitter, error);
+}
+
+
+gboolean
+modulemd_module_index_dump_to_custom (ModulemdModuleIndex *self,
+                                      ModulemdWriteHandler custom_write_fn,
+                                      void *custom_pvt_data,
+                                      GError **error)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+
+  MMD_INIT_YAML_EMITTER (emitter);
+  yaml_emitter_set_output (&emitter, custom_write_fn, custom_pvt_data);
+
+  return modulemd_module_index_dump_to_emitter (self, &emitter, error);
+}
+
+
+GStrv
+modulemd_module_index_get_module_names_as_strv (ModulemdModuleIndex *self)
+{
+  GStrv names = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  if (!self->module_names)
+    return modulemd_ordered_str_keys_as_strv (self->modules);
+
+  names = g_new0 (gchar *, self->module_names->len + 1);
+  for (guint i = 0; i < self->module_names->len; i++)
+    names[i] = g_strdup (g_ptr_array_index (self->module_names, i));
+
+  return names;
+}
+
+
+ModulemdModule *
+modulemd_module_index_get_module (ModulemdModuleIndex *self,
+                                  const gchar *module_name)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  return g_hash_table_lookup (self->modules, module_name);
+}
+
+
+static GPtrArray *
+search_stream_map (GHashTable *map, const gchar *key)
+{
+  GPtrArray *streams = g_hash_table_lookup (map, key);
+  GPtrArray *matches = NULL;
+
+  if (streams == NULL)
+    return g_ptr_array_new ();
+
+  matches = g_ptr_array_sized_new (streams->len);
+  for (guint i = 0; i < streams->len; i++)
+    g_ptr_array_add (matches, g_ptr_array_index (streams, i));
+
+  return matches;
+}
+
+
+GPtrArray *
+modulemd_module_index_search_streams_by_rpm_artifact (
+  ModulemdModuleIndex *self, const gchar *nevra)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+  g_return_val_if_fail (nevra, NULL);
+
+  ensure_artifact_streams (self, FALSE);
+
+  return search_stream_map (self->artifact_streams, nevra);
+}
+
+
+GPtrArray *
+modulemd_module_index_search_streams_by_package_name (
+  ModulemdModuleIndex *self, const gchar *package_name)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+  g_return_val_if_fail (package_name, NULL);
+
+  ensure_artifact_streams (self, FALSE);
+
+  return search_stream_map (self->package_streams, package_name);
+}
+
+
+GPtrArray *
+modulemd_module_index_search_streams_by_rpm_checksum (
+  ModulemdModuleIndex *self,
+  const gchar *digest,
+  const gchar *checksum,
+  ModulemdRpmMapEntry **entry)
+{
+  GHashTable *checksums = NULL;
+  ChecksumStreams *checksum_streams = NULL;
+  GPtrArray *matches = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+  g_return_val_if_fail (digest && checksum, NULL);
+
+  ensure_artifact_streams (self, TRUE);
+
+  if (entry)
+    *entry = NULL;
+
+  checksums = g_hash_table_lookup (self->checksum_streams, digest);
+  if (checksums)
+    checksum_streams = g_hash_table_lookup (checksums, checksum);
+  if (checksum_streams == NULL)
+    return g_ptr_array_new ();
+
+  if (entry)
+    *entry = checksum_streams->entry;
+
+  matches = g_ptr_array_sized_new (checksum_streams->streams->len);
+  for (guint i = 0; i < checksum_streams->streams->len; i++)
+    g_ptr_array_add (matches,
+                     g_ptr_array_index (checksum_streams->streams, i));
+
+  return matches;
+}
+
+
+gboolean
+modulemd_module_index_remove_module (ModulemdModuleIndex *self,
+                                     const gchar *module_name)
+{
+  ModulemdModule *module = NULL;
+  GPtrArray *streams = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
+
+  module = g_hash_table_lookup (self->modules, module_name);
+  if (module == NULL)
+    return FALSE;
+
+  if (modulemd_module_get_defaults (module) != NULL)
+    invalidate_default_streams (self);
+
+  if (have_artifact_streams (self))
+    {
+      streams = modulemd_module_get_all_streams (module);
+      for (guint i = 0; i < streams->len; i++)
+        update_artifact_streams (self, g_ptr_array_index (streams, i), FALSE);
+    }
+
+  return g_hash_table_remove (self->modules, module_name);
+}
+
+
+ModulemdModuleIndex *
+modulemd_module_index_filter (ModulemdModuleIndex *self,
+                              const gchar *module_name,
+                              const gchar *stream_name,
+                              guint64 version,
+                              const gchar *context,
+                              const gchar *arch,
+                              ModulemdDocumentTypeFlags doctypes)
+{
+  g_autoptr (ModulemdModuleIndex) filtered = NULL;
+  ModulemdModule *module = NULL;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  filtered = modulemd_module_index_new ();
+
+  /* The documents, shared or copied, are already at the versions of @self */
+  filtered->defaults_mdversion = self->defaults_mdversion;
+  filtered->stream_mdversion = self->stream_mdversion;
+  filtered->force_validation = self->force_validation;
+  filtered->passthrough = self->passthrough;
+
+  g_hash_table_iter_init (&iter, self->modules);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      if (module_name && !g_pattern_match_simple (module_name, key))
+        continue;
+
+      module = modulemd_module_filter (MODULEMD_MODULE (value),
+                                       stream_name,
+                                       version,
+                                       context,
+                                       arch,
+                                       doctypes);
+      if (module)
+        g_hash_table_replace (filtered->modules, g_strdup (key), module);
+    }
+
+  return g_steal_pointer (&filtered);
+}
+
+
+guint
+modulemd_module_index_prune (ModulemdModuleIndex *self,
+                             const gchar *module_name,
+                             const gchar *stream_name,
+                             guint64 version,
+                             const gchar *context,
+                             const gchar *arch,
+                             ModulemdDocumentTypeFlags doctypes)
+{
+  guint removed = 0;
+  ModulemdModule *module = NULL;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), 0);
+  g_return_val_if_fail (!self->frozen, 0);
+
+  invalidate_default_streams (self);
+  invalidate_artifact_streams (self);
+
+  g_hash_table_iter_init (&iter, self->modules);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      module = MODULEMD_MODULE (value);
+
+      if (module_name && !g_pattern_match_simple (module_name, key))
+        {
+          removed += modulemd_module_count_documents (module);
+          g_hash_table_iter_remove (&iter);
+          continue;
+        }
+
+      removed += modulemd_module_prune (
+        module, stream_name, version, context, arch, doctypes);
+
+      if (modulemd_module_count_documents (module) == 0)
+        g_hash_table_iter_remove (&iter);
+    }
+
+  return removed;
+}
+
+
+static gboolean
+add_module_stream (ModulemdModuleIndex *self,
+                   ModulemdModuleStream *stream,
+                   gboolean copy,
+                   GError **error)
 {
   g_autoptr (GError) nested_error = NULL;
   ModulemdModuleStreamVersionEnum mdversion = MD_MODULESTREAM_VERSION_UNSET;
+  ModulemdModule *module = NULL;
+  GPtrArray *streams = NULL;
+  guint n_streams;
   g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
 
   if (!modulemd_module_stream_get_module_name (stream) ||
       !modulemd_module_stream_get_stream_name (stream))
@@ -888,12 +1862,17 @@ modulemd_module_index_add_module_stream (ModulemdModuleIndex *self,
       return FALSE;
     }
 
-  mdversion = modulemd_module_add_stream (
-    get_or_create_module (self,
-                          modulemd_module_stream_get_module_name (stream)),
-    stream,
-    self->stream_mdversion,
-    &nested_error);
+  module = get_or_create_module (
+    self, modulemd_module_stream_get_module_name (stream));
+  streams = modulemd_module_get_all_streams (module);
+  n_streams = streams->len;
+
+  if (copy)
+    mdversion = modulemd_module_add_stream (
+      module, stream, self->stream_mdversion, &nested_error);
+  else
+    mdversion = modulemd_module_add_stream_shared (
+      module, stream, self->stream_mdversion, &nested_error);
 
   if (mdversion == MD_MODULESTREAM_VERSION_ERROR)
     {
@@ -901,6 +1880,20 @@ modulemd_module_index_add_module_stream (ModulemdModuleIndex *self,
       return FALSE;
     }
 
+  record_stat (self, INDEX_STAT_STREAMS_ADDED, 1);
+
+  if (have_artifact_streams (self))
+    {
+      /* A new stream is appended to the module. If it replaced a duplicate
+       * instead, start over rather than search for the old one.
+       */
+      if (streams->len > n_streams)
+        update_artifact_streams (
+          self, g_ptr_array_index (streams, streams->len - 1), TRUE);
+      else
+        invalidate_artifact_streams (self);
+    }
+
   if (mdversion > self->stream_mdversion)
     {
       /* Upgrade any streams we've already seen to this version */
@@ -917,16 +1910,50 @@ modulemd_module_index_add_module_stream (ModulemdModuleIndex *self,
 }
 
 
+gboolean
+modulemd_module_index_add_module_stream (ModulemdModuleIndex *self,
+                                         ModulemdModuleStream *stream,
+                                         GError **error)
+{
+  return add_module_stream (self, stream, TRUE, error);
+}
+
+
+/* One module's worth of work for modulemd_module_index_upgrade_streams() */
+typedef struct _UpgradeModuleJob
+{
+  ModulemdModule *module;
+  ModulemdModuleStreamVersionEnum mdversion;
+  GError *error;
+} UpgradeModuleJob;
+
+
+static void
+upgrade_module_job_run (gpointer data, gpointer user_data)
+{
+  UpgradeModuleJob *job = (UpgradeModuleJob *)data;
+
+  modulemd_module_upgrade_streams (job->module, job->mdversion, &job->error);
+}
+
+
 gboolean
 modulemd_module_index_upgrade_streams (
   ModulemdModuleIndex *self,
   ModulemdModuleStreamVersionEnum mdversion,
   GError **error)
 {
-  GHashTableIter iter;
-  gpointer key, value;
-  g_autoptr (ModulemdModule) module = NULL;
+  g_autoptr (GPtrArray) module_names = NULL;
+  g_autofree UpgradeModuleJob *jobs = NULL;
+  ModulemdModule *module = NULL;
+  GThreadPool *pool = NULL;
   g_autoptr (GError) nested_error = NULL;
+  guint n_jobs = 0;
+  guint max_threads;
+  guint i;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
 
   if (mdversion < self->stream_mdversion)
     {
@@ -939,29 +1966,64 @@ modulemd_module_index_upgrade_streams (
       return FALSE;
     }
 
-  g_hash_table_iter_init (&iter, self->modules);
-  while (g_hash_table_iter_next (&iter, &key, &value))
+  /* Upgrading replaces the stream objects */
+  invalidate_artifact_streams (self);
+
+  module_names = get_ordered_module_names (self);
+  jobs = g_new0 (UpgradeModuleJob, module_names->len);
+
+  for (i = 0; i < module_names->len; i++)
     {
-      module = g_object_ref (MODULEMD_MODULE (value));
+      module = modulemd_module_index_get_module (
+        self, g_ptr_array_index (module_names, i));
 
       /* Skip any module without streams */
       if (modulemd_module_get_all_streams (module)->len == 0)
-        {
-          g_clear_object (&module);
-          continue;
-        }
+        continue;
+
+      jobs[n_jobs].module = module;
+      jobs[n_jobs].mdversion = mdversion;
+      n_jobs++;
+    }
+
+  /* Modules do not share any streams, so each one can be upgraded on a
+   * thread of its own.
+   */
+  max_threads = MIN (g_get_num_processors (), n_jobs);
+  if (max_threads > 1)
+    pool = g_thread_pool_new (
+      upgrade_module_job_run, NULL, (gint)max_threads, FALSE, NULL);
+
+  for (i = 0; i < n_jobs; i++)
+    {
+      if (pool)
+        g_thread_pool_push (pool, &jobs[i], NULL);
+      else
+        upgrade_module_job_run (&jobs[i], NULL);
+    }
 
-      if (!modulemd_module_upgrade_streams (module, mdversion, &nested_error))
+  /* Wait for every job to finish */
+  if (pool)
+    g_thread_pool_free (pool, FALSE, TRUE);
+
+  /* Report the error of the first module that failed, in module order */
+  for (i = 0; i < n_jobs; i++)
+    {
+      if (jobs[i].error && !nested_error)
         {
           g_propagate_prefixed_error (
-            error,
-            g_steal_pointer (&nested_error),
+            &nested_error,
+            g_steal_pointer (&jobs[i].error),
             "Error upgrading streams for module %s",
-            modulemd_module_get_module_name (module));
-          return FALSE;
+            modulemd_module_get_module_name (jobs[i].module));
         }
+      g_clear_error (&jobs[i].error);
+    }
 
-      g_clear_object (&module);
+  if (nested_error)
+    {
+      g_propagate_error (error, g_steal_pointer (&nested_error));
+      return FALSE;
     }
 
   self->stream_mdversion = mdversion;
@@ -979,6 +2041,9 @@ modulemd_module_index_add_defaults (ModulemdModuleIndex *self,
   ModulemdDefaultsVersionEnum mdversion = MD_DEFAULTS_VERSION_UNSET;
 
   g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
+
+  invalidate_default_streams (self);
 
   mdversion = modulemd_module_set_defaults (
     get_or_create_module (self, modulemd_defaults_get_module_name (defaults)),
@@ -1007,9 +2072,8 @@ modulemd_module_index_add_defaults (ModulemdModuleIndex *self,
 }
 
 
-GHashTable *
-modulemd_module_index_get_default_streams_as_hash_table (
-  ModulemdModuleIndex *self, const gchar *intent)
+static GHashTable *
+build_default_streams (ModulemdModuleIndex *self, const gchar *intent)
 {
   GHashTable *defaults = NULL;
   GHashTableIter iter;
@@ -1038,22 +2102,103 @@ modulemd_module_index_get_default_streams_as_hash_table (
                 }
               break;
 
-            default:
-              /* This should be impossible and suggests that we somehow added
-               * a corrupt defaults object. We will ignore it and continue to
-               * return valid entries.
-               */
-              g_warning ("Encountered an unknown defaults mdversion: %" PRIu64,
-                         modulemd_defaults_get_mdversion (defs));
-              break;
-            }
-        }
+            default:
+              /* This should be impossible and suggests that we somehow added
+               * a corrupt defaults object. We will ignore it and continue to
+               * return valid entries.
+               */
+              g_warning ("Encountered an unknown defaults mdversion: %" PRIu64,
+                         modulemd_defaults_get_mdversion (defs));
+              break;
+            }
+        }
+    }
+
+  return defaults;
+}
+
+
+static void
+build_all_default_streams (ModulemdModuleIndex *self)
+{
+  g_autoptr (GHashTable) intents = NULL;
+  GHashTableIter iter;
+  gpointer key, value;
+  ModulemdDefaults *defs = NULL;
+
+  invalidate_default_streams (self);
+  self->default_streams = build_default_streams (self, NULL);
+
+  intents = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  g_hash_table_iter_init (&iter, self->modules);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      defs = modulemd_module_get_defaults (MODULEMD_MODULE (value));
+      if (MODULEMD_IS_DEFAULTS_V1 (defs))
+        modulemd_defaults_v1_add_intents (MODULEMD_DEFAULTS_V1 (defs),
+                                          intents);
+    }
+
+  g_hash_table_iter_init (&iter, intents);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_hash_table_replace (self->intent_default_streams,
+                          g_strdup (key),
+                          build_default_streams (self, key));
+}
+
+
+GHashTable *
+modulemd_module_index_peek_default_streams (ModulemdModuleIndex *self,
+                                            const gchar *intent)
+{
+  GHashTable *defaults = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  /* The defaults of a frozen index cannot change any more, and other threads
+   * may be reading its views, so they are never rebuilt. An intent without a
+   * view of its own has no separate defaults anywhere in the index.
+   */
+  if (self->frozen)
+    {
+      if (intent)
+        defaults = g_hash_table_lookup (self->intent_default_streams, intent);
+      return defaults ? defaults : self->default_streams;
+    }
+
+  if (self->defaults_generation != modulemd_defaults_get_generation ())
+    invalidate_default_streams (self);
+
+  if (!intent)
+    {
+      if (!self->default_streams)
+        self->default_streams = build_default_streams (self, NULL);
+      return self->default_streams;
+    }
+
+  defaults = g_hash_table_lookup (self->intent_default_streams, intent);
+  if (!defaults)
+    {
+      defaults = build_default_streams (self, intent);
+      g_hash_table_replace (
+        self->intent_default_streams, g_strdup (intent), defaults);
     }
 
   return defaults;
 }
 
 
+GHashTable *
+modulemd_module_index_get_default_streams_as_hash_table (
+  ModulemdModuleIndex *self, const gchar *intent)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  return modulemd_hash_table_deep_str_copy (
+    modulemd_module_index_peek_default_streams (self, intent));
+}
+
+
 gboolean
 modulemd_module_index_upgrade_defaults (ModulemdModuleIndex *self,
                                         ModulemdDefaultsVersionEnum mdversion,
@@ -1066,6 +2211,9 @@ modulemd_module_index_upgrade_defaults (ModulemdModuleIndex *self,
   ModulemdDefaultsVersionEnum returned_mdversion = MD_DEFAULTS_VERSION_UNSET;
   g_autoptr (GError) nested_error = NULL;
 
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
+
   if (mdversion < self->defaults_mdversion)
     {
       g_set_error (error,
@@ -1101,6 +2249,7 @@ modulemd_module_index_upgrade_defaults (ModulemdModuleIndex *self,
         }
 
       g_object_ref (defaults);
+      invalidate_default_streams (self);
 
       returned_mdversion = modulemd_module_set_defaults (
         module, defaults, self->defaults_mdversion, &nested_error);
@@ -1128,6 +2277,7 @@ modulemd_module_index_add_translation (ModulemdModuleIndex *self,
                                        GError **error)
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
 
   modulemd_module_add_translation (
     get_or_create_module (self,
@@ -1144,145 +2294,247 @@ modulemd_module_index_merge (ModulemdModuleIndex *from,
                              gboolean strict_default_streams,
                              GError **error)
 {
-  MODULEMD_INIT_TRACE ();
+  g_autoptr (GPtrArray) from_indexes = g_ptr_array_sized_new (1);
+
+  g_ptr_array_add (from_indexes, from);
+
+  return modulemd_module_index_merge_all (
+    from_indexes, into, override, strict_default_streams, NULL, error);
+}
+
+
+static gboolean
+merge_pending_defaults (ModulemdModuleIndex *into,
+                        GHashTable *pending_defaults,
+                        gboolean override,
+                        gboolean strict_default_streams,
+                        GPtrArray *all_conflicts,
+                        GError **error)
+{
   GHashTableIter iter;
   gpointer key, value;
   const gchar *module_name = NULL;
-  const gchar *trans_stream = NULL;
-  ModulemdModule *module = NULL;
-  ModulemdModule *into_module = NULL;
-  GPtrArray *streams = NULL;
-  ModulemdModuleStream *stream = NULL;
-  g_autoptr (GPtrArray) translations = NULL;
-  ModulemdTranslation *translation = NULL;
-  ModulemdTranslation *current_translation = NULL;
-  ModulemdDefaults *defaults = NULL;
+  GPtrArray *defaults_list = NULL;
   ModulemdDefaults *into_defaults = NULL;
+  ModulemdDefaultsConflict *conflict = NULL;
+  const gchar *intent = NULL;
+  const gchar *stream_name = NULL;
   g_autoptr (ModulemdDefaults) merged_defaults = NULL;
+  g_autoptr (GPtrArray) conflicts = NULL;
   g_autoptr (GError) nested_error = NULL;
-  guint i;
-  g_autoptr (GPtrArray) translated_stream_names = NULL;
-  gchar *translated_stream_name = NULL;
-
+  g_autofree gchar *values = NULL;
 
-  /* Loop through each module in the Index */
-  g_hash_table_iter_init (&iter, from->modules);
+  g_hash_table_iter_init (&iter, pending_defaults);
   while (g_hash_table_iter_next (&iter, &key, &value))
     {
       module_name = (const gchar *)key;
-      g_debug ("Merging module %s", module_name);
+      defaults_list = (GPtrArray *)value;
 
-      module = MODULEMD_MODULE (value);
-      into_module = get_or_create_module (into, module_name);
-
-      /* Copy all module streams for this module
-       * The module streams have "version" and "context" to disambiguate them,
-       * so we have documented that if there are two modules with differing
-       * content and the same NSVC, the operation is undefined.
-       * As such, we'll just assume it's safe to add every stream. If there are
-       * duplicates, they'll be deduplicated by replacing the previously-
-       * existing entry.
+      g_debug ("Prioritizer: merging %u defaults for %s",
+               defaults_list->len,
+               module_name);
+
+      /* Unless we've been told to override (we're at a higher priority
+       * level), the defaults already on the target participate in the merge.
        */
-      g_debug ("Prioritizer: merging streams for %s", module_name);
-      streams = modulemd_module_get_all_streams (module);
-      for (i = 0; i < streams->len; i++)
-        {
-          stream = g_ptr_array_index (streams, i);
+      into_defaults = modulemd_module_get_defaults (
+        modulemd_module_index_get_module (into, module_name));
+      if (!override && into_defaults)
+        g_ptr_array_insert (defaults_list, 0, into_defaults);
 
-          if (!modulemd_module_index_add_module_stream (
-                into, stream, &nested_error))
+      if (defaults_list->len == 1)
+        {
+          /* Nothing to merge with, so add_defaults() makes the only copy */
+          if (!modulemd_module_index_add_defaults (
+                into, g_ptr_array_index (defaults_list, 0), &nested_error))
             {
               g_propagate_error (error, g_steal_pointer (&nested_error));
               return FALSE;
             }
+          continue;
         }
 
+      merged_defaults = modulemd_defaults_merge_n (
+        defaults_list, strict_default_streams, &conflicts, &nested_error);
 
-      /* Merge any defaults entry for this module */
-      g_debug ("Prioritizer: merging defaults for %s", module_name);
-      defaults = modulemd_module_get_defaults (module);
-      into_defaults = modulemd_module_get_defaults (into_module);
-      if (override && defaults)
+      for (guint i = 0; conflicts && i < conflicts->len; i++)
         {
-          /* If we've been told to override (we're at a higher priority level),
-           * then just replace the current defaults with the new one
-           */
-          if (!modulemd_module_index_add_defaults (
-                into, defaults, &nested_error))
-            {
-              g_propagate_error (error, g_steal_pointer (&nested_error));
-              return FALSE;
-            }
+          conflict = g_ptr_array_index (conflicts, i);
+          intent = modulemd_defaults_conflict_get_intent (conflict);
+          stream_name = modulemd_defaults_conflict_get_stream_name (conflict);
+          values = g_strjoinv (
+            " != ",
+            (gchar **)modulemd_defaults_conflict_peek_values (conflict));
+          g_info (
+            "Defaults conflict for module %s (intent: %s, stream: %s): %s",
+            module_name,
+            intent ? intent : "<none>",
+            stream_name ? stream_name : "<none>",
+            values);
+          g_clear_pointer (&values, g_free);
+
+          if (all_conflicts)
+            g_ptr_array_add (all_conflicts, g_object_ref (conflict));
         }
-      else if (!defaults)
+      g_clear_pointer (&conflicts, g_ptr_array_unref);
+
+      if (!merged_defaults)
         {
-          /* No defaults to merge in right now, just continue */
+          g_propagate_error (error, g_steal_pointer (&nested_error));
+          return FALSE;
         }
-      else if (defaults && !into_defaults)
+
+      /* Add the new, merged defaults to the index */
+      if (!modulemd_module_index_add_defaults (
+            into, merged_defaults, &nested_error))
         {
-          /* There are no defaults on the target module yet. Copy these */
-          if (!modulemd_module_index_add_defaults (
-                into, defaults, &nested_error))
-            {
-              g_propagate_error (error, g_steal_pointer (&nested_error));
-              return FALSE;
-            }
+          g_propagate_error (error, g_steal_pointer (&nested_error));
+          return FALSE;
         }
-      else
+      g_clear_object (&merged_defaults);
+    }
+
+  return TRUE;
+}
+
+
+gboolean
+modulemd_module_index_merge_all (GPtrArray *from_indexes,
+                                 ModulemdModuleIndex *into,
+                                 gboolean override,
+                                 gboolean strict_default_streams,
+                                 GPtrArray *conflicts,
+                                 GError **error)
+{
+  MODULEMD_INIT_TRACE ();
+  GHashTableIter iter;
+  gpointer key, value;
+  const gchar *module_name = NULL;
+  const gchar *trans_stream = NULL;
+  ModulemdModuleIndex *from = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModule *into_module = NULL;
+  GPtrArray *streams = NULL;
+  ModulemdModuleStream *stream = NULL;
+  ModulemdTranslation *translation = NULL;
+  ModulemdTranslation *current_translation = NULL;
+  ModulemdDefaults *defaults = NULL;
+  GPtrArray *defaults_list = NULL;
+  g_autoptr (GHashTable) pending_defaults = NULL;
+  g_autoptr (GError) nested_error = NULL;
+  guint i;
+  g_autoptr (GPtrArray) translated_stream_names = NULL;
+  gchar *translated_stream_name = NULL;
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_MERGE);
+
+  g_return_val_if_fail (from_indexes, FALSE);
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (into), FALSE);
+  g_return_val_if_fail (!into->frozen, FALSE);
+
+  INDEX_STAT_TIMER (into, INDEX_STAT_TIME_MERGE);
+
+  /* Module name -> GPtrArray of the ModulemdDefaults (borrowed from the
+   * indexes being merged) for that module. They are merged together in a
+   * single pass once every index has been visited.
+   */
+  pending_defaults = g_hash_table_new_full (
+    g_str_hash, g_str_equal, NULL, (GDestroyNotify)g_ptr_array_unref);
+
+  for (guint idx = 0; idx < from_indexes->len; idx++)
+    {
+      from = g_ptr_array_index (from_indexes, idx);
+
+      /* Loop through each module in the Index */
+      g_hash_table_iter_init (&iter, from->modules);
+      while (g_hash_table_iter_next (&iter, &key, &value))
         {
-          merged_defaults = modulemd_defaults_merge (
-            defaults, into_defaults, strict_default_streams, &nested_error);
-          if (!merged_defaults)
+          module_name = (const gchar *)key;
+          g_debug ("Merging module %s", module_name);
+
+          module = MODULEMD_MODULE (value);
+          into_module = get_or_create_module (into, module_name);
+
+          /* Copy all module streams for this module
+           * The module streams have "version" and "context" to disambiguate
+           * them, so we have documented that if there are two modules with
+           * differing content and the same NSVC, the operation is undefined.
+           * As such, we'll just assume it's safe to add every stream. If there
+           * are duplicates, they'll be deduplicated by replacing the
+           * previously-existing entry.
+           */
+          g_debug ("Prioritizer: merging streams for %s", module_name);
+          streams = modulemd_module_get_all_streams (module);
+          for (i = 0; i < streams->len; i++)
             {
-              g_propagate_error (error, g_steal_pointer (&nested_error));
-              return FALSE;
+              stream = g_ptr_array_index (streams, i);
+
+              if (!modulemd_module_index_add_module_stream (
+                    into, stream, &nested_error))
+                {
+                  g_propagate_error (error, g_steal_pointer (&nested_error));
+                  return FALSE;
+                }
             }
 
-          /* Add the new, merged defaults to the index */
-          if (!modulemd_module_index_add_defaults (
-                into, merged_defaults, &nested_error))
+
+          /* Queue any defaults entry for this module */
+          defaults = modulemd_module_get_defaults (module);
+          if (defaults)
             {
-              g_propagate_error (error, g_steal_pointer (&nested_error));
-              return FALSE;
+              defaults_list =
+                g_hash_table_lookup (pending_defaults, module_name);
+              if (!defaults_list)
+                {
+                  defaults_list = g_ptr_array_new ();
+                  g_hash_table_insert (
+                    pending_defaults, (gpointer)module_name, defaults_list);
+                }
+              g_ptr_array_add (defaults_list, defaults);
             }
-          g_clear_object (&merged_defaults);
-        }
 
-      /* Merge translations for this module */
-      g_debug ("Prioritizer: merging translations for %s", module_name);
-      translated_stream_names =
-        modulemd_module_get_translated_streams (module);
-      for (i = 0; i < translated_stream_names->len; i++)
-        {
-          translated_stream_name =
-            g_ptr_array_index (translated_stream_names, i);
-          translation =
-            modulemd_module_get_translation (module, translated_stream_name);
-          trans_stream = modulemd_translation_get_module_stream (translation);
-          current_translation =
-            modulemd_module_get_translation (into_module, trans_stream);
-
-          if (!current_translation ||
-              modulemd_translation_get_modified (translation) >
-                modulemd_translation_get_modified (current_translation))
+          /* Merge translations for this module */
+          g_debug ("Prioritizer: merging translations for %s", module_name);
+          translated_stream_names =
+            modulemd_module_get_translated_streams (module);
+          for (i = 0; i < translated_stream_names->len; i++)
             {
-              /* There was no translation for this stream name or we just found
-               * a newer version of it, so set it on the index.
-               */
-              if (!modulemd_module_index_add_translation (
-                    into, translation, &nested_error))
+              translated_stream_name =
+                g_ptr_array_index (translated_stream_names, i);
+              translation = modulemd_module_get_translation (
+                module, translated_stream_name);
+              trans_stream =
+                modulemd_translation_get_module_stream (translation);
+              current_translation =
+                modulemd_module_get_translation (into_module, trans_stream);
+
+              if (!current_translation ||
+                  modulemd_translation_get_modified (translation) >
+                    modulemd_translation_get_modified (current_translation))
                 {
-                  g_propagate_error (error, g_steal_pointer (&nested_error));
-                  return FALSE;
+                  /* There was no translation for this stream name or we just
+                   * found a newer version of it, so set it on the index.
+                   */
+                  if (!modulemd_module_index_add_translation (
+                        into, translation, &nested_error))
+                    {
+                      g_propagate_error (error,
+                                         g_steal_pointer (&nested_error));
+                      return FALSE;
+                    }
                 }
             }
-        }
-      g_clear_pointer (&translated_stream_names, g_ptr_array_unref);
+          g_clear_pointer (&translated_stream_names, g_ptr_array_unref);
 
-      g_debug ("Prioritizer: all documents merged for %s", module_name);
-      g_clear_pointer (&translations, g_ptr_array_unref);
+          g_debug ("Prioritizer: all documents merged for %s", module_name);
+        }
     }
-  return TRUE;
+
+  return merge_pending_defaults (into,
+                                 pending_defaults,
+                                 override,
+                                 strict_default_streams,
+                                 conflicts,
+                                 error);
 }
 
 
@@ -1298,3 +2550,298 @@ modulemd_module_index_get_stream_mdversion (ModulemdModuleIndex *self)
 {
   return self->stream_mdversion;
 }
+
+
+void
+modulemd_module_index_freeze (ModulemdModuleIndex *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+  GPtrArray *streams = NULL;
+  ModulemdModuleStream *stream = NULL;
+
+  g_return_if_fail (MODULEMD_IS_MODULE_INDEX (self));
+
+  if (self->frozen)
+    return;
+
+  /* Build everything that readers would otherwise create on first use */
+  self->module_names =
+    modulemd_ordered_str_keys (self->modules, modulemd_strcmp_sort);
+
+  build_all_default_streams (self);
+
+  ensure_artifact_streams (self, FALSE);
+  ensure_artifact_streams (self, TRUE);
+
+  g_hash_table_iter_init (&iter, self->modules);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      streams = modulemd_module_get_all_streams (MODULEMD_MODULE (value));
+      g_ptr_array_sort (streams, compare_stream_SVCA);
+
+      for (guint i = 0; i < streams->len; i++)
+        {
+          stream = g_ptr_array_index (streams, i);
+
+          /* Invalid streams simply stay unvalidated, and fail to dump as
+           * they would have anyway.
+           */
+          if (!modulemd_module_stream_is_validated (stream))
+            modulemd_module_stream_validate (stream, NULL);
+
+          modulemd_module_stream_freeze (stream);
+        }
+
+      modulemd_module_freeze (MODULEMD_MODULE (value));
+    }
+
+  self->frozen = TRUE;
+}
+
+
+gboolean
+modulemd_module_index_is_frozen (ModulemdModuleIndex *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), FALSE);
+
+  return self->frozen;
+}
+
+
+ModulemdIndexDiff *
+modulemd_module_index_diff (ModulemdModuleIndex *from, ModulemdModuleIndex *to)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (from), NULL);
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (to), NULL);
+
+  return modulemd_index_diff_new (from, to);
+}
+
+
+static GVariant *
+export_strv (const gchar *const *strv)
+{
+  return g_variant_new_strv (strv, -1);
+}
+
+
+static GVariant *
+export_requirements_v1 (GHashTable *deps)
+{
+  GVariantBuilder builder;
+  g_autofree const gchar **modules = modulemd_ordered_str_keys_borrowed (deps);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sas}"));
+  for (guint i = 0; modules[i]; i++)
+    {
+      const gchar *streams[] = { g_hash_table_lookup (deps, modules[i]),
+                                 NULL };
+
+      g_variant_builder_add (
+        &builder, "{s@as}", modules[i], export_strv (streams));
+    }
+
+  return g_variant_builder_end (&builder);
+}
+
+
+static GVariant *
+export_requirements_v2 (ModulemdDependencies *deps, gboolean buildtime)
+{
+  GVariantBuilder builder;
+  const gchar *const *modules = NULL;
+  const gchar *const *streams = NULL;
+
+  if (buildtime)
+    modules = modulemd_dependencies_peek_buildtime_modules (deps);
+  else
+    modules = modulemd_dependencies_peek_runtime_modules (deps);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sas}"));
+  for (guint i = 0; modules[i]; i++)
+    {
+      if (buildtime)
+        streams =
+          modulemd_dependencies_peek_buildtime_streams (deps, modules[i]);
+      else
+        streams =
+          modulemd_dependencies_peek_runtime_streams (deps, modules[i]);
+
+      g_variant_builder_add (
+        &builder, "{s@as}", modules[i], export_strv (streams));
+    }
+
+  return g_variant_builder_end (&builder);
+}
+
+
+static GVariant *
+export_dependencies (ModulemdModuleStream *stream)
+{
+  GVariantBuilder builder;
+  GPtrArray *dependencies = NULL;
+  ModulemdDependencies *deps = NULL;
+  ModulemdModuleStreamV1 *v1_stream = NULL;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sa{sas}}"));
+
+  /* The single module -> stream maps of v1 streams are exported as one
+   * dependencies block, so that both versions have the same layout.
+   */
+  if (MODULEMD_IS_MODULE_STREAM_V1 (stream))
+    {
+      v1_stream = MODULEMD_MODULE_STREAM_V1 (stream);
+
+      g_variant_builder_open (&builder, G_VARIANT_TYPE ("a{sa{sas}}"));
+      g_variant_builder_add (
+        &builder,
+        "{s@a{sas}}",
+        "buildrequires",
+        export_requirements_v1 (v1_stream->buildtime_deps));
+      g_variant_builder_add (&builder,
+                             "{s@a{sas}}",
+                             "requires",
+                             export_requirements_v1 (v1_stream->runtime_deps));
+      g_variant_builder_close (&builder);
+    }
+  else if (MODULEMD_IS_MODULE_STREAM_V2 (stream))
+    {
+      dependencies = MODULEMD_MODULE_STREAM_V2 (stream)->dependencies;
+
+      for (guint i = 0; i < dependencies->len; i++)
+        {
+          deps = g_ptr_array_index (dependencies, i);
+
+          g_variant_builder_open (&builder, G_VARIANT_TYPE ("a{sa{sas}}"));
+          g_variant_builder_add (&builder,
+                                 "{s@a{sas}}",
+                                 "buildrequires",
+                                 export_requirements_v2 (deps, TRUE));
+          g_variant_builder_add (&builder,
+                                 "{s@a{sas}}",
+                                 "requires",
+                                 export_requirements_v2 (deps, FALSE));
+          g_variant_builder_close (&builder);
+        }
+    }
+
+  return g_variant_builder_end (&builder);
+}
+
+
+static GVariant *
+export_rpm_artifacts (ModulemdModuleStream *stream)
+{
+  g_autofree const gchar **artifacts = NULL;
+
+  if (MODULEMD_IS_MODULE_STREAM_V2 (stream))
+    return export_strv (modulemd_module_stream_v2_peek_rpm_artifacts (
+      MODULEMD_MODULE_STREAM_V2 (stream)));
+
+  artifacts =
+    modulemd_ordered_str_keys_borrowed (get_stream_rpm_artifacts (stream));
+
+  return export_strv (artifacts);
+}
+
+
+static GVariant *
+export_nullable_string (const gchar *str)
+{
+  return g_variant_new_maybe (G_VARIANT_TYPE_STRING,
+                              str ? g_variant_new_string (str) : NULL);
+}
+
+
+static GVariant *
+export_stream (ModulemdModuleStream *stream)
+{
+  GVariantBuilder builder;
+  g_autofree gchar *nsvca = NULL;
+
+  nsvca = modulemd_module_stream_get_NSVCA_as_string (stream);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+  g_variant_builder_add (
+    &builder,
+    "{sv}",
+    "module_name",
+    g_variant_new_string (modulemd_module_stream_get_module_name (stream)));
+  g_variant_builder_add (
+    &builder,
+    "{sv}",
+    "stream_name",
+    g_variant_new_string (modulemd_module_stream_get_stream_name (stream)));
+  g_variant_builder_add (
+    &builder,
+    "{sv}",
+    "version",
+    g_variant_new_uint64 (modulemd_module_stream_get_version (stream)));
+  g_variant_builder_add (
+    &builder,
+    "{sv}",
+    "context",
+    export_nullable_string (modulemd_module_stream_get_context (stream)));
+  g_variant_builder_add (
+    &builder,
+    "{sv}",
+    "arch",
+    export_nullable_string (modulemd_module_stream_get_arch (stream)));
+  g_variant_builder_add (
+    &builder, "{sv}", "nsvca", g_variant_new_string (nsvca));
+  g_variant_builder_add (
+    &builder, "{sv}", "rpm_artifacts", export_rpm_artifacts (stream));
+  g_variant_builder_add (
+    &builder, "{sv}", "dependencies", export_dependencies (stream));
+
+  return g_variant_builder_end (&builder);
+}
+
+
+GVariant *
+modulemd_module_index_export_streams (ModulemdModuleIndex *self)
+{
+  GVariantBuilder builder;
+  g_autoptr (GPtrArray) module_names = NULL;
+  ModulemdModule *module = NULL;
+  GPtrArray *streams = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  module_names = get_ordered_module_names (self);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sv}"));
+  for (guint i = 0; i < module_names->len; i++)
+    {
+      module = g_hash_table_lookup (self->modules,
+                                    g_ptr_array_index (module_names, i));
+      streams = modulemd_module_get_all_streams (module);
+
+      /* Use the order the streams are dumped in. Those of a frozen index
+       * were sorted when it was frozen.
+       */
+      if (!self->frozen)
+        g_ptr_array_sort (streams, compare_stream_SVCA);
+
+      for (guint j = 0; j < streams->len; j++)
+        g_variant_builder_add_value (
+          &builder, export_stream (g_ptr_array_index (streams, j)));
+    }
+
+  return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+
+gchar *
+modulemd_module_index_export_streams_as_json (ModulemdModuleIndex *self)
+{
+  g_autoptr (GVariant) streams = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_INDEX (self), NULL);
+
+  streams = modulemd_module_index_export_streams (self);
+
+  return modulemd_variant_to_json (streams);
+}
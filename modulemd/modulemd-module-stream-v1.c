@@ -119,6 +119,10 @@ modulemd_module_stream_v1_set_arch (ModulemdModuleStreamV1 *self,
                                     const gchar *arch)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   modulemd_module_stream_set_arch (MODULEMD_MODULE_STREAM (self), arch);
 
@@ -140,9 +144,17 @@ modulemd_module_stream_v1_set_buildopts (ModulemdModuleStreamV1 *self,
                                          ModulemdBuildopts *buildopts)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_object (&self->buildopts);
   self->buildopts = modulemd_buildopts_copy (buildopts);
+  if (self->buildopts)
+    modulemd_buildopts_set_owner (
+      self->buildopts,
+      modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_BUILDOPTS]);
 }
@@ -162,6 +174,10 @@ modulemd_module_stream_v1_set_community (ModulemdModuleStreamV1 *self,
                                          const gchar *community)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->community, g_free);
   self->community = g_strdup (community);
@@ -184,6 +200,10 @@ modulemd_module_stream_v1_set_description (ModulemdModuleStreamV1 *self,
                                            const gchar *description)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->description, g_free);
   self->description = g_strdup (description);
@@ -212,6 +232,10 @@ modulemd_module_stream_v1_set_documentation (ModulemdModuleStreamV1 *self,
                                              const gchar *documentation)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->documentation, g_free);
   self->documentation = g_strdup (documentation);
@@ -234,6 +258,10 @@ modulemd_module_stream_v1_set_summary (ModulemdModuleStreamV1 *self,
                                        const gchar *summary)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->summary, g_free);
   self->summary = g_strdup (summary);
@@ -261,6 +289,10 @@ modulemd_module_stream_v1_set_tracker (ModulemdModuleStreamV1 *self,
                                        const gchar *tracker)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->tracker, g_free);
   self->tracker = g_strdup (tracker);
@@ -286,14 +318,19 @@ modulemd_module_stream_v1_add_component (ModulemdModuleStreamV1 *self,
                                          ModulemdComponent *component)
 {
   GHashTable *table = NULL;
+  ModulemdComponent *copied_component = NULL;
 
   /* Do nothing if we were passed a NULL component */
   if (!component)
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (MODULEMD_IS_COMPONENT (component));
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   if (MODULEMD_IS_COMPONENT_RPM (component))
     {
       table = self->rpm_components;
@@ -308,12 +345,17 @@ modulemd_module_stream_v1_add_component (ModulemdModuleStreamV1 *self,
       g_return_if_reached ();
     }
 
+  copied_component = modulemd_component_copy (component, NULL);
+  modulemd_component_set_owner (
+    copied_component,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
+
   /* Add the component to the table. This will replace an existing component
    * with the same name
    */
   g_hash_table_replace (table,
                         g_strdup (modulemd_component_get_key (component)),
-                        modulemd_component_copy (component, NULL));
+                        copied_component);
 }
 
 
@@ -326,6 +368,10 @@ modulemd_module_stream_v1_remove_module_component (
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->module_components, component_name);
 }
@@ -336,6 +382,10 @@ modulemd_module_stream_v1_clear_module_components (
   ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->module_components);
 }
@@ -350,6 +400,10 @@ modulemd_module_stream_v1_remove_rpm_component (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_components, component_name);
 }
@@ -359,6 +413,10 @@ void
 modulemd_module_stream_v1_clear_rpm_components (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_components);
 }
@@ -412,6 +470,10 @@ modulemd_module_stream_v1_add_content_license (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->content_licenses, g_strdup (license));
 }
@@ -422,15 +484,37 @@ modulemd_module_stream_v1_replace_content_licenses (
   ModulemdModuleStreamV1 *self, GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->content_licenses, set);
 }
 
 
+static void
+modulemd_module_stream_v1_take_content_licenses (ModulemdModuleStreamV1 *self,
+                                                 GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->content_licenses, set);
+}
+
+
 void
 modulemd_module_stream_v1_clear_content_licenses (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->content_licenses);
 }
@@ -444,6 +528,10 @@ modulemd_module_stream_v1_add_module_license (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->module_licenses, g_strdup (license));
 }
@@ -454,15 +542,37 @@ modulemd_module_stream_v1_replace_module_licenses (
   ModulemdModuleStreamV1 *self, GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->module_licenses, set);
 }
 
 
+static void
+modulemd_module_stream_v1_take_module_licenses (ModulemdModuleStreamV1 *self,
+                                                GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->module_licenses, set);
+}
+
+
 void
 modulemd_module_stream_v1_clear_module_licenses (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->module_licenses);
 }
@@ -476,6 +586,10 @@ modulemd_module_stream_v1_remove_content_license (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->content_licenses, license);
 }
@@ -489,6 +603,10 @@ modulemd_module_stream_v1_remove_module_license (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->module_licenses, license);
 }
@@ -500,7 +618,8 @@ modulemd_module_stream_v1_get_content_licenses_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->content_licenses);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->content_licenses);
 }
 
 
@@ -510,7 +629,8 @@ modulemd_module_stream_v1_get_module_licenses_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->module_licenses);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->module_licenses);
 }
 
 
@@ -521,10 +641,16 @@ modulemd_module_stream_v1_add_profile (ModulemdModuleStreamV1 *self,
   if (!profile)
     return;
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (MODULEMD_IS_PROFILE (profile));
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   ModulemdProfile *copied_profile = modulemd_profile_copy (profile);
-  modulemd_profile_set_owner (copied_profile, MODULEMD_MODULE_STREAM (self));
+  modulemd_profile_set_owner (
+    copied_profile,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
 
   g_hash_table_replace (self->profiles,
                         g_strdup (modulemd_profile_get_name (profile)),
@@ -536,6 +662,10 @@ void
 modulemd_module_stream_v1_clear_profiles (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->profiles);
 }
@@ -569,6 +699,10 @@ modulemd_module_stream_v1_add_rpm_api (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->rpm_api, g_strdup (rpm));
 }
@@ -579,11 +713,29 @@ modulemd_module_stream_v1_replace_rpm_api (ModulemdModuleStreamV1 *self,
                                            GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->rpm_api, set);
 }
 
 
+static void
+modulemd_module_stream_v1_take_rpm_api (ModulemdModuleStreamV1 *self,
+                                        GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->rpm_api, set);
+}
+
+
 void
 modulemd_module_stream_v1_remove_rpm_api (ModulemdModuleStreamV1 *self,
                                           const gchar *rpm)
@@ -592,6 +744,10 @@ modulemd_module_stream_v1_remove_rpm_api (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_api, rpm);
 }
@@ -601,6 +757,10 @@ void
 modulemd_module_stream_v1_clear_rpm_api (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_api);
 }
@@ -611,7 +771,8 @@ modulemd_module_stream_v1_get_rpm_api_as_strv (ModulemdModuleStreamV1 *self)
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->rpm_api);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->rpm_api);
 }
 
 
@@ -623,6 +784,10 @@ modulemd_module_stream_v1_add_rpm_artifact (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->rpm_artifacts, g_strdup (nevr));
 }
@@ -633,11 +798,29 @@ modulemd_module_stream_v1_replace_rpm_artifacts (ModulemdModuleStreamV1 *self,
                                                  GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->rpm_artifacts, set);
 }
 
 
+static void
+modulemd_module_stream_v1_take_rpm_artifacts (ModulemdModuleStreamV1 *self,
+                                              GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->rpm_artifacts, set);
+}
+
+
 void
 modulemd_module_stream_v1_remove_rpm_artifact (ModulemdModuleStreamV1 *self,
                                                const gchar *nevr)
@@ -646,6 +829,10 @@ modulemd_module_stream_v1_remove_rpm_artifact (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_artifacts, nevr);
 }
@@ -655,6 +842,10 @@ void
 modulemd_module_stream_v1_clear_rpm_artifacts (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_artifacts);
 }
@@ -666,7 +857,8 @@ modulemd_module_stream_v1_get_rpm_artifacts_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->rpm_artifacts);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->rpm_artifacts);
 }
 
 
@@ -678,6 +870,10 @@ modulemd_module_stream_v1_add_rpm_filter (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->rpm_filters, g_strdup (rpm));
 }
@@ -688,11 +884,29 @@ modulemd_module_stream_v1_replace_rpm_filters (ModulemdModuleStreamV1 *self,
                                                GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->rpm_filters, set);
 }
 
 
+static void
+modulemd_module_stream_v1_take_rpm_filters (ModulemdModuleStreamV1 *self,
+                                            GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->rpm_filters, set);
+}
+
+
 void
 modulemd_module_stream_v1_remove_rpm_filter (ModulemdModuleStreamV1 *self,
                                              const gchar *rpm)
@@ -701,6 +915,10 @@ modulemd_module_stream_v1_remove_rpm_filter (ModulemdModuleStreamV1 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_filters, rpm);
 }
@@ -710,6 +928,10 @@ void
 modulemd_module_stream_v1_clear_rpm_filters (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_filters);
 }
@@ -721,7 +943,8 @@ modulemd_module_stream_v1_get_rpm_filters_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->rpm_filters);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->rpm_filters);
 }
 
 
@@ -729,15 +952,26 @@ void
 modulemd_module_stream_v1_add_servicelevel (ModulemdModuleStreamV1 *self,
                                             ModulemdServiceLevel *servicelevel)
 {
+  ModulemdServiceLevel *copied_servicelevel = NULL;
+
   if (!servicelevel)
     return;
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (MODULEMD_IS_SERVICE_LEVEL (servicelevel));
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  copied_servicelevel = modulemd_service_level_copy (servicelevel);
+  modulemd_service_level_set_owner (
+    copied_servicelevel,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
+
   g_hash_table_replace (
     self->servicelevels,
     g_strdup (modulemd_service_level_get_name (servicelevel)),
-    modulemd_service_level_copy (servicelevel));
+    copied_servicelevel);
 }
 
 
@@ -745,6 +979,10 @@ void
 modulemd_module_stream_v1_clear_servicelevels (ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->servicelevels);
 }
@@ -774,6 +1012,10 @@ void
 modulemd_module_stream_v1_set_eol (ModulemdModuleStreamV1 *self, GDate *eol)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   /* The "eol" field in the YAML is a relic of an early iteration and has been
    * entirely replaced by the ServiceLevel concept. If we encounter it, we just
@@ -805,8 +1047,12 @@ modulemd_module_stream_v1_add_buildtime_requirement (
   const gchar *module_stream)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (module_name && module_stream);
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   g_hash_table_replace (
     self->buildtime_deps, g_strdup (module_name), g_strdup (module_stream));
 }
@@ -817,6 +1063,10 @@ modulemd_module_stream_v1_replace_buildtime_deps (ModulemdModuleStreamV1 *self,
                                                   GHashTable *deps)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   if (deps)
     {
@@ -837,8 +1087,12 @@ modulemd_module_stream_v1_add_runtime_requirement (
   const gchar *module_stream)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (module_name && module_stream);
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   g_hash_table_replace (
     self->runtime_deps, g_strdup (module_name), g_strdup (module_stream));
 }
@@ -849,6 +1103,10 @@ modulemd_module_stream_v1_replace_runtime_deps (ModulemdModuleStreamV1 *self,
                                                 GHashTable *deps)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   if (deps)
     {
@@ -867,8 +1125,12 @@ modulemd_module_stream_v1_remove_buildtime_requirement (
   ModulemdModuleStreamV1 *self, const gchar *module_name)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (module_name);
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   g_hash_table_remove (self->buildtime_deps, module_name);
 }
 
@@ -878,8 +1140,12 @@ modulemd_module_stream_v1_remove_runtime_requirement (
   ModulemdModuleStreamV1 *self, const gchar *module_name)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (module_name);
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   g_hash_table_remove (self->runtime_deps, module_name);
 }
 
@@ -889,6 +1155,10 @@ modulemd_module_stream_v1_clear_buildtime_requirements (
   ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->buildtime_deps);
 }
@@ -899,6 +1169,10 @@ modulemd_module_stream_v1_clear_runtime_requirements (
   ModulemdModuleStreamV1 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->runtime_deps);
 }
@@ -948,6 +1222,10 @@ void
 modulemd_module_stream_v1_set_xmd (ModulemdModuleStreamV1 *self, GVariant *xmd)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   /* Do nothing if we were passed the same pointer */
   if (self->xmd == xmd)
@@ -966,6 +1244,45 @@ modulemd_module_stream_v1_get_xmd (ModulemdModuleStreamV1 *self)
 }
 
 
+gboolean
+modulemd_module_stream_v1_set_xmd_from_json (ModulemdModuleStreamV1 *self,
+                                             const gchar *json,
+                                             GError **error)
+{
+  GVariant *xmd = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), FALSE);
+  g_return_val_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)),
+    FALSE);
+  g_return_val_if_fail (json, FALSE);
+
+  xmd = modulemd_variant_from_json (json, error);
+  if (!xmd)
+    return FALSE;
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  /* The new variant is not shared with the caller, so needs no copy */
+  g_clear_pointer (&self->xmd, g_variant_unref);
+  self->xmd = xmd;
+
+  return TRUE;
+}
+
+
+gchar *
+modulemd_module_stream_v1_get_xmd_as_json (ModulemdModuleStreamV1 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self), NULL);
+
+  if (self->xmd == NULL)
+    return NULL;
+
+  return modulemd_variant_to_json (self->xmd);
+}
+
+
 static gboolean
 modulemd_module_stream_v1_equals (ModulemdModuleStream *self_1,
                                   ModulemdModuleStream *self_2)
@@ -1079,7 +1396,8 @@ modulemd_module_stream_v1_equals (ModulemdModuleStream *self_1,
   if (v1_self_1->xmd == NULL || v1_self_2->xmd == NULL)
     return FALSE;
 
-  if (!g_variant_equal (v1_self_1->xmd, v1_self_2->xmd))
+  if (v1_self_1->xmd != v1_self_2->xmd &&
+      !g_variant_equal (v1_self_1->xmd, v1_self_2->xmd))
     return FALSE;
 
   return TRUE;
@@ -1255,14 +1573,17 @@ modulemd_module_stream_v1_copy (ModulemdModuleStream *self,
 
   /* Properties */
   STREAM_COPY_IF_SET (v1, copy, v1_self, arch);
-  STREAM_COPY_IF_SET (v1, copy, v1_self, buildopts);
+  if (v1_self->buildopts != NULL)
+    modulemd_module_stream_v1_set_buildopts (copy, v1_self->buildopts);
   STREAM_COPY_IF_SET (v1, copy, v1_self, community);
   STREAM_COPY_IF_SET_WITH_LOCALE (v1, copy, v1_self, description);
   STREAM_COPY_IF_SET (v1, copy, v1_self, documentation);
   STREAM_COPY_IF_SET_WITH_LOCALE (v1, copy, v1_self, summary);
   STREAM_COPY_IF_SET (v1, copy, v1_self, tracker);
 
-  /* Internal Data Structures: With replace function */
+  /* Internal Data Structures: With replace function. These always build new
+   * sets, as those of a frozen stream point into memory owned by it.
+   */
   STREAM_REPLACE_HASHTABLE (v1, copy, v1_self, content_licenses);
   STREAM_REPLACE_HASHTABLE (v1, copy, v1_self, module_licenses);
   STREAM_REPLACE_HASHTABLE (v1, copy, v1_self, rpm_api);
@@ -1281,7 +1602,9 @@ modulemd_module_stream_v1_copy (ModulemdModuleStream *self,
   COPY_HASHTABLE_BY_VALUE_ADDER (
     copy, v1_self, servicelevels, modulemd_module_stream_v1_add_servicelevel);
 
-  STREAM_COPY_IF_SET (v1, copy, v1_self, xmd);
+  /* Shared with the original; see modulemd_module_stream_v2_copy() */
+  if (v1_self->xmd != NULL)
+    copy->xmd = g_variant_ref (v1_self->xmd);
 
   return MODULEMD_MODULE_STREAM (g_steal_pointer (&copy));
 }
@@ -1678,8 +2001,8 @@ modulemd_module_stream_v1_parse_yaml (ModulemdSubdocumentInfo *subdoc,
             {
               set = modulemd_yaml_parse_string_set_from_map (
                 &parser, "rpms", strict, &nested_error);
-              modulemd_module_stream_v1_replace_rpm_api (modulestream, set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v1_take_rpm_api (
+                modulestream, g_steal_pointer (&set));
             }
 
           /* Filter */
@@ -1688,9 +2011,8 @@ modulemd_module_stream_v1_parse_yaml (ModulemdSubdocumentInfo *subdoc,
             {
               set = modulemd_yaml_parse_string_set_from_map (
                 &parser, "rpms", strict, &nested_error);
-              modulemd_module_stream_v1_replace_rpm_filters (modulestream,
-                                                             set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v1_take_rpm_filters (
+                modulestream, g_steal_pointer (&set));
             }
 
           /* Build Options */
@@ -1733,9 +2055,8 @@ modulemd_module_stream_v1_parse_yaml (ModulemdSubdocumentInfo *subdoc,
                   g_propagate_error (error, g_steal_pointer (&nested_error));
                   return NULL;
                 }
-              modulemd_module_stream_v1_replace_rpm_artifacts (modulestream,
-                                                               set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v1_take_rpm_artifacts (
+                modulestream, g_steal_pointer (&set));
             }
 
           /* EOL (Deprecated) */
@@ -1856,16 +2177,15 @@ modulemd_module_stream_v1_parse_licenses (yaml_parser_t *parser,
                   g_propagate_error (error, g_steal_pointer (&nested_error));
                   return FALSE;
                 }
-              modulemd_module_stream_v1_replace_module_licenses (modulestream,
-                                                                 set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v1_take_module_licenses (
+                modulestream, g_steal_pointer (&set));
             }
           else if (g_str_equal ((const gchar *)event.data.scalar.value,
                                 "content"))
             {
               set = modulemd_yaml_parse_string_set (parser, &nested_error);
-              modulemd_module_stream_v1_replace_content_licenses (modulestream,
-                                                                  set);
+              modulemd_module_stream_v1_take_content_licenses (
+                modulestream, g_steal_pointer (&set));
             }
           else
             {
@@ -2633,3 +2953,86 @@ modulemd_module_stream_v1_emit_yaml (ModulemdModuleStreamV1 *self,
 
   return TRUE;
 }
+
+
+void
+modulemd_module_stream_v1_compact_sets (ModulemdModuleStreamV1 *self)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+
+  ModulemdModuleStream *stream = MODULEMD_MODULE_STREAM (self);
+
+  modulemd_module_stream_compact_set (stream, &self->content_licenses);
+  modulemd_module_stream_compact_set (stream, &self->module_licenses);
+  modulemd_module_stream_compact_set (stream, &self->rpm_api);
+  modulemd_module_stream_compact_set (stream, &self->rpm_artifacts);
+  modulemd_module_stream_compact_set (stream, &self->rpm_filters);
+}
+
+
+void
+modulemd_module_stream_v1_fingerprint_fields (
+  ModulemdModuleStreamV1 *self,
+  ModulemdFingerprintFieldFunc func,
+  gpointer user_data)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V1 (self));
+  g_return_if_fail (func);
+
+  func ("buildopts",
+        modulemd_buildopts_fingerprint (self->buildopts),
+        user_data);
+  func ("community", modulemd_fingerprint_string (self->community), user_data);
+  func ("description",
+        modulemd_fingerprint_string (self->description),
+        user_data);
+  func ("documentation",
+        modulemd_fingerprint_string (self->documentation),
+        user_data);
+  func ("summary", modulemd_fingerprint_string (self->summary), user_data);
+  func ("tracker", modulemd_fingerprint_string (self->tracker), user_data);
+  func ("module_components",
+        modulemd_fingerprint_hash_table (
+          self->module_components,
+          (ModulemdFingerprintFunc)modulemd_component_fingerprint),
+        user_data);
+  func ("rpm_components",
+        modulemd_fingerprint_hash_table (
+          self->rpm_components,
+          (ModulemdFingerprintFunc)modulemd_component_fingerprint),
+        user_data);
+  func ("content_licenses",
+        modulemd_fingerprint_set (self->content_licenses),
+        user_data);
+  func ("module_licenses",
+        modulemd_fingerprint_set (self->module_licenses),
+        user_data);
+  func ("profiles",
+        modulemd_fingerprint_hash_table (
+          self->profiles,
+          (ModulemdFingerprintFunc)modulemd_profile_fingerprint),
+        user_data);
+  func ("rpm_api", modulemd_fingerprint_set (self->rpm_api), user_data);
+  func ("rpm_artifacts",
+        modulemd_fingerprint_set (self->rpm_artifacts),
+        user_data);
+  func ("rpm_filters",
+        modulemd_fingerprint_set (self->rpm_filters),
+        user_data);
+  func ("servicelevels",
+        modulemd_fingerprint_hash_table (
+          self->servicelevels,
+          (ModulemdFingerprintFunc)modulemd_service_level_fingerprint),
+        user_data);
+
+  func ("buildtime_deps",
+        modulemd_fingerprint_hash_table (self->buildtime_deps,
+                                         modulemd_fingerprint_string),
+        user_data);
+  func ("runtime_deps",
+        modulemd_fingerprint_hash_table (self->runtime_deps,
+                                         modulemd_fingerprint_string),
+        user_data);
+
+  func ("xmd", modulemd_fingerprint_variant (self->xmd), user_data);
+}
@@ -232,7 +232,9 @@ modulemd_module_stream_v2_equals (ModulemdModuleStream *self_1,
   if (v2_self_1->xmd == NULL || v2_self_2->xmd == NULL)
     return FALSE;
 
-  if (!g_variant_equal (v2_self_1->xmd, v2_self_2->xmd))
+  /* Copies share the same xmd, so this usually short-circuits */
+  if (v2_self_1->xmd != v2_self_2->xmd &&
+      !g_variant_equal (v2_self_1->xmd, v2_self_2->xmd))
     return FALSE;
 
   return TRUE;
@@ -251,6 +253,10 @@ modulemd_module_stream_v2_set_arch (ModulemdModuleStreamV2 *self,
                                     const gchar *arch)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   modulemd_module_stream_set_arch (MODULEMD_MODULE_STREAM (self), arch);
 
@@ -272,9 +278,17 @@ modulemd_module_stream_v2_set_buildopts (ModulemdModuleStreamV2 *self,
                                          ModulemdBuildopts *buildopts)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_object (&self->buildopts);
   self->buildopts = modulemd_buildopts_copy (buildopts);
+  if (self->buildopts)
+    modulemd_buildopts_set_owner (
+      self->buildopts,
+      modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_BUILDOPTS]);
 }
@@ -294,6 +308,10 @@ modulemd_module_stream_v2_set_community (ModulemdModuleStreamV2 *self,
                                          const gchar *community)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->community, g_free);
   self->community = g_strdup (community);
@@ -316,6 +334,10 @@ modulemd_module_stream_v2_set_description (ModulemdModuleStreamV2 *self,
                                            const gchar *description)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->description, g_free);
   self->description = g_strdup (description);
@@ -344,6 +366,10 @@ modulemd_module_stream_v2_set_documentation (ModulemdModuleStreamV2 *self,
                                              const gchar *documentation)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->documentation, g_free);
   self->documentation = g_strdup (documentation);
@@ -366,6 +392,10 @@ modulemd_module_stream_v2_set_summary (ModulemdModuleStreamV2 *self,
                                        const gchar *summary)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->summary, g_free);
   self->summary = g_strdup (summary);
@@ -393,6 +423,10 @@ modulemd_module_stream_v2_set_tracker (ModulemdModuleStreamV2 *self,
                                        const gchar *tracker)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_clear_pointer (&self->tracker, g_free);
   self->tracker = g_strdup (tracker);
@@ -417,14 +451,19 @@ modulemd_module_stream_v2_add_component (ModulemdModuleStreamV2 *self,
                                          ModulemdComponent *component)
 {
   GHashTable *table = NULL;
+  ModulemdComponent *copied_component = NULL;
 
   /* Do nothing if we were passed a NULL component */
   if (!component)
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (MODULEMD_IS_COMPONENT (component));
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   if (MODULEMD_IS_COMPONENT_RPM (component))
     {
       table = self->rpm_components;
@@ -439,12 +478,17 @@ modulemd_module_stream_v2_add_component (ModulemdModuleStreamV2 *self,
       g_return_if_reached ();
     }
 
+  copied_component = modulemd_component_copy (component, NULL);
+  modulemd_component_set_owner (
+    copied_component,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
+
   /* Add the component to the table. This will replace an existing component
    * with the same name
    */
   g_hash_table_replace (table,
                         g_strdup (modulemd_component_get_key (component)),
-                        modulemd_component_copy (component, NULL));
+                        copied_component);
 }
 
 
@@ -457,6 +501,10 @@ modulemd_module_stream_v2_remove_module_component (
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->module_components, component_name);
 }
@@ -467,6 +515,10 @@ modulemd_module_stream_v2_clear_module_components (
   ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->module_components);
 }
@@ -481,6 +533,10 @@ modulemd_module_stream_v2_remove_rpm_component (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_components, component_name);
 }
@@ -490,6 +546,10 @@ void
 modulemd_module_stream_v2_clear_rpm_components (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_components);
 }
@@ -505,6 +565,17 @@ modulemd_module_stream_v2_get_module_component_names_as_strv (
 }
 
 
+const gchar *const *
+modulemd_module_stream_v2_peek_module_component_names (
+  ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->module_components);
+}
+
+
 GStrv
 modulemd_module_stream_v2_get_rpm_component_names_as_strv (
   ModulemdModuleStreamV2 *self)
@@ -515,6 +586,17 @@ modulemd_module_stream_v2_get_rpm_component_names_as_strv (
 }
 
 
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_component_names (
+  ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->rpm_components);
+}
+
+
 ModulemdComponentModule *
 modulemd_module_stream_v2_get_module_component (ModulemdModuleStreamV2 *self,
                                                 const gchar *component_name)
@@ -543,6 +625,10 @@ modulemd_module_stream_v2_add_content_license (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->content_licenses, g_strdup (license));
 }
@@ -553,11 +639,29 @@ modulemd_module_stream_v2_replace_content_licenses (
   ModulemdModuleStreamV2 *self, GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->content_licenses, set);
 }
 
 
+static void
+modulemd_module_stream_v2_take_content_licenses (ModulemdModuleStreamV2 *self,
+                                                 GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->content_licenses, set);
+}
+
+
 void
 modulemd_module_stream_v2_add_module_license (ModulemdModuleStreamV2 *self,
                                               const gchar *license)
@@ -566,6 +670,10 @@ modulemd_module_stream_v2_add_module_license (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->module_licenses, g_strdup (license));
 }
@@ -576,11 +684,29 @@ modulemd_module_stream_v2_replace_module_licenses (
   ModulemdModuleStreamV2 *self, GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->module_licenses, set);
 }
 
 
+static void
+modulemd_module_stream_v2_take_module_licenses (ModulemdModuleStreamV2 *self,
+                                                GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->module_licenses, set);
+}
+
+
 void
 modulemd_module_stream_v2_remove_content_license (ModulemdModuleStreamV2 *self,
                                                   const gchar *license)
@@ -589,6 +715,10 @@ modulemd_module_stream_v2_remove_content_license (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->content_licenses, license);
 }
@@ -602,6 +732,10 @@ modulemd_module_stream_v2_remove_module_license (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->module_licenses, license);
 }
@@ -611,6 +745,10 @@ void
 modulemd_module_stream_v2_clear_content_licenses (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->content_licenses);
 }
@@ -620,6 +758,10 @@ void
 modulemd_module_stream_v2_clear_module_licenses (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->module_licenses);
 }
@@ -631,7 +773,18 @@ modulemd_module_stream_v2_get_content_licenses_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->content_licenses);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->content_licenses);
+}
+
+
+const gchar *const *
+modulemd_module_stream_v2_peek_content_licenses (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->content_licenses);
 }
 
 
@@ -641,7 +794,18 @@ modulemd_module_stream_v2_get_module_licenses_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->module_licenses);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->module_licenses);
+}
+
+
+const gchar *const *
+modulemd_module_stream_v2_peek_module_licenses (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->module_licenses);
 }
 
 
@@ -652,10 +816,16 @@ modulemd_module_stream_v2_add_profile (ModulemdModuleStreamV2 *self,
   if (!profile)
     return;
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (MODULEMD_IS_PROFILE (profile));
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   ModulemdProfile *copied_profile = modulemd_profile_copy (profile);
-  modulemd_profile_set_owner (copied_profile, MODULEMD_MODULE_STREAM (self));
+  modulemd_profile_set_owner (
+    copied_profile,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
 
   g_hash_table_replace (self->profiles,
                         g_strdup (modulemd_profile_get_name (profile)),
@@ -667,6 +837,10 @@ void
 modulemd_module_stream_v2_clear_profiles (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->profiles);
 }
@@ -682,6 +856,16 @@ modulemd_module_stream_v2_get_profile_names_as_strv (
 }
 
 
+const gchar *const *
+modulemd_module_stream_v2_peek_profile_names (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->profiles);
+}
+
+
 ModulemdProfile *
 modulemd_module_stream_v2_get_profile (ModulemdModuleStreamV2 *self,
                                        const gchar *profile_name)
@@ -700,6 +884,10 @@ modulemd_module_stream_v2_add_rpm_api (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->rpm_api, g_strdup (rpm));
 }
@@ -710,11 +898,29 @@ modulemd_module_stream_v2_replace_rpm_api (ModulemdModuleStreamV2 *self,
                                            GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->rpm_api, set);
 }
 
 
+static void
+modulemd_module_stream_v2_take_rpm_api (ModulemdModuleStreamV2 *self,
+                                        GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->rpm_api, set);
+}
+
+
 void
 modulemd_module_stream_v2_remove_rpm_api (ModulemdModuleStreamV2 *self,
                                           const gchar *rpm)
@@ -723,6 +929,10 @@ modulemd_module_stream_v2_remove_rpm_api (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_api, rpm);
 }
@@ -732,6 +942,10 @@ void
 modulemd_module_stream_v2_clear_rpm_api (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_api);
 }
@@ -742,7 +956,18 @@ modulemd_module_stream_v2_get_rpm_api_as_strv (ModulemdModuleStreamV2 *self)
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->rpm_api);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->rpm_api);
+}
+
+
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_api (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->rpm_api);
 }
 
 
@@ -754,6 +979,10 @@ modulemd_module_stream_v2_add_rpm_artifact (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->rpm_artifacts, g_strdup (nevr));
 }
@@ -764,11 +993,29 @@ modulemd_module_stream_v2_replace_rpm_artifacts (ModulemdModuleStreamV2 *self,
                                                  GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->rpm_artifacts, set);
 }
 
 
+static void
+modulemd_module_stream_v2_take_rpm_artifacts (ModulemdModuleStreamV2 *self,
+                                              GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->rpm_artifacts, set);
+}
+
+
 void
 modulemd_module_stream_v2_remove_rpm_artifact (ModulemdModuleStreamV2 *self,
                                                const gchar *nevr)
@@ -777,6 +1024,10 @@ modulemd_module_stream_v2_remove_rpm_artifact (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_artifacts, nevr);
 }
@@ -786,6 +1037,10 @@ void
 modulemd_module_stream_v2_clear_rpm_artifacts (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_artifacts);
 }
@@ -797,7 +1052,18 @@ modulemd_module_stream_v2_get_rpm_artifacts_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->rpm_artifacts);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->rpm_artifacts);
+}
+
+
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_artifacts (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->rpm_artifacts);
 }
 
 
@@ -826,14 +1092,23 @@ modulemd_module_stream_v2_set_rpm_artifact_map_entry (
   const gchar *checksum)
 {
   GHashTable *digest_table = NULL;
+  ModulemdRpmMapEntry *copied_entry = NULL;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (entry && digest && checksum);
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
   digest_table = get_or_create_digest_table (self, digest);
 
-  g_hash_table_insert (
-    digest_table, g_strdup (checksum), modulemd_rpm_map_entry_copy (entry));
+  copied_entry = modulemd_rpm_map_entry_copy (entry);
+  modulemd_rpm_map_entry_set_owner (
+    copied_entry,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
+
+  g_hash_table_insert (digest_table, g_strdup (checksum), copied_entry);
 }
 
 
@@ -861,6 +1136,10 @@ modulemd_module_stream_v2_add_rpm_filter (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_add (self->rpm_filters, g_strdup (rpm));
 }
@@ -871,11 +1150,29 @@ modulemd_module_stream_v2_replace_rpm_filters (ModulemdModuleStreamV2 *self,
                                                GHashTable *set)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   MODULEMD_REPLACE_SET (self->rpm_filters, set);
 }
 
 
+static void
+modulemd_module_stream_v2_take_rpm_filters (ModulemdModuleStreamV2 *self,
+                                            GHashTable *set)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  MODULEMD_TAKE_SET (self->rpm_filters, set);
+}
+
+
 void
 modulemd_module_stream_v2_remove_rpm_filter (ModulemdModuleStreamV2 *self,
                                              const gchar *rpm)
@@ -884,6 +1181,10 @@ modulemd_module_stream_v2_remove_rpm_filter (ModulemdModuleStreamV2 *self,
     return;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove (self->rpm_filters, rpm);
 }
@@ -893,6 +1194,10 @@ void
 modulemd_module_stream_v2_clear_rpm_filters (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->rpm_filters);
 }
@@ -904,7 +1209,18 @@ modulemd_module_stream_v2_get_rpm_filters_as_strv (
 {
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
 
-  return modulemd_ordered_str_keys_as_strv (self->rpm_filters);
+  return modulemd_module_stream_set_as_strv (MODULEMD_MODULE_STREAM (self),
+                                             self->rpm_filters);
+}
+
+
+const gchar *const *
+modulemd_module_stream_v2_peek_rpm_filters (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->rpm_filters);
 }
 
 
@@ -912,15 +1228,26 @@ void
 modulemd_module_stream_v2_add_servicelevel (ModulemdModuleStreamV2 *self,
                                             ModulemdServiceLevel *servicelevel)
 {
+  ModulemdServiceLevel *copied_servicelevel = NULL;
+
   if (!servicelevel)
     return;
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
   g_return_if_fail (MODULEMD_IS_SERVICE_LEVEL (servicelevel));
 
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  copied_servicelevel = modulemd_service_level_copy (servicelevel);
+  modulemd_service_level_set_owner (
+    copied_servicelevel,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
+
   g_hash_table_replace (
     self->servicelevels,
     g_strdup (modulemd_service_level_get_name (servicelevel)),
-    modulemd_service_level_copy (servicelevel));
+    copied_servicelevel);
 }
 
 
@@ -928,6 +1255,10 @@ void
 modulemd_module_stream_v2_clear_servicelevels (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_hash_table_remove_all (self->servicelevels);
 }
@@ -943,6 +1274,17 @@ modulemd_module_stream_v2_get_servicelevel_names_as_strv (
 }
 
 
+const gchar *const *
+modulemd_module_stream_v2_peek_servicelevel_names (
+  ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  return modulemd_module_stream_peek_sorted_keys (
+    MODULEMD_MODULE_STREAM (self), self->servicelevels);
+}
+
+
 ModulemdServiceLevel *
 modulemd_module_stream_v2_get_servicelevel (ModulemdModuleStreamV2 *self,
                                             const gchar *servicelevel_name)
@@ -957,9 +1299,20 @@ void
 modulemd_module_stream_v2_add_dependencies (ModulemdModuleStreamV2 *self,
                                             ModulemdDependencies *deps)
 {
+  ModulemdDependencies *copied_deps = NULL;
+
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
 
-  g_ptr_array_add (self->dependencies, modulemd_dependencies_copy (deps));
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  copied_deps = modulemd_dependencies_copy (deps);
+  modulemd_dependencies_set_owner (
+    copied_deps,
+    modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (self)));
+
+  g_ptr_array_add (self->dependencies, copied_deps);
 }
 
 
@@ -969,6 +1322,10 @@ modulemd_module_stream_v2_replace_dependencies (ModulemdModuleStreamV2 *self,
 {
   gsize i;
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   for (i = 0; i < array->len; i++)
     {
@@ -982,6 +1339,10 @@ void
 modulemd_module_stream_v2_clear_dependencies (ModulemdModuleStreamV2 *self)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   g_ptr_array_set_size (self->dependencies, 0);
 }
@@ -1001,6 +1362,10 @@ modulemd_module_stream_v2_remove_dependencies (ModulemdModuleStreamV2 *self,
 {
   guint index;
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   while (g_ptr_array_find_with_equal_func (
     self->dependencies, deps, dep_equal_wrapper, &index))
@@ -1023,6 +1388,10 @@ void
 modulemd_module_stream_v2_set_xmd (ModulemdModuleStreamV2 *self, GVariant *xmd)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)));
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
 
   /* Do nothing if we were passed the same pointer */
   if (self->xmd == xmd)
@@ -1040,6 +1409,45 @@ modulemd_module_stream_v2_get_xmd (ModulemdModuleStreamV2 *self)
 }
 
 
+gboolean
+modulemd_module_stream_v2_set_xmd_from_json (ModulemdModuleStreamV2 *self,
+                                             const gchar *json,
+                                             GError **error)
+{
+  GVariant *xmd = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), FALSE);
+  g_return_val_if_fail (
+    !modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (self)),
+    FALSE);
+  g_return_val_if_fail (json, FALSE);
+
+  xmd = modulemd_variant_from_json (json, error);
+  if (!xmd)
+    return FALSE;
+
+  modulemd_module_stream_clear_validated (MODULEMD_MODULE_STREAM (self));
+
+  /* The new variant is not shared with the caller, so needs no copy */
+  g_clear_pointer (&self->xmd, g_variant_unref);
+  self->xmd = xmd;
+
+  return TRUE;
+}
+
+
+gchar *
+modulemd_module_stream_v2_get_xmd_as_json (ModulemdModuleStreamV2 *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self), NULL);
+
+  if (self->xmd == NULL)
+    return NULL;
+
+  return modulemd_variant_to_json (self->xmd);
+}
+
+
 static gboolean
 modulemd_module_stream_v2_validate (ModulemdModuleStream *self, GError **error)
 {
@@ -1215,6 +1623,7 @@ copy_rpm_artifact_map (ModulemdModuleStreamV2 *from,
   gpointer outer_key, outer_value;
   gpointer inner_key, inner_value;
   GHashTable *to_digest_table = NULL;
+  ModulemdRpmMapEntry *copied_entry = NULL;
 
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (from));
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (to));
@@ -1227,9 +1636,13 @@ copy_rpm_artifact_map (ModulemdModuleStreamV2 *from,
       g_hash_table_iter_init (&inner, (GHashTable *)outer_value);
       while (g_hash_table_iter_next (&inner, &inner_key, &inner_value))
         {
-          g_hash_table_insert (to_digest_table,
-                               g_strdup (inner_key),
-                               modulemd_rpm_map_entry_copy (inner_value));
+          copied_entry = modulemd_rpm_map_entry_copy (inner_value);
+          modulemd_rpm_map_entry_set_owner (
+            copied_entry,
+            modulemd_module_stream_as_owner (MODULEMD_MODULE_STREAM (to)));
+
+          g_hash_table_insert (
+            to_digest_table, g_strdup (inner_key), copied_entry);
         }
     }
 }
@@ -1250,14 +1663,17 @@ modulemd_module_stream_v2_copy (ModulemdModuleStream *self,
 
   /* Properties */
   STREAM_COPY_IF_SET (v2, copy, v2_self, arch);
-  STREAM_COPY_IF_SET (v2, copy, v2_self, buildopts);
+  if (v2_self->buildopts != NULL)
+    modulemd_module_stream_v2_set_buildopts (copy, v2_self->buildopts);
   STREAM_COPY_IF_SET (v2, copy, v2_self, community);
   STREAM_COPY_IF_SET_WITH_LOCALE (v2, copy, v2_self, description);
   STREAM_COPY_IF_SET (v2, copy, v2_self, documentation);
   STREAM_COPY_IF_SET_WITH_LOCALE (v2, copy, v2_self, summary);
   STREAM_COPY_IF_SET (v2, copy, v2_self, tracker);
 
-  /* Internal Data Structures: With replace function */
+  /* Internal Data Structures: With replace function. These always build new
+   * sets, as those of a frozen stream point into memory owned by it.
+   */
   STREAM_REPLACE_HASHTABLE (v2, copy, v2_self, content_licenses);
   STREAM_REPLACE_HASHTABLE (v2, copy, v2_self, module_licenses);
   STREAM_REPLACE_HASHTABLE (v2, copy, v2_self, rpm_api);
@@ -1278,7 +1694,11 @@ modulemd_module_stream_v2_copy (ModulemdModuleStream *self,
 
   copy_rpm_artifact_map (v2_self, copy);
 
-  STREAM_COPY_IF_SET (v2, copy, v2_self, xmd);
+  /* The stored xmd is a serialized GVariant that is never modified in place,
+   * so the copy can share it rather than serializing it all over again.
+   */
+  if (v2_self->xmd != NULL)
+    copy->xmd = g_variant_ref (v2_self->xmd);
 
   return MODULEMD_MODULE_STREAM (g_steal_pointer (&copy));
 }
@@ -1693,8 +2113,8 @@ modulemd_module_stream_v2_parse_yaml (ModulemdSubdocumentInfo *subdoc,
             {
               set = modulemd_yaml_parse_string_set_from_map (
                 &parser, "rpms", strict, &nested_error);
-              modulemd_module_stream_v2_replace_rpm_api (modulestream, set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v2_take_rpm_api (
+                modulestream, g_steal_pointer (&set));
             }
 
           /* Filter */
@@ -1703,9 +2123,8 @@ modulemd_module_stream_v2_parse_yaml (ModulemdSubdocumentInfo *subdoc,
             {
               set = modulemd_yaml_parse_string_set_from_map (
                 &parser, "rpms", strict, &nested_error);
-              modulemd_module_stream_v2_replace_rpm_filters (modulestream,
-                                                             set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v2_take_rpm_filters (
+                modulestream, g_steal_pointer (&set));
             }
 
           /* Build Options */
@@ -1843,17 +2262,15 @@ modulemd_module_stream_v2_parse_licenses (yaml_parser_t *parser,
                   g_propagate_error (error, g_steal_pointer (&nested_error));
                   return FALSE;
                 }
-              modulemd_module_stream_v2_replace_module_licenses (modulestream,
-                                                                 set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v2_take_module_licenses (
+                modulestream, g_steal_pointer (&set));
             }
           else if (g_str_equal ((const gchar *)event.data.scalar.value,
                                 "content"))
             {
               set = modulemd_yaml_parse_string_set (parser, &nested_error);
-              modulemd_module_stream_v2_replace_content_licenses (modulestream,
-                                                                  set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v2_take_content_licenses (
+                modulestream, g_steal_pointer (&set));
             }
           else
             {
@@ -2468,9 +2885,8 @@ modulemd_module_stream_v2_parse_artifacts (
                   return FALSE;
                 }
 
-              modulemd_module_stream_v2_replace_rpm_artifacts (modulestream,
-                                                               set);
-              g_clear_pointer (&set, g_hash_table_unref);
+              modulemd_module_stream_v2_take_rpm_artifacts (
+                modulestream, g_steal_pointer (&set));
             }
 
           else if (g_str_equal ((const gchar *)event.data.scalar.value,
@@ -2883,3 +3299,130 @@ modulemd_module_stream_v2_emit_rpm_map (ModulemdModuleStreamV2 *self,
 
   return TRUE;
 }
+
+
+static guint64
+rpm_artifact_map_fingerprint (gconstpointer table)
+{
+  return modulemd_fingerprint_hash_table (
+    (GHashTable *)table,
+    (ModulemdFingerprintFunc)modulemd_rpm_map_entry_fingerprint);
+}
+
+
+void
+modulemd_module_stream_v2_compact_sets (ModulemdModuleStreamV2 *self)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+
+  ModulemdModuleStream *stream = MODULEMD_MODULE_STREAM (self);
+
+  modulemd_module_stream_compact_set (stream, &self->content_licenses);
+  modulemd_module_stream_compact_set (stream, &self->module_licenses);
+  modulemd_module_stream_compact_set (stream, &self->rpm_api);
+  modulemd_module_stream_compact_set (stream, &self->rpm_artifacts);
+  modulemd_module_stream_compact_set (stream, &self->rpm_filters);
+}
+
+
+void
+modulemd_module_stream_v2_sort_collections (ModulemdModuleStreamV2 *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+
+  modulemd_module_stream_v2_peek_module_component_names (self);
+  modulemd_module_stream_v2_peek_rpm_component_names (self);
+  modulemd_module_stream_v2_peek_content_licenses (self);
+  modulemd_module_stream_v2_peek_module_licenses (self);
+  modulemd_module_stream_v2_peek_profile_names (self);
+  modulemd_module_stream_v2_peek_rpm_api (self);
+  modulemd_module_stream_v2_peek_rpm_artifacts (self);
+  modulemd_module_stream_v2_peek_rpm_filters (self);
+  modulemd_module_stream_v2_peek_servicelevel_names (self);
+
+  g_hash_table_iter_init (&iter, self->profiles);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    modulemd_profile_peek_rpms (MODULEMD_PROFILE (value));
+
+  for (guint i = 0; i < self->dependencies->len; i++)
+    modulemd_dependencies_sort_collections (
+      g_ptr_array_index (self->dependencies, i));
+}
+
+
+void
+modulemd_module_stream_v2_fingerprint_fields (
+  ModulemdModuleStreamV2 *self,
+  ModulemdFingerprintFieldFunc func,
+  gpointer user_data)
+{
+  guint64 fingerprint;
+
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM_V2 (self));
+  g_return_if_fail (func);
+
+  func ("buildopts",
+        modulemd_buildopts_fingerprint (self->buildopts),
+        user_data);
+  func ("community", modulemd_fingerprint_string (self->community), user_data);
+  func ("description",
+        modulemd_fingerprint_string (self->description),
+        user_data);
+  func ("documentation",
+        modulemd_fingerprint_string (self->documentation),
+        user_data);
+  func ("summary", modulemd_fingerprint_string (self->summary), user_data);
+  func ("tracker", modulemd_fingerprint_string (self->tracker), user_data);
+  func ("module_components",
+        modulemd_fingerprint_hash_table (
+          self->module_components,
+          (ModulemdFingerprintFunc)modulemd_component_fingerprint),
+        user_data);
+  func ("rpm_components",
+        modulemd_fingerprint_hash_table (
+          self->rpm_components,
+          (ModulemdFingerprintFunc)modulemd_component_fingerprint),
+        user_data);
+  func ("content_licenses",
+        modulemd_fingerprint_set (self->content_licenses),
+        user_data);
+  func ("module_licenses",
+        modulemd_fingerprint_set (self->module_licenses),
+        user_data);
+  func ("profiles",
+        modulemd_fingerprint_hash_table (
+          self->profiles,
+          (ModulemdFingerprintFunc)modulemd_profile_fingerprint),
+        user_data);
+  func ("rpm_api", modulemd_fingerprint_set (self->rpm_api), user_data);
+  func ("rpm_artifacts",
+        modulemd_fingerprint_set (self->rpm_artifacts),
+        user_data);
+  func ("rpm_filters",
+        modulemd_fingerprint_set (self->rpm_filters),
+        user_data);
+  func ("servicelevels",
+        modulemd_fingerprint_hash_table (
+          self->servicelevels,
+          (ModulemdFingerprintFunc)modulemd_service_level_fingerprint),
+        user_data);
+
+  func ("rpm_artifact_map",
+        modulemd_fingerprint_hash_table (self->rpm_artifact_map,
+                                         rpm_artifact_map_fingerprint),
+        user_data);
+
+  /* The order of the dependencies matters */
+  fingerprint = MODULEMD_FINGERPRINT_INIT;
+  for (guint i = 0; i < self->dependencies->len; i++)
+    fingerprint = modulemd_fingerprint_add (
+      fingerprint,
+      modulemd_dependencies_fingerprint (
+        g_ptr_array_index (self->dependencies, i)));
+  func ("dependencies", fingerprint, user_data);
+
+  func ("xmd", modulemd_fingerprint_variant (self->xmd), user_data);
+}
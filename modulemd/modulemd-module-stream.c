@@ -13,6 +13,7 @@
 
 #include <errno.h>
 #include <inttypes.h>
+#include <string.h>
 #include "modulemd-errors.h"
 #include "modulemd-module-stream.h"
 #include "modulemd-module-stream-v1.h"
@@ -21,6 +22,7 @@
 #include "private/modulemd-module-stream-private.h"
 #include "private/modulemd-module-stream-v1-private.h"
 #include "private/modulemd-module-stream-v2-private.h"
+#include "private/modulemd-profile-private.h"
 #include "private/modulemd-subdocument-info-private.h"
 #include "private/modulemd-util.h"
 #include "private/modulemd-yaml.h"
@@ -33,6 +35,38 @@ typedef struct
   gchar *context;
   gchar *arch;
   ModulemdTranslation *translation;
+
+  /* TRUE if the stream passed validation and has not been modified since */
+  gboolean validated;
+
+  /* The link the children of the subclasses report their changes through,
+   * created by modulemd_module_stream_as_owner() when the first one is added.
+   */
+  ModulemdOwner *owner;
+
+  /* The YAML document this stream was read from, kept only by indexes in
+   * passthrough mode and dropped as soon as the stream is modified.
+   */
+  GBytes *raw_yaml;
+
+  /* The cached result of modulemd_module_stream_get_fingerprint(), or 0.
+   * Dropped along with @validated. Frozen streams always have it, as their
+   * concurrent readers must not fill it in.
+   */
+  guint64 fingerprint;
+
+  /* Set once the stream belongs to a frozen index. Nothing may modify it
+   * after that, so the state above no longer changes and concurrent readers
+   * never write to it.
+   */
+  gboolean frozen;
+
+  /* The sorted keys of the collections of the subclasses, keyed by their
+   * tables; see modulemd_module_stream_peek_sorted_keys(). The string sets of
+   * a frozen stream point into the lists kept here for them by
+   * modulemd_module_stream_compact_set().
+   */
+  GHashTable *sorted_keys;
 } ModulemdModuleStreamPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (ModulemdModuleStream,
@@ -165,6 +199,7 @@ modulemd_module_stream_read_yaml (yaml_parser_t *parser,
   g_autoptr (GError) nested_error = NULL;
   g_autoptr (ModulemdModuleStream) stream = NULL;
   g_autoptr (ModulemdSubdocumentInfo) subdoc = NULL;
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_PARSE);
 
   /* The first event must be the stream start */
   if (!yaml_parser_parse (parser, &event))
@@ -293,6 +328,15 @@ modulemd_module_stream_finalize (GObject *object)
   g_clear_pointer (&priv->context, g_free);
   g_clear_pointer (&priv->arch, g_free);
   g_clear_pointer (&priv->translation, g_object_unref);
+  g_clear_pointer (&priv->raw_yaml, g_bytes_unref);
+
+  /* Children still held by the application outlive the stream */
+  if (priv->owner)
+    modulemd_owner_set_object (priv->owner, NULL);
+  g_clear_pointer (&priv->owner, modulemd_owner_unref);
+
+  /* The subclasses have already dropped the sets pointing into these */
+  g_clear_pointer (&priv->sorted_keys, g_hash_table_unref);
 
   G_OBJECT_CLASS (modulemd_module_stream_parent_class)->finalize (object);
 }
@@ -341,6 +385,16 @@ modulemd_module_stream_equals (ModulemdModuleStream *self_1,
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self_1), FALSE);
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self_2), FALSE);
 
+  if (self_1 == self_2)
+    return TRUE;
+
+  /* Equal streams always have the same fingerprint, and those are cached,
+   * so these only have to walk every field when they match.
+   */
+  if (modulemd_module_stream_get_fingerprint (self_1) !=
+      modulemd_module_stream_get_fingerprint (self_2))
+    return FALSE;
+
   klass = MODULEMD_MODULE_STREAM_GET_CLASS (self_1);
   g_return_val_if_fail (klass->equals, FALSE);
 
@@ -403,6 +457,9 @@ modulemd_module_stream_copy (ModulemdModuleStream *self,
                              const gchar *module_stream)
 {
   ModulemdModuleStreamClass *klass;
+  ModulemdModuleStream *copy = NULL;
+  ModulemdModuleStreamPrivate *priv = NULL;
+  ModulemdModuleStreamPrivate *copy_priv = NULL;
 
   if (!self)
     return NULL;
@@ -412,18 +469,40 @@ modulemd_module_stream_copy (ModulemdModuleStream *self,
   klass = MODULEMD_MODULE_STREAM_GET_CLASS (self);
   g_return_val_if_fail (klass->copy, NULL);
 
-  return klass->copy (self, module_name, module_stream);
+  priv = modulemd_module_stream_get_instance_private (self);
+  copy = klass->copy (self, module_name, module_stream);
+
+  /* An exact copy of a validated stream is just as valid, and can still be
+   * written out as the original YAML. A renamed copy needs to be checked
+   * again.
+   */
+  if (copy && !module_name && !module_stream)
+    {
+      modulemd_module_stream_set_validated (copy, priv->validated);
+      modulemd_module_stream_set_raw_yaml (copy, priv->raw_yaml);
+
+      copy_priv = modulemd_module_stream_get_instance_private (copy);
+      copy_priv->fingerprint = priv->fingerprint;
+    }
+
+  return copy;
 }
 
 
 static ModulemdModuleStream *
 modulemd_module_stream_upgrade_to_v2 (ModulemdModuleStream *from,
+                                      gboolean owned,
                                       GError **error);
 
-ModulemdModuleStream *
-modulemd_module_stream_upgrade (ModulemdModuleStream *self,
-                                guint64 mdversion,
-                                GError **error)
+
+/* When @owned is TRUE, nothing but the caller can see @self, which may be
+ * taken apart to build the upgraded stream.
+ */
+static ModulemdModuleStream *
+upgrade_stream (ModulemdModuleStream *self,
+                guint64 mdversion,
+                gboolean owned,
+                GError **error)
 {
   g_autoptr (GError) nested_error = NULL;
   g_autoptr (ModulemdModuleStream) current_stream = NULL;
@@ -450,6 +529,10 @@ modulemd_module_stream_upgrade (ModulemdModuleStream *self,
 
   if (current_mdversion == mdversion)
     {
+      /* Nobody else will see the original, so no need for a copy */
+      if (owned)
+        return g_object_ref (self);
+
       /* If we're already on the requested version, just make a copy */
       return modulemd_module_stream_copy (self, NULL, NULL);
     }
@@ -461,9 +544,13 @@ modulemd_module_stream_upgrade (ModulemdModuleStream *self,
       switch (current_mdversion)
         {
         case 1:
-          /* Upgrade to ModuleStreamV2 */
+          /* Upgrade to ModuleStreamV2. Intermediate versions are ours alone,
+           * so only the original may have to be copied.
+           */
           updated_stream = modulemd_module_stream_upgrade_to_v2 (
-            current_stream, &nested_error);
+            current_stream,
+            owned || current_stream != self,
+            &nested_error);
           if (!updated_stream)
             {
               g_propagate_error (error, g_steal_pointer (&nested_error));
@@ -492,8 +579,38 @@ modulemd_module_stream_upgrade (ModulemdModuleStream *self,
 }
 
 
+ModulemdModuleStream *
+modulemd_module_stream_upgrade (ModulemdModuleStream *self,
+                                guint64 mdversion,
+                                GError **error)
+{
+  return upgrade_stream (self, mdversion, FALSE, error);
+}
+
+
+ModulemdModuleStream *
+modulemd_module_stream_upgrade_owned (ModulemdModuleStream *self,
+                                      guint64 mdversion,
+                                      GError **error)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), NULL);
+
+  /* Streams also referenced by the application or by a #ModulemdIndexDiff
+   * must be left as they are. The string sets of frozen streams point into
+   * memory that goes away with them.
+   */
+  return upgrade_stream (
+    self,
+    mdversion,
+    !modulemd_module_stream_is_frozen (self) &&
+      modulemd_object_is_unshared (G_OBJECT (self)),
+    error);
+}
+
+
 static ModulemdModuleStream *
 modulemd_module_stream_upgrade_to_v2 (ModulemdModuleStream *from,
+                                      gboolean owned,
                                       GError **error)
 {
   ModulemdModuleStreamV1 *v1_stream = NULL;
@@ -523,37 +640,65 @@ modulemd_module_stream_upgrade_to_v2 (ModulemdModuleStream *from,
 
   /* Properties */
   STREAM_UPGRADE_IF_SET (v1, v2, copy, v1_stream, arch);
-  STREAM_UPGRADE_IF_SET (v1, v2, copy, v1_stream, buildopts);
   STREAM_UPGRADE_IF_SET (v1, v2, copy, v1_stream, community);
   STREAM_UPGRADE_IF_SET_WITH_LOCALE (v1, v2, copy, v1_stream, description);
   STREAM_UPGRADE_IF_SET (v1, v2, copy, v1_stream, documentation);
   STREAM_UPGRADE_IF_SET_WITH_LOCALE (v1, v2, copy, v1_stream, summary);
   STREAM_UPGRADE_IF_SET (v1, v2, copy, v1_stream, tracker);
 
-  /* Internal Data Structures: With replace function */
-  STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, content_licenses);
-  STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, module_licenses);
-  STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, rpm_api);
-  STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, rpm_artifacts);
-  STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, rpm_filters);
-
-  /* Internal Data Structures: With add on value */
-  COPY_HASHTABLE_BY_VALUE_ADDER (
-    copy, v1_stream, rpm_components, modulemd_module_stream_v2_add_component);
-  COPY_HASHTABLE_BY_VALUE_ADDER (copy,
-                                 v1_stream,
-                                 module_components,
-                                 modulemd_module_stream_v2_add_component);
-  COPY_HASHTABLE_BY_VALUE_ADDER (
-    copy, v1_stream, profiles, modulemd_module_stream_v2_add_profile);
-  COPY_HASHTABLE_BY_VALUE_ADDER (copy,
-                                 v1_stream,
-                                 servicelevels,
-                                 modulemd_module_stream_v2_add_servicelevel);
+  if (owned)
+    {
+      /* The V1 stream is going away, so hand its contents over as they are
+       * rather than holding two copies of everything until it does.
+       */
+      modulemd_module_stream_move_owner (MODULEMD_MODULE_STREAM (copy), from);
+      copy->buildopts = g_steal_pointer (&v1_stream->buildopts);
+
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, content_licenses);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, module_licenses);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, rpm_api);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, rpm_artifacts);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, rpm_filters);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, rpm_components);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, module_components);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, servicelevels);
+      STREAM_MOVE_HASHTABLE (copy, v1_stream, profiles);
+    }
+  else
+    {
+      STREAM_UPGRADE_IF_SET (v1, v2, copy, v1_stream, buildopts);
 
+      /* Internal Data Structures: With replace function. These always build
+       * new sets, as those of a frozen stream point into memory owned by it.
+       */
+      STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, content_licenses);
+      STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, module_licenses);
+      STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, rpm_api);
+      STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, rpm_artifacts);
+      STREAM_REPLACE_HASHTABLE (v2, copy, v1_stream, rpm_filters);
+
+      /* Internal Data Structures: With add on value */
+      COPY_HASHTABLE_BY_VALUE_ADDER (copy,
+                                     v1_stream,
+                                     rpm_components,
+                                     modulemd_module_stream_v2_add_component);
+      COPY_HASHTABLE_BY_VALUE_ADDER (copy,
+                                     v1_stream,
+                                     module_components,
+                                     modulemd_module_stream_v2_add_component);
+      COPY_HASHTABLE_BY_VALUE_ADDER (
+        copy, v1_stream, profiles, modulemd_module_stream_v2_add_profile);
+      COPY_HASHTABLE_BY_VALUE_ADDER (
+        copy,
+        v1_stream,
+        servicelevels,
+        modulemd_module_stream_v2_add_servicelevel);
+    }
 
+
+  /* xmd has the same representation in both versions, so share it */
   if (v1_stream->xmd != NULL)
-    modulemd_module_stream_v2_set_xmd (copy, v1_stream->xmd);
+    copy->xmd = g_variant_ref (v1_stream->xmd);
 
 
   /* Upgrade the Dependencies */
@@ -698,6 +843,7 @@ gboolean
 modulemd_module_stream_validate (ModulemdModuleStream *self, GError **error)
 {
   ModulemdModuleStreamClass *klass;
+  MODULEMD_PHASE_TIMER (MODULEMD_PHASE_VALIDATE);
 
   if (!self)
     return FALSE;
@@ -707,7 +853,329 @@ modulemd_module_stream_validate (ModulemdModuleStream *self, GError **error)
   klass = MODULEMD_MODULE_STREAM_GET_CLASS (self);
   g_return_val_if_fail (klass->validate, FALSE);
 
-  return klass->validate (self, error);
+  if (!klass->validate (self, error))
+    return FALSE;
+
+  modulemd_module_stream_set_validated (self, TRUE);
+  return TRUE;
+}
+
+
+gboolean
+modulemd_module_stream_is_validated (ModulemdModuleStream *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), FALSE);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  return priv->validated;
+}
+
+
+void
+modulemd_module_stream_set_validated (ModulemdModuleStream *self,
+                                      gboolean validated)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->frozen)
+    return;
+
+  priv->validated = validated;
+}
+
+
+void
+modulemd_module_stream_clear_validated (ModulemdModuleStream *self)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  g_return_if_fail (!priv->frozen);
+
+  priv->validated = FALSE;
+  priv->fingerprint = 0;
+  g_clear_pointer (&priv->raw_yaml, g_bytes_unref);
+  modulemd_sorted_keys_clear (priv->sorted_keys);
+}
+
+
+static void
+child_changed (gpointer object)
+{
+  ModulemdModuleStream *self = MODULEMD_MODULE_STREAM (object);
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->frozen)
+    return;
+
+  /* A child can change the content of @self, but not the keys it is stored
+   * under, so the sorted keys stay valid for the caller to look up children.
+   */
+  priv->validated = FALSE;
+  priv->fingerprint = 0;
+  g_clear_pointer (&priv->raw_yaml, g_bytes_unref);
+}
+
+
+ModulemdOwner *
+modulemd_module_stream_as_owner (ModulemdModuleStream *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), NULL);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->owner == NULL)
+    priv->owner = modulemd_owner_new (self, child_changed);
+
+  return priv->owner;
+}
+
+
+void
+modulemd_module_stream_move_owner (ModulemdModuleStream *self,
+                                   ModulemdModuleStream *from)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (from));
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+  ModulemdModuleStreamPrivate *from_priv =
+    modulemd_module_stream_get_instance_private (from);
+
+  g_return_if_fail (priv->owner == NULL);
+
+  priv->owner = g_steal_pointer (&from_priv->owner);
+  if (priv->owner)
+    modulemd_owner_set_object (priv->owner, self);
+}
+
+
+const gchar *const *
+modulemd_module_stream_peek_sorted_keys (ModulemdModuleStream *self,
+                                         GHashTable *table)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), NULL);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  return modulemd_sorted_keys_peek (&priv->sorted_keys, table);
+}
+
+
+void
+modulemd_module_stream_set_raw_yaml (ModulemdModuleStream *self,
+                                     GBytes *raw_yaml)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->frozen || priv->raw_yaml == raw_yaml)
+    return;
+
+  g_clear_pointer (&priv->raw_yaml, g_bytes_unref);
+  if (raw_yaml)
+    priv->raw_yaml = g_bytes_ref (raw_yaml);
+}
+
+
+GBytes *
+modulemd_module_stream_get_raw_yaml (ModulemdModuleStream *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), NULL);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  return priv->raw_yaml;
+}
+
+
+static guint64
+compute_fingerprint (ModulemdModuleStream *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  modulemd_module_stream_fingerprint_fields (
+    self, modulemd_fingerprint_add_field, &fingerprint);
+
+  return fingerprint;
+}
+
+
+void
+modulemd_module_stream_freeze (ModulemdModuleStream *self)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->frozen)
+    return;
+
+  /* Readers may need it concurrently, when it can no longer be computed */
+  modulemd_module_stream_get_fingerprint (self);
+
+  if (MODULEMD_IS_MODULE_STREAM_V1 (self))
+    modulemd_module_stream_v1_compact_sets (MODULEMD_MODULE_STREAM_V1 (self));
+  else if (MODULEMD_IS_MODULE_STREAM_V2 (self))
+    {
+      modulemd_module_stream_v2_compact_sets (
+        MODULEMD_MODULE_STREAM_V2 (self));
+      modulemd_module_stream_v2_sort_collections (
+        MODULEMD_MODULE_STREAM_V2 (self));
+    }
+
+  /* Its profiles, components and other children refuse changes from now on */
+  if (priv->owner)
+    modulemd_owner_freeze (priv->owner);
+
+  priv->frozen = TRUE;
+}
+
+
+void
+modulemd_module_stream_compact_set (ModulemdModuleStream *self,
+                                    GHashTable **set)
+{
+  g_autoptr (GPtrArray) keys = NULL;
+  GHashTable *compact = NULL;
+  GHashTableIter iter;
+  gpointer key;
+  gsize data_len = 0;
+  gchar **sorted = NULL;
+  gchar *data = NULL;
+
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (set && *set);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  keys = g_ptr_array_sized_new (g_hash_table_size (*set));
+  g_hash_table_iter_init (&iter, *set);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      g_ptr_array_add (keys, key);
+      data_len += strlen (key) + 1;
+    }
+  g_ptr_array_sort (keys, modulemd_strcmp_sort);
+
+  /* A single block holds the NULL-terminated array and then the strings */
+  sorted = g_malloc ((keys->len + 1) * sizeof (gchar *) + data_len);
+  data = (gchar *)(sorted + keys->len + 1);
+
+  compact = g_hash_table_new (g_str_hash, g_str_equal);
+  for (guint i = 0; i < keys->len; i++)
+    {
+      gsize len = strlen (g_ptr_array_index (keys, i)) + 1;
+
+      sorted[i] = memcpy (data, g_ptr_array_index (keys, i), len);
+      data += len;
+      g_hash_table_add (compact, sorted[i]);
+    }
+  sorted[keys->len] = NULL;
+
+  /* Same layout as the lists of modulemd_sorted_keys_peek() */
+  if (priv->sorted_keys == NULL)
+    priv->sorted_keys =
+      g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+  g_hash_table_insert (priv->sorted_keys, compact, sorted);
+
+  g_hash_table_unref (*set);
+  *set = compact;
+}
+
+
+GStrv
+modulemd_module_stream_set_as_strv (ModulemdModuleStream *self,
+                                    GHashTable *set)
+{
+  gchar **sorted = NULL;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), NULL);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->sorted_keys)
+    sorted = g_hash_table_lookup (priv->sorted_keys, set);
+
+  if (sorted)
+    return g_strdupv (sorted);
+
+  return modulemd_ordered_str_keys_as_strv (set);
+}
+
+
+gboolean
+modulemd_module_stream_is_frozen (ModulemdModuleStream *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), FALSE);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  return priv->frozen;
+}
+
+
+void
+modulemd_module_stream_fingerprint_fields (ModulemdModuleStream *self,
+                                           ModulemdFingerprintFieldFunc func,
+                                           gpointer user_data)
+{
+  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (func);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  func ("mdversion", modulemd_module_stream_get_mdversion (self), user_data);
+  func ("module_name",
+        modulemd_fingerprint_string (priv->module_name),
+        user_data);
+  func ("stream_name",
+        modulemd_fingerprint_string (priv->stream_name),
+        user_data);
+  func ("version", priv->version, user_data);
+  func ("context", modulemd_fingerprint_string (priv->context), user_data);
+  func ("arch", modulemd_fingerprint_string (priv->arch), user_data);
+
+  if (MODULEMD_IS_MODULE_STREAM_V1 (self))
+    modulemd_module_stream_v1_fingerprint_fields (
+      MODULEMD_MODULE_STREAM_V1 (self), func, user_data);
+  else if (MODULEMD_IS_MODULE_STREAM_V2 (self))
+    modulemd_module_stream_v2_fingerprint_fields (
+      MODULEMD_MODULE_STREAM_V2 (self), func, user_data);
+}
+
+
+guint64
+modulemd_module_stream_get_fingerprint (ModulemdModuleStream *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (self), 0);
+
+  ModulemdModuleStreamPrivate *priv =
+    modulemd_module_stream_get_instance_private (self);
+
+  if (priv->fingerprint == 0 && !priv->frozen)
+    priv->fingerprint = compute_fingerprint (self);
+
+  return priv->fingerprint;
 }
 
 
@@ -733,10 +1201,13 @@ modulemd_module_stream_set_module_name (ModulemdModuleStream *self,
                                         const gchar *module_name)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (!modulemd_module_stream_is_frozen (self));
 
   ModulemdModuleStreamPrivate *priv =
     modulemd_module_stream_get_instance_private (self);
 
+  modulemd_module_stream_clear_validated (self);
+
   g_clear_pointer (&priv->module_name, g_free);
   priv->module_name = g_strdup (module_name);
 
@@ -761,10 +1232,13 @@ modulemd_module_stream_set_stream_name (ModulemdModuleStream *self,
                                         const gchar *stream_name)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (!modulemd_module_stream_is_frozen (self));
 
   ModulemdModuleStreamPrivate *priv =
     modulemd_module_stream_get_instance_private (self);
 
+  modulemd_module_stream_clear_validated (self);
+
   g_clear_pointer (&priv->stream_name, g_free);
   priv->stream_name = g_strdup (stream_name);
 
@@ -789,10 +1263,13 @@ modulemd_module_stream_set_version (ModulemdModuleStream *self,
                                     guint64 version)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (!modulemd_module_stream_is_frozen (self));
 
   ModulemdModuleStreamPrivate *priv =
     modulemd_module_stream_get_instance_private (self);
 
+  modulemd_module_stream_clear_validated (self);
+
   priv->version = version;
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_VERSION]);
@@ -816,10 +1293,13 @@ modulemd_module_stream_set_context (ModulemdModuleStream *self,
                                     const gchar *context)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (!modulemd_module_stream_is_frozen (self));
 
   ModulemdModuleStreamPrivate *priv =
     modulemd_module_stream_get_instance_private (self);
 
+  modulemd_module_stream_clear_validated (self);
+
   g_clear_pointer (&priv->context, g_free);
   priv->context = g_strdup (context);
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_CONTEXT]);
@@ -842,10 +1322,13 @@ void
 modulemd_module_stream_set_arch (ModulemdModuleStream *self, const gchar *arch)
 {
   g_return_if_fail (MODULEMD_IS_MODULE_STREAM (self));
+  g_return_if_fail (!modulemd_module_stream_is_frozen (self));
 
   ModulemdModuleStreamPrivate *priv =
     modulemd_module_stream_get_instance_private (self);
 
+  modulemd_module_stream_clear_validated (self);
+
   g_clear_pointer (&priv->arch, g_free);
   priv->arch = g_strdup (arch);
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_CONTEXT]);
@@ -17,6 +17,7 @@
 #include "modulemd-errors.h"
 #include "modulemd-module.h"
 #include "private/glib-extensions.h"
+#include "private/modulemd-defaults-private.h"
 #include "private/modulemd-module-private.h"
 #include "private/modulemd-module-stream-private.h"
 #include "private/modulemd-translation-private.h"
@@ -32,6 +33,9 @@ struct _ModulemdModule
   GPtrArray *streams;
   ModulemdDefaults *defaults;
   GHashTable *translations;
+
+  /* Set by modulemd_module_freeze(). Nothing above changes after that. */
+  gboolean frozen;
 };
 
 G_DEFINE_TYPE (ModulemdModule, modulemd_module, G_TYPE_OBJECT)
@@ -191,6 +195,7 @@ modulemd_module_set_defaults (ModulemdModule *self,
   g_autoptr (ModulemdDefaults) upgraded_defaults = NULL;
   g_autoptr (GError) nested_error = NULL;
   g_return_val_if_fail (MODULEMD_IS_MODULE (self), MD_DEFAULTS_VERSION_ERROR);
+  g_return_val_if_fail (!self->frozen, MD_DEFAULTS_VERSION_ERROR);
 
   g_clear_object (&self->defaults);
   if (defaults == NULL)
@@ -259,11 +264,12 @@ modulemd_module_get_defaults (ModulemdModule *self)
 }
 
 
-ModulemdModuleStreamVersionEnum
-modulemd_module_add_stream (ModulemdModule *self,
-                            ModulemdModuleStream *stream,
-                            ModulemdModuleStreamVersionEnum index_mdversion,
-                            GError **error)
+static ModulemdModuleStreamVersionEnum
+add_stream (ModulemdModule *self,
+            ModulemdModuleStream *stream,
+            ModulemdModuleStreamVersionEnum index_mdversion,
+            gboolean copy,
+            GError **error)
 {
   ModulemdModuleStream *old = NULL;
   ModulemdTranslation *translation = NULL;
@@ -276,6 +282,7 @@ modulemd_module_add_stream (ModulemdModule *self,
                         MD_MODULESTREAM_VERSION_ERROR);
   g_return_val_if_fail (MODULEMD_IS_MODULE_STREAM (stream),
                         MD_MODULESTREAM_VERSION_ERROR);
+  g_return_val_if_fail (!self->frozen, MD_MODULESTREAM_VERSION_ERROR);
 
   module_name = modulemd_module_stream_get_module_name (stream);
   stream_name = modulemd_module_stream_get_stream_name (stream);
@@ -329,16 +336,18 @@ modulemd_module_add_stream (ModulemdModule *self,
       /* We're probably deduplicating content here, so remove the old one in
        * favor of the new one.
        */
-
       if (!modulemd_module_stream_equals (old, stream))
         {
+          g_autofree gchar *nsvca =
+            modulemd_module_stream_get_NSVCA_as_string (stream);
+
           /* The two streams have matching NSVCA, but differ in content */
           g_set_error (error,
                        MODULEMD_ERROR,
                        MODULEMD_ERROR_VALIDATE,
                        "Encountered two streams with matching NSVCA %s but "
                        "differing content",
-                       modulemd_module_stream_get_NSVCA_as_string (stream));
+                       nsvca);
           return MD_MODULESTREAM_VERSION_ERROR;
         }
 
@@ -372,10 +381,14 @@ modulemd_module_add_stream (ModulemdModule *self,
           return MD_MODULESTREAM_VERSION_ERROR;
         }
     }
-  else
+  else if (copy)
     {
       newstream = modulemd_module_stream_copy (stream, NULL, NULL);
     }
+  else
+    {
+      newstream = g_object_ref (stream);
+    }
 
   g_ptr_array_add (self->streams, newstream);
 
@@ -390,6 +403,27 @@ modulemd_module_add_stream (ModulemdModule *self,
 }
 
 
+ModulemdModuleStreamVersionEnum
+modulemd_module_add_stream (ModulemdModule *self,
+                            ModulemdModuleStream *stream,
+                            ModulemdModuleStreamVersionEnum index_mdversion,
+                            GError **error)
+{
+  return add_stream (self, stream, index_mdversion, TRUE, error);
+}
+
+
+ModulemdModuleStreamVersionEnum
+modulemd_module_add_stream_shared (
+  ModulemdModule *self,
+  ModulemdModuleStream *stream,
+  ModulemdModuleStreamVersionEnum index_mdversion,
+  GError **error)
+{
+  return add_stream (self, stream, index_mdversion, FALSE, error);
+}
+
+
 GStrv
 modulemd_module_get_stream_names_as_strv (ModulemdModule *self)
 {
@@ -635,8 +669,12 @@ modulemd_module_remove_streams_by_NSVCA (ModulemdModule *self,
 {
   gboolean found = FALSE;
   guint index;
-  g_autoptr (modulemd_nsvca) nsvca = g_malloc0_n (1, sizeof (modulemd_nsvca));
+  g_autoptr (modulemd_nsvca) nsvca = NULL;
+
+  g_return_if_fail (MODULEMD_IS_MODULE (self));
+  g_return_if_fail (!self->frozen);
 
+  nsvca = g_malloc0_n (1, sizeof (modulemd_nsvca));
   nsvca->stream_name = stream_name;
   nsvca->version = version;
   nsvca->context = context;
@@ -656,6 +694,194 @@ modulemd_module_remove_streams_by_NSVCA (ModulemdModule *self,
 }
 
 
+static gboolean
+pattern_matches (const gchar *pattern, const gchar *value)
+{
+  if (pattern == NULL)
+    return TRUE;
+
+  return value != NULL && g_pattern_match_simple (pattern, value);
+}
+
+
+static gboolean
+stream_matches (ModulemdModuleStream *stream,
+                const gchar *stream_name,
+                guint64 version,
+                const gchar *context,
+                const gchar *arch)
+{
+  if (!pattern_matches (stream_name,
+                        modulemd_module_stream_get_stream_name (stream)))
+    return FALSE;
+
+  if (version && modulemd_module_stream_get_version (stream) != version)
+    return FALSE;
+
+  if (!pattern_matches (context, modulemd_module_stream_get_context (stream)))
+    return FALSE;
+
+  return pattern_matches (arch, modulemd_module_stream_get_arch (stream));
+}
+
+
+ModulemdModule *
+modulemd_module_filter (ModulemdModule *self,
+                        const gchar *stream_name,
+                        guint64 version,
+                        const gchar *context,
+                        const gchar *arch,
+                        ModulemdDocumentTypeFlags doctypes)
+{
+  g_autoptr (ModulemdModule) m = NULL;
+  ModulemdModuleStream *stream = NULL;
+  ModulemdModuleStream *copy = NULL;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE (self), NULL);
+
+  m = modulemd_module_new (self->module_name);
+
+  /* The documents of a frozen module never change again, so they can be
+   * shared. Any other ones are copied, so that changing them through one
+   * module, or freezing it, leaves the other alone.
+   */
+  if (doctypes & MODULEMD_DOCUMENT_TYPE_TRANSLATIONS)
+    {
+      g_hash_table_iter_init (&iter, self->translations);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+          if (!pattern_matches (stream_name, key))
+            continue;
+
+          g_hash_table_replace (
+            m->translations,
+            g_strdup (key),
+            self->frozen ? g_object_ref (value) :
+                           modulemd_translation_copy (value));
+        }
+    }
+
+  if (doctypes & MODULEMD_DOCUMENT_TYPE_MODULE_STREAM)
+    {
+      for (guint i = 0; i < self->streams->len; i++)
+        {
+          stream = g_ptr_array_index (self->streams, i);
+          if (!stream_matches (stream, stream_name, version, context, arch))
+            continue;
+
+          if (self->frozen)
+            {
+              g_ptr_array_add (m->streams, g_object_ref (stream));
+              continue;
+            }
+
+          /* Copies use the translation of @m, if it kept one */
+          copy = modulemd_module_stream_copy (stream, NULL, NULL);
+          modulemd_module_stream_associate_translation (
+            copy,
+            g_hash_table_lookup (
+              m->translations,
+              modulemd_module_stream_get_stream_name (copy)));
+          g_ptr_array_add (m->streams, copy);
+        }
+    }
+
+  if ((doctypes & MODULEMD_DOCUMENT_TYPE_DEFAULTS) && self->defaults)
+    m->defaults = self->frozen ? g_object_ref (self->defaults) :
+                                 modulemd_defaults_copy (self->defaults);
+
+  if (modulemd_module_count_documents (m) == 0)
+    return NULL;
+
+  return g_steal_pointer (&m);
+}
+
+
+guint
+modulemd_module_prune (ModulemdModule *self,
+                       const gchar *stream_name,
+                       guint64 version,
+                       const gchar *context,
+                       const gchar *arch,
+                       ModulemdDocumentTypeFlags doctypes)
+{
+  guint removed = 0;
+  guint i = 0;
+  GHashTableIter iter;
+  gpointer key;
+
+  g_return_val_if_fail (MODULEMD_IS_MODULE (self), 0);
+  g_return_val_if_fail (!self->frozen, 0);
+
+  while (i < self->streams->len)
+    {
+      if ((doctypes & MODULEMD_DOCUMENT_TYPE_MODULE_STREAM) &&
+          stream_matches (g_ptr_array_index (self->streams, i),
+                          stream_name,
+                          version,
+                          context,
+                          arch))
+        {
+          i++;
+          continue;
+        }
+
+      g_ptr_array_remove_index (self->streams, i);
+      removed++;
+    }
+
+  if (!(doctypes & MODULEMD_DOCUMENT_TYPE_DEFAULTS) && self->defaults)
+    {
+      g_clear_object (&self->defaults);
+      removed++;
+    }
+
+  g_hash_table_iter_init (&iter, self->translations);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      if ((doctypes & MODULEMD_DOCUMENT_TYPE_TRANSLATIONS) &&
+          pattern_matches (stream_name, key))
+        continue;
+
+      g_hash_table_iter_remove (&iter);
+      removed++;
+    }
+
+  return removed;
+}
+
+
+guint
+modulemd_module_count_documents (ModulemdModule *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_MODULE (self), 0);
+
+  return self->streams->len + (self->defaults ? 1 : 0) +
+         g_hash_table_size (self->translations);
+}
+
+
+void
+modulemd_module_freeze (ModulemdModule *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_if_fail (MODULEMD_IS_MODULE (self));
+
+  if (self->defaults)
+    modulemd_defaults_freeze (self->defaults);
+
+  g_hash_table_iter_init (&iter, self->translations);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    modulemd_translation_freeze (MODULEMD_TRANSLATION (value));
+
+  self->frozen = TRUE;
+}
+
+
 void
 modulemd_module_add_translation (ModulemdModule *self,
                                  ModulemdTranslation *translation)
@@ -667,6 +893,7 @@ modulemd_module_add_translation (ModulemdModule *self,
   g_return_if_fail (
     g_str_equal (modulemd_translation_get_module_name (translation),
                  modulemd_module_get_module_name (self)));
+  g_return_if_fail (!self->frozen);
 
   newtrans = modulemd_translation_copy (translation);
 
@@ -707,26 +934,27 @@ modulemd_module_upgrade_streams (ModulemdModule *self,
                                  ModulemdModuleStreamVersionEnum mdversion,
                                  GError **error)
 {
-  g_autoptr (GPtrArray) new_streams = NULL;
   ModulemdModuleStreamVersionEnum current_mdversion;
-  g_autoptr (ModulemdModuleStream) modulestream = NULL;
-  g_autoptr (ModulemdModuleStream) upgraded_stream = NULL;
+  ModulemdModuleStream *modulestream = NULL;
+  ModulemdModuleStream *upgraded_stream = NULL;
   g_autofree gchar *nsvca = NULL;
   g_autoptr (GError) nested_error = NULL;
 
   g_return_val_if_fail (MODULEMD_IS_MODULE (self), FALSE);
+  g_return_val_if_fail (!self->frozen, FALSE);
 
-  new_streams = g_ptr_array_new_full (self->streams->len, g_object_unref);
-
+  /* Each stream is replaced as soon as it is upgraded, so that the old one
+   * can be freed right away rather than once they all have been.
+   */
   for (guint i = 0; i < self->streams->len; i++)
     {
-      modulestream = g_object_ref (
-        MODULEMD_MODULE_STREAM (g_ptr_array_index (self->streams, i)));
+      modulestream =
+        MODULEMD_MODULE_STREAM (g_ptr_array_index (self->streams, i));
       current_mdversion = modulemd_module_stream_get_mdversion (modulestream);
-      nsvca = modulemd_module_stream_get_NSVCA_as_string (modulestream);
 
       if (current_mdversion <= MD_MODULESTREAM_VERSION_UNSET)
         {
+          nsvca = modulemd_module_stream_get_NSVCA_as_string (modulestream);
           g_set_error (error,
                        MODULEMD_ERROR,
                        MODULEMD_ERROR_VALIDATE,
@@ -735,33 +963,29 @@ modulemd_module_upgrade_streams (ModulemdModule *self,
                        current_mdversion);
           return FALSE;
         }
+
+      /* Already at the right version */
       if (current_mdversion == mdversion)
+        continue;
+
+      /* Unless it is shared, the old stream is only referenced from here and
+       * hands its contents over to the new one instead of copying them.
+       */
+      upgraded_stream = modulemd_module_stream_upgrade_owned (
+        modulestream, mdversion, &nested_error);
+      if (!upgraded_stream)
         {
-          /* Already at the right version, so just add it to the new list */
-          g_ptr_array_add (new_streams, g_steal_pointer (&modulestream));
-        }
-      else
-        {
-          upgraded_stream = modulemd_module_stream_upgrade (
-            modulestream, mdversion, &nested_error);
-          if (!upgraded_stream)
-            {
-              g_propagate_prefixed_error (error,
-                                          g_steal_pointer (&nested_error),
-                                          "Error upgrading module stream %s",
-                                          nsvca);
-              return FALSE;
-            }
-          g_ptr_array_add (new_streams, g_steal_pointer (&upgraded_stream));
+          nsvca = modulemd_module_stream_get_NSVCA_as_string (modulestream);
+          g_propagate_prefixed_error (error,
+                                      g_steal_pointer (&nested_error),
+                                      "Error upgrading module stream %s",
+                                      nsvca);
+          return FALSE;
         }
 
-      g_clear_pointer (&nsvca, g_free);
-      g_clear_object (&modulestream);
+      self->streams->pdata[i] = upgraded_stream;
+      g_object_unref (modulestream);
     }
 
-  /* Replace the old stream list with the new one */
-  g_ptr_array_unref (self->streams);
-  self->streams = g_steal_pointer (&new_streams);
-
   return TRUE;
 }
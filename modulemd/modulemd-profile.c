@@ -33,7 +33,11 @@ struct _ModulemdProfile
 
   GHashTable *rpms;
 
-  ModulemdModuleStream *owner;
+  /* The list returned by modulemd_profile_peek_rpms(), or NULL */
+  const gchar **sorted_rpms;
+
+  /* The stream this profile belongs to, if any */
+  ModulemdOwner *owner;
 };
 
 G_DEFINE_TYPE (ModulemdProfile, modulemd_profile, G_TYPE_OBJECT)
@@ -100,8 +104,9 @@ modulemd_profile_copy (ModulemdProfile *self)
   modulemd_profile_set_description (
     p, modulemd_profile_get_description (self, NULL));
 
+  /* A shared set would change the sorted RPMs cached on the other profile */
   g_hash_table_unref (p->rpms);
-  p->rpms = g_hash_table_ref (self->rpms);
+  p->rpms = modulemd_hash_table_deep_set_copy (self->rpms);
 
   return g_steal_pointer (&p);
 }
@@ -115,6 +120,8 @@ modulemd_profile_finalize (GObject *object)
   g_clear_pointer (&self->name, g_free);
   g_clear_pointer (&self->description, g_free);
   g_clear_pointer (&self->rpms, g_hash_table_unref);
+  g_clear_pointer (&self->sorted_rpms, g_free);
+  g_clear_pointer (&self->owner, modulemd_owner_unref);
 
   G_OBJECT_CLASS (modulemd_profile_parent_class)->finalize (object);
 }
@@ -127,6 +134,9 @@ modulemd_profile_set_name (ModulemdProfile *self, const gchar *name)
   g_return_if_fail (name);
   g_return_if_fail (g_strcmp0 (name, P_DEFAULT_STRING));
 
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+
   g_clear_pointer (&self->name, g_free);
   self->name = g_strdup (name);
 
@@ -148,6 +158,9 @@ modulemd_profile_set_description (ModulemdProfile *self,
                                   const gchar *description)
 {
   g_return_if_fail (MODULEMD_IS_PROFILE (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
 
   g_clear_pointer (&self->description, g_free);
   self->description = g_strdup (description);
@@ -159,11 +172,13 @@ modulemd_profile_get_description (ModulemdProfile *self, const gchar *locale)
 {
   g_return_val_if_fail (MODULEMD_IS_PROFILE (self), NULL);
 
+  ModulemdModuleStream *owner = modulemd_owner_get_object (self->owner);
+
   /* Retrieve translated strings, if available */
-  if (self->owner)
+  if (owner)
     {
       ModulemdTranslationEntry *entry =
-        modulemd_module_stream_get_translation_entry (self->owner, locale);
+        modulemd_module_stream_get_translation_entry (owner, locale);
 
       if (entry != NULL)
         {
@@ -184,6 +199,9 @@ void
 modulemd_profile_add_rpm (ModulemdProfile *self, const gchar *rpm)
 {
   g_return_if_fail (MODULEMD_IS_PROFILE (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  g_clear_pointer (&self->sorted_rpms, g_free);
   g_hash_table_add (self->rpms, g_strdup (rpm));
 }
 
@@ -192,6 +210,9 @@ void
 modulemd_profile_remove_rpm (ModulemdProfile *self, const gchar *rpm)
 {
   g_return_if_fail (MODULEMD_IS_PROFILE (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  g_clear_pointer (&self->sorted_rpms, g_free);
   g_hash_table_remove (self->rpms, rpm);
 }
 
@@ -200,6 +221,9 @@ void
 modulemd_profile_clear_rpms (ModulemdProfile *self)
 {
   g_return_if_fail (MODULEMD_IS_PROFILE (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+  g_clear_pointer (&self->sorted_rpms, g_free);
   g_hash_table_remove_all (self->rpms);
 }
 
@@ -213,13 +237,24 @@ modulemd_profile_get_rpms_as_strv (ModulemdProfile *self)
 }
 
 
+const gchar *const *
+modulemd_profile_peek_rpms (ModulemdProfile *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_PROFILE (self), NULL);
+
+  if (self->sorted_rpms == NULL)
+    self->sorted_rpms = modulemd_ordered_str_keys_borrowed (self->rpms);
+
+  return self->sorted_rpms;
+}
+
+
 void
-modulemd_profile_set_owner (ModulemdProfile *self, ModulemdModuleStream *owner)
+modulemd_profile_set_owner (ModulemdProfile *self, ModulemdOwner *owner)
 {
   g_return_if_fail (MODULEMD_IS_PROFILE (self));
-  g_return_if_fail (MODULEMD_IS_MODULE_STREAM (owner));
 
-  self->owner = owner;
+  modulemd_owner_replace (&self->owner, owner);
 }
 
 
@@ -466,3 +501,24 @@ modulemd_profile_emit_yaml (ModulemdProfile *self,
     }
   return TRUE;
 }
+
+
+guint64
+modulemd_profile_fingerprint (ModulemdProfile *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_PROFILE (self), 0);
+
+  /* Like modulemd_profile_equals(), only the untranslated description */
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->name);
+  fingerprint = modulemd_fingerprint_add_string (
+    fingerprint, modulemd_profile_get_description (self, NULL));
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint, modulemd_fingerprint_set (self->rpms));
+
+  return fingerprint;
+}
@@ -30,6 +30,9 @@ struct _ModulemdRpmMapEntry
   gchar *version;
   gchar *release;
   gchar *arch;
+
+  /* The stream this entry belongs to, if any */
+  ModulemdOwner *owner;
 };
 
 G_DEFINE_TYPE (ModulemdRpmMapEntry, modulemd_rpm_map_entry, G_TYPE_OBJECT)
@@ -95,6 +98,7 @@ modulemd_rpm_map_entry_finalize (GObject *object)
   g_clear_pointer (&self->version, g_free);
   g_clear_pointer (&self->release, g_free);
   g_clear_pointer (&self->arch, g_free);
+  g_clear_pointer (&self->owner, modulemd_owner_unref);
 
   G_OBJECT_CLASS (modulemd_rpm_map_entry_parent_class)->finalize (object);
 }
@@ -171,23 +175,111 @@ modulemd_rpm_map_entry_validate (ModulemdRpmMapEntry *self, GError **error)
 }
 
 
-MODULEMD_SETTER_GETTER_STRING (
-  ModulemdRpmMapEntry, rpm_map_entry, RPM_MAP_ENTRY, name, NAME)
+void
+modulemd_rpm_map_entry_set_name (ModulemdRpmMapEntry *self, const gchar *name)
+{
+  g_return_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
+
+  g_clear_pointer (&self->name, g_free);
+  self->name = g_strdup (name);
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_NAME]);
+}
+
+
+const gchar *
+modulemd_rpm_map_entry_get_name (ModulemdRpmMapEntry *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self), NULL);
+
+  return self->name;
+}
+
+
+void
+modulemd_rpm_map_entry_set_version (ModulemdRpmMapEntry *self,
+                                    const gchar *version)
+{
+  g_return_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
+
+  g_clear_pointer (&self->version, g_free);
+  self->version = g_strdup (version);
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_VERSION]);
+}
+
+
+const gchar *
+modulemd_rpm_map_entry_get_version (ModulemdRpmMapEntry *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self), NULL);
+
+  return self->version;
+}
+
+
+void
+modulemd_rpm_map_entry_set_release (ModulemdRpmMapEntry *self,
+                                    const gchar *release)
+{
+  g_return_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
+
+  g_clear_pointer (&self->release, g_free);
+  self->release = g_strdup (release);
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_RELEASE]);
+}
+
+
+const gchar *
+modulemd_rpm_map_entry_get_release (ModulemdRpmMapEntry *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self), NULL);
+
+  return self->release;
+}
 
-MODULEMD_SETTER_GETTER_STRING (
-  ModulemdRpmMapEntry, rpm_map_entry, RPM_MAP_ENTRY, version, VERSION)
 
-MODULEMD_SETTER_GETTER_STRING (
-  ModulemdRpmMapEntry, rpm_map_entry, RPM_MAP_ENTRY, release, RELEASE)
+void
+modulemd_rpm_map_entry_set_arch (ModulemdRpmMapEntry *self, const gchar *arch)
+{
+  g_return_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
 
-MODULEMD_SETTER_GETTER_STRING (
-  ModulemdRpmMapEntry, rpm_map_entry, RPM_MAP_ENTRY, arch, ARCH)
+  modulemd_owner_changed (self->owner);
+
+  g_clear_pointer (&self->arch, g_free);
+  self->arch = g_strdup (arch);
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_ARCH]);
+}
+
+
+const gchar *
+modulemd_rpm_map_entry_get_arch (ModulemdRpmMapEntry *self)
+{
+  g_return_val_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self), NULL);
+
+  return self->arch;
+}
 
 
 void
 modulemd_rpm_map_entry_set_epoch (ModulemdRpmMapEntry *self, guint64 epoch)
 {
   g_return_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
 
   self->epoch = epoch;
 
@@ -562,3 +654,33 @@ modulemd_rpm_map_entry_emit_yaml (ModulemdRpmMapEntry *self,
 
   return TRUE;
 }
+
+
+guint64
+modulemd_rpm_map_entry_fingerprint (ModulemdRpmMapEntry *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self), 0);
+
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->name);
+  fingerprint = modulemd_fingerprint_add (fingerprint, self->epoch);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->version);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->release);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->arch);
+
+  return fingerprint;
+}
+
+
+void
+modulemd_rpm_map_entry_set_owner (ModulemdRpmMapEntry *self,
+                                  ModulemdOwner *owner)
+{
+  g_return_if_fail (MODULEMD_IS_RPM_MAP_ENTRY (self));
+
+  modulemd_owner_replace (&self->owner, owner);
+}
@@ -28,6 +28,9 @@ struct _ModulemdServiceLevel
 
   gchar *name;
   GDate *eol;
+
+  /* The stream this service level belongs to, if any */
+  ModulemdOwner *owner;
 };
 
 G_DEFINE_TYPE (ModulemdServiceLevel, modulemd_service_level, G_TYPE_OBJECT)
@@ -120,6 +123,7 @@ modulemd_service_level_finalize (GObject *object)
 
   g_clear_pointer (&self->name, g_free);
   g_clear_pointer (&self->eol, g_date_free);
+  g_clear_pointer (&self->owner, modulemd_owner_unref);
 
   G_OBJECT_CLASS (modulemd_service_level_parent_class)->finalize (object);
 }
@@ -136,6 +140,9 @@ modulemd_service_level_set_name (ModulemdServiceLevel *self, const gchar *name)
   /* It is a coding error if we ever get the default name here */
   g_return_if_fail (g_strcmp0 (name, SL_DEFAULT_STRING));
 
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+  modulemd_owner_changed (self->owner);
+
   g_clear_pointer (&self->name, g_free);
   self->name = g_strdup (name);
 
@@ -156,6 +163,9 @@ void
 modulemd_service_level_set_eol (ModulemdServiceLevel *self, GDate *date)
 {
   g_return_if_fail (MODULEMD_IS_SERVICE_LEVEL (self));
+  g_return_if_fail (!modulemd_owner_is_frozen (self->owner));
+
+  modulemd_owner_changed (self->owner);
 
   if (!date || !g_date_valid (date))
     {
@@ -460,3 +470,34 @@ modulemd_service_level_emit_yaml (ModulemdServiceLevel *self,
 
   return TRUE;
 }
+
+
+guint64
+modulemd_service_level_fingerprint (ModulemdServiceLevel *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_SERVICE_LEVEL (self), 0);
+
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->name);
+
+  /* All invalid dates are equivalent */
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint,
+    g_date_valid (self->eol) ? g_date_get_julian (self->eol) : 0);
+
+  return fingerprint;
+}
+
+
+void
+modulemd_service_level_set_owner (ModulemdServiceLevel *self,
+                                  ModulemdOwner *owner)
+{
+  g_return_if_fail (MODULEMD_IS_SERVICE_LEVEL (self));
+
+  modulemd_owner_replace (&self->owner, owner);
+}
@@ -83,13 +83,22 @@ modulemd_subdocument_info_set_yaml (ModulemdSubdocumentInfo *self,
 {
   g_return_if_fail (MODULEMD_IS_SUBDOCUMENT_INFO (self));
 
-  g_debug ("Setting YAML: %s\n", yaml);
-
   g_clear_pointer (&self->contents, g_free);
   self->contents = g_strdup (yaml);
 }
 
 
+void
+modulemd_subdocument_info_take_yaml (ModulemdSubdocumentInfo *self,
+                                     gchar *yaml)
+{
+  g_return_if_fail (MODULEMD_IS_SUBDOCUMENT_INFO (self));
+
+  g_clear_pointer (&self->contents, g_free);
+  self->contents = yaml;
+}
+
+
 const gchar *
 modulemd_subdocument_info_get_yaml (ModulemdSubdocumentInfo *self)
 {
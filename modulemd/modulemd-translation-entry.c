@@ -32,6 +32,11 @@ struct _ModulemdTranslationEntry
   gchar *description;
 
   GHashTable *profile_descriptions;
+
+  /* Set by modulemd_translation_entry_freeze(). The setters refuse to modify
+   * the entry after that.
+   */
+  gboolean frozen;
 };
 
 G_DEFINE_TYPE (ModulemdTranslationEntry,
@@ -104,6 +109,7 @@ modulemd_translation_entry_set_summary (ModulemdTranslationEntry *self,
                                         const gchar *summary)
 {
   g_return_if_fail (MODULEMD_IS_TRANSLATION_ENTRY (self));
+  g_return_if_fail (!self->frozen);
 
   g_clear_pointer (&self->summary, g_free);
   self->summary = g_strdup (summary);
@@ -126,6 +132,7 @@ modulemd_translation_entry_set_description (ModulemdTranslationEntry *self,
                                             const gchar *description)
 {
   g_return_if_fail (MODULEMD_IS_TRANSLATION_ENTRY (self));
+  g_return_if_fail (!self->frozen);
 
   g_clear_pointer (&self->description, g_free);
   self->description = g_strdup (description);
@@ -154,6 +161,7 @@ modulemd_translation_entry_set_locale (ModulemdTranslationEntry *self,
 
   /* It is a coding error if we ever get the default string here */
   g_return_if_fail (g_strcmp0 (locale, TE_DEFAULT_STRING));
+  g_return_if_fail (!self->frozen);
 
   g_clear_pointer (&self->locale, g_free);
   self->locale = g_strdup (locale);
@@ -185,6 +193,9 @@ modulemd_translation_entry_set_profile_description (
   const gchar *profile_name,
   const gchar *profile_description)
 {
+  g_return_if_fail (MODULEMD_IS_TRANSLATION_ENTRY (self));
+  g_return_if_fail (!self->frozen);
+
   g_hash_table_replace (self->profile_descriptions,
                         g_strdup (profile_name),
                         g_strdup (profile_description));
@@ -669,3 +680,35 @@ modulemd_translation_entry_emit_yaml (ModulemdTranslationEntry *self,
 
   return TRUE;
 }
+
+
+guint64
+modulemd_translation_entry_fingerprint (ModulemdTranslationEntry *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  if (!self)
+    return 0;
+
+  g_return_val_if_fail (MODULEMD_IS_TRANSLATION_ENTRY (self), 0);
+
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->locale);
+  fingerprint = modulemd_fingerprint_add_string (fingerprint, self->summary);
+  fingerprint =
+    modulemd_fingerprint_add_string (fingerprint, self->description);
+  fingerprint = modulemd_fingerprint_add (
+    fingerprint,
+    modulemd_fingerprint_hash_table (self->profile_descriptions,
+                                     modulemd_fingerprint_string));
+
+  return fingerprint;
+}
+
+
+void
+modulemd_translation_entry_freeze (ModulemdTranslationEntry *self)
+{
+  g_return_if_fail (MODULEMD_IS_TRANSLATION_ENTRY (self));
+
+  self->frozen = TRUE;
+}
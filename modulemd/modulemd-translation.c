@@ -38,6 +38,11 @@ struct _ModulemdTranslation
   guint64 modified;
 
   GHashTable *translation_entries;
+
+  /* Set by modulemd_translation_freeze(). The setters refuse to modify the
+   * translation or its entries after that.
+   */
+  gboolean frozen;
 };
 
 G_DEFINE_TYPE (ModulemdTranslation, modulemd_translation, G_TYPE_OBJECT)
@@ -238,6 +243,7 @@ void
 modulemd_translation_set_modified (ModulemdTranslation *self, guint64 modified)
 {
   g_return_if_fail (MODULEMD_IS_TRANSLATION (self));
+  g_return_if_fail (!self->frozen);
 
   self->modified = modified;
 
@@ -259,6 +265,7 @@ modulemd_translation_set_translation_entry (
   ModulemdTranslation *self, ModulemdTranslationEntry *translation_entry)
 {
   g_return_if_fail (MODULEMD_IS_TRANSLATION (self));
+  g_return_if_fail (!self->frozen);
 
   g_hash_table_insert (
     self->translation_entries,
@@ -717,3 +724,66 @@ modulemd_translation_emit_yaml (ModulemdTranslation *self,
 
   return TRUE;
 }
+
+
+void
+modulemd_translation_fingerprint_fields (ModulemdTranslation *self,
+                                         ModulemdFingerprintFieldFunc func,
+                                         gpointer user_data)
+{
+  g_autoptr (GPtrArray) locales = NULL;
+  const gchar *locale = NULL;
+
+  g_return_if_fail (MODULEMD_IS_TRANSLATION (self));
+  g_return_if_fail (func);
+
+  func ("version", self->version, user_data);
+  func ("module_name",
+        modulemd_fingerprint_string (self->module_name),
+        user_data);
+  func ("module_stream",
+        modulemd_fingerprint_string (self->module_stream),
+        user_data);
+  func ("modified", self->modified, user_data);
+
+  locales = modulemd_ordered_str_keys (self->translation_entries,
+                                       modulemd_strcmp_sort);
+  for (guint i = 0; i < locales->len; i++)
+    {
+      locale = g_ptr_array_index (locales, i);
+      func (locale,
+            modulemd_translation_entry_fingerprint (
+              g_hash_table_lookup (self->translation_entries, locale)),
+            user_data);
+    }
+}
+
+
+guint64
+modulemd_translation_get_fingerprint (ModulemdTranslation *self)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  g_return_val_if_fail (MODULEMD_IS_TRANSLATION (self), 0);
+
+  modulemd_translation_fingerprint_fields (
+    self, modulemd_fingerprint_add_field, &fingerprint);
+
+  return fingerprint;
+}
+
+
+void
+modulemd_translation_freeze (ModulemdTranslation *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_if_fail (MODULEMD_IS_TRANSLATION (self));
+
+  g_hash_table_iter_init (&iter, self->translation_entries);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    modulemd_translation_entry_freeze (MODULEMD_TRANSLATION_ENTRY (value));
+
+  self->frozen = TRUE;
+}
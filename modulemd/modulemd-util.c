@@ -11,6 +11,7 @@
  * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
  */
 
+#include <math.h>
 #include <string.h>
 
 #include "private/modulemd-util.h"
@@ -23,27 +24,6 @@ modulemd_error_quark (void)
 }
 
 
-modulemd_tracer *
-modulemd_trace_init (const gchar *function_name)
-{
-  modulemd_tracer *self = g_malloc0_n (1, sizeof (modulemd_tracer));
-  self->function_name = g_strdup (function_name);
-
-  g_debug ("TRACE: Entering %s", self->function_name);
-
-  return self;
-}
-
-
-void
-modulemd_trace_free (modulemd_tracer *tracer)
-{
-  g_debug ("TRACE: Exiting %s", tracer->function_name);
-  g_clear_pointer (&tracer->function_name, g_free);
-  g_free (tracer);
-}
-
-
 GHashTable *
 modulemd_hash_table_deep_str_copy (GHashTable *orig)
 {
@@ -262,6 +242,186 @@ modulemd_ordered_str_keys_as_strv (GHashTable *htable)
 }
 
 
+const gchar **
+modulemd_ordered_str_keys_borrowed (GHashTable *htable)
+{
+  GPtrArray *keys = NULL;
+  GHashTableIter iter;
+  gpointer key;
+
+  g_return_val_if_fail (htable, NULL);
+
+  keys = g_ptr_array_sized_new (g_hash_table_size (htable) + 1);
+  g_hash_table_iter_init (&iter, htable);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_ptr_array_add (keys, key);
+  g_ptr_array_sort (keys, modulemd_strcmp_sort);
+  g_ptr_array_add (keys, NULL);
+
+  return (const gchar **)g_ptr_array_free (keys, FALSE);
+}
+
+
+const gchar *const *
+modulemd_sorted_keys_peek (GHashTable **cache, GHashTable *htable)
+{
+  const gchar **sorted = NULL;
+
+  g_return_val_if_fail (cache, NULL);
+  g_return_val_if_fail (htable, NULL);
+
+  if (*cache)
+    {
+      sorted = g_hash_table_lookup (*cache, htable);
+      if (sorted)
+        return (const gchar *const *)sorted;
+    }
+  else
+    {
+      *cache =
+        g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+    }
+
+  sorted = modulemd_ordered_str_keys_borrowed (htable);
+  g_hash_table_insert (*cache, htable, sorted);
+
+  return (const gchar *const *)sorted;
+}
+
+
+void
+modulemd_sorted_keys_clear (GHashTable *cache)
+{
+  if (cache)
+    g_hash_table_remove_all (cache);
+}
+
+
+struct _ModulemdOwner
+{
+  gint ref_count;
+  gpointer object;
+  ModulemdOwnerChangedFunc changed;
+  gboolean frozen;
+};
+
+
+ModulemdOwner *
+modulemd_owner_new (gpointer object, ModulemdOwnerChangedFunc changed)
+{
+  ModulemdOwner *owner = g_new0 (ModulemdOwner, 1);
+
+  owner->ref_count = 1;
+  owner->object = object;
+  owner->changed = changed;
+
+  return owner;
+}
+
+
+ModulemdOwner *
+modulemd_owner_ref (ModulemdOwner *owner)
+{
+  g_return_val_if_fail (owner, NULL);
+
+  g_atomic_int_inc (&owner->ref_count);
+
+  return owner;
+}
+
+
+void
+modulemd_owner_unref (ModulemdOwner *owner)
+{
+  if (!owner)
+    return;
+
+  if (g_atomic_int_dec_and_test (&owner->ref_count))
+    g_free (owner);
+}
+
+
+void
+modulemd_owner_replace (ModulemdOwner **slot, ModulemdOwner *owner)
+{
+  ModulemdOwner *old;
+
+  g_return_if_fail (slot);
+
+  old = *slot;
+  *slot = owner ? modulemd_owner_ref (owner) : NULL;
+  modulemd_owner_unref (old);
+}
+
+
+void
+modulemd_owner_set_object (ModulemdOwner *owner, gpointer object)
+{
+  g_return_if_fail (owner);
+
+  owner->object = object;
+}
+
+
+gpointer
+modulemd_owner_get_object (ModulemdOwner *owner)
+{
+  return owner ? owner->object : NULL;
+}
+
+
+void
+modulemd_owner_changed (ModulemdOwner *owner)
+{
+  if (owner && owner->object && owner->changed)
+    owner->changed (owner->object);
+}
+
+
+void
+modulemd_owner_freeze (ModulemdOwner *owner)
+{
+  g_return_if_fail (owner);
+
+  owner->frozen = TRUE;
+}
+
+
+gboolean
+modulemd_owner_is_frozen (ModulemdOwner *owner)
+{
+  return owner && owner->frozen;
+}
+
+
+static void
+note_last_ref (gpointer data, GObject *object, gboolean is_last_ref)
+{
+  if (is_last_ref)
+    *(gboolean *)data = TRUE;
+}
+
+
+gboolean
+modulemd_object_is_unshared (GObject *object)
+{
+  gboolean unshared = FALSE;
+
+  g_return_val_if_fail (G_IS_OBJECT (object), FALSE);
+
+  /* GObject notifies a toggle reference when it becomes the last one, which
+   * happens here when the caller's reference is dropped if nobody else holds
+   * one. With more than one toggle reference, nothing is notified at all.
+   */
+  g_object_add_toggle_ref (object, note_last_ref, &unshared);
+  g_object_unref (object);
+  g_object_ref (object);
+  g_object_remove_toggle_ref (object, note_last_ref, &unshared);
+
+  return unshared;
+}
+
+
 void
 modulemd_hash_table_unref (void *table)
 {
@@ -284,7 +444,7 @@ modulemd_variant_deep_copy (GVariant *variant)
 {
   const GVariantType *data_type = g_variant_get_type (variant);
   gsize data_size = g_variant_get_size (variant);
-  gpointer data = g_malloc0 (data_size);
+  gpointer data = g_malloc (data_size);
 
   g_variant_store (variant, data);
 
@@ -293,104 +453,737 @@ modulemd_variant_deep_copy (GVariant *variant)
 }
 
 
-gboolean
-modulemd_validate_nevra (const gchar *nevra)
+static void
+append_json_string (GString *json, const gchar *str)
 {
-  g_autofree gchar *tmp = g_strdup (nevra);
-  gsize len = strlen (nevra);
-  gchar *i;
-  gchar *endptr;
+  const gchar *run = str;
+  const gchar *p;
 
-  /* Since the "name" portion of a NEVRA can have an infinite number of
-   * hyphens, we need to parse from the end backwards.
-   */
-  i = &tmp[len - 1];
+  g_string_append_c (json, '"');
 
-  /* Everything after the last '.' must be the architecture */
-  while (i >= tmp)
+  /* Copy the runs of characters that need no escaping in one go */
+  for (p = str; *p; p++)
     {
-      if (*i == '.')
+      guchar c = (guchar)*p;
+
+      if (c >= 0x20 && c != '"' && c != '\\')
+        continue;
+
+      g_string_append_len (json, run, p - run);
+      run = p + 1;
+
+      switch (c)
         {
-          break;
+        case '"': g_string_append (json, "\\\""); break;
+        case '\\': g_string_append (json, "\\\\"); break;
+        case '\b': g_string_append (json, "\\b"); break;
+        case '\f': g_string_append (json, "\\f"); break;
+        case '\n': g_string_append (json, "\\n"); break;
+        case '\r': g_string_append (json, "\\r"); break;
+        case '\t': g_string_append (json, "\\t"); break;
+        default: g_string_append_printf (json, "\\u%04x", c); break;
         }
-      i--;
     }
 
-  if (i < tmp)
+  g_string_append_len (json, run, p - run);
+  g_string_append_c (json, '"');
+}
+
+
+static void
+append_json_value (GString *json, GVariant *variant)
+{
+  g_autoptr (GVariant) child = NULL;
+  gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+  GVariantIter iter;
+  gboolean first = TRUE;
+  gdouble d;
+
+  switch (g_variant_classify (variant))
     {
-      /* We hit the start of the string without hitting '.' */
+    case G_VARIANT_CLASS_BOOLEAN:
+      g_string_append (json,
+                       g_variant_get_boolean (variant) ? "true" : "false");
+      return;
+
+    case G_VARIANT_CLASS_BYTE:
+      g_string_append_printf (json, "%u", g_variant_get_byte (variant));
+      return;
+
+    case G_VARIANT_CLASS_INT16:
+      g_string_append_printf (json, "%d", g_variant_get_int16 (variant));
+      return;
+
+    case G_VARIANT_CLASS_UINT16:
+      g_string_append_printf (json, "%u", g_variant_get_uint16 (variant));
+      return;
+
+    case G_VARIANT_CLASS_INT32:
+      g_string_append_printf (json, "%d", g_variant_get_int32 (variant));
+      return;
+
+    case G_VARIANT_CLASS_HANDLE:
+      g_string_append_printf (json, "%d", g_variant_get_handle (variant));
+      return;
+
+    case G_VARIANT_CLASS_UINT32:
+      g_string_append_printf (json, "%u", g_variant_get_uint32 (variant));
+      return;
+
+    case G_VARIANT_CLASS_INT64:
+      g_string_append_printf (
+        json, "%" G_GINT64_FORMAT, g_variant_get_int64 (variant));
+      return;
+
+    case G_VARIANT_CLASS_UINT64:
+      g_string_append_printf (
+        json, "%" G_GUINT64_FORMAT, g_variant_get_uint64 (variant));
+      return;
+
+    case G_VARIANT_CLASS_DOUBLE:
+      /* JSON has no representation for infinities and NaN */
+      d = g_variant_get_double (variant);
+      if (isfinite (d))
+        g_string_append (json, g_ascii_dtostr (buf, sizeof (buf), d));
+      else
+        g_string_append (json, "null");
+      return;
+
+    case G_VARIANT_CLASS_STRING:
+    case G_VARIANT_CLASS_OBJECT_PATH:
+    case G_VARIANT_CLASS_SIGNATURE:
+      append_json_string (json, g_variant_get_string (variant, NULL));
+      return;
+
+    case G_VARIANT_CLASS_VARIANT:
+      child = g_variant_get_variant (variant);
+      append_json_value (json, child);
+      return;
+
+    case G_VARIANT_CLASS_MAYBE:
+      child = g_variant_get_maybe (variant);
+      if (child)
+        append_json_value (json, child);
+      else
+        g_string_append (json, "null");
+      return;
+
+    case G_VARIANT_CLASS_ARRAY:
+      if (g_variant_type_is_dict_entry (
+            g_variant_type_element (g_variant_get_type (variant))))
+        {
+          g_string_append_c (json, '{');
+          g_variant_iter_init (&iter, variant);
+          while ((child = g_variant_iter_next_value (&iter)))
+            {
+              if (!first)
+                g_string_append_c (json, ',');
+              first = FALSE;
+              append_json_value (json, child);
+              g_clear_pointer (&child, g_variant_unref);
+            }
+          g_string_append_c (json, '}');
+          return;
+        }
+      /* Fall through intentional */
+
+    case G_VARIANT_CLASS_TUPLE:
+      g_string_append_c (json, '[');
+      g_variant_iter_init (&iter, variant);
+      while ((child = g_variant_iter_next_value (&iter)))
+        {
+          if (!first)
+            g_string_append_c (json, ',');
+          first = FALSE;
+          append_json_value (json, child);
+          g_clear_pointer (&child, g_variant_unref);
+        }
+      g_string_append_c (json, ']');
+      return;
+
+    case G_VARIANT_CLASS_DICT_ENTRY:
+      {
+        g_autoptr (GVariant) key = g_variant_get_child_value (variant, 0);
+
+        /* JSON object keys are always strings */
+        if (g_variant_is_of_type (key, G_VARIANT_TYPE_STRING))
+          append_json_string (json, g_variant_get_string (key, NULL));
+        else
+          {
+            g_autoptr (GString) key_json = g_string_new (NULL);
+            append_json_value (key_json, key);
+            append_json_string (json, key_json->str);
+          }
+
+        g_string_append_c (json, ':');
+        child = g_variant_get_child_value (variant, 1);
+        append_json_value (json, child);
+        return;
+      }
+    }
+}
+
+
+gchar *
+modulemd_variant_to_json (GVariant *variant)
+{
+  GString *json = NULL;
+
+  g_return_val_if_fail (variant, NULL);
+
+  json = g_string_sized_new (g_variant_get_size (variant) * 2 + 16);
+  append_json_value (json, variant);
+
+  return g_string_free (json, FALSE);
+}
+
+
+/* Documents nested deeper than this are rejected rather than risking the
+ * stack.
+ */
+#define MMD_JSON_MAX_DEPTH 512
+
+typedef struct _JsonReader
+{
+  const gchar *json;
+  const gchar *p;
+  guint depth;
+} JsonReader;
+
+
+static void
+json_set_error (JsonReader *reader, GError **error, const gchar *message)
+{
+  g_set_error (error,
+               MODULEMD_ERROR,
+               MODULEMD_ERROR_VALIDATE,
+               "Invalid JSON at offset %" G_GSIZE_FORMAT ": %s",
+               (gsize)(reader->p - reader->json),
+               message);
+}
+
+
+static void
+json_skip_whitespace (JsonReader *reader)
+{
+  while (*reader->p == ' ' || *reader->p == '\t' || *reader->p == '\n' ||
+         *reader->p == '\r')
+    reader->p++;
+}
+
+
+static gboolean
+json_read_hex4 (JsonReader *reader, gunichar *value)
+{
+  gint digit;
+
+  *value = 0;
+  for (guint i = 0; i < 4; i++)
+    {
+      /* Stops at the terminating NUL, which is not a hex digit */
+      digit = g_ascii_xdigit_value (reader->p[i]);
+      if (digit < 0)
+        return FALSE;
+      *value = (*value << 4) | (gunichar)digit;
+    }
+
+  reader->p += 4;
+  return TRUE;
+}
+
+
+static gboolean
+json_read_escape (JsonReader *reader, GString *str, GError **error)
+{
+  gunichar c;
+  gunichar low;
+
+  switch (*reader->p++)
+    {
+    case '"': g_string_append_c (str, '"'); return TRUE;
+    case '\\': g_string_append_c (str, '\\'); return TRUE;
+    case '/': g_string_append_c (str, '/'); return TRUE;
+    case 'b': g_string_append_c (str, '\b'); return TRUE;
+    case 'f': g_string_append_c (str, '\f'); return TRUE;
+    case 'n': g_string_append_c (str, '\n'); return TRUE;
+    case 'r': g_string_append_c (str, '\r'); return TRUE;
+    case 't': g_string_append_c (str, '\t'); return TRUE;
+    case 'u': break;
+
+    default:
+      json_set_error (reader, error, "Invalid escape sequence");
       return FALSE;
     }
 
-  /*
-   * TODO: Compare the architecture suffix with a list of known-valid ones
-   * This needs to come from an external source that's kept up to date or
-   * this will regularly break.
-   */
+  if (!json_read_hex4 (reader, &c))
+    {
+      json_set_error (reader, error, "Invalid \\u escape sequence");
+      return FALSE;
+    }
 
-  /* Process the "release" tag */
-  while (i >= tmp)
+  /* Characters outside of the BMP are written as UTF-16 surrogate pairs */
+  if (c >= 0xD800 && c < 0xDC00)
     {
-      if (*i == '-')
+      if (reader->p[0] != '\\' || reader->p[1] != 'u')
+        {
+          json_set_error (reader, error, "Unpaired UTF-16 surrogate");
+          return FALSE;
+        }
+
+      reader->p += 2;
+      if (!json_read_hex4 (reader, &low) || low < 0xDC00 || low >= 0xE000)
         {
-          break;
+          json_set_error (reader, error, "Unpaired UTF-16 surrogate");
+          return FALSE;
         }
-      i--;
+
+      c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+    }
+  else if (c >= 0xDC00 && c < 0xE000)
+    {
+      json_set_error (reader, error, "Unpaired UTF-16 surrogate");
+      return FALSE;
     }
 
-  if (i < tmp)
+  /* GVariant strings cannot hold NUL characters */
+  if (c == 0)
     {
-      /* We hit the start of the string without hitting '-' */
+      json_set_error (reader, error, "NUL character in string");
       return FALSE;
     }
 
-  /* No need to validate Release; it's fairly arbitrary */
+  g_string_append_unichar (str, c);
+  return TRUE;
+}
+
+
+static gchar *
+json_read_string (JsonReader *reader, GError **error)
+{
+  g_autoptr (GString) str = g_string_new (NULL);
+  const gchar *run = NULL;
+
+  /* Skip the opening quote */
+  run = ++reader->p;
 
-  /* Process the version */
-  while (i >= tmp)
+  while (*reader->p != '"')
     {
-      if (*i == ':')
+      if (*reader->p == '\0')
+        {
+          json_set_error (reader, error, "Unterminated string");
+          return NULL;
+        }
+
+      if ((guchar)*reader->p < 0x20)
         {
-          break;
+          json_set_error (reader, error, "Control character in string");
+          return NULL;
         }
-      i--;
+
+      if (*reader->p != '\\')
+        {
+          reader->p++;
+          continue;
+        }
+
+      /* Copy the unescaped run before the backslash in one go */
+      g_string_append_len (str, run, reader->p - run);
+      reader->p++;
+      if (!json_read_escape (reader, str, error))
+        return NULL;
+      run = reader->p;
     }
-  if (i < tmp)
+
+  g_string_append_len (str, run, reader->p - run);
+
+  if (!g_utf8_validate (str->str, str->len, NULL))
     {
-      /* We hit the start of the string without hitting ':' */
-      return FALSE;
+      json_set_error (reader, error, "String is not valid UTF-8");
+      return NULL;
     }
 
-  /* Process the epoch */
-  *i = '\0';
-  while (i >= tmp)
+  /* Skip the closing quote */
+  reader->p++;
+
+  return g_string_free (g_steal_pointer (&str), FALSE);
+}
+
+
+static gboolean
+json_skip_digits (JsonReader *reader)
+{
+  const gchar *start = reader->p;
+
+  while (g_ascii_isdigit (*reader->p))
+    reader->p++;
+
+  return reader->p > start;
+}
+
+
+static GVariant *
+json_read_number (JsonReader *reader, GError **error)
+{
+  const gchar *start = reader->p;
+  gboolean valid;
+
+  if (*reader->p == '-')
+    reader->p++;
+
+  /* Only zero itself may start with a zero */
+  if (*reader->p == '0')
+    {
+      reader->p++;
+      valid = TRUE;
+    }
+  else
+    valid = json_skip_digits (reader);
+
+  if (valid && *reader->p == '.')
+    {
+      reader->p++;
+      valid = json_skip_digits (reader);
+    }
+
+  if (valid && (*reader->p == 'e' || *reader->p == 'E'))
     {
-      if (*i == '-')
+      reader->p++;
+      if (*reader->p == '+' || *reader->p == '-')
+        reader->p++;
+      valid = json_skip_digits (reader);
+    }
+
+  if (!valid)
+    {
+      json_set_error (reader, error, "Invalid number");
+      return NULL;
+    }
+
+  /* Scalars read from YAML are strings too, whatever they look like */
+  return g_variant_new_take_string (g_strndup (start, reader->p - start));
+}
+
+
+static GVariant *
+json_read_value (JsonReader *reader, GError **error);
+
+
+static GVariant *
+json_read_object (JsonReader *reader, GError **error)
+{
+  GVariantBuilder builder;
+  g_autoptr (GPtrArray) keys = g_ptr_array_new_with_free_func (g_free);
+  g_autoptr (GPtrArray) values =
+    g_ptr_array_new_with_free_func ((GDestroyNotify)g_variant_unref);
+  g_autoptr (GHashTable) positions =
+    g_hash_table_new (g_str_hash, g_str_equal);
+  g_autofree gchar *key = NULL;
+  GVariant *value = NULL;
+  gpointer position;
+  guint i;
+
+  /* Skip the opening brace */
+  reader->p++;
+  json_skip_whitespace (reader);
+
+  while (*reader->p != '}')
+    {
+      if (keys->len > 0)
+        {
+          if (*reader->p != ',')
+            {
+              json_set_error (reader, error, "Expected ',' or '}'");
+              return NULL;
+            }
+          reader->p++;
+          json_skip_whitespace (reader);
+        }
+
+      if (*reader->p != '"')
+        {
+          json_set_error (reader, error, "Expected a string key");
+          return NULL;
+        }
+
+      key = json_read_string (reader, error);
+      if (!key)
+        return NULL;
+
+      json_skip_whitespace (reader);
+      if (*reader->p != ':')
         {
-          break;
+          json_set_error (reader, error, "Expected ':'");
+          return NULL;
         }
-      i--;
+      reader->p++;
+
+      value = json_read_value (reader, error);
+      if (!value)
+        return NULL;
+      g_variant_ref_sink (value);
+
+      /* The last of duplicate keys wins, as when reading YAML, while the
+       * keys otherwise keep the order of the document.
+       */
+      if (g_hash_table_lookup_extended (positions, key, NULL, &position))
+        {
+          i = GPOINTER_TO_UINT (position);
+          g_variant_unref (g_ptr_array_index (values, i));
+          g_ptr_array_index (values, i) = value;
+          g_clear_pointer (&key, g_free);
+        }
+      else
+        {
+          g_hash_table_insert (positions, key, GUINT_TO_POINTER (keys->len));
+          g_ptr_array_add (keys, g_steal_pointer (&key));
+          g_ptr_array_add (values, value);
+        }
+
+      json_skip_whitespace (reader);
     }
-  if (i < tmp)
+
+  /* Skip the closing brace */
+  reader->p++;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+  for (i = 0; i < keys->len; i++)
+    g_variant_builder_add (&builder,
+                           "{sv}",
+                           g_ptr_array_index (keys, i),
+                           g_ptr_array_index (values, i));
+
+  return g_variant_builder_end (&builder);
+}
+
+
+static GVariant *
+json_read_array (JsonReader *reader, GError **error)
+{
+  g_autoptr (GPtrArray) values =
+    g_ptr_array_new_with_free_func ((GDestroyNotify)g_variant_unref);
+  const GVariantType *type = NULL;
+  GVariant *value = NULL;
+
+  /* Skip the opening bracket */
+  reader->p++;
+  json_skip_whitespace (reader);
+
+  while (*reader->p != ']')
     {
-      /* We hit the start of the string without hitting '-' */
-      return FALSE;
+      if (values->len > 0)
+        {
+          if (*reader->p != ',')
+            {
+              json_set_error (reader, error, "Expected ',' or ']'");
+              return NULL;
+            }
+          reader->p++;
+        }
+
+      value = json_read_value (reader, error);
+      if (!value)
+        return NULL;
+      g_ptr_array_add (values, g_variant_ref_sink (value));
+
+      json_skip_whitespace (reader);
     }
 
-  /* Validate that this section is a number */
-  g_ascii_strtoll (i, &endptr, 10);
-  if (endptr == i)
+  /* Skip the closing bracket */
+  reader->p++;
+
+  /* Like empty YAML sequences */
+  if (values->len == 0)
+    return g_variant_new ("av", NULL);
+
+  type = g_variant_get_type (g_ptr_array_index (values, 0));
+  for (guint i = 1; i < values->len; i++)
     {
-      /* String conversion failed */
-      return FALSE;
+      if (g_variant_type_equal (
+            type, g_variant_get_type (g_ptr_array_index (values, i))))
+        continue;
+
+      /* The elements of a GVariant array must all have the same type, so
+       * mixed lists are stored as arrays of variants.
+       */
+      for (guint j = 0; j < values->len; j++)
+        {
+          value = g_ptr_array_index (values, j);
+          g_ptr_array_index (values, j) =
+            g_variant_ref_sink (g_variant_new_variant (value));
+          g_variant_unref (value);
+        }
+      type = G_VARIANT_TYPE_VARIANT;
+      break;
+    }
+
+  return g_variant_new_array (
+    type, (GVariant *const *)values->pdata, values->len);
+}
+
+
+static GVariant *
+json_read_value (JsonReader *reader, GError **error)
+{
+  GVariant *value = NULL;
+  gchar *str = NULL;
+
+  json_skip_whitespace (reader);
+
+  switch (*reader->p)
+    {
+    case '{':
+    case '[':
+      if (reader->depth == MMD_JSON_MAX_DEPTH)
+        {
+          json_set_error (reader, error, "Nested too deeply");
+          return NULL;
+        }
+
+      reader->depth++;
+      if (*reader->p == '{')
+        value = json_read_object (reader, error);
+      else
+        value = json_read_array (reader, error);
+      reader->depth--;
+      return value;
+
+    case '"':
+      str = json_read_string (reader, error);
+      if (!str)
+        return NULL;
+      return g_variant_new_take_string (str);
+
+    case 't':
+      if (!g_str_has_prefix (reader->p, "true"))
+        break;
+      reader->p += strlen ("true");
+      return g_variant_new_boolean (TRUE);
+
+    case 'f':
+      if (!g_str_has_prefix (reader->p, "false"))
+        break;
+      reader->p += strlen ("false");
+      return g_variant_new_boolean (FALSE);
+
+    case 'n':
+      /* The Python bindings have always stored None as an empty string */
+      if (!g_str_has_prefix (reader->p, "null"))
+        break;
+      reader->p += strlen ("null");
+      return g_variant_new_string ("");
+
+    default:
+      if (*reader->p == '-' || g_ascii_isdigit (*reader->p))
+        return json_read_number (reader, error);
+      break;
+    }
+
+  json_set_error (reader, error, "Expected a value");
+  return NULL;
+}
+
+
+GVariant *
+modulemd_variant_from_json (const gchar *json, GError **error)
+{
+  JsonReader reader = { json, json, 0 };
+  g_autoptr (GVariant) variant = NULL;
+
+  g_return_val_if_fail (json, NULL);
+
+  variant = json_read_value (&reader, error);
+  if (!variant)
+    return NULL;
+  g_variant_ref_sink (variant);
+
+  json_skip_whitespace (&reader);
+  if (*reader.p != '\0')
+    {
+      json_set_error (&reader, error, "Unexpected data after the value");
+      return NULL;
     }
 
+  return g_steal_pointer (&variant);
+}
+
+
+gboolean
+modulemd_nevra_parse (const gchar *nevra, ModulemdNevra *parsed)
+{
+  gsize i;
+  gsize epoch = 0;
+  gsize version = 0;
+  gsize release = 0;
+  gsize arch = 0;
+
+  g_return_val_if_fail (nevra, FALSE);
+
+  /* Since the "name" portion of a NEVRA can have an infinite number of
+   * hyphens, we need to parse from the end backwards. Each separator is
+   * searched for before the one found previously, so a single pass over the
+   * string finds them all.
+   */
+  for (i = strlen (nevra); i > 0 && epoch == 0; i--)
+    {
+      gchar c = nevra[i - 1];
+
+      /* Everything after the last '.' must be the architecture */
+      if (arch == 0)
+        {
+          if (c == '.')
+            arch = i;
+        }
+      /* No need to validate the release; it's fairly arbitrary */
+      else if (release == 0)
+        {
+          if (c == '-')
+            release = i;
+        }
+      else if (version == 0)
+        {
+          if (c == ':')
+            version = i;
+        }
+      else if (c == '-')
+        {
+          epoch = i;
+        }
+    }
+
+  /*
+   * TODO: Compare the architecture suffix with a list of known-valid ones
+   * This needs to come from an external source that's kept up to date or
+   * this will regularly break.
+   */
+
+  /* We hit the start of the string without finding every separator, or the
+   * epoch is not a number.
+   */
+  if (epoch == 0 || !g_ascii_isdigit (nevra[epoch]))
+    return FALSE;
+
   /* No need to specifically parse the name section here */
 
+  if (parsed)
+    {
+      parsed->nevra = nevra;
+      parsed->epoch = epoch;
+      parsed->version = version;
+      parsed->release = release;
+      parsed->arch = arch;
+    }
+
   return TRUE;
 }
 
 
+gboolean
+modulemd_validate_nevra (const gchar *nevra)
+{
+  return modulemd_nevra_parse (nevra, NULL);
+}
+
+
 gboolean
 modulemd_boolean_equals (gboolean a, gboolean b)
 {
@@ -404,3 +1197,132 @@ modulemd_boolean_equals (gboolean a, gboolean b)
 
   return FALSE;
 }
+
+
+/* The finalizer of MurmurHash3, which spreads every input bit over the
+ * whole output
+ */
+static guint64
+fingerprint_mix (guint64 value)
+{
+  value ^= value >> 33;
+  value *= G_GUINT64_CONSTANT (0xff51afd7ed558ccd);
+  value ^= value >> 33;
+  value *= G_GUINT64_CONSTANT (0xc4ceb9fe1a85ec53);
+  value ^= value >> 33;
+
+  return value;
+}
+
+
+/* 64-bit FNV-1a */
+static guint64
+fingerprint_bytes (const guchar *data, gsize len)
+{
+  guint64 fingerprint = MODULEMD_FINGERPRINT_INIT;
+
+  for (gsize i = 0; i < len; i++)
+    {
+      fingerprint ^= data[i];
+      fingerprint *= G_GUINT64_CONSTANT (0x100000001b3);
+    }
+
+  return fingerprint;
+}
+
+
+guint64
+modulemd_fingerprint_add (guint64 fingerprint, guint64 value)
+{
+  return fingerprint_mix (fingerprint * G_GUINT64_CONSTANT (31) +
+                          fingerprint_mix (value));
+}
+
+
+guint64
+modulemd_fingerprint_string (gconstpointer str)
+{
+  if (str == NULL)
+    return 0;
+
+  return fingerprint_bytes (str, strlen (str));
+}
+
+
+guint64
+modulemd_fingerprint_add_string (guint64 fingerprint, const gchar *str)
+{
+  return modulemd_fingerprint_add (fingerprint,
+                                   modulemd_fingerprint_string (str));
+}
+
+
+guint64
+modulemd_fingerprint_set (gconstpointer set)
+{
+  GHashTableIter iter;
+  gpointer key;
+  guint64 sum = 0;
+
+  if (set == NULL)
+    return 0;
+
+  /* Addition commutes, so the iteration order does not matter */
+  g_hash_table_iter_init (&iter, (GHashTable *)set);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    sum += fingerprint_mix (modulemd_fingerprint_string (key));
+
+  return modulemd_fingerprint_add (g_hash_table_size ((GHashTable *)set),
+                                   sum);
+}
+
+
+guint64
+modulemd_fingerprint_hash_table (GHashTable *table,
+                                 ModulemdFingerprintFunc value_func)
+{
+  GHashTableIter iter;
+  gpointer key;
+  gpointer value;
+  guint64 sum = 0;
+
+  if (table == NULL)
+    return 0;
+
+  g_hash_table_iter_init (&iter, table);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    sum += fingerprint_mix (modulemd_fingerprint_add (
+      modulemd_fingerprint_string (key), value_func (value)));
+
+  return modulemd_fingerprint_add (g_hash_table_size (table), sum);
+}
+
+
+guint64
+modulemd_fingerprint_variant (GVariant *variant)
+{
+  g_autoptr (GVariant) normal = NULL;
+
+  if (variant == NULL)
+    return 0;
+
+  /* g_variant_equal() compares the serialized data of the normal forms */
+  normal = g_variant_get_normal_form (variant);
+
+  return modulemd_fingerprint_add (
+    modulemd_fingerprint_string (g_variant_get_type_string (normal)),
+    fingerprint_bytes (g_variant_get_data (normal),
+                       g_variant_get_size (normal)));
+}
+
+
+void
+modulemd_fingerprint_add_field (const gchar *field,
+                                guint64 fingerprint,
+                                gpointer user_data)
+{
+  guint64 *total = (guint64 *)user_data;
+
+  *total = modulemd_fingerprint_add (
+    modulemd_fingerprint_add_string (*total, field), fingerprint);
+}
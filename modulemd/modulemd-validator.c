@@ -31,10 +31,11 @@ enum mmd_verbosity
 struct validator_options
 {
   enum mmd_verbosity verbosity;
+  gboolean stats;
   gchar **filenames;
 };
 
-struct validator_options options = { 0, NULL };
+struct validator_options options = { 0, FALSE, NULL };
 
 static gboolean
 set_verbosity (const gchar *option_name,
@@ -67,6 +68,7 @@ set_verbosity (const gchar *option_name,
               debugging_env = g_strdup (G_LOG_DOMAIN);
             }
           g_setenv ("G_MESSAGES_DEBUG", debugging_env, TRUE);
+          modulemd_set_tracing_enabled (TRUE);
         }
     }
   else if (g_strcmp0 ("-q", option_name) == 0 ||
@@ -92,11 +94,31 @@ static GOptionEntry entries[] = {
   { "quiet", 'q', G_OPTION_FLAG_NO_ARG, G_OPTION_ARG_CALLBACK, set_verbosity, "Print no output", NULL },
   { "verbose", 'v', G_OPTION_FLAG_NO_ARG, G_OPTION_ARG_CALLBACK, set_verbosity, "Be verbose", NULL },
   { "debug", 0, G_OPTION_FLAG_NO_ARG, G_OPTION_ARG_CALLBACK, set_verbosity, "Output debugging messages", NULL },
+  { "stats", 0, 0, G_OPTION_ARG_NONE, &options.stats, "Print performance statistics for each file", NULL },
   { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &options.filenames, "Files to be validated", NULL },
   { NULL } };
 // clang-format on
 
 
+static void
+print_stats (const gchar *filename, ModulemdModuleIndex *index)
+{
+  g_autoptr (GVariant) stats = NULL;
+  GVariantIter iter;
+  const gchar *key;
+  guint64 value;
+
+  stats = g_variant_ref_sink (modulemd_module_index_get_stats (index));
+
+  g_fprintf (stdout, "Statistics for %s:\n", filename);
+  g_variant_iter_init (&iter, stats);
+  while (g_variant_iter_next (&iter, "{&st}", &key, &value))
+    {
+      g_fprintf (stdout, "  %s: %" G_GUINT64_FORMAT "\n", key, value);
+    }
+}
+
+
 static gboolean
 parse_file (const gchar *filename, GPtrArray **failures, GError **error)
 {
@@ -105,6 +127,7 @@ parse_file (const gchar *filename, GPtrArray **failures, GError **error)
   g_autoptr (FILE) yaml_stream = NULL;
   int saved_errno;
   g_autoptr (ModulemdModuleIndex) index = NULL;
+  gboolean ret;
 
   if (options.verbosity >= MMD_VERBOSE)
     {
@@ -131,8 +154,17 @@ parse_file (const gchar *filename, GPtrArray **failures, GError **error)
   yaml_parser_set_input_file (&parser, yaml_stream);
 
   index = modulemd_module_index_new ();
-  return modulemd_module_index_update_from_parser (
+  modulemd_module_index_set_collect_stats (index, options.stats);
+
+  ret = modulemd_module_index_update_from_parser (
     index, &parser, TRUE, TRUE, failures, error);
+
+  if (options.stats)
+    {
+      print_stats (filename, index);
+    }
+
+  return ret;
 }
 
 
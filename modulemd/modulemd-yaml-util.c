@@ -14,6 +14,7 @@
 #include <glib.h>
 #include <yaml.h>
 #include <inttypes.h>
+#include <string.h>
 #include "modulemd-errors.h"
 #include "private/modulemd-subdocument-info-private.h"
 #include "private/modulemd-util.h"
@@ -35,6 +36,64 @@ modulemd_yaml_string_free (modulemd_yaml_string *yaml_string)
 }
 
 
+/* Smallest allocation made for a modulemd_yaml_string, so that short
+ * documents don't go through several tiny reallocations.
+ */
+#define MMD_YAML_STRING_MIN_ALLOC 4096
+
+
+static void
+modulemd_yaml_string_grow (modulemd_yaml_string *yaml_string, gsize needed)
+{
+  gsize new_alloc;
+
+  if (needed <= yaml_string->alloc)
+    return;
+
+  new_alloc = MAX (yaml_string->alloc, MMD_YAML_STRING_MIN_ALLOC);
+  while (new_alloc < needed)
+    {
+      if (!g_size_checked_mul (&new_alloc, new_alloc, 2))
+        {
+          new_alloc = needed;
+          break;
+        }
+    }
+
+  yaml_string->str = g_realloc (yaml_string->str, new_alloc);
+  yaml_string->alloc = new_alloc;
+}
+
+
+void
+modulemd_yaml_string_reserve (modulemd_yaml_string *yaml_string, gsize size)
+{
+  gsize total;
+
+  g_return_if_fail (yaml_string);
+
+  if (!g_size_checked_add (&total, yaml_string->len, size + 1))
+    return;
+
+  modulemd_yaml_string_grow (yaml_string, total);
+  yaml_string->str[yaml_string->len] = '\0';
+}
+
+
+void
+modulemd_yaml_string_shrink (modulemd_yaml_string *yaml_string)
+{
+  g_return_if_fail (yaml_string);
+
+  if (!yaml_string->str ||
+      yaml_string->alloc - (yaml_string->len + 1) <= yaml_string->len / 8)
+    return;
+
+  yaml_string->str = g_realloc (yaml_string->str, yaml_string->len + 1);
+  yaml_string->alloc = yaml_string->len + 1;
+}
+
+
 int
 write_yaml_string (void *data, unsigned char *buffer, size_t size)
 {
@@ -46,7 +105,7 @@ write_yaml_string (void *data, unsigned char *buffer, size_t size)
       return 0;
     }
 
-  yaml_string->str = g_realloc_n (yaml_string->str, total, sizeof (char));
+  modulemd_yaml_string_grow (yaml_string, total);
 
   memcpy (yaml_string->str + yaml_string->len, buffer, size);
   yaml_string->len += size;
@@ -182,6 +241,43 @@ mmd_emitter_end_document (yaml_emitter_t *emitter, GError **error)
 }
 
 
+gboolean
+mmd_emitter_raw_document (yaml_emitter_t *emitter,
+                          GBytes *yaml,
+                          GError **error)
+{
+  gsize size;
+  const unsigned char *data = g_bytes_get_data (yaml, &size);
+
+  /* Every event handed to libyaml so far must have been written out, and the
+   * last of them must have completed a document (or started the stream).
+   */
+  if (emitter->events.head != emitter->events.tail ||
+      (emitter->state != YAML_EMIT_FIRST_DOCUMENT_START_STATE &&
+       emitter->state != YAML_EMIT_DOCUMENT_START_STATE))
+    {
+      g_set_error_literal (error,
+                           MODULEMD_YAML_ERROR,
+                           MODULEMD_YAML_ERROR_EMIT,
+                           "Raw YAML may only be written between documents");
+      return FALSE;
+    }
+
+  if (!yaml_emitter_flush (emitter) ||
+      !emitter->write_handler (
+        emitter->write_handler_data, (unsigned char *)data, size))
+    {
+      g_set_error_literal (error,
+                           MODULEMD_YAML_ERROR,
+                           MODULEMD_YAML_ERROR_EMIT,
+                           "Could not write the raw YAML document");
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+
 gboolean
 mmd_emitter_start_mapping (yaml_emitter_t *emitter,
                            yaml_mapping_style_t style,
@@ -283,7 +379,10 @@ mmd_emitter_scalar (yaml_emitter_t *emitter,
   int ret;
   MMD_INIT_YAML_EVENT (event);
 
-  g_debug ("SCALAR: %s", scalar);
+  /* This is called for every scalar in the output, so it deliberately does
+   * not log anything. Depending on the GLib version, g_debug() may format
+   * (and allocate) its message even when debug output is disabled.
+   */
   ret = yaml_scalar_event_initialize (&event,
                                       NULL,
                                       NULL,
@@ -349,11 +448,104 @@ mmd_emitter_strv (yaml_emitter_t *emitter,
 }
 
 
+/* Eight ASCII digits, loaded into a 64-bit word with the first digit in the
+ * least significant byte.
+ */
+#define ALL_HIGH_NIBBLES G_GUINT64_CONSTANT (0xF0F0F0F0F0F0F0F0)
+#define ALL_DIGIT_ZEROS G_GUINT64_CONSTANT (0x3030303030303030)
+#define ALL_SIXES G_GUINT64_CONSTANT (0x0606060606060606)
+
+
+static inline guint64
+load_eight_bytes (const gchar *bytes)
+{
+  guint64 chunk;
+
+  memcpy (&chunk, bytes, sizeof (chunk));
+  return GUINT64_FROM_LE (chunk);
+}
+
+
+static inline gboolean
+eight_bytes_are_digits (guint64 chunk)
+{
+  /* Every byte must be 0x30 to 0x39: its high nibble is 3 both as-is and
+   * after adding 6, which would carry into the high nibble from 0x3A up.
+   */
+  return (chunk & ALL_HIGH_NIBBLES) == ALL_DIGIT_ZEROS &&
+         ((chunk + ALL_SIXES) & ALL_HIGH_NIBBLES) == ALL_DIGIT_ZEROS;
+}
+
+
+static inline guint64
+eight_digits_to_uint64 (guint64 chunk)
+{
+  /* Combine adjacent digits into pairs, then pairs into groups of four and
+   * finally the two groups of four, each step with a single multiply.
+   */
+  chunk = ((chunk & G_GUINT64_CONSTANT (0x0F0F0F0F0F0F0F0F)) * 2561) >> 8;
+  chunk = ((chunk & G_GUINT64_CONSTANT (0x00FF00FF00FF00FF)) * 6553601) >> 16;
+  return ((chunk & G_GUINT64_CONSTANT (0x0000FFFF0000FFFF)) *
+          G_GUINT64_CONSTANT (42949672960001)) >>
+         32;
+}
+
+
+gboolean
+modulemd_yaml_scalar_to_uint64 (const gchar *scalar,
+                                gsize length,
+                                guint64 *value)
+{
+  guint64 result = 0;
+  guint64 chunk;
+  gsize i = 0;
+
+  if (length == 0 || length > 19)
+    return FALSE;
+
+  for (; i + 8 <= length; i += 8)
+    {
+      chunk = load_eight_bytes (scalar + i);
+      if (!eight_bytes_are_digits (chunk))
+        return FALSE;
+      result = result * 100000000 + eight_digits_to_uint64 (chunk);
+    }
+
+  for (; i < length; i++)
+    {
+      if (!g_ascii_isdigit (scalar[i]))
+        return FALSE;
+      result = result * 10 + (scalar[i] - '0');
+    }
+
+  *value = result;
+  return TRUE;
+}
+
+
+/* Parses the common YYYY-MM-DD form of a date in place */
+static gboolean
+parse_iso_date (const gchar *scalar,
+                gsize length,
+                guint64 *year,
+                guint64 *month,
+                guint64 *day)
+{
+  if (length != 10 || scalar[4] != '-' || scalar[7] != '-')
+    return FALSE;
+
+  return modulemd_yaml_scalar_to_uint64 (scalar, 4, year) &&
+         modulemd_yaml_scalar_to_uint64 (scalar + 5, 2, month) &&
+         modulemd_yaml_scalar_to_uint64 (scalar + 8, 2, day);
+}
+
+
 GDate *
 modulemd_yaml_parse_date (yaml_parser_t *parser, GError **error)
 {
   MMD_INIT_YAML_EVENT (event);
   g_auto (GStrv) strv = NULL;
+  guint64 year, month, day;
 
   YAML_PARSER_PARSE_WITH_EXIT (parser, &event, error);
   if (event.type != YAML_SCALAR_EVENT)
@@ -361,8 +553,14 @@ modulemd_yaml_parse_date (yaml_parser_t *parser, GError **error)
       MMD_YAML_ERROR_EVENT_EXIT (error, event, "Date was not a scalar");
     }
 
-  g_debug ("Parsing scalar: %s", (const gchar *)event.data.scalar.value);
+  if (parse_iso_date ((const gchar *)event.data.scalar.value,
+                      event.data.scalar.length,
+                      &year,
+                      &month,
+                      &day))
+    return g_date_new_dmy (day, month, year);
 
+  /* Fall back to accepting unpadded fields and trailing text */
   strv = g_strsplit ((const gchar *)event.data.scalar.value, "-", 4);
 
   if (!strv[0] || !strv[1] || !strv[2])
@@ -387,8 +585,6 @@ modulemd_yaml_parse_string (yaml_parser_t *parser, GError **error)
       MMD_YAML_ERROR_EVENT_EXIT (error, event, "String was not a scalar");
     }
 
-  g_debug ("Parsing scalar: %s", (const gchar *)event.data.scalar.value);
-
   return g_strdup ((const gchar *)event.data.scalar.value);
 }
 
@@ -426,6 +622,7 @@ gint64
 modulemd_yaml_parse_int64 (yaml_parser_t *parser, GError **error)
 {
   MMD_INIT_YAML_EVENT (event);
+  guint64 value;
 
   YAML_PARSER_PARSE_WITH_EXIT_INT (parser, &event, error);
   if (event.type != YAML_SCALAR_EVENT)
@@ -433,6 +630,13 @@ modulemd_yaml_parse_int64 (yaml_parser_t *parser, GError **error)
       MMD_YAML_ERROR_EVENT_EXIT_INT (error, event, "String was not a scalar");
     }
 
+  /* Eighteen digits always fit in a gint64 */
+  if (event.data.scalar.length <= 18 &&
+      modulemd_yaml_scalar_to_uint64 ((const gchar *)event.data.scalar.value,
+                                      event.data.scalar.length,
+                                      &value))
+    return (gint64)value;
+
   return g_ascii_strtoll ((const gchar *)event.data.scalar.value, NULL, 10);
 }
 
@@ -441,6 +645,7 @@ guint64
 modulemd_yaml_parse_uint64 (yaml_parser_t *parser, GError **error)
 {
   MMD_INIT_YAML_EVENT (event);
+  guint64 value;
 
   YAML_PARSER_PARSE_WITH_EXIT_INT (parser, &event, error);
   if (event.type != YAML_SCALAR_EVENT)
@@ -448,7 +653,10 @@ modulemd_yaml_parse_uint64 (yaml_parser_t *parser, GError **error)
       MMD_YAML_ERROR_EVENT_EXIT_INT (error, event, "String was not a scalar");
     }
 
-  g_debug ("Parsing scalar: %s", (const gchar *)event.data.scalar.value);
+  if (modulemd_yaml_scalar_to_uint64 ((const gchar *)event.data.scalar.value,
+                                      event.data.scalar.length,
+                                      &value))
+    return value;
 
   return g_ascii_strtoull ((const gchar *)event.data.scalar.value, NULL, 10);
 }
@@ -479,8 +687,6 @@ modulemd_yaml_parse_string_set (yaml_parser_t *parser, GError **error)
           break;
 
         case YAML_SCALAR_EVENT:
-          g_debug ("Parsing scalar: %s",
-                   (const gchar *)event.data.scalar.value);
           g_hash_table_add (result,
                             g_strdup ((const gchar *)event.data.scalar.value));
 
@@ -847,7 +1053,10 @@ modulemd_yaml_parse_document_type (yaml_parser_t *parser)
 
   modulemd_subdocument_info_set_doctype (s, doctype);
   modulemd_subdocument_info_set_mdversion (s, mdversion);
-  modulemd_subdocument_info_set_yaml (s, yaml_string->str);
+  /* The emitted text becomes the document's contents without another copy */
+  modulemd_yaml_string_shrink (yaml_string);
+  modulemd_subdocument_info_take_yaml (s,
+                                       g_steal_pointer (&yaml_string->str));
 
   return g_steal_pointer (&s);
 }
@@ -983,6 +1192,12 @@ modulemd_yaml_emit_variant (yaml_emitter_t *emitter,
         }
       EMIT_SEQUENCE_END (emitter, error);
     }
+  else if (g_variant_is_of_type (variant, G_VARIANT_TYPE_VARIANT))
+    {
+      /* Lists with elements of different types, as read from JSON */
+      value = g_variant_get_variant (variant);
+      return modulemd_yaml_emit_variant (emitter, value, error);
+    }
   else
     {
       g_set_error (error,
@@ -1002,8 +1217,6 @@ mmd_variant_from_scalar (const gchar *scalar)
   MODULEMD_INIT_TRACE ();
   GVariant *variant = NULL;
 
-  g_debug ("Variant from scalar: %s", scalar);
-
   g_return_val_if_fail (scalar, NULL);
 
   /* Treat "TRUE" and "FALSE" as boolean values */
@@ -1036,7 +1249,6 @@ mmd_variant_from_mapping (yaml_parser_t *parser, GError **error)
 
   g_autoptr (GVariantDict) dict = NULL;
   g_autoptr (GVariant) value = NULL;
-  g_autofree gchar *key = NULL;
   g_autoptr (GError) nested_error = NULL;
 
   dict = g_variant_dict_new (NULL);
@@ -1053,9 +1265,9 @@ mmd_variant_from_mapping (yaml_parser_t *parser, GError **error)
           break;
 
         case YAML_SCALAR_EVENT:
-          /* All mapping keys must be scalars */
-          key = g_strdup ((const gchar *)event.data.scalar.value);
-
+          /* All mapping keys must be scalars. The key is read straight from
+           * the event, which stays alive until the value has been inserted.
+           */
           YAML_PARSER_PARSE_WITH_EXIT (parser, &value_event, error);
 
           switch (value_event.type)
@@ -1099,8 +1311,9 @@ mmd_variant_from_mapping (yaml_parser_t *parser, GError **error)
             }
 
           yaml_event_delete (&value_event);
-          g_variant_dict_insert_value (dict, key, g_steal_pointer (&value));
-          g_clear_pointer (&key, g_free);
+          g_variant_dict_insert_value (dict,
+                                       (const gchar *)event.data.scalar.value,
+                                       g_steal_pointer (&value));
           break;
 
         default:
@@ -0,0 +1,90 @@
+#!/usr/bin/python3
+
+# This file is part of libmodulemd
+# Copyright (C) 2019 Red Hat, Inc.
+#
+# Fedora-License-Identifier: MIT
+# SPDX-2.0-License-Identifier: MIT
+# SPDX-3.0-License-Identifier: MIT
+#
+# This program is free software.
+# For more information on the license, see COPYING.
+# For more information on free software, see
+# <https://www.gnu.org/philosophy/free-sw.en.html>.
+
+from os import path
+import sys
+try:
+    import unittest
+    import gi
+    gi.require_version('Modulemd', '2.0')
+    from gi.repository import Modulemd
+except ImportError:
+    # Return error 77 to skip this test on platforms without the necessary
+    # python modules
+    sys.exit(77)
+
+from base import TestBase
+
+
+class TestIndexDiff(TestBase):
+
+    def read_index(self, fname):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(
+            path.join(self.test_data_path, fname), True)
+        self.assertTrue(ret)
+        return idx
+
+    def test_identical(self):
+        f29 = self.read_index("f29.yaml")
+        diff = f29.diff(self.read_index("f29.yaml"))
+        self.assertTrue(diff.is_empty())
+        self.assertEqual(len(diff.get_added_streams()), 0)
+        self.assertEqual(len(diff.get_removed_streams()), 0)
+        self.assertEqual(len(diff.get_changed_streams()), 0)
+
+    def test_updates(self):
+        f29 = self.read_index("f29.yaml")
+        updates = self.read_index("f29-updates.yaml")
+        diff = f29.diff(updates)
+        self.assertFalse(diff.is_empty())
+
+        def nsvcas(idx):
+            return {s.get_NSVCA()
+                    for n in idx.get_module_names()
+                    for s in idx.get_module(n).get_all_streams()}
+
+        before = nsvcas(f29)
+        after = nsvcas(updates)
+        added = {s.get_NSVCA() for s in diff.get_added_streams()}
+        removed = {s.get_NSVCA() for s in diff.get_removed_streams()}
+
+        self.assertEqual(added, after - before)
+        self.assertEqual(removed, before - after)
+
+        for stream in diff.get_changed_streams():
+            self.assertIn(stream.get_NSVCA(), before & after)
+            self.assertTrue(
+                diff.get_changed_stream_fields(stream.get_NSVCA()))
+
+    def test_changed_fields(self):
+        old = Modulemd.ModuleIndex.new()
+        new = Modulemd.ModuleIndex.new()
+        for idx, summary in ((old, "Before"), (new, "After")):
+            stream = Modulemd.ModuleStreamV2.new("foo", "bar")
+            stream.props.version = 1
+            stream.props.context = "c0ffee42"
+            stream.set_summary(summary)
+            idx.add_module_stream(stream)
+
+        diff = old.diff(new)
+        self.assertEqual(len(diff.get_changed_streams()), 1)
+        self.assertEqual(
+            diff.get_changed_stream_fields("foo:bar:1:c0ffee42"), ["summary"])
+        self.assertIsNone(
+            diff.get_changed_stream_fields("foo:bar:2:c0ffee42"))
+
+
+if __name__ == '__main__':
+    unittest.main()
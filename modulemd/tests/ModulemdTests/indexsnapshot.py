@@ -0,0 +1,61 @@
+#!/usr/bin/python3
+
+# This file is part of libmodulemd
+# Copyright (C) 2019 Red Hat, Inc.
+#
+# Fedora-License-Identifier: MIT
+# SPDX-2.0-License-Identifier: MIT
+# SPDX-3.0-License-Identifier: MIT
+#
+# This program is free software.
+# For more information on the license, see COPYING.
+# For more information on free software, see
+# <https://www.gnu.org/philosophy/free-sw.en.html>.
+
+from os import path
+import sys
+try:
+    import unittest
+    import gi
+    gi.require_version('Modulemd', '2.0')
+    from gi.repository import Modulemd
+except ImportError:
+    # Return error 77 to skip this test on platforms without the necessary
+    # python modules
+    sys.exit(77)
+
+from base import TestBase
+
+
+class TestIndexSnapshot(TestBase):
+
+    def read_index(self, fname):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(
+            path.join(self.test_data_path, fname), True)
+        self.assertTrue(ret)
+        return idx
+
+    def test_publish(self):
+        f29 = self.read_index("f29.yaml")
+        updates = self.read_index("f29-updates.yaml")
+
+        snapshot = Modulemd.IndexSnapshot.new(f29)
+        self.assertTrue(f29.is_frozen())
+        self.assertEqual(snapshot.get_generation(), 0)
+
+        held = snapshot.acquire()
+        self.assertEqual(held.dump_to_string(), f29.dump_to_string())
+
+        snapshot.publish(updates)
+        self.assertTrue(updates.is_frozen())
+        self.assertEqual(snapshot.get_generation(), 1)
+
+        # Readers of the old version are not affected
+        self.assertEqual(held.dump_to_string(), f29.dump_to_string())
+        self.assertEqual(snapshot.acquire().dump_to_string(),
+                         updates.dump_to_string())
+
+
+if __name__ == '__main__':
+    unittest.main()
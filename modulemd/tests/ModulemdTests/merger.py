@@ -232,6 +232,41 @@ data:
         with self.assertRaisesRegexp(gi.repository.GLib.GError, "Default stream mismatch in module python"):
             merger.resolve_ext(True)
 
+    def test_resolve_with_conflicts(self):
+        merger = Modulemd.ModuleIndexMerger.new()
+
+        for stream in ("27", "38"):
+            default = """
+---
+document: modulemd-defaults
+version: 1
+data:
+    module: python
+    modified: 201901010000
+    stream: %s
+...
+""" % (stream)
+
+            index = Modulemd.ModuleIndex()
+            index.update_from_string(default, strict=True)
+            merger.associate_index(index, 0)
+
+        merged_idx, conflicts = merger.resolve_with_conflicts(False)
+        self.assertIsNotNone(merged_idx)
+        self.assertIsNone(
+            merged_idx.get_module("python").get_defaults().get_default_stream())
+
+        self.assertEqual(len(conflicts), 1)
+        conflict = conflicts[0]
+        self.assertEqual(
+            conflict.get_conflict_type(),
+            Modulemd.DefaultsConflictTypeEnum.DEFAULT_STREAM)
+        self.assertEqual(conflict.get_module_name(), "python")
+        self.assertIsNone(conflict.get_intent())
+        self.assertIsNone(conflict.get_stream_name())
+        self.assertEqual(conflict.get_modified(), 201901010000)
+        self.assertEqual(conflict.peek_values(), ["27", "38"])
+
     def test_merge_add_only(self):
         base_idx = Modulemd.ModuleIndex()
         self.assertTrue(base_idx.update_from_file(
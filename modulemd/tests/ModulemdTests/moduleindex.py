@@ -12,6 +12,7 @@
 # For more information on free software, see
 # <https://www.gnu.org/philosophy/free-sw.en.html>.
 
+import json
 from os import path
 import sys
 try:
@@ -115,6 +116,9 @@ profiles:
 
         self.assertNotIn("nodejs", default_streams.keys())
 
+        self.assertEqual(idx.peek_default_streams(None), default_streams)
+        self.assertEqual(idx.peek_default_streams("server"), default_streams)
+
     def test_dump_empty_index(self):
         idx = Modulemd.ModuleIndex.new()
 
@@ -122,6 +126,165 @@ profiles:
             yaml = idx.dump_to_string()
             self.assertIsNone(yaml)
 
+    def test_dump_parallel(self):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(path.join(
+            self.test_data_path, "f29.yaml"), True)
+        self.assertTrue(ret)
+
+        serial = idx.dump_to_string()
+        self.assertIsNotNone(serial)
+
+        for threads in range(0, 4):
+            self.assertEqual(serial, idx.dump_to_string_parallel(threads))
+
+    def test_freeze(self):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(path.join(
+            self.test_data_path, "f29.yaml"), True)
+        self.assertTrue(ret)
+
+        serial = idx.dump_to_string()
+        self.assertFalse(idx.is_frozen())
+        idx.freeze()
+        self.assertTrue(idx.is_frozen())
+
+        self.assertEqual(serial, idx.dump_to_string())
+        self.assertEqual(serial, idx.dump_to_string_parallel(0))
+        self.assertEqual(idx.get_default_streams()["stratis"], "1")
+        self.assertEqual(
+            len(idx.search_streams_by_package_name("stratisd")), 2)
+
+        filtered = idx.filter("dwm", None, 0, None, None,
+                              Modulemd.DocumentTypeFlags.ALL)
+        self.assertFalse(filtered.is_frozen())
+        self.assertListEqual(filtered.get_module_names(), ["dwm"])
+
+    def test_stats(self):
+        idx = Modulemd.ModuleIndex.new()
+        self.assertFalse(idx.get_collect_stats())
+        idx.set_collect_stats(True)
+        self.assertTrue(idx.get_collect_stats())
+
+        ret, failures = idx.update_from_file(path.join(
+            self.test_data_path, "f29.yaml"), True)
+        self.assertTrue(ret)
+
+        stats = idx.get_stats().unpack()
+        self.assertEqual(
+            stats['bytes-read'],
+            path.getsize(path.join(self.test_data_path, "f29.yaml")))
+        self.assertGreater(stats['documents-modulemd'], 0)
+        self.assertEqual(stats['failures'], 0)
+
+        idx.reset_stats()
+        for value in idx.get_stats().unpack().values():
+            self.assertEqual(value, 0)
+
+    def test_filter(self):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(path.join(
+            self.test_data_path, "f29.yaml"), True)
+        self.assertTrue(ret)
+
+        filtered = idx.filter("dwm", None, 0, None, "x86_64",
+                              Modulemd.DocumentTypeFlags.ALL)
+        self.assertListEqual(filtered.get_module_names(), ["dwm"])
+        self.assertEqual(filtered.get_default_streams()["dwm"], "6.1")
+        for stream in filtered.get_module("dwm").get_all_streams():
+            self.assertEqual(stream.get_arch(), "x86_64")
+
+        filtered = idx.filter(None, None, 0, None, None,
+                              Modulemd.DocumentTypeFlags.DEFAULTS)
+        for name in filtered.get_module_names():
+            self.assertEqual(
+                len(filtered.get_module(name).get_all_streams()), 0)
+
+        module_names = idx.get_module_names()
+        self.assertGreater(idx.prune("dwm", None, 0, None, None,
+                                     Modulemd.DocumentTypeFlags.ALL), 0)
+        self.assertListEqual(idx.get_module_names(), ["dwm"])
+        self.assertIn("stratis", module_names)
+
+    def test_search_streams_by_rpm_artifact(self):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(path.join(
+            self.test_data_path, "f29.yaml"), True)
+        self.assertTrue(ret)
+
+        streams = idx.search_streams_by_rpm_artifact(
+            "stratisd-0:1.0.0-1.module_2238+b7fada88.x86_64")
+        self.assertEqual(len(streams), 1)
+        self.assertEqual(streams[0].get_module_name(), "stratis")
+        self.assertEqual(streams[0].get_stream_name(), "1")
+
+        streams = idx.search_streams_by_package_name("stratisd")
+        self.assertEqual(len(streams), 2)
+        for stream in streams:
+            self.assertEqual(stream.get_module_name(), "stratis")
+
+        self.assertEqual(
+            len(idx.search_streams_by_package_name("stratis")), 0)
+        self.assertEqual(
+            len(idx.search_streams_by_rpm_artifact("stratisd")), 0)
+
+        self.assertTrue(idx.remove_module("stratis"))
+        self.assertEqual(
+            len(idx.search_streams_by_package_name("stratisd")), 0)
+
+    def test_search_streams_by_rpm_checksum(self):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(
+            path.join(self.source_root, "spec.v2.yaml"), True)
+        self.assertTrue(ret)
+
+        checksum = ("ee47083ed80146eb2c84e9a94d0836393912185dcda62b9d93ee0c2"
+                    "ea5dc795b")
+        streams, entry = idx.search_streams_by_rpm_checksum(
+            "sha256", checksum)
+        self.assertEqual(len(streams), 1)
+        self.assertEqual(streams[0].get_nsvc(),
+                         "foo:latest:20160927144203:c0ffee43")
+        self.assertEqual(entry.get_nevra_as_string(),
+                         "bar-0:1.23-1.module_deadbeef.x86_64")
+
+        streams, entry = idx.search_streams_by_rpm_checksum(
+            "sha512", checksum)
+        self.assertEqual(len(streams), 0)
+        self.assertIsNone(entry)
+
+    def test_export_streams(self):
+        idx = Modulemd.ModuleIndex.new()
+        ret, failures = idx.update_from_file(
+            path.join(self.source_root, "spec.v2.yaml"), True)
+        self.assertTrue(ret)
+
+        streams = json.loads(idx.export_streams_as_json())
+        self.assertEqual(len(streams), 1)
+
+        stream = streams[0]
+        self.assertEqual(stream['nsvca'],
+                         "foo:latest:20160927144203:c0ffee43:x86_64")
+        self.assertEqual(stream['version'], 20160927144203)
+        self.assertEqual(stream['arch'], "x86_64")
+        self.assertEqual(len(stream['rpm_artifacts']), 7)
+        self.assertEqual(stream['rpm_artifacts'][0],
+                         "bar-0:1.23-1.module_deadbeef.x86_64")
+
+        self.assertEqual(len(stream['dependencies']), 4)
+        self.assertDictEqual(stream['dependencies'][1]['buildrequires'], {
+            'buildtools': ['v1', 'v2'],
+            'compatible': ['v3'],
+            'platform': ['f27']})
+        self.assertListEqual(
+            stream['dependencies'][3]['requires']['extras'], [])
+
+        if '_overrides_module' in dir(Modulemd):
+            # The overrides decode the JSON summary in one call
+            self.assertEqual(idx.export_streams(), streams)
+        else:
+            self.assertEqual(idx.export_streams().unpack(), streams)
+
     def test_update_from_defaults_directory(self):
         idx = Modulemd.ModuleIndex.new()
         self.assertIsNotNone(idx)
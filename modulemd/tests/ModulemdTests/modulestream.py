@@ -13,6 +13,7 @@
 # For more information on free software, see
 # <https://www.gnu.org/philosophy/free-sw.en.html>.
 
+import json
 import os
 import sys
 try:
@@ -576,6 +577,46 @@ class TestModuleStream(TestBase):
 
             self.assertIsNotNone(out_yaml)
 
+    def test_xmd_json(self):
+        xmd = {'mbs': {'commit': 'abc',
+                       'buildrequires': {'platform': {'ref': 'f29'}},
+                       'rpms': ['a', 'b']},
+               'flag': True,
+               'unicode': '\u00e9'}
+
+        for version in modulestream_versions:
+            stream = Modulemd.ModuleStream.new(version, 'foo', 'bar')
+            self.assertIsNone(stream.get_xmd_as_json())
+
+            self.assertTrue(stream.set_xmd_from_json(json.dumps(xmd)))
+            self.assertEqual(json.loads(stream.get_xmd_as_json()), xmd)
+
+            # Numbers are stored as the strings YAML would give
+            stream.set_xmd_from_json('{"ids": [1, 2]}')
+            self.assertEqual(json.loads(stream.get_xmd_as_json()),
+                             {'ids': ['1', '2']})
+
+            with self.assertRaisesRegexp(gi.repository.GLib.GError,
+                                         'Invalid JSON'):
+                stream.set_xmd_from_json('{"ids": [1, 2}')
+
+            if '_overrides_module' in dir(Modulemd):
+                stream.set_xmd(xmd)
+                self.assertEqual(stream.get_xmd(), xmd)
+
+                # Only strings, booleans, lists and dictionaries can be set,
+                # as before the conversion went through JSON
+                for bad_xmd in (None, 1, {'ids': [1, 2]}, {'ratio': 0.5},
+                                {1: 'one'}, ('a', 'b')):
+                    with self.assertRaises(TypeError):
+                        stream.set_xmd(bad_xmd)
+                self.assertEqual(stream.get_xmd(), xmd)
+
+                # None inside lists and dictionaries is stored as ''
+                stream.set_xmd({'a': None, 'b': ['c', None]})
+                self.assertEqual(stream.get_xmd(),
+                                 {'a': '', 'b': ['c', '']})
+
     def test_upgrade(self):
         v1_stream = Modulemd.ModuleStreamV1.new("SuperModule", "latest")
         v1_stream.set_summary("Summary")
@@ -1183,6 +1224,26 @@ data:
         self.assertIsNotNone(stream)
         self.assertTrue(stream.validate())
 
+    def test_fingerprint(self):
+        stream = Modulemd.ModuleStream.read_file(
+            "%s/stream_unicode.yaml" %
+            (os.getenv('TEST_DATA_PATH')), True, '', '')
+        fingerprint = stream.get_fingerprint()
+        self.assertNotEqual(fingerprint, 0)
+
+        # Copies match until one of them is modified
+        copy = stream.copy()
+        self.assertEqual(copy.get_fingerprint(), fingerprint)
+        self.assertTrue(stream.equals(copy))
+
+        copy.set_summary('A different summary')
+        self.assertNotEqual(copy.get_fingerprint(), fingerprint)
+        self.assertFalse(stream.equals(copy))
+
+        copy.set_summary(stream.get_summary(locale="C"))
+        self.assertEqual(copy.get_fingerprint(), fingerprint)
+        self.assertTrue(stream.equals(copy))
+
     def test_xmd_issue_274(self):
         # Test a valid module stream with unicode in the description
         stream = Modulemd.ModuleStream.read_file(
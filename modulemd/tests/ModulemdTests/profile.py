@@ -114,6 +114,10 @@ class TestProfile(TestBase):
 
         p.remove_rpm('test1')
         assert p.get_rpms() == ['test2', 'test3']
+        assert p.peek_rpms() == ['test2', 'test3']
+
+        p.clear_rpms()
+        assert p.peek_rpms() == []
 
 
 if __name__ == '__main__':
@@ -13,6 +13,7 @@
 
 #include <glib.h>
 #include <glib/gstdio.h>
+#include <unistd.h>
 
 #include "modulemd-compression.h"
 #include "private/modulemd-compression-private.h"
@@ -104,8 +105,7 @@ test_modulemd_detect_compression (void)
     }
 
 
-    /* == Test detection by libmagic == */
-#ifdef HAVE_LIBMAGIC
+  /* == Detect by file signature, then by libmagic == */
   struct expected_compression_t expected_magic[] = {
     { .filename = "bzipped",
       .type = MODULEMD_COMPRESSION_TYPE_BZ2_COMPRESSION },
@@ -113,27 +113,17 @@ test_modulemd_detect_compression (void)
       .type = MODULEMD_COMPRESSION_TYPE_GZ_COMPRESSION },
     { .filename = "xzipped",
       .type = MODULEMD_COMPRESSION_TYPE_XZ_COMPRESSION },
+#ifdef HAVE_LIBMAGIC
     { .filename = "uncompressed",
       .type = MODULEMD_COMPRESSION_TYPE_NO_COMPRESSION },
-    { .filename = "empty",
-      .type = MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION },
-    { .filename = NULL }
-  };
 #else
-  struct expected_compression_t expected_magic[] = {
-    { .filename = "bzipped",
-      .type = MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION },
-    { .filename = "gzipped",
-      .type = MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION },
-    { .filename = "xzipped",
-      .type = MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION },
     { .filename = "uncompressed",
       .type = MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION },
+#endif
     { .filename = "empty",
       .type = MODULEMD_COMPRESSION_TYPE_UNKNOWN_COMPRESSION },
     { .filename = NULL }
   };
-#endif
 
   for (size_t j = 0; expected_magic[j].filename; j++)
     {
@@ -147,6 +137,9 @@ test_modulemd_detect_compression (void)
                        ==,
                        expected_magic[j].type);
       g_assert_no_error (error);
+
+      /* Detection must leave the file ready to be read from the start */
+      g_assert_cmpint (lseek (fd, 0, SEEK_CUR), ==, 0);
       g_clear_error (&error);
       g_clear_pointer (&filestream, fclose);
       g_clear_pointer (&filename, g_free);
@@ -154,6 +147,55 @@ test_modulemd_detect_compression (void)
 }
 
 
+static void
+test_modulemd_detect_compression_benchmark (void)
+{
+  const gchar *filenames[] = { "gzipped", "uncompressed", NULL };
+  g_autofree gchar *filename = NULL;
+  g_autoptr (FILE) filestream = NULL;
+  g_autoptr (GError) error = NULL;
+  ModulemdCompressionTypeEnum expected;
+  guint iterations = 1000;
+  gdouble elapsed;
+  int fd;
+
+  if (!g_test_perf ())
+    return;
+
+  for (size_t i = 0; filenames[i]; i++)
+    {
+      filename = g_strdup_printf ("%s/compression/%s",
+                                  g_getenv ("TEST_DATA_PATH"),
+                                  filenames[i]);
+      filestream = g_fopen (filename, "rb");
+      g_assert_nonnull (filestream);
+      fd = fileno (filestream);
+
+      /* The first call may have to load the libmagic database */
+      expected = modulemd_detect_compression (filename, fd, &error);
+      g_assert_no_error (error);
+
+      g_test_timer_start ();
+      for (guint n = 0; n < iterations; n++)
+        {
+          g_assert_cmpint (modulemd_detect_compression (filename, fd, &error),
+                           ==,
+                           expected);
+          g_assert_no_error (error);
+        }
+      elapsed = g_test_timer_elapsed ();
+
+      g_test_minimized_result (elapsed * 1000000 / iterations,
+                               "Detected the compression of %s in %.1f us",
+                               filenames[i],
+                               elapsed * 1000000 / iterations);
+
+      g_clear_pointer (&filestream, fclose);
+      g_clear_pointer (&filename, g_free);
+    }
+}
+
+
 struct expected_suffix_t
 {
   ModulemdCompressionTypeEnum type;
@@ -244,6 +286,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/modulemd/compression/detect",
                    test_modulemd_detect_compression);
 
+  g_test_add_func ("/modulemd/compression/detect_benchmark",
+                   test_modulemd_detect_compression_benchmark);
+
   g_test_add_func ("/modulemd/compression/suffix",
                    test_modulemd_compression_suffix);
 
@@ -16,7 +16,9 @@
 #include <locale.h>
 #include <signal.h>
 
+#include "modulemd-defaults-conflict.h"
 #include "modulemd-defaults-v1.h"
+#include "modulemd-errors.h"
 #include "private/glib-extensions.h"
 #include "private/modulemd-defaults-v1-private.h"
 #include "private/modulemd-translation-entry-private.h"
@@ -373,6 +375,7 @@ defaults_test_profiles (CommonMmdTestFixture *fixture, gconstpointer user_data)
   g_autoptr (ModulemdDefaultsV1) defaults = NULL;
   g_auto (GStrv) streams = NULL;
   g_auto (GStrv) profiles = NULL;
+  const gchar *const *peeked = NULL;
 
   defaults = modulemd_defaults_v1_new ("foo");
   g_assert_true (MODULEMD_IS_DEFAULTS_V1 (defaults));
@@ -453,6 +456,43 @@ defaults_test_profiles (CommonMmdTestFixture *fixture, gconstpointer user_data)
   g_assert_cmpstr (streams[1], ==, "stable");
   g_assert_null (streams[2]);
   g_clear_pointer (&streams, g_strfreev);
+
+  /* The peeked lists match, and are kept until the next change */
+  peeked = modulemd_defaults_v1_peek_streams_with_default_profiles (defaults,
+                                                                    NULL);
+  g_assert_cmpstr (peeked[0], ==, "experimental");
+  g_assert_cmpstr (peeked[1], ==, "stable");
+  g_assert_null (peeked[2]);
+  g_assert_true (modulemd_defaults_v1_peek_streams_with_default_profiles (
+                   defaults, "server") == peeked);
+
+  peeked = modulemd_defaults_v1_peek_default_profiles_for_stream (
+    defaults, "stable", NULL);
+  g_assert_cmpstr (peeked[0], ==, "client");
+  g_assert_cmpstr (peeked[1], ==, "server");
+  g_assert_null (peeked[2]);
+  g_assert_null (modulemd_defaults_v1_peek_default_profiles_for_stream (
+    defaults, "nonexistent", NULL));
+
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    defaults, "stable", "default", NULL);
+  peeked = modulemd_defaults_v1_peek_default_profiles_for_stream (
+    defaults, "stable", NULL);
+  g_assert_cmpstr (peeked[0], ==, "client");
+  g_assert_cmpstr (peeked[1], ==, "default");
+  g_assert_cmpstr (peeked[2], ==, "server");
+  g_assert_null (peeked[3]);
+
+  /* Intents fall back to the generic profiles */
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    defaults, "stable", "minimal", "server");
+  peeked = modulemd_defaults_v1_peek_default_profiles_for_stream (
+    defaults, "stable", "server");
+  g_assert_cmpstr (peeked[0], ==, "minimal");
+  g_assert_null (peeked[1]);
+  peeked = modulemd_defaults_v1_peek_default_profiles_for_stream (
+    defaults, "experimental", "server");
+  g_assert_cmpstr (peeked[0], ==, "client");
 }
 
 
@@ -737,6 +777,241 @@ defaults_test_emit_yaml (CommonMmdTestFixture *fixture,
 }
 
 
+static void
+defaults_test_merge_n (CommonMmdTestFixture *fixture, gconstpointer user_data)
+{
+  g_autoptr (ModulemdDefaultsV1) older = NULL;
+  g_autoptr (ModulemdDefaultsV1) newer = NULL;
+  g_autoptr (ModulemdDefaultsV1) newer_conflict = NULL;
+  g_autoptr (ModulemdDefaultsV1) merged = NULL;
+  g_autoptr (GPtrArray) defaults = NULL;
+  g_autoptr (GPtrArray) conflicts = NULL;
+  g_auto (GStrv) profiles = NULL;
+  g_autoptr (GError) error = NULL;
+  ModulemdDefaultsConflict *conflict = NULL;
+  const gchar *const *values = NULL;
+
+  older = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (older), 1);
+  modulemd_defaults_v1_set_default_stream (older, "old", NULL);
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    older, "old", "client", NULL);
+  modulemd_defaults_v1_set_default_stream (older, "old", "server");
+
+  newer = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (newer), 2);
+  modulemd_defaults_v1_set_default_stream (newer, "new", NULL);
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    newer, "new", "server", NULL);
+
+  newer_conflict = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (newer_conflict), 2);
+  modulemd_defaults_v1_set_default_stream (newer_conflict, "newest", NULL);
+
+  /* The newest value for each field wins, regardless of ordering */
+  defaults = g_ptr_array_new ();
+  g_ptr_array_add (defaults, newer);
+  g_ptr_array_add (defaults, older);
+
+  merged = modulemd_defaults_v1_merge_n (defaults, TRUE, &conflicts, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (merged);
+  g_assert_nonnull (conflicts);
+  g_assert_cmpint (conflicts->len, ==, 0);
+  g_assert_cmpuint (
+    modulemd_defaults_get_modified (MODULEMD_DEFAULTS (merged)), ==, 2);
+  g_assert_cmpstr (
+    modulemd_defaults_v1_get_default_stream (merged, NULL), ==, "new");
+  g_assert_cmpstr (
+    modulemd_defaults_v1_get_default_stream (merged, "server"), ==, "old");
+
+  /* Profiles that only appear in the older entry are retained */
+  profiles = modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
+    merged, "old", NULL);
+  g_assert_cmpint (g_strv_length (profiles), ==, 1);
+  g_assert_cmpstr (profiles[0], ==, "client");
+  g_clear_pointer (&profiles, g_strfreev);
+
+  profiles = modulemd_defaults_v1_get_default_profiles_for_stream_as_strv (
+    merged, "new", NULL);
+  g_assert_cmpint (g_strv_length (profiles), ==, 1);
+  g_assert_cmpstr (profiles[0], ==, "server");
+  g_clear_pointer (&profiles, g_strfreev);
+
+  g_clear_object (&merged);
+  g_clear_pointer (&conflicts, g_ptr_array_unref);
+
+  /* Two entries with the same modified value but different default streams
+   * are reported as a conflict and unset the default stream.
+   */
+  g_ptr_array_add (defaults, newer_conflict);
+
+  merged = modulemd_defaults_v1_merge_n (defaults, FALSE, &conflicts, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (merged);
+  g_assert_nonnull (conflicts);
+  g_assert_cmpint (conflicts->len, ==, 1);
+  g_assert_null (modulemd_defaults_v1_get_default_stream (merged, NULL));
+
+  conflict = g_ptr_array_index (conflicts, 0);
+  g_assert_true (MODULEMD_IS_DEFAULTS_CONFLICT (conflict));
+  g_assert_cmpint (modulemd_defaults_conflict_get_conflict_type (conflict),
+                   ==,
+                   MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM);
+  g_assert_cmpstr (
+    modulemd_defaults_conflict_get_module_name (conflict), ==, "foo");
+  g_assert_null (modulemd_defaults_conflict_get_intent (conflict));
+  g_assert_null (modulemd_defaults_conflict_get_stream_name (conflict));
+  g_assert_cmpuint (modulemd_defaults_conflict_get_modified (conflict), ==, 2);
+  values = modulemd_defaults_conflict_peek_values (conflict);
+  g_assert_cmpint (g_strv_length ((gchar **)values), ==, 2);
+  g_assert_cmpstr (values[0], ==, "new");
+  g_assert_cmpstr (values[1], ==, "newest");
+
+  g_clear_object (&merged);
+  g_clear_pointer (&conflicts, g_ptr_array_unref);
+
+  /* With strict default streams, the same conflict is an error but is still
+   * reported.
+   */
+  merged = modulemd_defaults_v1_merge_n (defaults, TRUE, &conflicts, &error);
+  g_assert_error (error, MODULEMD_ERROR, MODULEMD_ERROR_VALIDATE);
+  g_assert_null (merged);
+  g_assert_nonnull (conflicts);
+  g_assert_cmpint (conflicts->len, ==, 1);
+}
+
+
+static void
+defaults_test_merge_n_conflict_marker (CommonMmdTestFixture *fixture,
+                                       gconstpointer user_data)
+{
+  g_autoptr (ModulemdDefaultsV1) first = NULL;
+  g_autoptr (ModulemdDefaultsV1) second = NULL;
+  g_autoptr (ModulemdDefaultsV1) blocked = NULL;
+  g_autoptr (ModulemdDefaultsV1) same = NULL;
+  g_autoptr (ModulemdDefaultsV1) newer = NULL;
+  g_autoptr (ModulemdDefaultsV1) merged = NULL;
+  g_autoptr (GPtrArray) defaults = NULL;
+  g_autoptr (GPtrArray) conflicts = NULL;
+  g_autoptr (GError) error = NULL;
+
+  first = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (first), 1);
+  modulemd_defaults_v1_set_default_stream (first, "first", NULL);
+
+  second = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (second), 1);
+  modulemd_defaults_v1_set_default_stream (second, "second", NULL);
+
+  /* A non-strict conflict leaves the merge conflict marker behind */
+  defaults = g_ptr_array_new ();
+  g_ptr_array_add (defaults, first);
+  g_ptr_array_add (defaults, second);
+  blocked = modulemd_defaults_v1_merge_n (defaults, FALSE, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (blocked);
+  g_assert_null (modulemd_defaults_v1_get_default_stream (blocked, NULL));
+  g_clear_pointer (&defaults, g_ptr_array_unref);
+
+  /* Merging the marker with a default stream of the same modified value
+   * keeps the default stream unset. The conflict was already reported by
+   * the merge that produced the marker.
+   */
+  same = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (same), 1);
+  modulemd_defaults_v1_set_default_stream (same, "first", NULL);
+
+  defaults = g_ptr_array_new ();
+  g_ptr_array_add (defaults, blocked);
+  g_ptr_array_add (defaults, same);
+  merged = modulemd_defaults_v1_merge_n (defaults, FALSE, &conflicts, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (merged);
+  g_assert_cmpint (conflicts->len, ==, 0);
+  g_assert_null (modulemd_defaults_v1_get_default_stream (merged, NULL));
+  g_clear_object (&merged);
+  g_clear_pointer (&conflicts, g_ptr_array_unref);
+
+  /* A default stream with a higher modified value supersedes the marker,
+   * whichever order the defaults are merged in.
+   */
+  newer = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_set_modified (MODULEMD_DEFAULTS (newer), 2);
+  modulemd_defaults_v1_set_default_stream (newer, "newer", NULL);
+
+  g_ptr_array_add (defaults, newer);
+  merged = modulemd_defaults_v1_merge_n (defaults, TRUE, &conflicts, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (merged);
+  g_assert_cmpint (conflicts->len, ==, 0);
+  g_assert_cmpstr (
+    modulemd_defaults_v1_get_default_stream (merged, NULL), ==, "newer");
+  g_clear_object (&merged);
+  g_clear_pointer (&conflicts, g_ptr_array_unref);
+
+  g_ptr_array_remove_index (defaults, 0);
+  g_ptr_array_add (defaults, blocked);
+  merged = modulemd_defaults_v1_merge_n (defaults, TRUE, &conflicts, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (
+    modulemd_defaults_v1_get_default_stream (merged, NULL), ==, "newer");
+}
+
+
+static void
+defaults_test_fingerprint (CommonMmdTestFixture *fixture,
+                           gconstpointer user_data)
+{
+  g_autoptr (ModulemdDefaultsV1) defaults = NULL;
+  g_autoptr (ModulemdDefaults) copy = NULL;
+  ModulemdDefaultsV1 *v1_copy = NULL;
+  guint64 fingerprint;
+
+  defaults = modulemd_defaults_v1_new ("foo");
+  modulemd_defaults_v1_set_default_stream (defaults, "latest", NULL);
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    defaults, "latest", "client", NULL);
+  modulemd_defaults_v1_set_default_stream (defaults, "stable", "server");
+
+  fingerprint =
+    modulemd_defaults_get_fingerprint (MODULEMD_DEFAULTS (defaults));
+  g_assert_cmpuint (fingerprint, !=, 0);
+
+  /* Copies have the same content, and so the same fingerprint */
+  copy = modulemd_defaults_copy (MODULEMD_DEFAULTS (defaults));
+  v1_copy = MODULEMD_DEFAULTS_V1 (copy);
+  g_assert_cmpuint (modulemd_defaults_get_fingerprint (copy), ==, fingerprint);
+  g_assert_true (
+    modulemd_defaults_equals (MODULEMD_DEFAULTS (defaults), copy));
+
+  /* Every setter drops the cached fingerprint */
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    v1_copy, "latest", "server", NULL);
+  g_assert_cmpuint (modulemd_defaults_get_fingerprint (copy), !=, fingerprint);
+  g_assert_false (
+    modulemd_defaults_equals (MODULEMD_DEFAULTS (defaults), copy));
+
+  modulemd_defaults_v1_remove_default_profiles_for_stream (
+    v1_copy, "latest", NULL);
+  modulemd_defaults_v1_add_default_profile_for_stream (
+    v1_copy, "latest", "client", NULL);
+  g_assert_cmpuint (modulemd_defaults_get_fingerprint (copy), ==, fingerprint);
+  g_assert_true (
+    modulemd_defaults_equals (MODULEMD_DEFAULTS (defaults), copy));
+
+  modulemd_defaults_v1_set_default_stream (v1_copy, NULL, "server");
+  g_assert_cmpuint (modulemd_defaults_get_fingerprint (copy), !=, fingerprint);
+  modulemd_defaults_v1_set_default_stream (v1_copy, "stable", "server");
+  g_assert_cmpuint (modulemd_defaults_get_fingerprint (copy), ==, fingerprint);
+
+  modulemd_defaults_set_modified (copy, 42);
+  g_assert_cmpuint (modulemd_defaults_get_fingerprint (copy), !=, fingerprint);
+  g_assert_false (
+    modulemd_defaults_equals (MODULEMD_DEFAULTS (defaults), copy));
+}
+
+
 int
 main (int argc, char *argv[])
 {
@@ -788,6 +1063,27 @@ main (int argc, char *argv[])
               defaults_test_profiles,
               NULL);
 
+  g_test_add ("/modulemd/v2/defaults/v1/merge_n",
+              CommonMmdTestFixture,
+              NULL,
+              NULL,
+              defaults_test_merge_n,
+              NULL);
+
+  g_test_add ("/modulemd/v2/defaults/v1/merge_n_conflict_marker",
+              CommonMmdTestFixture,
+              NULL,
+              NULL,
+              defaults_test_merge_n_conflict_marker,
+              NULL);
+
+  g_test_add ("/modulemd/v2/defaults/v1/fingerprint",
+              CommonMmdTestFixture,
+              NULL,
+              NULL,
+              defaults_test_fingerprint,
+              NULL);
+
   g_test_add ("/modulemd/v2/defaults/v1/yaml/parse",
               CommonMmdTestFixture,
               NULL,
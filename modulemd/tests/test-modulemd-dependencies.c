@@ -391,6 +391,63 @@ dependencies_test_copy (DependenciesFixture *fixture, gconstpointer user_data)
   g_clear_pointer (&list, g_strfreev);
 }
 
+static void
+dependencies_test_peek (DependenciesFixture *fixture, gconstpointer user_data)
+{
+  g_autoptr (ModulemdDependencies) d = NULL;
+  g_autoptr (ModulemdDependencies) d_copy = NULL;
+  const gchar *const *modules = NULL;
+  const gchar *const *streams = NULL;
+
+  d = modulemd_dependencies_new ();
+  modulemd_dependencies_add_buildtime_stream (d, "buildmod1", "stream2");
+  modulemd_dependencies_add_buildtime_stream (d, "buildmod1", "stream1");
+  modulemd_dependencies_set_empty_buildtime_dependencies_for_module (
+    d, "builddef");
+  modulemd_dependencies_add_runtime_stream (d, "runmod1", "stream3");
+
+  modules = modulemd_dependencies_peek_buildtime_modules (d);
+  g_assert_cmpstr (modules[0], ==, "builddef");
+  g_assert_cmpstr (modules[1], ==, "buildmod1");
+  g_assert_null (modules[2]);
+  g_assert_true (modulemd_dependencies_peek_buildtime_modules (d) == modules);
+
+  streams = modulemd_dependencies_peek_buildtime_streams (d, "buildmod1");
+  g_assert_cmpstr (streams[0], ==, "stream1");
+  g_assert_cmpstr (streams[1], ==, "stream2");
+  g_assert_null (streams[2]);
+  g_assert_null (
+    modulemd_dependencies_peek_buildtime_streams (d, "builddef")[0]);
+
+  modules = modulemd_dependencies_peek_runtime_modules (d);
+  g_assert_cmpstr (modules[0], ==, "runmod1");
+  g_assert_null (modules[1]);
+  streams = modulemd_dependencies_peek_runtime_streams (d, "runmod1");
+  g_assert_cmpstr (streams[0], ==, "stream3");
+  g_assert_null (streams[1]);
+
+  signal (SIGTRAP, sigtrap_handler);
+  g_assert_null (
+    modulemd_dependencies_peek_runtime_streams (d, "nosuchmodule"));
+
+  /* Modifying a copy leaves the lists of the original alone */
+  d_copy = modulemd_dependencies_copy (d);
+  modulemd_dependencies_add_runtime_stream (d_copy, "runmod1", "stream0");
+  streams = modulemd_dependencies_peek_runtime_streams (d_copy, "runmod1");
+  g_assert_cmpstr (streams[0], ==, "stream0");
+  streams = modulemd_dependencies_peek_runtime_streams (d, "runmod1");
+  g_assert_cmpstr (streams[0], ==, "stream3");
+  g_assert_null (streams[1]);
+
+  /* Changes show up in the next peek */
+  modulemd_dependencies_add_runtime_stream (d, "runmod0", "stream5");
+  modules = modulemd_dependencies_peek_runtime_modules (d);
+  g_assert_cmpstr (modules[0], ==, "runmod0");
+  g_assert_cmpstr (modules[1], ==, "runmod1");
+  modulemd_dependencies_clear_runtime_dependencies (d);
+  g_assert_null (modulemd_dependencies_peek_runtime_modules (d)[0]);
+}
+
 static void
 dependencies_test_parse_yaml (DependenciesFixture *fixture,
                               gconstpointer user_data)
@@ -626,6 +683,13 @@ main (int argc, char *argv[])
               dependencies_test_copy,
               NULL);
 
+  g_test_add ("/modulemd/v2/dependencies/peek",
+              DependenciesFixture,
+              NULL,
+              NULL,
+              dependencies_test_peek,
+              NULL);
+
   g_test_add ("/modulemd/v2/dependencies/yaml/parse",
               DependenciesFixture,
               NULL,
@@ -0,0 +1,409 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include <locale.h>
+
+#include "modulemd-defaults-v1.h"
+#include "modulemd-index-diff.h"
+#include "modulemd-module.h"
+#include "modulemd-module-index.h"
+#include "modulemd-module-stream-v2.h"
+#include "modulemd-translation.h"
+#include "modulemd-translation-entry.h"
+#include "private/test-utils.h"
+
+
+static ModulemdModuleIndex *
+read_index (const gchar *filename)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml_path = NULL;
+
+  yaml_path =
+    g_strdup_printf ("%s/%s", g_getenv ("TEST_DATA_PATH"), filename);
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+
+  return g_steal_pointer (&index);
+}
+
+
+static void
+add_stream (ModulemdModuleIndex *index,
+            const gchar *stream_name,
+            const gchar *summary)
+{
+  g_autoptr (ModulemdModuleStreamV2) stream = NULL;
+  g_autoptr (GError) error = NULL;
+
+  stream = modulemd_module_stream_v2_new ("foo", stream_name);
+  modulemd_module_stream_set_version (MODULEMD_MODULE_STREAM (stream), 1);
+  modulemd_module_stream_set_context (MODULEMD_MODULE_STREAM (stream),
+                                      "c0ffee42");
+  modulemd_module_stream_v2_set_summary (stream, summary);
+  modulemd_module_stream_v2_add_rpm_api (stream, "foo");
+
+  g_assert_true (modulemd_module_index_add_module_stream (
+    index, MODULEMD_MODULE_STREAM (stream), &error));
+  g_assert_no_error (error);
+}
+
+
+static void
+add_defaults (ModulemdModuleIndex *index,
+              const gchar *module_name,
+              const gchar *default_stream)
+{
+  g_autoptr (ModulemdDefaultsV1) defaults = NULL;
+  g_autoptr (GError) error = NULL;
+
+  defaults = modulemd_defaults_v1_new (module_name);
+  modulemd_defaults_v1_set_default_stream (defaults, default_stream, NULL);
+
+  g_assert_true (modulemd_module_index_add_defaults (
+    index, MODULEMD_DEFAULTS (defaults), &error));
+  g_assert_no_error (error);
+}
+
+
+static void
+add_translation (ModulemdModuleIndex *index,
+                 const gchar *stream_name,
+                 const gchar *locale,
+                 const gchar *summary)
+{
+  g_autoptr (ModulemdTranslation) translation = NULL;
+  g_autoptr (ModulemdTranslationEntry) entry = NULL;
+  g_autoptr (GError) error = NULL;
+
+  translation = modulemd_translation_new (1, "foo", stream_name, 42);
+  entry = modulemd_translation_entry_new (locale);
+  modulemd_translation_entry_set_summary (entry, summary);
+  modulemd_translation_set_translation_entry (translation, entry);
+
+  g_assert_true (
+    modulemd_module_index_add_translation (index, translation, &error));
+  g_assert_no_error (error);
+}
+
+
+/* The set of the NSVCAs of all of the streams in @index */
+static GHashTable *
+get_nsvcas (ModulemdModuleIndex *index)
+{
+  g_auto (GStrv) module_names =
+    modulemd_module_index_get_module_names_as_strv (index);
+  GHashTable *nsvcas =
+    g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  ModulemdModule *module = NULL;
+  GPtrArray *streams = NULL;
+
+  for (guint i = 0; module_names[i]; i++)
+    {
+      module = modulemd_module_index_get_module (index, module_names[i]);
+      streams = modulemd_module_get_all_streams (module);
+      for (guint j = 0; j < streams->len; j++)
+        g_hash_table_add (nsvcas,
+                          modulemd_module_stream_get_NSVCA_as_string (
+                            g_ptr_array_index (streams, j)));
+    }
+
+  return nsvcas;
+}
+
+
+/* Checks that each stream of @streams is in @in and not in @not_in */
+static void
+assert_streams_in (GPtrArray *streams, GHashTable *in, GHashTable *not_in)
+{
+  g_autofree gchar *nsvca = NULL;
+
+  for (guint i = 0; i < streams->len; i++)
+    {
+      nsvca = modulemd_module_stream_get_NSVCA_as_string (
+        g_ptr_array_index (streams, i));
+      g_assert_true (g_hash_table_contains (in, nsvca));
+      if (not_in)
+        g_assert_false (g_hash_table_contains (not_in, nsvca));
+      g_clear_pointer (&nsvca, g_free);
+    }
+}
+
+
+static void
+test_index_diff_identical (void)
+{
+  g_autoptr (ModulemdModuleIndex) first = read_index ("f29.yaml");
+  g_autoptr (ModulemdModuleIndex) second = read_index ("f29.yaml");
+  g_autoptr (ModulemdIndexDiff) diff = NULL;
+
+  diff = modulemd_module_index_diff (first, first);
+  g_assert_true (modulemd_index_diff_is_empty (diff));
+  g_clear_object (&diff);
+
+  /* Separately-read copies of the same metadata have the same fingerprints */
+  diff = modulemd_module_index_diff (first, second);
+  g_assert_true (modulemd_index_diff_is_empty (diff));
+  g_assert_cmpuint (modulemd_index_diff_get_added_streams (diff)->len, ==, 0);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_removed_streams (diff)->len, ==, 0);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_changed_streams (diff)->len, ==, 0);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_changed_defaults (diff)->len, ==, 0);
+  g_clear_object (&diff);
+
+  /* Whether the indexes are frozen makes no difference */
+  modulemd_module_index_freeze (second);
+  diff = modulemd_module_index_diff (first, second);
+  g_assert_true (modulemd_index_diff_is_empty (diff));
+}
+
+
+static void
+test_index_diff_streams (void)
+{
+  g_autoptr (ModulemdModuleIndex) from = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) to = modulemd_module_index_new ();
+  g_autoptr (ModulemdIndexDiff) diff = NULL;
+  g_auto (GStrv) fields = NULL;
+  GPtrArray *streams = NULL;
+
+  add_stream (from, "same", "Same");
+  add_stream (from, "changed", "Before");
+  add_stream (from, "removed", "Removed");
+
+  add_stream (to, "same", "Same");
+  add_stream (to, "changed", "After");
+  add_stream (to, "added", "Added");
+
+  diff = modulemd_module_index_diff (from, to);
+  g_assert_false (modulemd_index_diff_is_empty (diff));
+
+  streams = modulemd_index_diff_get_added_streams (diff);
+  g_assert_cmpuint (streams->len, ==, 1);
+  g_assert_cmpstr (
+    modulemd_module_stream_get_stream_name (g_ptr_array_index (streams, 0)),
+    ==,
+    "added");
+
+  streams = modulemd_index_diff_get_removed_streams (diff);
+  g_assert_cmpuint (streams->len, ==, 1);
+  g_assert_cmpstr (
+    modulemd_module_stream_get_stream_name (g_ptr_array_index (streams, 0)),
+    ==,
+    "removed");
+
+  /* Changed streams are the versions from the new index */
+  streams = modulemd_index_diff_get_changed_streams (diff);
+  g_assert_cmpuint (streams->len, ==, 1);
+  g_assert_cmpstr (modulemd_module_stream_v2_get_summary (
+                     g_ptr_array_index (streams, 0), "C"),
+                   ==,
+                   "After");
+
+  fields = modulemd_index_diff_get_changed_stream_fields_as_strv (
+    diff, "foo:changed:1:c0ffee42");
+  g_assert_nonnull (fields);
+  g_assert_cmpuint (g_strv_length (fields), ==, 1);
+  g_assert_cmpstr (fields[0], ==, "summary");
+  g_clear_pointer (&fields, g_strfreev);
+
+  fields = modulemd_index_diff_get_changed_stream_fields_as_strv (
+    diff, "foo:same:1:c0ffee42");
+  g_assert_null (fields);
+
+  /* The other way around */
+  g_clear_object (&diff);
+  diff = modulemd_module_index_diff (to, from);
+  g_assert_cmpuint (modulemd_index_diff_get_added_streams (diff)->len, ==, 1);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_removed_streams (diff)->len, ==, 1);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_changed_streams (diff)->len, ==, 1);
+}
+
+
+static void
+test_index_diff_defaults (void)
+{
+  g_autoptr (ModulemdModuleIndex) from = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) to = modulemd_module_index_new ();
+  g_autoptr (ModulemdIndexDiff) diff = NULL;
+  g_auto (GStrv) fields = NULL;
+  GPtrArray *defaults = NULL;
+
+  add_defaults (from, "foo", "bar");
+  add_defaults (from, "gone", "bar");
+
+  add_defaults (to, "foo", "baz");
+  add_defaults (to, "new", "bar");
+
+  diff = modulemd_module_index_diff (from, to);
+  g_assert_false (modulemd_index_diff_is_empty (diff));
+
+  defaults = modulemd_index_diff_get_added_defaults (diff);
+  g_assert_cmpuint (defaults->len, ==, 1);
+  g_assert_cmpstr (
+    modulemd_defaults_get_module_name (g_ptr_array_index (defaults, 0)),
+    ==,
+    "new");
+
+  defaults = modulemd_index_diff_get_removed_defaults (diff);
+  g_assert_cmpuint (defaults->len, ==, 1);
+  g_assert_cmpstr (
+    modulemd_defaults_get_module_name (g_ptr_array_index (defaults, 0)),
+    ==,
+    "gone");
+
+  defaults = modulemd_index_diff_get_changed_defaults (diff);
+  g_assert_cmpuint (defaults->len, ==, 1);
+
+  fields =
+    modulemd_index_diff_get_changed_defaults_fields_as_strv (diff, "foo");
+  g_assert_nonnull (fields);
+  g_assert_cmpuint (g_strv_length (fields), ==, 1);
+  g_assert_cmpstr (fields[0], ==, "default_stream");
+}
+
+
+static void
+test_index_diff_translations (void)
+{
+  g_autoptr (ModulemdModuleIndex) from = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) to = modulemd_module_index_new ();
+  g_autoptr (ModulemdIndexDiff) diff = NULL;
+  g_auto (GStrv) fields = NULL;
+
+  add_translation (from, "bar", "en_GB", "Colour");
+  add_translation (from, "removed", "en_GB", "Gone");
+
+  add_translation (to, "bar", "en_GB", "Color");
+  add_translation (to, "added", "en_GB", "New");
+
+  diff = modulemd_module_index_diff (from, to);
+  g_assert_false (modulemd_index_diff_is_empty (diff));
+
+  g_assert_cmpuint (
+    modulemd_index_diff_get_added_translations (diff)->len, ==, 1);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_removed_translations (diff)->len, ==, 1);
+  g_assert_cmpuint (
+    modulemd_index_diff_get_changed_translations (diff)->len, ==, 1);
+
+  /* Each locale is a field of its own */
+  fields = modulemd_index_diff_get_changed_translation_fields_as_strv (
+    diff, "foo", "bar");
+  g_assert_nonnull (fields);
+  g_assert_cmpuint (g_strv_length (fields), ==, 1);
+  g_assert_cmpstr (fields[0], ==, "en_GB");
+}
+
+
+static void
+test_index_diff_updates (void)
+{
+  g_autoptr (ModulemdModuleIndex) f29 = read_index ("f29.yaml");
+  g_autoptr (ModulemdModuleIndex) updates = read_index ("f29-updates.yaml");
+  g_autoptr (ModulemdIndexDiff) diff = NULL;
+  g_autoptr (GHashTable) f29_nsvcas = NULL;
+  g_autoptr (GHashTable) updates_nsvcas = NULL;
+  g_autofree gchar *nsvca = NULL;
+  g_auto (GStrv) fields = NULL;
+  GPtrArray *added = NULL;
+  GPtrArray *removed = NULL;
+  GPtrArray *changed = NULL;
+  gdouble elapsed;
+  guint iterations = 100;
+
+  diff = modulemd_module_index_diff (f29, updates);
+  g_assert_false (modulemd_index_diff_is_empty (diff));
+
+  added = modulemd_index_diff_get_added_streams (diff);
+  removed = modulemd_index_diff_get_removed_streams (diff);
+  changed = modulemd_index_diff_get_changed_streams (diff);
+  g_assert_cmpuint (added->len, >, 0);
+
+  f29_nsvcas = get_nsvcas (f29);
+  updates_nsvcas = get_nsvcas (updates);
+  assert_streams_in (added, updates_nsvcas, f29_nsvcas);
+  assert_streams_in (removed, f29_nsvcas, updates_nsvcas);
+  assert_streams_in (changed, updates_nsvcas, NULL);
+  assert_streams_in (changed, f29_nsvcas, NULL);
+
+  /* Every other stream is the same on both sides */
+  g_assert_cmpuint (g_hash_table_size (f29_nsvcas) - removed->len,
+                    ==,
+                    g_hash_table_size (updates_nsvcas) - added->len);
+
+  for (guint i = 0; i < changed->len; i++)
+    {
+      nsvca = modulemd_module_stream_get_NSVCA_as_string (
+        g_ptr_array_index (changed, i));
+      fields =
+        modulemd_index_diff_get_changed_stream_fields_as_strv (diff, nsvca);
+      g_assert_nonnull (fields);
+      g_assert_cmpuint (g_strv_length (fields), >, 0);
+      g_clear_pointer (&fields, g_strfreev);
+      g_clear_pointer (&nsvca, g_free);
+    }
+
+  if (!g_test_perf ())
+    return;
+
+  /* Frozen indexes have all of their stream fingerprints ready */
+  modulemd_module_index_freeze (f29);
+  modulemd_module_index_freeze (updates);
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      g_clear_object (&diff);
+      diff = modulemd_module_index_diff (f29, updates);
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed * 1000 / iterations,
+                           "Compared f29 with f29-updates in %.3f ms",
+                           elapsed * 1000 / iterations);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  setlocale (LC_ALL, "");
+
+  g_test_init (&argc, &argv, NULL);
+  g_test_bug_base ("https://bugzilla.redhat.com/show_bug.cgi?id=");
+
+  g_test_add_func ("/modulemd/v2/index_diff/identical",
+                   test_index_diff_identical);
+
+  g_test_add_func ("/modulemd/v2/index_diff/streams", test_index_diff_streams);
+
+  g_test_add_func ("/modulemd/v2/index_diff/defaults",
+                   test_index_diff_defaults);
+
+  g_test_add_func ("/modulemd/v2/index_diff/translations",
+                   test_index_diff_translations);
+
+  g_test_add_func ("/modulemd/v2/index_diff/updates", test_index_diff_updates);
+
+  return g_test_run ();
+}
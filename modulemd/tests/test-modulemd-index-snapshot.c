@@ -0,0 +1,266 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include <locale.h>
+
+#include "modulemd-index-snapshot.h"
+#include "modulemd-module.h"
+#include "modulemd-module-index.h"
+#include "modulemd-module-stream.h"
+#include "private/test-utils.h"
+
+
+/* An index with one stream of module "foo", whose version is @version */
+static ModulemdModuleIndex *
+versioned_index (guint64 version)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (GError) error = NULL;
+
+  stream = modulemd_module_stream_new (2, "foo", "bar");
+  modulemd_module_stream_set_version (stream, version);
+  modulemd_module_stream_set_context (stream, "c0ffee42");
+  g_assert_true (
+    modulemd_module_index_add_module_stream (index, stream, &error));
+  g_assert_no_error (error);
+
+  return g_steal_pointer (&index);
+}
+
+
+static guint64
+index_version (ModulemdModuleIndex *index)
+{
+  ModulemdModule *module = modulemd_module_index_get_module (index, "foo");
+  GPtrArray *streams = modulemd_module_get_all_streams (module);
+
+  g_assert_cmpuint (streams->len, ==, 1);
+  return modulemd_module_stream_get_version (g_ptr_array_index (streams, 0));
+}
+
+
+static void
+test_index_snapshot_publish (void)
+{
+  g_autoptr (ModulemdModuleIndex) first = versioned_index (1);
+  g_autoptr (ModulemdModuleIndex) second = versioned_index (2);
+  g_autoptr (ModulemdIndexSnapshot) snapshot = NULL;
+  g_autoptr (ModulemdModuleIndex) held = NULL;
+  g_autoptr (ModulemdModuleIndex) current = NULL;
+  gpointer first_alive = first;
+  gpointer second_alive = second;
+
+  snapshot = modulemd_index_snapshot_new (first);
+  g_assert_true (modulemd_module_index_is_frozen (first));
+  g_assert_cmpuint (modulemd_index_snapshot_get_generation (snapshot), ==, 0);
+
+  held = modulemd_index_snapshot_acquire (snapshot);
+  g_assert_true (held == first);
+
+  modulemd_index_snapshot_publish (snapshot, second);
+  g_assert_true (modulemd_module_index_is_frozen (second));
+  g_assert_cmpuint (modulemd_index_snapshot_get_generation (snapshot), ==, 1);
+
+  /* New readers see the new version, old ones keep theirs */
+  current = modulemd_index_snapshot_acquire (snapshot);
+  g_assert_true (current == second);
+  g_assert_cmpuint (index_version (held), ==, 1);
+  g_assert_cmpuint (index_version (current), ==, 2);
+
+  /* The old version goes away with its last reader */
+  g_object_add_weak_pointer (G_OBJECT (first), &first_alive);
+  g_clear_object (&first);
+  g_assert_nonnull (first_alive);
+  g_clear_object (&held);
+  g_assert_null (first_alive);
+
+  /* And the current one with the snapshot */
+  g_object_add_weak_pointer (G_OBJECT (second), &second_alive);
+  g_clear_object (&second);
+  g_clear_object (&current);
+  g_assert_nonnull (second_alive);
+  g_clear_object (&snapshot);
+  g_assert_null (second_alive);
+}
+
+
+/* Shared between the reader threads and the writer of the tests below */
+typedef struct _SnapshotReaders
+{
+  ModulemdIndexSnapshot *snapshot;
+  gint done;
+  guint64 last_version;
+} SnapshotReaders;
+
+
+static gpointer
+snapshot_reader_run (gpointer data)
+{
+  SnapshotReaders *readers = (SnapshotReaders *)data;
+  ModulemdModuleIndex *index = NULL;
+  guint64 version;
+  guint64 previous = 0;
+  guint64 reads = 0;
+
+  while (!g_atomic_int_get (&readers->done))
+    {
+      index = modulemd_index_snapshot_acquire (readers->snapshot);
+      version = index_version (index);
+      g_object_unref (index);
+
+      /* Versions are published in order, so a reader never goes back */
+      g_assert_cmpuint (version, >=, previous);
+      previous = version;
+      reads++;
+    }
+
+  g_assert_cmpuint (previous, <=, readers->last_version);
+
+  return GSIZE_TO_POINTER (reads);
+}
+
+
+static void
+test_index_snapshot_concurrent (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = versioned_index (1);
+  g_autoptr (ModulemdIndexSnapshot) snapshot = NULL;
+  SnapshotReaders readers = { 0 };
+  GThread *threads[4];
+  const guint64 versions = 200;
+
+  snapshot = modulemd_index_snapshot_new (index);
+  g_clear_object (&index);
+
+  readers.snapshot = snapshot;
+  readers.last_version = versions;
+
+  for (guint i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("reader", snapshot_reader_run, &readers);
+
+  /* Every version but the current one is freed while the readers run */
+  for (guint64 version = 2; version <= versions; version++)
+    {
+      index = versioned_index (version);
+      modulemd_index_snapshot_publish (snapshot, index);
+      g_clear_object (&index);
+    }
+
+  g_atomic_int_set (&readers.done, TRUE);
+  for (guint i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  g_assert_cmpuint (
+    modulemd_index_snapshot_get_generation (snapshot), ==, versions - 1);
+
+  index = modulemd_index_snapshot_acquire (snapshot);
+  g_assert_cmpuint (index_version (index), ==, versions);
+}
+
+
+/* Keeps publishing newer versions until the readers are done */
+static gpointer
+snapshot_publisher_run (gpointer data)
+{
+  SnapshotReaders *readers = (SnapshotReaders *)data;
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  guint64 version = 2;
+
+  while (!g_atomic_int_get (&readers->done))
+    {
+      index = versioned_index (version++);
+      modulemd_index_snapshot_publish (readers->snapshot, index);
+      g_clear_object (&index);
+    }
+
+  return NULL;
+}
+
+
+static void
+test_index_snapshot_benchmark (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = versioned_index (1);
+  g_autoptr (ModulemdIndexSnapshot) snapshot = NULL;
+  g_autoptr (ModulemdModuleIndex) acquired = NULL;
+  SnapshotReaders readers = { 0 };
+  GThread *publisher = NULL;
+  GThread *threads[4];
+  guint64 reads = 0;
+  const guint iterations = 1000000;
+  gdouble elapsed;
+
+  snapshot = modulemd_index_snapshot_new (index);
+
+  if (!g_test_perf ())
+    return;
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      acquired = modulemd_index_snapshot_acquire (snapshot);
+      g_clear_object (&acquired);
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed * 1e9 / iterations,
+                           "Acquired the current index in %.1f ns",
+                           elapsed * 1e9 / iterations);
+
+  /* Readers keep going at full speed while the index is being replaced */
+  readers.snapshot = snapshot;
+  readers.last_version = G_MAXUINT64;
+
+  publisher = g_thread_new ("publisher", snapshot_publisher_run, &readers);
+  for (guint i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("reader", snapshot_reader_run, &readers);
+
+  g_test_timer_start ();
+  g_usleep (G_USEC_PER_SEC / 2);
+  g_atomic_int_set (&readers.done, TRUE);
+
+  for (guint i = 0; i < G_N_ELEMENTS (threads); i++)
+    reads += GPOINTER_TO_SIZE (g_thread_join (threads[i]));
+  elapsed = g_test_timer_elapsed ();
+  g_thread_join (publisher);
+
+  g_test_maximized_result (reads / elapsed,
+                           "%u readers acquired %.0f indexes per second while "
+                           "%u versions were published",
+                           (guint)G_N_ELEMENTS (threads),
+                           reads / elapsed,
+                           modulemd_index_snapshot_get_generation (snapshot));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  setlocale (LC_ALL, "");
+
+  g_test_init (&argc, &argv, NULL);
+  g_test_bug_base ("https://bugzilla.redhat.com/show_bug.cgi?id=");
+
+  g_test_add_func ("/modulemd/v2/index_snapshot/publish",
+                   test_index_snapshot_publish);
+
+  g_test_add_func ("/modulemd/v2/index_snapshot/concurrent",
+                   test_index_snapshot_concurrent);
+
+  g_test_add_func ("/modulemd/v2/index_snapshot/benchmark",
+                   test_index_snapshot_benchmark);
+
+  return g_test_run ();
+}
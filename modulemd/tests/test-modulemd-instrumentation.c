@@ -0,0 +1,139 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include <locale.h>
+
+#include "modulemd-instrumentation.h"
+#include "modulemd-module-index.h"
+#include "private/modulemd-util.h"
+#include "private/test-utils.h"
+
+
+static gboolean
+traced_function (void)
+{
+  MODULEMD_INIT_TRACE ();
+
+  return tracer.traced;
+}
+
+
+static void
+test_modulemd_instrumentation_tracing (void)
+{
+  g_assert_false (modulemd_get_tracing_enabled ());
+  g_assert_false (traced_function ());
+
+  modulemd_set_tracing_enabled (TRUE);
+  g_assert_true (modulemd_get_tracing_enabled ());
+  g_assert_true (traced_function ());
+
+  /* Enabling tracing must not affect the phase timing flag */
+  g_assert_false (modulemd_get_phase_timing_enabled ());
+
+  modulemd_set_tracing_enabled (FALSE);
+  g_assert_false (modulemd_get_tracing_enabled ());
+  g_assert_false (traced_function ());
+}
+
+
+static ModulemdModuleIndex *
+read_spec_index (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml_path =
+    g_strdup_printf ("%s/spec.v2.yaml", g_getenv ("MESON_SOURCE_ROOT"));
+
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+
+  return g_steal_pointer (&index);
+}
+
+
+static void
+test_modulemd_instrumentation_phase_timing (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (ModulemdModuleIndex) merged = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml_str = NULL;
+  ModulemdPhaseEnum phase;
+
+  /* Nothing is counted while phase timing is disabled */
+  g_assert_false (modulemd_get_phase_timing_enabled ());
+  index = read_spec_index ();
+  for (phase = 0; phase < MODULEMD_PHASE_SENTINEL; phase++)
+    {
+      g_assert_cmpuint (modulemd_get_phase_calls (phase), ==, 0);
+      g_assert_cmpuint (modulemd_get_phase_time (phase), ==, 0);
+    }
+  g_clear_object (&index);
+
+  modulemd_set_phase_timing_enabled (TRUE);
+  g_assert_true (modulemd_get_phase_timing_enabled ());
+
+  index = read_spec_index ();
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_PARSE), >, 0);
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_VALIDATE), >, 0);
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_MERGE), ==, 0);
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_EMIT), ==, 0);
+
+  merged = modulemd_module_index_new ();
+  g_assert_true (
+    modulemd_module_index_merge (index, merged, FALSE, FALSE, &error));
+  g_assert_no_error (error);
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_MERGE), ==, 1);
+
+  yaml_str = modulemd_module_index_dump_to_string (merged, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (yaml_str);
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_EMIT), ==, 1);
+
+  /* Disabling phase timing keeps the counters as they are */
+  modulemd_set_phase_timing_enabled (FALSE);
+  g_clear_pointer (&yaml_str, g_free);
+  yaml_str = modulemd_module_index_dump_to_string (merged, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (modulemd_get_phase_calls (MODULEMD_PHASE_EMIT), ==, 1);
+
+  modulemd_reset_phase_timings ();
+  for (phase = 0; phase < MODULEMD_PHASE_SENTINEL; phase++)
+    {
+      g_assert_cmpuint (modulemd_get_phase_calls (phase), ==, 0);
+      g_assert_cmpuint (modulemd_get_phase_time (phase), ==, 0);
+    }
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  setlocale (LC_ALL, "");
+
+  g_test_init (&argc, &argv, NULL);
+  g_test_bug_base ("https://bugzilla.redhat.com/show_bug.cgi?id=");
+
+  g_test_add_func ("/modulemd/instrumentation/tracing",
+                   test_modulemd_instrumentation_tracing);
+
+  g_test_add_func ("/modulemd/instrumentation/phase_timing",
+                   test_modulemd_instrumentation_phase_timing);
+
+  return g_test_run ();
+}
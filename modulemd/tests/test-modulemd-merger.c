@@ -15,6 +15,7 @@
 #include <yaml.h>
 
 #include "modulemd-defaults.h"
+#include "modulemd-defaults-conflict.h"
 #include "modulemd-defaults-v1.h"
 #include "modulemd-module-index.h"
 #include "modulemd-module-index-merger.h"
@@ -160,8 +161,11 @@ merger_test_add_conflicting_stream (void)
   g_autoptr (ModulemdModuleIndex) merged_idx = NULL;
   g_autoptr (ModulemdModuleIndexMerger) merger =
     modulemd_module_index_merger_new ();
+  g_autoptr (GPtrArray) conflicts = NULL;
   ModulemdModule *psql = NULL;
   ModulemdDefaults *psql_defs = NULL;
+  ModulemdDefaultsConflict *conflict = NULL;
+  const gchar *const *values = NULL;
   g_autofree gchar *base_yaml =
     g_strdup_printf ("%s/merger/base.yaml", g_getenv ("TEST_DATA_PATH"));
   g_autofree gchar *add_conflicting_yaml = g_strdup_printf (
@@ -176,8 +180,8 @@ merger_test_add_conflicting_stream (void)
   modulemd_module_index_merger_associate_index (
     merger, add_conflicting_idx, 0);
 
-  merged_idx =
-    modulemd_module_index_merger_resolve_ext (merger, FALSE, &error);
+  merged_idx = modulemd_module_index_merger_resolve_with_conflicts (
+    merger, FALSE, &conflicts, &error);
   g_assert_no_error (error);
   g_assert_nonnull (merged_idx);
 
@@ -189,6 +193,20 @@ merger_test_add_conflicting_stream (void)
 
   g_assert_null (modulemd_defaults_v1_get_default_stream (
     MODULEMD_DEFAULTS_V1 (psql_defs), NULL));
+
+  /* The conflict that unset the default stream is reported */
+  g_assert_nonnull (conflicts);
+  g_assert_cmpint (conflicts->len, ==, 1);
+  conflict = g_ptr_array_index (conflicts, 0);
+  g_assert_cmpint (modulemd_defaults_conflict_get_conflict_type (conflict),
+                   ==,
+                   MODULEMD_DEFAULTS_CONFLICT_DEFAULT_STREAM);
+  g_assert_cmpstr (
+    modulemd_defaults_conflict_get_module_name (conflict), ==, "postgresql");
+  g_assert_null (modulemd_defaults_conflict_get_intent (conflict));
+  values = modulemd_defaults_conflict_peek_values (conflict);
+  g_assert_true (g_strv_contains (values, "8.1"));
+  g_assert_true (g_strv_contains (values, "8.2"));
 }
 
 
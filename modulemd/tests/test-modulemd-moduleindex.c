@@ -19,12 +19,14 @@
 
 #include "config.h"
 #include "modulemd-defaults.h"
+#include "modulemd-defaults-v1.h"
 #include "modulemd-module.h"
 #include "modulemd-module-index.h"
 #include "modulemd-module-stream-v1.h"
 #include "modulemd-module-stream-v2.h"
 #include "private/glib-extensions.h"
 #include "private/modulemd-module-private.h"
+#include "private/modulemd-module-stream-private.h"
 #include "private/modulemd-util.h"
 #include "private/modulemd-yaml.h"
 #include "private/test-utils.h"
@@ -456,6 +458,202 @@ module_index_test_stream_upgrade (ModuleIndexFixture *fixture,
 }
 
 
+/* Adds @n_modules modules of @n_streams V1 streams each to @index */
+static void
+add_v1_streams (ModulemdModuleIndex *index, guint n_modules, guint n_streams)
+{
+  g_autoptr (ModulemdModuleStreamV1) stream = NULL;
+  g_autoptr (ModulemdProfile) profile = NULL;
+  g_autoptr (ModulemdComponentRpm) component = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *module_name = NULL;
+
+  for (guint i = 0; i < n_modules; i++)
+    {
+      module_name = g_strdup_printf ("module%u", i);
+
+      for (guint j = 0; j < n_streams; j++)
+        {
+          stream = modulemd_module_stream_v1_new (module_name, "stream");
+          modulemd_module_stream_set_version (MODULEMD_MODULE_STREAM (stream),
+                                              j + 1);
+          modulemd_module_stream_set_context (MODULEMD_MODULE_STREAM (stream),
+                                              "c0ffee42");
+          modulemd_module_stream_v1_set_summary (stream, "A test stream");
+          modulemd_module_stream_v1_set_description (
+            stream, "A test stream's description");
+          modulemd_module_stream_v1_add_module_license (stream, "MIT");
+          modulemd_module_stream_v1_add_rpm_api (stream, "foo");
+
+          profile = modulemd_profile_new ("default");
+          modulemd_profile_set_description (profile, "The default profile");
+          modulemd_profile_add_rpm (profile, "foo");
+          modulemd_module_stream_v1_add_profile (stream, profile);
+
+          component = modulemd_component_rpm_new ("foo");
+          modulemd_component_set_rationale (MODULEMD_COMPONENT (component),
+                                            "The API");
+          modulemd_module_stream_v1_add_component (
+            stream, MODULEMD_COMPONENT (component));
+
+          g_assert_true (modulemd_module_index_add_module_stream (
+            index, MODULEMD_MODULE_STREAM (stream), &error));
+          g_assert_no_error (error);
+
+          g_clear_object (&component);
+          g_clear_object (&profile);
+          g_clear_object (&stream);
+        }
+
+      g_clear_pointer (&module_name, g_free);
+    }
+}
+
+
+static void
+ignore_toggle (gpointer data, GObject *object, gboolean is_last_ref)
+{
+}
+
+
+static void
+module_index_test_stream_upgrade_owned (ModuleIndexFixture *fixture,
+                                        gconstpointer user_data)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (ModulemdModuleStream) shared = NULL;
+  g_autoptr (ModulemdModuleStream) expected = NULL;
+  g_autoptr (GError) error = NULL;
+  g_auto (GStrv) licenses = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModuleStream *stream = NULL;
+  ModulemdProfile *profile = NULL;
+  ModulemdModuleStream *wrapped = NULL;
+  gpointer unshared = NULL;
+  GPtrArray *streams = NULL;
+
+  index = modulemd_module_index_new ();
+  add_v1_streams (index, 8, 4);
+
+  /* One stream is also held from outside of the index... */
+  module = modulemd_module_index_get_module (index, "module0");
+  shared = g_object_ref (modulemd_module_get_stream_by_NSVCA (
+    module, "stream", 1, "c0ffee42", NULL, &error));
+  g_assert_no_error (error);
+
+  /* ...and the others only from the index */
+  unshared = modulemd_module_get_stream_by_NSVCA (
+    module, "stream", 2, "c0ffee42", NULL, &error);
+  g_assert_no_error (error);
+  g_object_add_weak_pointer (G_OBJECT (unshared), &unshared);
+
+  /* Language bindings hold their objects through a toggle reference */
+  wrapped = modulemd_module_get_stream_by_NSVCA (
+    module, "stream", 3, "c0ffee42", NULL, &error);
+  g_assert_no_error (error);
+  g_object_add_toggle_ref (G_OBJECT (wrapped), ignore_toggle, NULL);
+
+  g_assert_true (modulemd_module_index_upgrade_streams (
+    index, MD_MODULESTREAM_VERSION_TWO, &error));
+  g_assert_no_error (error);
+
+  /* Replaced streams are freed right away */
+  g_assert_null (unshared);
+
+  /* The shared stream was copied, so it is left as it was */
+  g_assert_cmpint (modulemd_module_stream_get_mdversion (shared),
+                   ==,
+                   MD_MODULESTREAM_VERSION_ONE);
+  licenses = modulemd_module_stream_v1_get_module_licenses_as_strv (
+    MODULEMD_MODULE_STREAM_V1 (shared));
+  g_assert_cmpint (g_strv_length (licenses), ==, 1);
+  g_clear_pointer (&licenses, g_strfreev);
+
+  /* So was the wrapped one */
+  licenses = modulemd_module_stream_v1_get_module_licenses_as_strv (
+    MODULEMD_MODULE_STREAM_V1 (wrapped));
+  g_assert_cmpint (g_strv_length (licenses), ==, 1);
+  g_clear_pointer (&licenses, g_strfreev);
+  g_object_remove_toggle_ref (G_OBJECT (wrapped), ignore_toggle, NULL);
+
+  /* The others took over the contents of the old streams, which end up the
+   * same as if they had been copied.
+   */
+  for (guint i = 0; i < 8; i++)
+    {
+      g_autofree gchar *module_name = g_strdup_printf ("module%u", i);
+      module = modulemd_module_index_get_module (index, module_name);
+      streams = modulemd_module_get_all_streams (module);
+      g_assert_cmpint (streams->len, ==, 4);
+
+      for (guint j = 0; j < streams->len; j++)
+        {
+          stream = g_ptr_array_index (streams, j);
+          g_assert_cmpint (modulemd_module_stream_get_mdversion (stream),
+                           ==,
+                           MD_MODULESTREAM_VERSION_TWO);
+
+          licenses = modulemd_module_stream_v2_get_module_licenses_as_strv (
+            MODULEMD_MODULE_STREAM_V2 (stream));
+          g_assert_cmpint (g_strv_length (licenses), ==, 1);
+          g_assert_cmpstr (licenses[0], ==, "MIT");
+          g_clear_pointer (&licenses, g_strfreev);
+
+          profile = modulemd_module_stream_v2_get_profile (
+            MODULEMD_MODULE_STREAM_V2 (stream), "default");
+          g_assert_nonnull (profile);
+          g_assert_cmpstr (modulemd_profile_get_description (profile, "C"),
+                           ==,
+                           "The default profile");
+          g_assert_nonnull (modulemd_module_stream_v2_get_rpm_component (
+            MODULEMD_MODULE_STREAM_V2 (stream), "foo"));
+
+          if (i != 0)
+            continue;
+
+          /* All streams of a module only differ by their version */
+          expected = modulemd_module_stream_upgrade (
+            shared, MD_MODULESTREAM_VERSION_TWO, &error);
+          g_assert_no_error (error);
+          modulemd_module_stream_set_version (
+            expected, modulemd_module_stream_get_version (stream));
+          g_assert_true (modulemd_module_stream_equals (expected, stream));
+          g_clear_object (&expected);
+        }
+    }
+}
+
+
+static void
+module_index_test_stream_upgrade_benchmark (ModuleIndexFixture *fixture,
+                                            gconstpointer user_data)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (GError) error = NULL;
+  const guint n_modules = 200;
+  const guint n_streams = 50;
+  gdouble elapsed;
+
+  if (!g_test_perf ())
+    return;
+
+  index = modulemd_module_index_new ();
+  add_v1_streams (index, n_modules, n_streams);
+
+  g_test_timer_start ();
+  g_assert_true (modulemd_module_index_upgrade_streams (
+    index, MD_MODULESTREAM_VERSION_TWO, &error));
+  elapsed = g_test_timer_elapsed ();
+  g_assert_no_error (error);
+
+  g_test_minimized_result (elapsed,
+                           "Upgraded %u streams of %u modules in %.3f s",
+                           n_modules * n_streams,
+                           n_modules,
+                           elapsed);
+}
+
+
 static void
 module_index_test_index_upgrade (ModuleIndexFixture *fixture,
                                  gconstpointer user_data)
@@ -971,6 +1169,10 @@ module_index_test_get_default_streams (void)
   g_autoptr (GPtrArray) failures = NULL;
   g_autoptr (GError) error = NULL;
   g_autoptr (GHashTable) default_streams = NULL;
+  g_autoptr (GHashTable) cached_streams = NULL;
+  g_autoptr (ModulemdDefaultsV1) defaults = NULL;
+  ModulemdModule *module = NULL;
+  GHashTable *peeked = NULL;
 
   yaml_path =
     g_strdup_printf ("%s/f29-updates.yaml", g_getenv ("TEST_DATA_PATH"));
@@ -1000,6 +1202,90 @@ module_index_test_get_default_streams (void)
   g_assert_cmpstr (g_hash_table_lookup (default_streams, "stratis"), ==, "1");
 
   g_assert_false (g_hash_table_contains (default_streams, "nodejs"));
+
+  /* The table is cached by the index and copied for every caller */
+  peeked = modulemd_module_index_peek_default_streams (index, NULL);
+  g_assert_true (peeked == modulemd_module_index_peek_default_streams (index,
+                                                                       NULL));
+  g_assert_true (peeked != default_streams);
+  g_assert_cmpint (g_hash_table_size (peeked), ==, 3);
+  cached_streams =
+    modulemd_module_index_get_default_streams_as_hash_table (index, NULL);
+  g_assert_true (cached_streams != default_streams);
+  g_assert_true (cached_streams != peeked);
+  g_assert_cmpint (g_hash_table_size (cached_streams), ==, 3);
+  g_clear_pointer (&cached_streams, g_hash_table_unref);
+
+  /* Adding defaults shows up in the next table */
+  defaults = modulemd_defaults_v1_new ("nodejs");
+  modulemd_defaults_v1_set_default_stream (defaults, "10", NULL);
+  g_assert_true (modulemd_module_index_add_defaults (
+    index, MODULEMD_DEFAULTS (defaults), &error));
+  g_assert_no_error (error);
+
+  peeked = modulemd_module_index_peek_default_streams (index, NULL);
+  g_assert_cmpint (g_hash_table_size (peeked), ==, 4);
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "10");
+
+  /* The table handed out earlier is left untouched */
+  g_assert_cmpint (g_hash_table_size (default_streams), ==, 3);
+
+  /* So do changes made to the defaults held by a module of the index */
+  module = modulemd_module_index_get_module (index, "nodejs");
+  g_assert_nonnull (module);
+  modulemd_defaults_v1_set_default_stream (
+    MODULEMD_DEFAULTS_V1 (modulemd_module_get_defaults (module)), "12", NULL);
+
+  peeked = modulemd_module_index_peek_default_streams (index, NULL);
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "12");
+
+  /* Each intent has its own table, kept until the defaults change */
+  peeked = modulemd_module_index_peek_default_streams (index, "server");
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "12");
+  g_assert_true (peeked ==
+                 modulemd_module_index_peek_default_streams (index, "server"));
+
+  modulemd_defaults_v1_set_default_stream (
+    MODULEMD_DEFAULTS_V1 (modulemd_module_get_defaults (module)),
+    "8",
+    "server");
+
+  peeked = modulemd_module_index_peek_default_streams (index, "server");
+  g_assert_cmpint (g_hash_table_size (peeked), ==, 4);
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "8");
+  peeked = modulemd_module_index_peek_default_streams (index, NULL);
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "12");
+
+  /* Removing a module with defaults drops it from every table */
+  g_assert_true (modulemd_module_index_remove_module (index, "nodejs"));
+  peeked = modulemd_module_index_peek_default_streams (index, "server");
+  g_assert_cmpint (g_hash_table_size (peeked), ==, 3);
+  g_assert_false (g_hash_table_contains (peeked, "nodejs"));
+  peeked = modulemd_module_index_peek_default_streams (index, NULL);
+  g_assert_cmpint (g_hash_table_size (peeked), ==, 3);
+
+  /* Freezing keeps the tables for every intent with defaults of its own */
+  modulemd_defaults_v1_set_default_stream (defaults, "8", "server");
+  g_assert_true (modulemd_module_index_add_defaults (
+    index, MODULEMD_DEFAULTS (defaults), &error));
+  g_assert_no_error (error);
+  modulemd_module_index_freeze (index);
+
+  peeked = modulemd_module_index_peek_default_streams (index, "server");
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "8");
+  g_assert_true (peeked ==
+                 modulemd_module_index_peek_default_streams (index, "server"));
+  peeked = modulemd_module_index_peek_default_streams (index, NULL);
+  g_assert_cmpstr (g_hash_table_lookup (peeked, "nodejs"), ==, "10");
+  g_assert_true (peeked == modulemd_module_index_peek_default_streams (
+                             index, "workstation"));
+
+  /* Copies of a frozen table are still independent */
+  cached_streams =
+    modulemd_module_index_get_default_streams_as_hash_table (index, NULL);
+  g_assert_true (cached_streams != peeked);
+  g_hash_table_remove (cached_streams, "nodejs");
+  g_assert_cmpint (g_hash_table_size (peeked), ==, 4);
 }
 
 
@@ -1044,7 +1330,7 @@ test_module_index_read_compressed (void)
   g_autofree gchar *compressed_text = NULL;
 
 #ifdef HAVE_RPMIO
-#ifdef HAVE_LIBMAGIC
+  /* Files without a suffix are recognized by their signature */
   struct expected_compressed_read_t expected[] = {
     {
       .filename = "bzipped",
@@ -1060,30 +1346,6 @@ test_module_index_read_compressed (void)
     { .filename = "xzipped.yaml.xz", .succeeds = TRUE },
     { .filename = NULL }
   };
-#else /* HAVE_LIBMAGIC */
-  struct expected_compressed_read_t expected[] = {
-    { .filename = "bzipped",
-      .succeeds = FALSE,
-      .error_domain = MODULEMD_YAML_ERROR,
-      .error_code = MODULEMD_YAML_ERROR_UNPARSEABLE },
-    {
-      .filename = "bzipped.yaml.bz2",
-      .succeeds = TRUE,
-    },
-    { .filename = "gzipped",
-      .succeeds = FALSE,
-      .error_domain = MODULEMD_YAML_ERROR,
-      .error_code = MODULEMD_YAML_ERROR_UNPARSEABLE },
-    { .filename = "gzipped.yaml.gz", .succeeds = TRUE },
-    { .filename = "xzipped",
-      .succeeds = FALSE,
-      .error_domain = MODULEMD_YAML_ERROR,
-      .error_code = MODULEMD_YAML_ERROR_UNPARSEABLE },
-    { .filename = "xzipped.yaml.xz", .succeeds = TRUE },
-    { .filename = NULL }
-  };
-#endif /* HAVE_LIBMAGIC */
-
 #else /* HAVE_RPMIO */
   struct expected_compressed_read_t expected[] = {
     { .filename = "bzipped",
@@ -1348,81 +1610,1557 @@ test_module_index_read_def_dir (void)
 }
 
 
-int
-main (int argc, char *argv[])
+static void
+module_index_test_dump_large (void)
 {
-  setlocale (LC_ALL, "");
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (ModulemdModuleIndex) reparsed = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml_path = NULL;
+  g_autofree gchar *output = NULL;
+  g_autofree gchar *reparsed_output = NULL;
+  g_autofree gchar *parallel_output = NULL;
+  g_auto (GStrv) module_names = NULL;
+  ModulemdModule *module = NULL;
+  guint n_streams = 0;
+  guint n_defaults = 0;
+  guint n_stream_docs = 0;
+  guint n_defaults_docs = 0;
+  gchar *bench_output = NULL;
+  guint iterations = 20;
+  gdouble elapsed;
 
-  g_test_init (&argc, &argv, NULL);
-  g_test_bug_base ("https://bugzilla.redhat.com/show_bug.cgi?id=");
+  index = modulemd_module_index_new ();
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+  g_clear_pointer (&yaml_path, g_free);
+  g_clear_pointer (&failures, g_ptr_array_unref);
 
-  // Define the tests.
+  yaml_path =
+    g_strdup_printf ("%s/f29-updates.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+  g_clear_pointer (&failures, g_ptr_array_unref);
 
-  g_test_add ("/modulemd/v2/module/index/dump",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_dump,
-              NULL);
+  /* Every stream and every set of defaults must have been written out in
+   * full, however far the output outgrew its initial reservation.
+   */
+  output = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (output);
 
-  g_test_add ("/modulemd/v2/module/index/read",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_read,
-              NULL);
+  module_names = modulemd_module_index_get_module_names_as_strv (index);
+  for (guint i = 0; module_names[i]; i++)
+    {
+      module = modulemd_module_index_get_module (index, module_names[i]);
+      n_streams += modulemd_module_get_all_streams (module)->len;
+      if (modulemd_module_get_defaults (module))
+        n_defaults++;
+    }
+  g_assert_cmpuint (n_streams, >, 0);
+  g_assert_cmpuint (n_defaults, >, 0);
 
-  g_test_add ("/modulemd/v2/module/index/read/mixed",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_read_mixed,
-              NULL);
+  for (const gchar *p = output;
+       (p = strstr (p, "---\ndocument: modulemd")) != NULL;
+       p += strlen ("---\ndocument: modulemd"))
+    {
+      if (g_str_has_prefix (p, "---\ndocument: modulemd\n"))
+        n_stream_docs++;
+      else if (g_str_has_prefix (p, "---\ndocument: modulemd-defaults\n"))
+        n_defaults_docs++;
+    }
+  g_assert_cmpuint (n_stream_docs, ==, n_streams);
+  g_assert_cmpuint (n_defaults_docs, ==, n_defaults);
+  g_assert_true (g_str_has_suffix (output, "\n...\n"));
 
-  g_test_add ("/modulemd/v2/module/index/read/unknown",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_read_unknown,
-              NULL);
+  /* Dumping the re-read output must give back the same bytes */
+  reparsed = modulemd_module_index_new ();
+  g_assert_true (modulemd_module_index_update_from_string (
+    reparsed, output, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
 
-  g_test_add ("/modulemd/v2/module/index/upgrade/stream",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_stream_upgrade,
-              NULL);
+  reparsed_output = modulemd_module_index_dump_to_string (reparsed, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (output, ==, reparsed_output);
 
-  g_test_add ("/modulemd/v2/module/index/upgrade/index",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_index_upgrade,
-              NULL);
+  /* The parallel dump must match the serial one, whatever the thread count */
+  for (guint threads = 0; threads <= 4; threads++)
+    {
+      parallel_output = modulemd_module_index_dump_to_string_parallel (
+        index, threads, &error);
+      g_assert_no_error (error);
+      g_assert_cmpstr (output, ==, parallel_output);
+      g_clear_pointer (&parallel_output, g_free);
+    }
 
-  g_test_add ("/modulemd/v2/module/index/remove_module",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_remove_module,
-              NULL);
+  if (!g_test_perf ())
+    return;
 
-  g_test_add ("/modulemd/v2/module/index/custom_read",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_custom_read,
-              NULL);
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      bench_output = modulemd_module_index_dump_to_string (index, &error);
+      g_assert_no_error (error);
+      g_assert_nonnull (bench_output);
+      g_clear_pointer (&bench_output, g_free);
+    }
+  elapsed = g_test_timer_elapsed ();
 
-  g_test_add ("/modulemd/v2/module/index/custom_write",
-              ModuleIndexFixture,
-              NULL,
-              NULL,
-              module_index_test_custom_write,
-              NULL);
+  g_test_minimized_result (elapsed * 1000 / iterations,
+                           "Dumped %" G_GSIZE_FORMAT
+                           " bytes of YAML in %.3f ms per iteration",
+                           strlen (output),
+                           elapsed * 1000 / iterations);
 
-  g_test_add_func ("/modulemd/v2/module/index/get_default_streams",
-                   module_index_test_get_default_streams);
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      bench_output =
+        modulemd_module_index_dump_to_string_parallel (index, 0, &error);
+      g_assert_no_error (error);
+      g_assert_nonnull (bench_output);
+      g_clear_pointer (&bench_output, g_free);
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed * 1000 / iterations,
+                           "Dumped %" G_GSIZE_FORMAT
+                           " bytes of YAML in parallel in %.3f ms per "
+                           "iteration",
+                           strlen (output),
+                           elapsed * 1000 / iterations);
+}
+
+
+static void
+module_index_test_read_large (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml_path = NULL;
+  g_autofree gchar *yaml_str = NULL;
+  g_auto (GStrv) licenses = NULL;
+  g_auto (GStrv) artifacts = NULL;
+  g_auto (GStrv) api = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModuleStreamV2 *stream = NULL;
+  guint iterations = 20;
+  gdouble elapsed;
+
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (g_file_get_contents (yaml_path, &yaml_str, NULL, &error));
+  g_assert_no_error (error);
+
+  index = modulemd_module_index_new ();
+  g_assert_true (modulemd_module_index_update_from_string (
+    index, yaml_str, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  /* Sets handed over by the parser must end up in the stream intact */
+  module = modulemd_module_index_get_module (index, "stratis");
+  g_assert_nonnull (module);
+  stream = (ModulemdModuleStreamV2 *)modulemd_module_get_stream_by_NSVCA (
+    module, "1", 20180927214347, "7a127764", "x86_64", &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (stream);
+  g_assert_cmpstr (modulemd_module_stream_v2_get_summary (stream, "C"),
+                   ==,
+                   "Stratis Storage");
+
+  licenses = modulemd_module_stream_v2_get_module_licenses_as_strv (stream);
+  g_assert_cmpuint (g_strv_length (licenses), ==, 1);
+  g_assert_cmpstr (licenses[0], ==, "MIT");
+
+  api = modulemd_module_stream_v2_get_rpm_api_as_strv (stream);
+  g_assert_cmpuint (g_strv_length (api), ==, 1);
+  g_assert_cmpstr (api[0], ==, "stratisd");
+
+  artifacts = modulemd_module_stream_v2_get_rpm_artifacts_as_strv (stream);
+  g_assert_cmpuint (g_strv_length (artifacts), ==, 1);
+  g_assert_cmpstr (
+    artifacts[0], ==, "stratisd-0:1.0.0-1.module_2238+b7fada88.x86_64");
+
+  if (!g_test_perf ())
+    return;
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      g_clear_object (&index);
+      index = modulemd_module_index_new ();
+      g_assert_true (modulemd_module_index_update_from_string (
+        index, yaml_str, TRUE, &failures, &error));
+      g_assert_no_error (error);
+      g_clear_pointer (&failures, g_ptr_array_unref);
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed * 1000 / iterations,
+                           "Read %" G_GSIZE_FORMAT
+                           " bytes of YAML in %.3f ms per iteration",
+                           strlen (yaml_str),
+                           elapsed * 1000 / iterations);
+}
+
+
+static void
+module_index_test_skip_validation (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (ModulemdModuleStreamV2) stream = NULL;
+  g_autoptr (ModulemdModuleStream) copy = NULL;
+  g_autoptr (ModulemdProfile) profile = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModuleStream *indexed = NULL;
+  ModulemdProfile *stored_profile = NULL;
+
+  stream = modulemd_module_stream_v2_new ("foo", "bar");
+  modulemd_module_stream_set_version (MODULEMD_MODULE_STREAM (stream), 1);
+  modulemd_module_stream_set_context (MODULEMD_MODULE_STREAM (stream), "c0");
+  modulemd_module_stream_v2_set_summary (stream, "Summary");
+  modulemd_module_stream_v2_set_description (stream, "Description");
+  modulemd_module_stream_v2_add_module_license (stream, "MIT");
+  g_assert_false (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  /* Successful validation is remembered, and survives an exact copy */
+  g_assert_true (
+    modulemd_module_stream_validate (MODULEMD_MODULE_STREAM (stream), &error));
+  g_assert_no_error (error);
+  g_assert_true (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  copy =
+    modulemd_module_stream_copy (MODULEMD_MODULE_STREAM (stream), NULL, NULL);
+  g_assert_true (modulemd_module_stream_is_validated (copy));
+  g_clear_object (&copy);
+
+  copy = modulemd_module_stream_copy (
+    MODULEMD_MODULE_STREAM (stream), NULL, "baz");
+  g_assert_false (modulemd_module_stream_is_validated (copy));
+  g_clear_object (&copy);
+
+  /* Reading a child leaves the result alone, modifying the child forgets
+   * it.
+   */
+  profile = modulemd_profile_new ("default");
+  modulemd_module_stream_v2_add_profile (stream, profile);
+  g_clear_object (&profile);
+  g_assert_true (
+    modulemd_module_stream_validate (MODULEMD_MODULE_STREAM (stream), &error));
+  g_assert_no_error (error);
+  g_assert_true (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  stored_profile = modulemd_module_stream_v2_get_profile (stream, "default");
+  g_assert_nonnull (stored_profile);
+  g_assert_cmpstr (modulemd_profile_get_name (stored_profile), ==, "default");
+  g_assert_true (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  modulemd_profile_add_rpm (stored_profile, "foo");
+  g_assert_false (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  g_assert_true (
+    modulemd_module_stream_validate (MODULEMD_MODULE_STREAM (stream), &error));
+  g_assert_no_error (error);
+  g_assert_true (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  /* A child kept past the end of its stream no longer reports to it */
+  copy =
+    modulemd_module_stream_copy (MODULEMD_MODULE_STREAM (stream), NULL, NULL);
+  profile = g_object_ref (modulemd_module_stream_v2_get_profile (
+    MODULEMD_MODULE_STREAM_V2 (copy), "default"));
+  g_clear_object (&copy);
+  modulemd_profile_add_rpm (profile, "bar");
+  g_clear_object (&profile);
+  g_assert_true (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  /* Any setter forgets it */
+  modulemd_module_stream_v2_add_rpm_artifact (stream, "not-a-nevra");
+  g_assert_false (
+    modulemd_module_stream_is_validated (MODULEMD_MODULE_STREAM (stream)));
+
+  index = modulemd_module_index_new ();
+  g_assert_true (modulemd_module_index_add_module_stream (
+    index, MODULEMD_MODULE_STREAM (stream), &error));
+  g_assert_no_error (error);
+
+  /* The modified stream is validated during the dump */
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_null (yaml);
+  g_assert_error (error, MODULEMD_ERROR, MODULEMD_ERROR_VALIDATE);
+  g_clear_error (&error);
+
+  /* A stream recorded as validated is dumped without being checked again */
+  module = modulemd_module_index_get_module (index, "foo");
+  indexed = g_ptr_array_index (modulemd_module_get_all_streams (module), 0);
+  modulemd_module_stream_set_validated (indexed, TRUE);
+
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (yaml);
+  g_clear_pointer (&yaml, g_free);
+
+  /* ...unless the caller asks for full validation */
+  g_assert_false (modulemd_module_index_get_force_validation (index));
+  modulemd_module_index_set_force_validation (index, TRUE);
+  g_assert_true (modulemd_module_index_get_force_validation (index));
+
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_null (yaml);
+  g_assert_error (error, MODULEMD_ERROR, MODULEMD_ERROR_VALIDATE);
+}
+
+
+static guint64
+lookup_stat (GVariant *stats, const gchar *name)
+{
+  guint64 value = 0;
+
+  g_assert_true (g_variant_lookup (stats, name, "t", &value));
+
+  return value;
+}
+
+
+static void
+module_index_test_stats (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (ModulemdModuleIndex) merged = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GVariant) stats = NULL;
+  g_autofree gchar *yaml_path = NULL;
+  g_autofree gchar *contents = NULL;
+  g_autofree gchar *yaml = NULL;
+  gsize length;
+  GVariantIter iter;
+  const gchar *key;
+  guint64 value;
+
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (g_file_get_contents (yaml_path, &contents, &length, NULL));
+
+  /* Nothing is collected by default */
+  index = modulemd_module_index_new ();
+  g_assert_false (modulemd_module_index_get_collect_stats (index));
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  stats = g_variant_ref_sink (modulemd_module_index_get_stats (index));
+  g_assert_true (g_variant_is_of_type (stats, G_VARIANT_TYPE ("a{st}")));
+  g_variant_iter_init (&iter, stats);
+  while (g_variant_iter_next (&iter, "{&st}", &key, &value))
+    g_assert_cmpuint (value, ==, 0);
+  g_clear_pointer (&stats, g_variant_unref);
+  g_clear_object (&index);
+
+  /* Reading a file */
+  index = modulemd_module_index_new ();
+  modulemd_module_index_set_collect_stats (index, TRUE);
+  g_assert_true (modulemd_module_index_get_collect_stats (index));
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  stats = g_variant_ref_sink (modulemd_module_index_get_stats (index));
+  g_assert_cmpuint (lookup_stat (stats, "bytes-read"), ==, length);
+  g_assert_cmpuint (lookup_stat (stats, "documents-modulemd"), >, 0);
+  g_assert_cmpuint (lookup_stat (stats, "documents-modulemd"),
+                    ==,
+                    lookup_stat (stats, "streams-added"));
+  g_assert_cmpuint (lookup_stat (stats, "documents-modulemd-defaults"), >, 0);
+  g_assert_cmpuint (lookup_stat (stats, "failures"), ==, 0);
+  g_assert_cmpuint (lookup_stat (stats, "time-update-from-file"),
+                    >=,
+                    lookup_stat (stats, "time-update-from-parser"));
+  g_assert_cmpuint (lookup_stat (stats, "time-update-from-parser"),
+                    >=,
+                    lookup_stat (stats, "time-parse-documents"));
+  g_assert_cmpuint (lookup_stat (stats, "time-merge"), ==, 0);
+  g_assert_cmpuint (lookup_stat (stats, "time-dump"), ==, 0);
+  g_clear_pointer (&stats, g_variant_unref);
+
+  /* Failed subdocuments */
+  modulemd_module_index_reset_stats (index);
+  g_clear_pointer (&yaml_path, g_free);
+  yaml_path =
+    g_strdup_printf ("%s/broken_stream.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_false (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 1);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  stats = g_variant_ref_sink (modulemd_module_index_get_stats (index));
+  g_assert_cmpuint (lookup_stat (stats, "failures"), ==, 1);
+  g_assert_cmpuint (lookup_stat (stats, "documents-modulemd"), ==, 0);
+  g_clear_pointer (&stats, g_variant_unref);
+
+  /* Merging is recorded against the destination index */
+  merged = modulemd_module_index_new ();
+  modulemd_module_index_set_collect_stats (merged, TRUE);
+  g_assert_true (
+    modulemd_module_index_merge (index, merged, FALSE, FALSE, &error));
+  g_assert_no_error (error);
+
+  stats = g_variant_ref_sink (modulemd_module_index_get_stats (merged));
+  g_assert_cmpuint (lookup_stat (stats, "bytes-read"), ==, 0);
+  g_assert_cmpuint (lookup_stat (stats, "streams-added"), >, 0);
+  g_clear_pointer (&stats, g_variant_unref);
+
+  /* Dumping */
+  yaml = modulemd_module_index_dump_to_string (merged, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (yaml);
+
+  /* Resetting */
+  modulemd_module_index_reset_stats (merged);
+  stats = g_variant_ref_sink (modulemd_module_index_get_stats (merged));
+  g_variant_iter_init (&iter, stats);
+  while (g_variant_iter_next (&iter, "{&st}", &key, &value))
+    g_assert_cmpuint (value, ==, 0);
+}
+
+
+static void
+module_index_test_passthrough (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = NULL;
+  g_autoptr (ModulemdModuleIndex) normal = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml = NULL;
+  g_autofree gchar *normal_yaml = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModuleStream *stream = NULL;
+  GPtrArray *deps = NULL;
+  const gchar *input = "---\n"
+                       "document: modulemd\n"
+                       "version: 2\n"
+                       "data:\n"
+                       "  summary: A test module\n"
+                       "  name: foo\n"
+                       "  stream: bar\n"
+                       "  version: 1\n"
+                       "  context: c0ffee\n"
+                       "  description: A test module in all its glory.\n"
+                       "  license:\n"
+                       "    module:\n"
+                       "    - MIT\n"
+                       "  dependencies:\n"
+                       "  - buildrequires:\n"
+                       "      platform:\n"
+                       "      - f29\n"
+                       "...\n";
+
+  index = modulemd_module_index_new ();
+  g_assert_false (modulemd_module_index_get_passthrough (index));
+  modulemd_module_index_set_passthrough (index, TRUE);
+  g_assert_true (modulemd_module_index_get_passthrough (index));
+  g_assert_true (modulemd_module_index_update_from_string (
+    index, input, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  normal = modulemd_module_index_new ();
+  g_assert_true (modulemd_module_index_update_from_string (
+    normal, input, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  /* The unmodified stream is written back out with its keys in their
+   * original order, unlike a normal dump.
+   */
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (yaml, ==, input);
+  g_clear_pointer (&yaml, g_free);
+
+  normal_yaml = modulemd_module_index_dump_to_string (normal, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (normal_yaml, !=, input);
+  g_clear_pointer (&normal_yaml, g_free);
+
+  yaml = modulemd_module_index_dump_to_string_parallel (index, 2, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (yaml, ==, input);
+  g_clear_pointer (&yaml, g_free);
+
+  /* Reading a child of the stream doesn't count as modifying it */
+  module = modulemd_module_index_get_module (index, "foo");
+  stream = g_ptr_array_index (modulemd_module_get_all_streams (module), 0);
+  deps = modulemd_module_stream_v2_get_dependencies (
+    MODULEMD_MODULE_STREAM_V2 (stream));
+  g_assert_cmpint (deps->len, ==, 1);
+  g_assert_true (modulemd_dependencies_buildrequires_module_and_stream (
+    g_ptr_array_index (deps, 0), "platform", "f29"));
+  g_assert_nonnull (modulemd_module_stream_get_raw_yaml (stream));
+
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (yaml, ==, input);
+  g_clear_pointer (&yaml, g_free);
+
+  /* Once modified, it is serialized like any other stream */
+  modulemd_module_stream_v2_set_summary (MODULEMD_MODULE_STREAM_V2 (stream),
+                                         "Changed");
+  g_assert_null (modulemd_module_stream_get_raw_yaml (stream));
+
+  module = modulemd_module_index_get_module (normal, "foo");
+  stream = g_ptr_array_index (modulemd_module_get_all_streams (module), 0);
+  modulemd_module_stream_v2_set_summary (MODULEMD_MODULE_STREAM_V2 (stream),
+                                         "Changed");
+
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  normal_yaml = modulemd_module_index_dump_to_string (normal, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (yaml, ==, normal_yaml);
+  g_clear_pointer (&yaml, g_free);
+
+  /* Modifying a child modifies the stream as well */
+  g_clear_object (&index);
+  index = modulemd_module_index_new ();
+  modulemd_module_index_set_passthrough (index, TRUE);
+  g_assert_true (modulemd_module_index_update_from_string (
+    index, input, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_clear_pointer (&failures, g_ptr_array_unref);
+
+  module = modulemd_module_index_get_module (index, "foo");
+  stream = g_ptr_array_index (modulemd_module_get_all_streams (module), 0);
+  g_assert_nonnull (modulemd_module_stream_get_raw_yaml (stream));
+  deps = modulemd_module_stream_v2_get_dependencies (
+    MODULEMD_MODULE_STREAM_V2 (stream));
+  modulemd_dependencies_add_runtime_stream (
+    g_ptr_array_index (deps, 0), "platform", "f29");
+  g_assert_null (modulemd_module_stream_get_raw_yaml (stream));
+
+  yaml = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (g_strstr_len (yaml, -1, "    requires:"));
+  g_assert_cmpstr (yaml, !=, input);
+}
+
+
+static void
+add_filter_test_stream (ModulemdModuleIndex *index,
+                        const gchar *module_name,
+                        const gchar *stream_name,
+                        guint64 version,
+                        const gchar *arch)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (GError) error = NULL;
+
+  stream = modulemd_module_stream_new (2, module_name, stream_name);
+  modulemd_module_stream_set_version (stream, version);
+  modulemd_module_stream_set_context (stream, "c0ffee");
+  modulemd_module_stream_v2_set_arch (MODULEMD_MODULE_STREAM_V2 (stream),
+                                      arch);
+  g_assert_true (
+    modulemd_module_index_add_module_stream (index, stream, &error));
+  g_assert_no_error (error);
+}
+
+
+static ModulemdModuleIndex *
+filter_test_index (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (ModulemdDefaults) defaults = NULL;
+  g_autoptr (ModulemdTranslation) translation = NULL;
+  g_autoptr (GError) error = NULL;
+
+  add_filter_test_stream (index, "foo", "bar", 1, "x86_64");
+  add_filter_test_stream (index, "foo", "bar", 2, "aarch64");
+  add_filter_test_stream (index, "foo", "baz", 1, "x86_64");
+  add_filter_test_stream (index, "quux", "1.0", 1, "aarch64");
+
+  defaults = modulemd_defaults_new (MD_DEFAULTS_VERSION_ONE, "foo");
+  modulemd_defaults_v1_set_default_stream (
+    MODULEMD_DEFAULTS_V1 (defaults), "bar", NULL);
+  g_assert_true (modulemd_module_index_add_defaults (index, defaults, &error));
+  g_assert_no_error (error);
+
+  translation = modulemd_translation_new (1, "foo", "bar", 42);
+  g_assert_true (
+    modulemd_module_index_add_translation (index, translation, &error));
+  g_assert_no_error (error);
+
+  return g_steal_pointer (&index);
+}
+
+
+static void
+module_index_test_filter (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = filter_test_index ();
+  g_autoptr (ModulemdModuleIndex) filtered = NULL;
+  g_autoptr (GHashTable) default_streams = NULL;
+  g_auto (GStrv) module_names = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModule *filtered_module = NULL;
+  GPtrArray *streams = NULL;
+  ModulemdModuleStream *stream = NULL;
+  ModulemdModuleStream *original = NULL;
+
+  /* Filter by architecture, keeping every document type */
+  filtered = modulemd_module_index_filter (
+    index, NULL, NULL, 0, NULL, "x86_64", MODULEMD_DOCUMENT_TYPE_ALL);
+  g_assert_nonnull (filtered);
+
+  /* quux had no x86_64 streams, defaults or translations */
+  module_names = modulemd_module_index_get_module_names_as_strv (filtered);
+  g_assert_cmpuint (g_strv_length (module_names), ==, 1);
+  g_assert_cmpstr (module_names[0], ==, "foo");
+
+  module = modulemd_module_index_get_module (index, "foo");
+  filtered_module = modulemd_module_index_get_module (filtered, "foo");
+  streams = modulemd_module_get_all_streams (filtered_module);
+  g_assert_cmpuint (streams->len, ==, 2);
+  for (guint i = 0; i < streams->len; i++)
+    {
+      stream = g_ptr_array_index (streams, i);
+      g_assert_cmpstr (modulemd_module_stream_get_arch (stream), ==, "x86_64");
+
+      /* Streams of an unfrozen index are copied */
+      original = modulemd_module_get_stream_by_NSVCA (
+        module,
+        modulemd_module_stream_get_stream_name (stream),
+        modulemd_module_stream_get_version (stream),
+        modulemd_module_stream_get_context (stream),
+        modulemd_module_stream_get_arch (stream),
+        NULL);
+      g_assert_nonnull (original);
+      g_assert_true (original != stream);
+      g_assert_true (modulemd_module_stream_equals (original, stream));
+    }
+  g_assert_nonnull (modulemd_module_get_defaults (filtered_module));
+  g_assert_true (modulemd_module_get_defaults (filtered_module) !=
+                 modulemd_module_get_defaults (module));
+  g_assert_true (
+    modulemd_defaults_equals (modulemd_module_get_defaults (filtered_module),
+                              modulemd_module_get_defaults (module)));
+  g_assert_nonnull (modulemd_module_get_translation (filtered_module, "bar"));
+  g_assert_true (modulemd_module_get_translation (filtered_module, "bar") !=
+                 modulemd_module_get_translation (module, "bar"));
+
+  /* So changing them leaves the original index alone */
+  modulemd_module_stream_v2_set_summary (MODULEMD_MODULE_STREAM_V2 (stream),
+                                         "Changed");
+  g_assert_null (modulemd_module_stream_v2_get_summary (
+    MODULEMD_MODULE_STREAM_V2 (original), "C"));
+  modulemd_defaults_v1_set_default_stream (
+    MODULEMD_DEFAULTS_V1 (modulemd_module_get_defaults (filtered_module)),
+    "baz",
+    NULL);
+  g_assert_cmpstr (
+    modulemd_defaults_v1_get_default_stream (
+      MODULEMD_DEFAULTS_V1 (modulemd_module_get_defaults (module)), NULL),
+    ==,
+    "bar");
+  g_clear_object (&filtered);
+  g_clear_pointer (&module_names, g_strfreev);
+
+  /* Filter by module and stream name globs and version */
+  filtered = modulemd_module_index_filter (
+    index, "f*", "ba?", 2, NULL, NULL, MODULEMD_DOCUMENT_TYPE_MODULE_STREAM);
+  module_names = modulemd_module_index_get_module_names_as_strv (filtered);
+  g_assert_cmpuint (g_strv_length (module_names), ==, 1);
+  filtered_module = modulemd_module_index_get_module (filtered, "foo");
+  streams = modulemd_module_get_all_streams (filtered_module);
+  g_assert_cmpuint (streams->len, ==, 1);
+  stream = g_ptr_array_index (streams, 0);
+  g_assert_cmpstr (modulemd_module_stream_get_stream_name (stream), ==, "bar");
+  g_assert_cmpuint (modulemd_module_stream_get_version (stream), ==, 2);
+  g_assert_null (modulemd_module_get_defaults (filtered_module));
+  g_assert_null (modulemd_module_get_translation (filtered_module, "bar"));
+  g_clear_object (&filtered);
+  g_clear_pointer (&module_names, g_strfreev);
+
+  /* Defaults only */
+  filtered = modulemd_module_index_filter (
+    index, NULL, NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_DEFAULTS);
+  module_names = modulemd_module_index_get_module_names_as_strv (filtered);
+  g_assert_cmpuint (g_strv_length (module_names), ==, 1);
+  filtered_module = modulemd_module_index_get_module (filtered, "foo");
+  g_assert_cmpuint (
+    modulemd_module_get_all_streams (filtered_module)->len, ==, 0);
+  default_streams =
+    modulemd_module_index_get_default_streams_as_hash_table (filtered, NULL);
+  g_assert_cmpstr (g_hash_table_lookup (default_streams, "foo"), ==, "bar");
+  g_clear_object (&filtered);
+
+  /* Nothing matches */
+  filtered = modulemd_module_index_filter (
+    index, "nonexistent", NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_ALL);
+  g_assert_nonnull (filtered);
+  g_assert_null (modulemd_module_index_get_module (filtered, "foo"));
+  g_clear_object (&filtered);
+
+  /* The original index is unchanged */
+  g_assert_cmpuint (modulemd_module_get_all_streams (module)->len, ==, 3);
+  g_assert_nonnull (modulemd_module_index_get_module (index, "quux"));
+
+  /* The documents of a frozen index are shared, not copied */
+  modulemd_module_index_freeze (index);
+  filtered = modulemd_module_index_filter (
+    index, "foo", NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_ALL);
+  filtered_module = modulemd_module_index_get_module (filtered, "foo");
+  streams = modulemd_module_get_all_streams (filtered_module);
+  g_assert_cmpuint (streams->len, ==, 3);
+  for (guint i = 0; i < streams->len; i++)
+    g_assert_true (g_ptr_array_find (modulemd_module_get_all_streams (module),
+                                     g_ptr_array_index (streams, i),
+                                     NULL));
+  g_assert_true (modulemd_module_get_defaults (filtered_module) ==
+                 modulemd_module_get_defaults (module));
+  g_assert_true (modulemd_module_get_translation (filtered_module, "bar") ==
+                 modulemd_module_get_translation (module, "bar"));
+  g_clear_object (&filtered);
+}
+
+
+static void
+module_index_test_prune (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = filter_test_index ();
+  g_autoptr (GHashTable) default_streams = NULL;
+  ModulemdModule *module = NULL;
+
+  /* foo has a default stream until its defaults are pruned */
+  default_streams =
+    modulemd_module_index_get_default_streams_as_hash_table (index, NULL);
+  g_assert_true (g_hash_table_contains (default_streams, "foo"));
+  g_clear_pointer (&default_streams, g_hash_table_unref);
+
+  /* Drops the aarch64 streams of foo and all of quux */
+  g_assert_cmpuint (modulemd_module_index_prune (index,
+                                                 NULL,
+                                                 NULL,
+                                                 0,
+                                                 NULL,
+                                                 "x86_64",
+                                                 MODULEMD_DOCUMENT_TYPE_ALL),
+                    ==,
+                    2);
+  g_assert_null (modulemd_module_index_get_module (index, "quux"));
+  module = modulemd_module_index_get_module (index, "foo");
+  g_assert_cmpuint (modulemd_module_get_all_streams (module)->len, ==, 2);
+  g_assert_nonnull (modulemd_module_get_defaults (module));
+
+  /* Drops the defaults and translation */
+  g_assert_cmpuint (
+    modulemd_module_index_prune (
+      index, NULL, NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_MODULE_STREAM),
+    ==,
+    2);
+  g_assert_null (modulemd_module_get_defaults (module));
+  g_assert_null (modulemd_module_get_translation (module, "bar"));
+  default_streams =
+    modulemd_module_index_get_default_streams_as_hash_table (index, NULL);
+  g_assert_cmpuint (g_hash_table_size (default_streams), ==, 0);
+
+  /* Drops everything that is left */
+  g_assert_cmpuint (
+    modulemd_module_index_prune (
+      index, "nonexistent", NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_ALL),
+    ==,
+    2);
+  g_assert_null (modulemd_module_index_get_module (index, "foo"));
+}
+
+
+static void
+add_artifact_test_stream (ModulemdModuleIndex *index,
+                          guint64 mdversion,
+                          const gchar *module_name,
+                          const gchar *stream_name,
+                          const gchar *artifact)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (GError) error = NULL;
+
+  stream = modulemd_module_stream_new (mdversion, module_name, stream_name);
+  if (mdversion == MD_MODULESTREAM_VERSION_ONE)
+    modulemd_module_stream_v1_add_rpm_artifact (
+      MODULEMD_MODULE_STREAM_V1 (stream), artifact);
+  else
+    modulemd_module_stream_v2_add_rpm_artifact (
+      MODULEMD_MODULE_STREAM_V2 (stream), artifact);
+
+  g_assert_true (
+    modulemd_module_index_add_module_stream (index, stream, &error));
+  g_assert_no_error (error);
+}
+
+
+static void
+assert_artifact_streams (ModulemdModuleIndex *index,
+                         const gchar *nevra,
+                         const gchar *package_name,
+                         guint n_artifact_streams,
+                         guint n_package_streams)
+{
+  g_autoptr (GPtrArray) streams = NULL;
+
+  streams =
+    modulemd_module_index_search_streams_by_rpm_artifact (index, nevra);
+  g_assert_nonnull (streams);
+  g_assert_cmpuint (streams->len, ==, n_artifact_streams);
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  streams =
+    modulemd_module_index_search_streams_by_package_name (index, package_name);
+  g_assert_nonnull (streams);
+  g_assert_cmpuint (streams->len, ==, n_package_streams);
+}
+
+
+static void
+module_index_test_search_by_rpm_artifact (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (GPtrArray) streams = NULL;
+  const gchar *foo_x86 = "foo-bar-0:1.2-3.module_f29+123.x86_64";
+  const gchar *foo_src = "foo-bar-0:1.2-3.module_f29+123.src";
+  const gchar *foo_new = "foo-bar-0:1.3-1.module_f29+456.x86_64";
+
+  /* The lookup table is built from a mix of stream versions */
+  add_artifact_test_stream (index, 1, "foo", "stable", foo_x86);
+  add_artifact_test_stream (index, 1, "foo", "stable-src", foo_src);
+
+  assert_artifact_streams (index, foo_x86, "foo-bar", 1, 2);
+  assert_artifact_streams (index, foo_src, "foo-bar", 1, 2);
+  assert_artifact_streams (index, "foo-bar", "foo", 0, 0);
+
+  streams =
+    modulemd_module_index_search_streams_by_rpm_artifact (index, foo_x86);
+  g_assert_cmpstr (
+    modulemd_module_stream_get_stream_name (g_ptr_array_index (streams, 0)),
+    ==,
+    "stable");
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  /* Adding a V2 stream upgrades the others and rebuilds the table */
+  add_artifact_test_stream (index, 2, "foo", "latest", foo_new);
+  assert_artifact_streams (index, foo_x86, "foo-bar", 1, 3);
+  assert_artifact_streams (index, foo_new, "foo-bar", 1, 3);
+
+  /* Streams added after the table was built are included */
+  add_artifact_test_stream (index, 2, "baz", "latest", foo_x86);
+  assert_artifact_streams (index, foo_x86, "foo-bar", 2, 4);
+
+  /* Removing a module removes its streams from the table */
+  g_assert_true (modulemd_module_index_remove_module (index, "foo"));
+  assert_artifact_streams (index, foo_x86, "foo-bar", 1, 1);
+  assert_artifact_streams (index, foo_new, "foo-bar", 0, 1);
+
+  streams =
+    modulemd_module_index_search_streams_by_package_name (index, "foo-bar");
+  g_assert_cmpstr (
+    modulemd_module_stream_get_module_name (g_ptr_array_index (streams, 0)),
+    ==,
+    "baz");
+}
+
+
+static void
+add_checksum_test_stream (ModulemdModuleIndex *index,
+                          const gchar *module_name,
+                          const gchar *stream_name,
+                          ModulemdRpmMapEntry *entry,
+                          const gchar *checksum)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (GError) error = NULL;
+
+  stream = modulemd_module_stream_new (2, module_name, stream_name);
+  modulemd_module_stream_v2_set_rpm_artifact_map_entry (
+    MODULEMD_MODULE_STREAM_V2 (stream), entry, "sha256", checksum);
+
+  g_assert_true (
+    modulemd_module_index_add_module_stream (index, stream, &error));
+  g_assert_no_error (error);
+}
+
+
+static void
+module_index_test_search_by_rpm_checksum (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (ModulemdRpmMapEntry) bar =
+    modulemd_rpm_map_entry_new ("bar", 0, "1.23", "1.module_f29", "x86_64");
+  g_autoptr (ModulemdRpmMapEntry) baz =
+    modulemd_rpm_map_entry_new ("baz", 0, "4.56", "1.module_f29", "x86_64");
+  g_autoptr (GPtrArray) streams = NULL;
+  ModulemdRpmMapEntry *entry = NULL;
+
+  add_checksum_test_stream (index, "foo", "a", bar, "c0ffee");
+
+  streams = modulemd_module_index_search_streams_by_rpm_checksum (
+    index, "sha256", "c0ffee", &entry);
+  g_assert_cmpuint (streams->len, ==, 1);
+  g_assert_cmpstr (
+    modulemd_module_stream_get_stream_name (g_ptr_array_index (streams, 0)),
+    ==,
+    "a");
+  g_assert_true (modulemd_rpm_map_entry_equals (entry, bar));
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  /* Wrong digest or unknown checksum */
+  streams = modulemd_module_index_search_streams_by_rpm_checksum (
+    index, "sha512", "c0ffee", &entry);
+  g_assert_cmpuint (streams->len, ==, 0);
+  g_assert_null (entry);
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  streams = modulemd_module_index_search_streams_by_rpm_checksum (
+    index, "sha256", "deadbeef", NULL);
+  g_assert_cmpuint (streams->len, ==, 0);
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  /* Streams added after the table was built are included */
+  add_checksum_test_stream (index, "foo", "b", bar, "c0ffee");
+  add_checksum_test_stream (index, "quux", "a", baz, "deadbeef");
+
+  streams = modulemd_module_index_search_streams_by_rpm_checksum (
+    index, "sha256", "c0ffee", NULL);
+  g_assert_cmpuint (streams->len, ==, 2);
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  streams = modulemd_module_index_search_streams_by_rpm_checksum (
+    index, "sha256", "deadbeef", &entry);
+  g_assert_cmpuint (streams->len, ==, 1);
+  g_assert_true (modulemd_rpm_map_entry_equals (entry, baz));
+  g_clear_pointer (&streams, g_ptr_array_unref);
+
+  /* Removing a module removes its streams from the table */
+  g_assert_true (modulemd_module_index_remove_module (index, "foo"));
+  streams = modulemd_module_index_search_streams_by_rpm_checksum (
+    index, "sha256", "c0ffee", &entry);
+  g_assert_cmpuint (streams->len, ==, 0);
+  g_assert_null (entry);
+}
+
+
+/* The reads done by each thread of module_index_test_freeze() */
+typedef struct _FrozenReadJob
+{
+  ModulemdModuleIndex *index;
+  guint iterations;
+  gboolean dump;
+  guint64 found;
+  gchar *yaml;
+} FrozenReadJob;
+
+
+static gpointer
+frozen_read_job_run (gpointer data)
+{
+  FrozenReadJob *job = (FrozenReadJob *)data;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GPtrArray) streams = NULL;
+  g_auto (GStrv) module_names = NULL;
+  ModulemdModule *module = NULL;
+
+  for (guint n = 0; n < job->iterations; n++)
+    {
+      module_names =
+        modulemd_module_index_get_module_names_as_strv (job->index);
+      for (guint i = 0; module_names[i]; i++)
+        {
+          module =
+            modulemd_module_index_get_module (job->index, module_names[i]);
+          job->found += modulemd_module_get_all_streams (module)->len;
+        }
+      g_clear_pointer (&module_names, g_strfreev);
+
+      streams = modulemd_module_index_search_streams_by_package_name (
+        job->index, "stratisd");
+      job->found += streams->len;
+      g_clear_pointer (&streams, g_ptr_array_unref);
+
+      job->found += g_hash_table_size (
+        modulemd_module_index_peek_default_streams (job->index, NULL));
+    }
+
+  if (job->dump)
+    {
+      job->yaml = modulemd_module_index_dump_to_string (job->index, &error);
+      g_assert_no_error (error);
+    }
+
+  return NULL;
+}
+
+
+/* Runs the same reads on @n_threads threads at once, checks them against
+ * the single round of @expected and returns how long they took
+ */
+static gdouble
+run_frozen_read_jobs (ModulemdModuleIndex *index,
+                      guint n_threads,
+                      guint iterations,
+                      gboolean dump,
+                      const FrozenReadJob *expected)
+{
+  g_autofree FrozenReadJob *jobs = g_new0 (FrozenReadJob, n_threads);
+  g_autofree GThread **threads = g_new0 (GThread *, n_threads);
+  gdouble elapsed;
+
+  g_test_timer_start ();
+  for (guint i = 0; i < n_threads; i++)
+    {
+      jobs[i].index = index;
+      jobs[i].iterations = iterations;
+      jobs[i].dump = dump;
+      threads[i] = g_thread_new ("reader", frozen_read_job_run, &jobs[i]);
+    }
+
+  for (guint i = 0; i < n_threads; i++)
+    g_thread_join (threads[i]);
+  elapsed = g_test_timer_elapsed ();
+
+  for (guint i = 0; i < n_threads; i++)
+    {
+      g_assert_cmpuint (jobs[i].found, ==, expected->found * iterations);
+      if (dump)
+        g_assert_cmpstr (jobs[i].yaml, ==, expected->yaml);
+      g_free (jobs[i].yaml);
+    }
+
+  return elapsed;
+}
+
+
+static void
+module_index_test_freeze (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) filtered = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GHashTable) default_streams = NULL;
+  g_autoptr (ModulemdTranslation) translation = NULL;
+  g_autoptr (ModulemdTranslationEntry) entry = NULL;
+  g_auto (GStrv) rpms = NULL;
+  g_autofree gchar *yaml_path = NULL;
+  g_autofree gchar *parallel_output = NULL;
+  ModulemdModuleStream *stream = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdProfile *profile = NULL;
+  ModulemdComponentRpm *component = NULL;
+  ModulemdDefaults *defaults = NULL;
+  ModulemdTranslationEntry *frozen_entry = NULL;
+  FrozenReadJob expected = { 0 };
+  const guint iterations = 1000;
+  gdouble elapsed;
+  gdouble serial_rate = 0;
+
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+
+  translation = modulemd_translation_new (1, "stratis", "1", 42);
+  entry = modulemd_translation_entry_new ("ja");
+  modulemd_translation_entry_set_summary (entry, "Original");
+  modulemd_translation_set_translation_entry (translation, entry);
+  g_assert_true (
+    modulemd_module_index_add_translation (index, translation, &error));
+  g_assert_no_error (error);
+
+  /* Collect what the reads give before the index is frozen */
+  expected.index = index;
+  expected.iterations = 1;
+  expected.dump = TRUE;
+  frozen_read_job_run (&expected);
+  g_assert_nonnull (expected.yaml);
+
+  g_assert_false (modulemd_module_index_is_frozen (index));
+  modulemd_module_index_freeze (index);
+  g_assert_true (modulemd_module_index_is_frozen (index));
+
+  /* Freezing twice is harmless */
+  modulemd_module_index_freeze (index);
+  g_assert_true (modulemd_module_index_is_frozen (index));
+
+  /* Every stream was validated, and reading a child doesn't change that */
+  module = modulemd_module_index_get_module (index, "stratis");
+  g_assert_nonnull (module);
+  stream = g_ptr_array_index (modulemd_module_get_all_streams (module), 0);
+  g_assert_true (modulemd_module_stream_is_frozen (stream));
+  g_assert_true (modulemd_module_stream_is_validated (stream));
+  modulemd_module_stream_v2_get_buildopts (MODULEMD_MODULE_STREAM_V2 (stream));
+  g_assert_true (modulemd_module_stream_is_validated (stream));
+
+  /* Intents without defaults of their own share the generic view */
+  g_assert_true (
+    modulemd_module_index_peek_default_streams (index, "server") ==
+    modulemd_module_index_peek_default_streams (index, NULL));
+  default_streams =
+    modulemd_module_index_get_default_streams_as_hash_table (index, "server");
+  g_assert_nonnull (default_streams);
+  g_assert_cmpstr (g_hash_table_lookup (default_streams, "stratis"), ==, "1");
+  g_clear_pointer (&default_streams, g_hash_table_unref);
+
+  /* Readers on many threads see the same content as before */
+  for (guint n_threads = 1; n_threads <= 8; n_threads *= 2)
+    run_frozen_read_jobs (index, n_threads, 10, TRUE, &expected);
+
+  for (guint threads = 0; threads <= 4; threads++)
+    {
+      parallel_output = modulemd_module_index_dump_to_string_parallel (
+        index, threads, &error);
+      g_assert_no_error (error);
+      g_assert_cmpstr (expected.yaml, ==, parallel_output);
+      g_clear_pointer (&parallel_output, g_free);
+    }
+
+  /* A filtered copy can still be modified */
+  filtered = modulemd_module_index_filter (
+    index, "stratis", NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_ALL);
+  g_assert_false (modulemd_module_index_is_frozen (filtered));
+  g_assert_true (modulemd_module_index_remove_module (filtered, "stratis"));
+
+  /* But the frozen index cannot */
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  g_assert_false (modulemd_module_index_remove_module (index, "stratis"));
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_nonnull (modulemd_module_index_get_module (index, "stratis"));
+
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  g_assert_false (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_module_index_set_force_validation (index, TRUE);
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_false (modulemd_module_index_get_force_validation (index));
+
+  /* Nor the children of its streams, its defaults or its translations */
+  profile = modulemd_module_stream_v2_get_profile (
+    MODULEMD_MODULE_STREAM_V2 (stream), "default");
+  g_assert_nonnull (profile);
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_profile_add_rpm (profile, "changed");
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  rpms = modulemd_profile_get_rpms_as_strv (profile);
+  g_assert_false (g_strv_contains ((const gchar *const *)rpms, "changed"));
+
+  component = modulemd_module_stream_v2_get_rpm_component (
+    MODULEMD_MODULE_STREAM_V2 (stream), "stratisd");
+  g_assert_nonnull (component);
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_component_rpm_set_ref (component, "changed");
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_cmpstr (modulemd_component_rpm_get_ref (component), !=, "changed");
+
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_component_set_rationale (MODULEMD_COMPONENT (component), "changed");
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_cmpstr (
+    modulemd_component_get_rationale (MODULEMD_COMPONENT (component)),
+    !=,
+    "changed");
+
+  defaults = modulemd_module_get_defaults (module);
+  g_assert_nonnull (defaults);
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_defaults_v1_set_default_stream (
+    MODULEMD_DEFAULTS_V1 (defaults), "changed", NULL);
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_cmpstr (modulemd_defaults_v1_get_default_stream (
+                     MODULEMD_DEFAULTS_V1 (defaults), NULL),
+                   ==,
+                   "1");
+
+  frozen_entry = modulemd_translation_get_translation_entry (
+    modulemd_module_get_translation (module, "1"), "ja");
+  g_assert_nonnull (frozen_entry);
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_translation_entry_set_summary (frozen_entry, "Changed");
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_cmpstr (
+    modulemd_translation_entry_get_summary (frozen_entry), ==, "Original");
+
+  /* The translation added was copied, so it can still be changed */
+  modulemd_translation_entry_set_summary (entry, "Changed");
+  g_assert_cmpstr (
+    modulemd_translation_entry_get_summary (entry), ==, "Changed");
+
+  g_clear_pointer (&expected.yaml, g_free);
+
+  if (!g_test_perf ())
+    return;
+
+  /* Each thread does the same amount of lookups, so with no locking the
+   * number of lookups per second should grow with the number of threads.
+   */
+  for (guint n_threads = 1; n_threads <= 4; n_threads *= 2)
+    {
+      elapsed =
+        run_frozen_read_jobs (index, n_threads, iterations, FALSE, &expected);
+      if (n_threads == 1)
+        serial_rate = iterations / elapsed;
+
+      g_test_maximized_result (n_threads * iterations / elapsed,
+                               "%u threads: %.0f lookup rounds per second "
+                               "(%.2fx of one thread)",
+                               n_threads,
+                               n_threads * iterations / elapsed,
+                               n_threads * iterations / elapsed / serial_rate);
+    }
+}
+
+
+static void
+module_index_test_freeze_shared (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) filtered = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *yaml_path = NULL;
+  ModulemdModule *module = NULL;
+  ModulemdModule *frozen_module = NULL;
+  ModulemdModuleStreamV2 *stream = NULL;
+  ModulemdModuleStreamV2 *frozen_stream = NULL;
+
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (modulemd_module_index_update_from_file (
+    index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (failures->len, ==, 0);
+
+  /* The filtered index has copies of the streams and defaults of @index,
+   * which must stay modifiable once the filtered index is frozen.
+   */
+  filtered = modulemd_module_index_filter (
+    index, "stratis", NULL, 0, NULL, NULL, MODULEMD_DOCUMENT_TYPE_ALL);
+  modulemd_module_index_freeze (filtered);
+
+  module = modulemd_module_index_get_module (index, "stratis");
+  frozen_module = modulemd_module_index_get_module (filtered, "stratis");
+  g_assert_true (modulemd_module_get_defaults (module) !=
+                 modulemd_module_get_defaults (frozen_module));
+
+  stream = g_ptr_array_index (modulemd_module_get_all_streams (module), 0);
+  frozen_stream =
+    g_ptr_array_index (modulemd_module_get_all_streams (frozen_module), 0);
+  g_assert_true (stream != frozen_stream);
+  g_assert_false (
+    modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (stream)));
+  g_assert_true (
+    modulemd_module_stream_is_frozen (MODULEMD_MODULE_STREAM (frozen_stream)));
+
+  modulemd_module_stream_v2_set_summary (stream, "Changed");
+  g_assert_cmpstr (
+    modulemd_module_stream_v2_get_summary (stream, "C"), ==, "Changed");
+  g_assert_cmpstr (
+    modulemd_module_stream_v2_get_summary (frozen_stream, "C"), !=, "Changed");
+
+  /* Frozen streams refuse to change */
+  modulemd_test_signal = 0;
+  signal (SIGTRAP, modulemd_test_signal_handler);
+  modulemd_module_stream_v2_set_summary (frozen_stream, "Changed");
+  g_assert_cmpint (modulemd_test_signal, ==, SIGTRAP);
+  g_assert_cmpstr (
+    modulemd_module_stream_v2_get_summary (frozen_stream, "C"), !=, "Changed");
+}
+
+
+static void
+module_index_test_export_streams (void)
+{
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) v1_index = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleIndex) f29_index = modulemd_module_index_new ();
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (ModulemdDependencies) deps = NULL;
+  g_autoptr (GVariant) streams = NULL;
+  g_autoptr (GVariant) foo = NULL;
+  g_autoptr (GVariant) deps_list = NULL;
+  g_autoptr (GPtrArray) failures = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *json = NULL;
+  g_autofree gchar *frozen_json = NULL;
+  g_autofree gchar *yaml_path = NULL;
+  g_autofree const gchar **artifacts = NULL;
+  const gchar *context = NULL;
+  guint64 version = 0;
+  const guint iterations = 100;
+  gdouble elapsed;
+
+  stream = modulemd_module_stream_new (2, "foo", "latest");
+  modulemd_module_stream_set_version (stream, 5);
+  modulemd_module_stream_set_context (stream, "c0ffee");
+  modulemd_module_stream_v2_set_arch (MODULEMD_MODULE_STREAM_V2 (stream),
+                                      "x86_64");
+  modulemd_module_stream_v2_add_rpm_artifact (
+    MODULEMD_MODULE_STREAM_V2 (stream), "foo-0:1.0-1.x86_64");
+  modulemd_module_stream_v2_add_rpm_artifact (
+    MODULEMD_MODULE_STREAM_V2 (stream), "foo-0:1.0-1.src");
+  deps = modulemd_dependencies_new ();
+  modulemd_dependencies_add_buildtime_stream (deps, "platform", "f29");
+  modulemd_dependencies_add_buildtime_stream (deps, "platform", "f28");
+  modulemd_dependencies_set_empty_runtime_dependencies_for_module (
+    deps, "platform");
+  modulemd_module_stream_v2_add_dependencies (
+    MODULEMD_MODULE_STREAM_V2 (stream), deps);
+  g_assert_true (
+    modulemd_module_index_add_module_stream (index, stream, &error));
+  g_assert_no_error (error);
+  g_clear_object (&stream);
+
+  stream = modulemd_module_stream_new (2, "bar", "stable");
+  g_assert_true (
+    modulemd_module_index_add_module_stream (index, stream, &error));
+  g_assert_no_error (error);
+  g_clear_object (&stream);
+
+  /* The streams are sorted by module name */
+  streams = modulemd_module_index_export_streams (index);
+  g_assert_nonnull (streams);
+  g_assert_true (g_variant_is_of_type (streams, G_VARIANT_TYPE ("aa{sv}")));
+  g_assert_cmpuint (g_variant_n_children (streams), ==, 2);
+
+  foo = g_variant_get_child_value (streams, 1);
+  g_assert_true (g_variant_lookup (foo, "version", "t", &version));
+  g_assert_cmpuint (version, ==, 5);
+  g_assert_true (g_variant_lookup (foo, "context", "m&s", &context));
+  g_assert_cmpstr (context, ==, "c0ffee");
+  g_assert_true (g_variant_lookup (foo, "rpm_artifacts", "^a&s", &artifacts));
+  g_assert_cmpuint (g_strv_length ((gchar **)artifacts), ==, 2);
+  g_assert_cmpstr (artifacts[0], ==, "foo-0:1.0-1.src");
+  deps_list = g_variant_lookup_value (
+    foo, "dependencies", G_VARIANT_TYPE ("aa{sa{sas}}"));
+  g_assert_nonnull (deps_list);
+  g_assert_cmpuint (g_variant_n_children (deps_list), ==, 1);
+
+  json = modulemd_module_index_export_streams_as_json (index);
+  g_assert_cmpstr (
+    json,
+    ==,
+    "[{\"module_name\":\"bar\",\"stream_name\":\"stable\",\"version\":0,"
+    "\"context\":null,\"arch\":null,\"nsvca\":\"bar:stable\","
+    "\"rpm_artifacts\":[],\"dependencies\":[]},"
+    "{\"module_name\":\"foo\",\"stream_name\":\"latest\",\"version\":5,"
+    "\"context\":\"c0ffee\",\"arch\":\"x86_64\","
+    "\"nsvca\":\"foo:latest:5:c0ffee:x86_64\","
+    "\"rpm_artifacts\":[\"foo-0:1.0-1.src\",\"foo-0:1.0-1.x86_64\"],"
+    "\"dependencies\":[{\"buildrequires\":{\"platform\":[\"f28\",\"f29\"]},"
+    "\"requires\":{\"platform\":[]}}]}]");
+
+  /* Exporting only reads from a frozen index, and gives the same result */
+  modulemd_module_index_freeze (index);
+  frozen_json = modulemd_module_index_export_streams_as_json (index);
+  g_assert_cmpstr (frozen_json, ==, json);
+  g_clear_pointer (&json, g_free);
+
+  /* The requirements of v1 streams are exported as one dependencies block */
+  stream = modulemd_module_stream_new (1, "baz", "old");
+  modulemd_module_stream_v1_add_buildtime_requirement (
+    MODULEMD_MODULE_STREAM_V1 (stream), "platform", "f29");
+  modulemd_module_stream_v1_add_runtime_requirement (
+    MODULEMD_MODULE_STREAM_V1 (stream), "platform", "f29");
+  g_assert_true (
+    modulemd_module_index_add_module_stream (v1_index, stream, &error));
+  g_assert_no_error (error);
+
+  json = modulemd_module_index_export_streams_as_json (v1_index);
+  g_assert_cmpstr (
+    json,
+    ==,
+    "[{\"module_name\":\"baz\",\"stream_name\":\"old\",\"version\":0,"
+    "\"context\":null,\"arch\":null,\"nsvca\":\"baz:old\","
+    "\"rpm_artifacts\":[],"
+    "\"dependencies\":[{\"buildrequires\":{\"platform\":[\"f29\"]},"
+    "\"requires\":{\"platform\":[\"f29\"]}}]}]");
+
+  if (!g_test_perf ())
+    return;
+
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  g_assert_true (modulemd_module_index_update_from_file (
+    f29_index, yaml_path, TRUE, &failures, &error));
+  g_assert_no_error (error);
+  modulemd_module_index_freeze (f29_index);
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      g_clear_pointer (&json, g_free);
+      json = modulemd_module_index_export_streams_as_json (f29_index);
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed * 1000 / iterations,
+                           "Exported %" G_GSIZE_FORMAT
+                           " bytes of JSON in %.3f ms per iteration",
+                           strlen (json),
+                           elapsed * 1000 / iterations);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  setlocale (LC_ALL, "");
+
+  g_test_init (&argc, &argv, NULL);
+  g_test_bug_base ("https://bugzilla.redhat.com/show_bug.cgi?id=");
+
+  // Define the tests.
+
+  g_test_add ("/modulemd/v2/module/index/dump",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_dump,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/read",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_read,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/read/mixed",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_read_mixed,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/read/unknown",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_read_unknown,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/upgrade/stream",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_stream_upgrade,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/upgrade/stream_owned",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_stream_upgrade_owned,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/upgrade/stream_benchmark",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_stream_upgrade_benchmark,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/upgrade/index",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_index_upgrade,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/remove_module",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_remove_module,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/custom_read",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_custom_read,
+              NULL);
+
+  g_test_add ("/modulemd/v2/module/index/custom_write",
+              ModuleIndexFixture,
+              NULL,
+              NULL,
+              module_index_test_custom_write,
+              NULL);
+
+  g_test_add_func ("/modulemd/v2/module/index/get_default_streams",
+                   module_index_test_get_default_streams);
+
+  g_test_add_func ("/modulemd/v2/module/index/dump_large",
+                   module_index_test_dump_large);
+
+  g_test_add_func ("/modulemd/v2/module/index/read_large",
+                   module_index_test_read_large);
+
+  g_test_add_func ("/modulemd/v2/module/index/skip_validation",
+                   module_index_test_skip_validation);
+
+  g_test_add_func ("/modulemd/v2/module/index/stats",
+                   module_index_test_stats);
+
+  g_test_add_func ("/modulemd/v2/module/index/passthrough",
+                   module_index_test_passthrough);
+
+  g_test_add_func ("/modulemd/v2/module/index/filter",
+                   module_index_test_filter);
+
+  g_test_add_func ("/modulemd/v2/module/index/prune",
+                   module_index_test_prune);
+
+  g_test_add_func ("/modulemd/v2/module/index/search_by_rpm_artifact",
+                   module_index_test_search_by_rpm_artifact);
+
+  g_test_add_func ("/modulemd/v2/module/index/search_by_rpm_checksum",
+                   module_index_test_search_by_rpm_checksum);
+
+  g_test_add_func ("/modulemd/v2/module/index/freeze",
+                   module_index_test_freeze);
+
+  g_test_add_func ("/modulemd/v2/module/index/freeze_shared",
+                   module_index_test_freeze_shared);
+
+  g_test_add_func ("/modulemd/v2/module/index/export_streams",
+                   module_index_test_export_streams);
 
   g_test_add_func ("/modulemd/v2/module/index/empty",
                    module_index_test_dump_empty_index);
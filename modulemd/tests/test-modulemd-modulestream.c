@@ -186,6 +186,67 @@ module_stream_test_copy (ModuleStreamFixture *fixture, gconstpointer user_data)
 }
 
 
+static void
+module_stream_test_copy_sets (ModuleStreamFixture *fixture,
+                              gconstpointer user_data)
+{
+  g_autoptr (ModulemdModuleStreamV1) v1_stream = NULL;
+  g_autoptr (ModulemdModuleStreamV2) v2_stream = NULL;
+  g_autoptr (ModulemdModuleStream) copied_stream = NULL;
+  g_autoptr (ModulemdModuleStream) upgraded_stream = NULL;
+  g_autoptr (GError) error = NULL;
+  g_auto (GStrv) rpm_api = NULL;
+
+  /* The copy must own its sets: changing it or dropping the original must
+   * not affect the other one.
+   */
+  v1_stream = modulemd_module_stream_v1_new ("foo", "latest");
+  modulemd_module_stream_v1_add_rpm_api (v1_stream, "foo");
+  modulemd_module_stream_v1_add_rpm_api (v1_stream, "bar");
+
+  copied_stream = modulemd_module_stream_copy (
+    MODULEMD_MODULE_STREAM (v1_stream), NULL, NULL);
+  modulemd_module_stream_v1_remove_rpm_api (
+    MODULEMD_MODULE_STREAM_V1 (copied_stream), "foo");
+  rpm_api = modulemd_module_stream_v1_get_rpm_api_as_strv (v1_stream);
+  g_assert_cmpuint (g_strv_length (rpm_api), ==, 2);
+  g_clear_pointer (&rpm_api, g_strfreev);
+
+  /* Upgrading leaves the V1 stream to its caller */
+  upgraded_stream = modulemd_module_stream_upgrade (
+    MODULEMD_MODULE_STREAM (v1_stream), MD_MODULESTREAM_VERSION_TWO, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (upgraded_stream);
+  g_clear_object (&v1_stream);
+
+  rpm_api = modulemd_module_stream_v1_get_rpm_api_as_strv (
+    MODULEMD_MODULE_STREAM_V1 (copied_stream));
+  g_assert_cmpuint (g_strv_length (rpm_api), ==, 1);
+  g_assert_cmpstr (rpm_api[0], ==, "bar");
+  g_clear_pointer (&rpm_api, g_strfreev);
+  g_clear_object (&copied_stream);
+
+  rpm_api = modulemd_module_stream_v2_get_rpm_api_as_strv (
+    MODULEMD_MODULE_STREAM_V2 (upgraded_stream));
+  g_assert_cmpuint (g_strv_length (rpm_api), ==, 2);
+  g_clear_pointer (&rpm_api, g_strfreev);
+
+  v2_stream = MODULEMD_MODULE_STREAM_V2 (g_steal_pointer (&upgraded_stream));
+  copied_stream = modulemd_module_stream_copy (
+    MODULEMD_MODULE_STREAM (v2_stream), NULL, NULL);
+  modulemd_module_stream_v2_add_rpm_api (
+    MODULEMD_MODULE_STREAM_V2 (copied_stream), "baz");
+  g_clear_object (&v2_stream);
+
+  rpm_api = modulemd_module_stream_v2_get_rpm_api_as_strv (
+    MODULEMD_MODULE_STREAM_V2 (copied_stream));
+  g_assert_cmpuint (g_strv_length (rpm_api), ==, 3);
+  g_assert_cmpstr (rpm_api[0], ==, "bar");
+  g_assert_cmpstr (rpm_api[1], ==, "baz");
+  g_assert_cmpstr (rpm_api[2], ==, "foo");
+}
+
+
 static void
 module_stream_test_equals (ModuleStreamFixture *fixture,
                            gconstpointer user_data)
@@ -1547,6 +1608,504 @@ module_stream_v2_test_xmd_issue_290_with_example (void)
 }
 
 
+static void
+module_stream_test_xmd_shared_copy (void)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (ModulemdModuleStream) copy = NULL;
+  g_autoptr (ModulemdModuleStream) upgraded = NULL;
+  g_autofree gchar *path = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GVariant) other_xmd = NULL;
+  GVariant *xmd = NULL;
+
+  path =
+    g_strdup_printf ("%s/stream_unicode.yaml", g_getenv ("TEST_DATA_PATH"));
+  stream = modulemd_module_stream_read_file (path, TRUE, NULL, NULL, &error);
+  g_assert_nonnull (stream);
+  g_assert_no_error (error);
+
+  xmd = modulemd_module_stream_v1_get_xmd (MODULEMD_MODULE_STREAM_V1 (stream));
+  g_assert_nonnull (xmd);
+
+  /* Copies and upgrades share the xmd of the original */
+  copy = modulemd_module_stream_copy (stream, NULL, NULL);
+  g_assert_true (
+    modulemd_module_stream_v1_get_xmd (MODULEMD_MODULE_STREAM_V1 (copy)) ==
+    xmd);
+  g_assert_true (modulemd_module_stream_equals (stream, copy));
+
+  upgraded = modulemd_module_stream_upgrade (
+    stream, MD_MODULESTREAM_VERSION_TWO, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (upgraded);
+  g_assert_true (modulemd_module_stream_v2_get_xmd (
+                   MODULEMD_MODULE_STREAM_V2 (upgraded)) == xmd);
+
+  /* Replacing the xmd of a copy leaves the original alone */
+  other_xmd = g_variant_ref_sink (g_variant_new_string ("other"));
+  modulemd_module_stream_v1_set_xmd (MODULEMD_MODULE_STREAM_V1 (copy),
+                                     other_xmd);
+  g_assert_true (
+    modulemd_module_stream_v1_get_xmd (MODULEMD_MODULE_STREAM_V1 (stream)) ==
+    xmd);
+  g_assert_false (modulemd_module_stream_equals (stream, copy));
+}
+
+
+static void
+module_stream_test_xmd_json (void)
+{
+  g_autoptr (ModulemdModuleStreamV2) stream = NULL;
+  g_autoptr (ModulemdModuleStreamV1) v1_stream = NULL;
+  g_autoptr (ModulemdModuleIndex) index = modulemd_module_index_new ();
+  g_autoptr (GString) large = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *json = NULL;
+  g_autofree gchar *deep = NULL;
+  g_autofree gchar *yaml_str = NULL;
+  GVariant *xmd = NULL;
+  const gchar *commit = NULL;
+  gboolean flag = FALSE;
+  const gchar *const invalid[] = {
+    "",
+    "{\"a\": }",
+    "{\"a\": 1,}",
+    "[1 2]",
+    "{\"a\": \"unterminated}",
+    "\"\\ud800\"",
+    "\"\\u0000\"",
+    "01",
+    "1.",
+    "tru",
+    "{} {}",
+    NULL,
+  };
+  const guint n_entries = 10000;
+  const guint iterations = 100;
+  gdouble elapsed;
+
+  /* Whitespace, escapes, surrogate pairs, numbers and nulls are accepted */
+  stream = modulemd_module_stream_v2_new ("foo", "bar");
+  g_assert_null (modulemd_module_stream_v2_get_xmd_as_json (stream));
+  g_assert_true (modulemd_module_stream_v2_set_xmd_from_json (
+    stream,
+    "{ \"mbs\": {\"commit\": \"abc\", \"scmurl\": null,\n"
+    "  \"buildrequires\": {\"platform\": {\"filtered_rpms\": []}}},\n"
+    "  \"flag\": true, \"ids\": [1, -2.5e3],\n"
+    "  \"mixed\": [\"a\", [\"b\"], []],\n"
+    "  \"text\": \"q\\\" s\\\\ t\\t \\u00e9 \\ud83d\\ude00 \\/\" }",
+    &error));
+  g_assert_no_error (error);
+
+  xmd = modulemd_module_stream_v2_get_xmd (stream);
+  g_assert_true (g_variant_is_of_type (xmd, G_VARIANT_TYPE_VARDICT));
+  g_assert_true (g_variant_lookup (xmd, "flag", "b", &flag));
+  g_assert_true (flag);
+  g_assert_true (g_variant_lookup (xmd, "mbs", "@a{sv}", NULL));
+
+  /* Keys keep their order, and mixed lists come back as they were set */
+  json = modulemd_module_stream_v2_get_xmd_as_json (stream);
+  g_assert_cmpstr (
+    json,
+    ==,
+    "{\"mbs\":{\"commit\":\"abc\",\"scmurl\":\"\","
+    "\"buildrequires\":{\"platform\":{\"filtered_rpms\":[]}}},"
+    "\"flag\":true,\"ids\":[\"1\",\"-2.5e3\"],\"mixed\":[\"a\",[\"b\"],[]],"
+    "\"text\":\"q\\\" s\\\\ t\\t \xc3\xa9 \xf0\x9f\x98\x80 /\"}");
+
+  /* The XMD read from JSON can be written out as YAML */
+  modulemd_module_stream_v2_set_summary (stream, "summary");
+  modulemd_module_stream_v2_set_description (stream, "desc");
+  modulemd_module_stream_v2_add_module_license (stream, "MIT");
+  g_assert_true (modulemd_module_index_add_module_stream (
+    index, MODULEMD_MODULE_STREAM (stream), &error));
+  g_assert_no_error (error);
+  yaml_str = modulemd_module_index_dump_to_string (index, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (strstr (yaml_str, "    mixed:\n    - a\n"));
+
+  /* Invalid documents are rejected and leave the XMD alone */
+  for (guint i = 0; invalid[i]; i++)
+    {
+      g_assert_false (modulemd_module_stream_v2_set_xmd_from_json (
+        stream, invalid[i], &error));
+      g_assert_error (error, MODULEMD_ERROR, MODULEMD_ERROR_VALIDATE);
+      g_clear_error (&error);
+    }
+  g_assert_true (modulemd_module_stream_v2_get_xmd (stream) == xmd);
+
+  /* So are documents nested too deeply to be read safely */
+  deep = g_strnfill (100000, '[');
+  g_assert_false (
+    modulemd_module_stream_v2_set_xmd_from_json (stream, deep, &error));
+  g_assert_error (error, MODULEMD_ERROR, MODULEMD_ERROR_VALIDATE);
+  g_clear_error (&error);
+
+  /* The last of duplicate keys wins, and v1 streams work the same way */
+  v1_stream = modulemd_module_stream_v1_new ("foo", "bar");
+  g_assert_true (modulemd_module_stream_v1_set_xmd_from_json (
+    v1_stream, "{\"commit\": \"old\", \"commit\": \"new\"}", &error));
+  g_assert_no_error (error);
+  g_assert_true (
+    g_variant_lookup (modulemd_module_stream_v1_get_xmd (v1_stream),
+                      "commit",
+                      "&s",
+                      &commit));
+  g_assert_cmpstr (commit, ==, "new");
+  g_clear_pointer (&json, g_free);
+  json = modulemd_module_stream_v1_get_xmd_as_json (v1_stream);
+  g_assert_cmpstr (json, ==, "{\"commit\":\"new\"}");
+
+  if (!g_test_perf ())
+    return;
+
+  large = g_string_new ("{");
+  for (guint i = 0; i < n_entries; i++)
+    g_string_append_printf (large,
+                            "%s\"key%u\": {\"ref\": \"%u\", "
+                            "\"rpms\": [\"a\", \"b\", \"c\"]}",
+                            i ? ", " : "",
+                            i,
+                            i);
+  g_string_append_c (large, '}');
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    {
+      g_assert_true (modulemd_module_stream_v2_set_xmd_from_json (
+        stream, large->str, &error));
+      g_assert_no_error (error);
+      g_clear_pointer (&json, g_free);
+      json = modulemd_module_stream_v2_get_xmd_as_json (stream);
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed * 1000 / iterations,
+                           "Converted %u XMD entries to and from JSON in "
+                           "%.3f ms per iteration",
+                           n_entries,
+                           elapsed * 1000 / iterations);
+}
+
+
+static void
+module_stream_test_fingerprint (void)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (ModulemdModuleStream) copy = NULL;
+  g_autofree gchar *path = NULL;
+  g_autofree gchar *summary = NULL;
+  g_autoptr (GError) error = NULL;
+  ModulemdModuleStreamV2 *v2_copy = NULL;
+  ModulemdBuildopts *buildopts = NULL;
+  guint64 fingerprint;
+
+  path = g_strdup_printf ("%s/spec.v2.yaml", g_getenv ("MESON_SOURCE_ROOT"));
+  stream = modulemd_module_stream_read_file (path, TRUE, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (stream);
+
+  fingerprint = modulemd_module_stream_get_fingerprint (stream);
+  g_assert_cmpuint (fingerprint, !=, 0);
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (stream), ==, fingerprint);
+
+  /* Copies have the same content, and so the same fingerprint */
+  copy = modulemd_module_stream_copy (stream, NULL, NULL);
+  v2_copy = MODULEMD_MODULE_STREAM_V2 (copy);
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (copy), ==, fingerprint);
+  g_assert_true (modulemd_module_stream_equals (stream, copy));
+
+  /* Setters change the fingerprint */
+  summary = g_strdup (modulemd_module_stream_v2_get_summary (v2_copy, "C"));
+  modulemd_module_stream_v2_set_summary (v2_copy, "Something else");
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (copy), !=, fingerprint);
+  g_assert_false (modulemd_module_stream_equals (stream, copy));
+
+  modulemd_module_stream_v2_set_summary (v2_copy, summary);
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (copy), ==, fingerprint);
+  g_assert_true (modulemd_module_stream_equals (stream, copy));
+
+  /* So do changes made through a child, after reading it has left the
+   * cached fingerprint alone.
+   */
+  buildopts = modulemd_module_stream_v2_get_buildopts (v2_copy);
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (copy), ==, fingerprint);
+  g_assert_true (modulemd_module_stream_equals (stream, copy));
+  modulemd_buildopts_add_rpm_to_whitelist (buildopts, "something-else");
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (copy), !=, fingerprint);
+  g_assert_false (modulemd_module_stream_equals (stream, copy));
+
+  /* Streams of different metadata versions never match */
+  g_clear_object (&copy);
+  copy = modulemd_module_stream_new (
+    MD_MODULESTREAM_VERSION_ONE,
+    modulemd_module_stream_get_module_name (stream),
+    modulemd_module_stream_get_stream_name (stream));
+  g_assert_false (modulemd_module_stream_equals (stream, copy));
+}
+
+
+static void
+assert_strv_sorted_equal (GStrv actual, GStrv expected)
+{
+  g_assert_cmpuint (g_strv_length (actual), ==, g_strv_length (expected));
+  for (guint i = 0; expected[i]; i++)
+    {
+      g_assert_cmpstr (actual[i], ==, expected[i]);
+      if (i > 0)
+        g_assert_cmpint (g_strcmp0 (actual[i - 1], actual[i]), <, 0);
+    }
+}
+
+
+static void
+module_stream_test_frozen_sets (void)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (ModulemdModuleStream) copy = NULL;
+  g_autoptr (ModulemdModuleStream) refrozen = NULL;
+  g_auto (GStrv) rpm_api = NULL;
+  g_autofree gchar *path = NULL;
+  g_autoptr (GError) error = NULL;
+  ModulemdModuleStreamV2 *v2_stream = NULL;
+  ModulemdModuleStreamV2 *v2_copy = NULL;
+  GStrv (*getters[]) (ModulemdModuleStreamV2 *) = {
+    modulemd_module_stream_v2_get_content_licenses_as_strv,
+    modulemd_module_stream_v2_get_module_licenses_as_strv,
+    modulemd_module_stream_v2_get_rpm_api_as_strv,
+    modulemd_module_stream_v2_get_rpm_artifacts_as_strv,
+    modulemd_module_stream_v2_get_rpm_filters_as_strv,
+  };
+  guint64 fingerprint;
+  const guint iterations = 100000;
+  gdouble elapsed;
+
+  path = g_strdup_printf ("%s/spec.v2.yaml", g_getenv ("MESON_SOURCE_ROOT"));
+  stream = modulemd_module_stream_read_file (path, TRUE, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (stream);
+  v2_stream = MODULEMD_MODULE_STREAM_V2 (stream);
+  fingerprint = modulemd_module_stream_get_fingerprint (stream);
+
+  copy = modulemd_module_stream_copy (stream, NULL, NULL);
+  v2_copy = MODULEMD_MODULE_STREAM_V2 (copy);
+
+  /* Freezing packs the sets, which still hand out the same sorted lists */
+  modulemd_module_stream_freeze (stream);
+  for (guint i = 0; i < G_N_ELEMENTS (getters); i++)
+    {
+      g_auto (GStrv) frozen = getters[i] (v2_stream);
+      g_auto (GStrv) unfrozen = getters[i] (v2_copy);
+
+      g_assert_cmpuint (g_strv_length (frozen), >, 0);
+      assert_strv_sorted_equal (frozen, unfrozen);
+    }
+
+  g_assert_cmpuint (
+    modulemd_module_stream_get_fingerprint (stream), ==, fingerprint);
+  g_assert_true (modulemd_module_stream_equals (stream, copy));
+  g_assert_true (modulemd_module_stream_equals (copy, stream));
+
+  /* Copies of a frozen stream get sets of their own, which can change */
+  refrozen = modulemd_module_stream_copy (stream, NULL, NULL);
+  g_assert_false (modulemd_module_stream_is_frozen (refrozen));
+  modulemd_module_stream_v2_add_rpm_api (MODULEMD_MODULE_STREAM_V2 (refrozen),
+                                         "aaa-first");
+  g_assert_false (modulemd_module_stream_equals (stream, refrozen));
+  modulemd_module_stream_freeze (refrozen);
+  rpm_api = modulemd_module_stream_v2_get_rpm_api_as_strv (
+    MODULEMD_MODULE_STREAM_V2 (refrozen));
+  g_assert_cmpstr (rpm_api[0], ==, "aaa-first");
+  g_assert_cmpstr (rpm_api[1], ==, "bar");
+
+  if (!g_test_perf ())
+    return;
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    g_strfreev (modulemd_module_stream_v2_get_rpm_api_as_strv (v2_copy));
+  elapsed = g_test_timer_elapsed ();
+  g_test_message ("Sorting the set: %.3f s", elapsed);
+
+  g_test_timer_start ();
+  for (guint i = 0; i < iterations; i++)
+    g_strfreev (modulemd_module_stream_v2_get_rpm_api_as_strv (v2_stream));
+  elapsed = g_test_timer_elapsed ();
+  g_test_minimized_result (elapsed, "Copying the packed set: %.3f s", elapsed);
+}
+
+static void
+module_stream_test_frozen_copy (void)
+{
+  g_autoptr (ModulemdModuleStreamV1) v1_stream = NULL;
+  g_autoptr (ModulemdModuleStream) copy = NULL;
+  g_autoptr (ModulemdModuleStream) upgraded = NULL;
+  g_autoptr (GError) error = NULL;
+  g_auto (GStrv) rpm_api = NULL;
+
+  v1_stream = modulemd_module_stream_v1_new ("foo", "latest");
+  modulemd_module_stream_v1_add_rpm_api (v1_stream, "foo");
+  modulemd_module_stream_v1_add_rpm_api (v1_stream, "bar");
+  modulemd_module_stream_freeze (MODULEMD_MODULE_STREAM (v1_stream));
+
+  copy = modulemd_module_stream_copy (
+    MODULEMD_MODULE_STREAM (v1_stream), NULL, NULL);
+  upgraded = modulemd_module_stream_upgrade (
+    MODULEMD_MODULE_STREAM (v1_stream), MD_MODULESTREAM_VERSION_TWO, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (upgraded);
+
+  /* Neither may keep the packed sets, which go away with the original */
+  g_clear_object (&v1_stream);
+
+  modulemd_module_stream_v1_add_rpm_api (MODULEMD_MODULE_STREAM_V1 (copy),
+                                         "baz");
+  modulemd_module_stream_v1_remove_rpm_api (MODULEMD_MODULE_STREAM_V1 (copy),
+                                            "foo");
+  rpm_api = modulemd_module_stream_v1_get_rpm_api_as_strv (
+    MODULEMD_MODULE_STREAM_V1 (copy));
+  g_assert_cmpuint (g_strv_length (rpm_api), ==, 2);
+  g_assert_cmpstr (rpm_api[0], ==, "bar");
+  g_assert_cmpstr (rpm_api[1], ==, "baz");
+  g_clear_pointer (&rpm_api, g_strfreev);
+
+  modulemd_module_stream_v2_remove_rpm_api (
+    MODULEMD_MODULE_STREAM_V2 (upgraded), "bar");
+  rpm_api = modulemd_module_stream_v2_get_rpm_api_as_strv (
+    MODULEMD_MODULE_STREAM_V2 (upgraded));
+  g_assert_cmpuint (g_strv_length (rpm_api), ==, 1);
+  g_assert_cmpstr (rpm_api[0], ==, "foo");
+}
+
+
+static void
+module_stream_v2_test_peek (void)
+{
+  g_autoptr (ModulemdModuleStream) stream = NULL;
+  g_autoptr (ModulemdModuleStream) frozen = NULL;
+  g_autofree gchar *path = NULL;
+  g_autoptr (GError) error = NULL;
+  ModulemdModuleStreamV2 *v2_stream = NULL;
+  ModulemdModuleStreamV2 *v2_frozen = NULL;
+  ModulemdProfile *profile = NULL;
+  ModulemdDependencies *deps = NULL;
+  const gchar *const *peeked = NULL;
+  const gchar *const *names = NULL;
+  struct
+  {
+    const gchar *const *(*peek) (ModulemdModuleStreamV2 *);
+    GStrv (*get) (ModulemdModuleStreamV2 *);
+  } collections[] = {
+    { modulemd_module_stream_v2_peek_module_component_names,
+      modulemd_module_stream_v2_get_module_component_names_as_strv },
+    { modulemd_module_stream_v2_peek_rpm_component_names,
+      modulemd_module_stream_v2_get_rpm_component_names_as_strv },
+    { modulemd_module_stream_v2_peek_content_licenses,
+      modulemd_module_stream_v2_get_content_licenses_as_strv },
+    { modulemd_module_stream_v2_peek_module_licenses,
+      modulemd_module_stream_v2_get_module_licenses_as_strv },
+    { modulemd_module_stream_v2_peek_profile_names,
+      modulemd_module_stream_v2_get_profile_names_as_strv },
+    { modulemd_module_stream_v2_peek_rpm_api,
+      modulemd_module_stream_v2_get_rpm_api_as_strv },
+    { modulemd_module_stream_v2_peek_rpm_artifacts,
+      modulemd_module_stream_v2_get_rpm_artifacts_as_strv },
+    { modulemd_module_stream_v2_peek_rpm_filters,
+      modulemd_module_stream_v2_get_rpm_filters_as_strv },
+    { modulemd_module_stream_v2_peek_servicelevel_names,
+      modulemd_module_stream_v2_get_servicelevel_names_as_strv },
+  };
+
+  path = g_strdup_printf ("%s/spec.v2.yaml", g_getenv ("MESON_SOURCE_ROOT"));
+  stream = modulemd_module_stream_read_file (path, TRUE, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (stream);
+  v2_stream = MODULEMD_MODULE_STREAM_V2 (stream);
+
+  frozen = modulemd_module_stream_copy (stream, NULL, NULL);
+  v2_frozen = MODULEMD_MODULE_STREAM_V2 (frozen);
+  modulemd_module_stream_freeze (frozen);
+
+  /* Every list matches its copying getter, whether frozen or not */
+  for (guint i = 0; i < G_N_ELEMENTS (collections); i++)
+    {
+      g_auto (GStrv) expected = collections[i].get (v2_stream);
+
+      peeked = collections[i].peek (v2_stream);
+      g_assert_true (collections[i].peek (v2_stream) == peeked);
+      assert_strv_sorted_equal ((GStrv)peeked, expected);
+      assert_strv_sorted_equal ((GStrv)collections[i].peek (v2_frozen),
+                                expected);
+    }
+
+  /* Looking up children does not drop the list being walked */
+  names = modulemd_module_stream_v2_peek_profile_names (v2_stream);
+  g_assert_nonnull (names[0]);
+  for (guint i = 0; names[i]; i++)
+    {
+      g_auto (GStrv) expected = NULL;
+
+      profile = modulemd_module_stream_v2_get_profile (v2_stream, names[i]);
+      expected = modulemd_profile_get_rpms_as_strv (profile);
+      assert_strv_sorted_equal ((GStrv)modulemd_profile_peek_rpms (profile),
+                                expected);
+      g_assert_true (modulemd_module_stream_v2_peek_profile_names (
+                       v2_stream) == names);
+    }
+
+  deps = g_ptr_array_index (
+    modulemd_module_stream_v2_get_dependencies (v2_frozen), 0);
+  names = modulemd_dependencies_peek_buildtime_modules (deps);
+  g_assert_nonnull (names[0]);
+  g_assert_nonnull (
+    modulemd_dependencies_peek_buildtime_streams (deps, names[0]));
+
+  /* Modifying the stream itself shows up in the next peek */
+  modulemd_module_stream_v2_add_rpm_api (v2_stream, "aaa-first");
+  peeked = modulemd_module_stream_v2_peek_rpm_api (v2_stream);
+  g_assert_cmpstr (peeked[0], ==, "aaa-first");
+  modulemd_module_stream_v2_clear_rpm_api (v2_stream);
+  g_assert_null (modulemd_module_stream_v2_peek_rpm_api (v2_stream)[0]);
+}
+
+static void
+module_stream_test_nevra_parse (void)
+{
+  ModulemdNevra parsed;
+  const gchar *nevra = "python3-foo-bar-1:2.3.4-5.module_f29+123.noarch";
+
+  g_assert_true (modulemd_nevra_parse (nevra, &parsed));
+  g_assert_true (parsed.nevra == nevra);
+  g_assert_cmpuint (MODULEMD_NEVRA_NAME_LEN (&parsed), ==, 15);
+  g_assert_cmpuint (parsed.epoch, ==, 16);
+  g_assert_cmpuint (parsed.version, ==, 18);
+  g_assert_cmpuint (parsed.release, ==, 24);
+  g_assert_cmpuint (parsed.arch, ==, 41);
+  g_assert_cmpstr (&nevra[parsed.release], ==, "5.module_f29+123.noarch");
+  g_assert_cmpstr (&nevra[parsed.arch], ==, "noarch");
+  g_assert_true (modulemd_validate_nevra (nevra));
+
+  /* The name may be empty, but the epoch must be a number */
+  g_assert_true (modulemd_nevra_parse ("-0:1-1.x86_64", &parsed));
+  g_assert_cmpuint (MODULEMD_NEVRA_NAME_LEN (&parsed), ==, 0);
+  g_assert_false (modulemd_validate_nevra ("foo-:1-1.x86_64"));
+  g_assert_false (modulemd_validate_nevra ("foo-x:1-1.x86_64"));
+
+  /* Missing separators */
+  g_assert_false (modulemd_validate_nevra ("foo-0:1-1"));
+  g_assert_false (modulemd_validate_nevra ("foo-0:1.x86_64"));
+  g_assert_false (modulemd_validate_nevra ("foo-1-1.x86_64"));
+  g_assert_false (modulemd_validate_nevra ("foo0:1-1.x86_64"));
+  g_assert_false (modulemd_validate_nevra (""));
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1577,6 +2136,13 @@ main (int argc, char *argv[])
               module_stream_test_copy,
               NULL);
 
+  g_test_add ("/modulemd/v2/modulestream/copy_sets",
+              ModuleStreamFixture,
+              NULL,
+              NULL,
+              module_stream_test_copy_sets,
+              NULL);
+
   g_test_add ("/modulemd/v2/modulestream/equals",
               ModuleStreamFixture,
               NULL,
@@ -1680,5 +2246,26 @@ main (int argc, char *argv[])
   g_test_add_func ("/modulemd/v2/modulestream/v2/xmd/issue290plus",
                    module_stream_v2_test_xmd_issue_290_with_example);
 
+  g_test_add_func ("/modulemd/v2/modulestream/xmd/shared_copy",
+                   module_stream_test_xmd_shared_copy);
+
+  g_test_add_func ("/modulemd/v2/modulestream/xmd/json",
+                   module_stream_test_xmd_json);
+
+  g_test_add_func ("/modulemd/v2/modulestream/fingerprint",
+                   module_stream_test_fingerprint);
+
+  g_test_add_func ("/modulemd/v2/modulestream/frozen_sets",
+                   module_stream_test_frozen_sets);
+
+  g_test_add_func ("/modulemd/v2/modulestream/frozen_copy",
+                   module_stream_test_frozen_copy);
+
+  g_test_add_func ("/modulemd/v2/modulestream/v2/peek",
+                   module_stream_v2_test_peek);
+
+  g_test_add_func ("/modulemd/v2/modulestream/nevra_parse",
+                   module_stream_test_nevra_parse);
+
   return g_test_run ();
 }
@@ -356,7 +356,9 @@ static void
 profile_test_rpms (ProfileFixture *fixture, gconstpointer user_data)
 {
   g_autoptr (ModulemdProfile) p = NULL;
+  g_autoptr (ModulemdProfile) copy = NULL;
   g_auto (GStrv) rpms = NULL;
+  const gchar *const *peeked = NULL;
 
   p = modulemd_profile_new ("testprofile");
   g_assert_nonnull (p);
@@ -387,6 +389,26 @@ profile_test_rpms (ProfileFixture *fixture, gconstpointer user_data)
   g_assert_cmpstr (rpms[0], ==, "test1");
   g_assert_cmpstr (rpms[1], ==, "test3");
   g_clear_pointer (&rpms, g_strfreev);
+
+  /* The peeked list is the same, and is kept until the next change */
+  peeked = modulemd_profile_peek_rpms (p);
+  g_assert_cmpstr (peeked[0], ==, "test1");
+  g_assert_cmpstr (peeked[1], ==, "test3");
+  g_assert_null (peeked[2]);
+  g_assert_true (modulemd_profile_peek_rpms (p) == peeked);
+
+  /* Copies have RPMs of their own */
+  copy = modulemd_profile_copy (p);
+  modulemd_profile_add_rpm (copy, "test0");
+  peeked = modulemd_profile_peek_rpms (copy);
+  g_assert_cmpstr (peeked[0], ==, "test0");
+  g_assert_cmpstr (peeked[1], ==, "test1");
+  peeked = modulemd_profile_peek_rpms (p);
+  g_assert_cmpstr (peeked[0], ==, "test1");
+  g_assert_null (peeked[2]);
+
+  modulemd_profile_clear_rpms (p);
+  g_assert_null (modulemd_profile_peek_rpms (p)[0]);
 }
 
 
@@ -0,0 +1,355 @@
+/*
+ * This file is part of libmodulemd
+ * Copyright (C) 2019 Red Hat, Inc.
+ *
+ * Fedora-License-Identifier: MIT
+ * SPDX-2.0-License-Identifier: MIT
+ * SPDX-3.0-License-Identifier: MIT
+ *
+ * This program is free software.
+ * For more information on the license, see COPYING.
+ * For more information on free software, see <https://www.gnu.org/philosophy/free-sw.en.html>.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+#include <string.h>
+
+#include "private/glib-extensions.h"
+#include "private/modulemd-yaml.h"
+#include "private/test-utils.h"
+
+
+static void
+assert_scalar_to_uint64 (const gchar *scalar, gboolean valid, guint64 expected)
+{
+  guint64 value = G_MAXUINT64;
+
+  g_assert_cmpint (
+    modulemd_yaml_scalar_to_uint64 (scalar, strlen (scalar), &value),
+    ==,
+    valid);
+
+  if (valid)
+    g_assert_cmpuint (value, ==, expected);
+  else
+    g_assert_cmpuint (value, ==, G_MAXUINT64);
+}
+
+
+static void
+test_yaml_util_scalar_to_uint64 (void)
+{
+  guint64 value;
+
+  /* Every length around the eight-digit boundaries */
+  assert_scalar_to_uint64 ("0", TRUE, 0);
+  assert_scalar_to_uint64 ("7", TRUE, 7);
+  assert_scalar_to_uint64 ("1234567", TRUE, 1234567);
+  assert_scalar_to_uint64 ("12345678", TRUE, 12345678);
+  assert_scalar_to_uint64 ("00000001", TRUE, 1);
+  assert_scalar_to_uint64 ("123456789", TRUE, 123456789);
+  assert_scalar_to_uint64 ("20180816111033", TRUE, 20180816111033);
+  assert_scalar_to_uint64 ("1234567890123456", TRUE, 1234567890123456);
+  assert_scalar_to_uint64 (
+    "9999999999999999999", TRUE, G_GUINT64_CONSTANT (9999999999999999999));
+
+  /* Too long to be sure it fits */
+  assert_scalar_to_uint64 ("18446744073709551615", FALSE, 0);
+
+  /* Anything but plain digits */
+  assert_scalar_to_uint64 ("", FALSE, 0);
+  assert_scalar_to_uint64 ("-1", FALSE, 0);
+  assert_scalar_to_uint64 ("+1", FALSE, 0);
+  assert_scalar_to_uint64 (" 1", FALSE, 0);
+  assert_scalar_to_uint64 ("1.0", FALSE, 0);
+  assert_scalar_to_uint64 ("1234567:", FALSE, 0);
+  assert_scalar_to_uint64 ("/1234567", FALSE, 0);
+  assert_scalar_to_uint64 ("123456789a", FALSE, 0);
+  assert_scalar_to_uint64 ("1234567\xff", FALSE, 0);
+  assert_scalar_to_uint64 ("0x10", FALSE, 0);
+
+  /* Only @length bytes are looked at */
+  g_assert_true (modulemd_yaml_scalar_to_uint64 ("12345678xyz", 8, &value));
+  g_assert_cmpuint (value, ==, 12345678);
+}
+
+
+static GDate *
+parse_date_value (const gchar *yaml, GError **error)
+{
+  MMD_INIT_YAML_PARSER (parser);
+  g_autofree gchar *key = NULL;
+
+  yaml_parser_set_input_string (
+    &parser, (const unsigned char *)yaml, strlen (yaml));
+  parser_skip_headers (&parser);
+
+  key = modulemd_yaml_parse_string (&parser, error);
+  g_assert_cmpstr (key, ==, "date");
+
+  return modulemd_yaml_parse_date (&parser, error);
+}
+
+
+static gint64
+parse_int64_value (const gchar *yaml, gboolean is_signed)
+{
+  MMD_INIT_YAML_PARSER (parser);
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *key = NULL;
+  gint64 value;
+
+  yaml_parser_set_input_string (
+    &parser, (const unsigned char *)yaml, strlen (yaml));
+  parser_skip_headers (&parser);
+
+  key = modulemd_yaml_parse_string (&parser, &error);
+  g_assert_cmpstr (key, ==, "number");
+
+  if (is_signed)
+    value = modulemd_yaml_parse_int64 (&parser, &error);
+  else
+    value = (gint64)modulemd_yaml_parse_uint64 (&parser, &error);
+  g_assert_no_error (error);
+
+  return value;
+}
+
+
+static void
+test_yaml_util_parse_numbers (void)
+{
+  g_autoptr (GDate) date = NULL;
+  g_autoptr (GError) error = NULL;
+
+  g_assert_cmpint (parse_int64_value ("number: 20180816111033", FALSE),
+                   ==,
+                   20180816111033);
+  g_assert_cmpint (parse_int64_value ("number: 42", TRUE), ==, 42);
+
+  /* Values outside the fast path are parsed as before */
+  g_assert_cmpint (parse_int64_value ("number: -42", TRUE), ==, -42);
+  g_assert_cmpint (parse_int64_value ("number: 42abc", FALSE), ==, 42);
+  g_assert_cmpint (
+    parse_int64_value ("number: 1234567890123456789", TRUE),
+    ==,
+    G_GINT64_CONSTANT (1234567890123456789));
+
+  date = parse_date_value ("date: 2018-07-11", &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (date);
+  g_assert_cmpint (g_date_get_year (date), ==, 2018);
+  g_assert_cmpint (g_date_get_month (date), ==, 7);
+  g_assert_cmpint (g_date_get_day (date), ==, 11);
+  g_clear_pointer (&date, g_date_free);
+
+  /* Unpadded dates are still accepted */
+  date = parse_date_value ("date: 2018-7-1", &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (date);
+  g_assert_cmpint (g_date_get_month (date), ==, 7);
+  g_assert_cmpint (g_date_get_day (date), ==, 1);
+  g_clear_pointer (&date, g_date_free);
+
+  date = parse_date_value ("date: 20180711", &error);
+  g_assert_null (date);
+  g_assert_error (error, MODULEMD_YAML_ERROR, MODULEMD_YAML_ERROR_PARSE);
+}
+
+
+/* Collects every scalar in @path that consists only of digits */
+static GPtrArray *
+read_numeric_scalars (const gchar *path)
+{
+  MMD_INIT_YAML_PARSER (parser);
+  g_autoptr (FILE) yaml_stream = NULL;
+  g_autoptr (GPtrArray) scalars = g_ptr_array_new_with_free_func (g_free);
+  const gchar *value = NULL;
+  gboolean done = FALSE;
+
+  yaml_stream = g_fopen (path, "rb");
+  g_assert_nonnull (yaml_stream);
+  yaml_parser_set_input_file (&parser, yaml_stream);
+
+  while (!done)
+    {
+      MMD_INIT_YAML_EVENT (event);
+      g_assert_true (yaml_parser_parse (&parser, &event));
+
+      if (event.type == YAML_STREAM_END_EVENT)
+        done = TRUE;
+
+      if (event.type != YAML_SCALAR_EVENT || event.data.scalar.length == 0)
+        continue;
+
+      value = (const gchar *)event.data.scalar.value;
+      if (strspn (value, "0123456789") == event.data.scalar.length)
+        g_ptr_array_add (scalars, g_strdup (value));
+    }
+
+  return g_steal_pointer (&scalars);
+}
+
+
+static void
+test_yaml_util_scalar_benchmark (void)
+{
+  g_autofree gchar *yaml_path = NULL;
+  g_autoptr (GPtrArray) scalars = NULL;
+  const guint iterations = 1000;
+  const gchar *scalar = NULL;
+  guint64 value;
+  guint64 checksum = 0;
+  guint64 fast_checksum = 0;
+  gdouble elapsed;
+  gdouble fast_elapsed;
+
+  yaml_path = g_strdup_printf ("%s/f29.yaml", g_getenv ("TEST_DATA_PATH"));
+  scalars = read_numeric_scalars (yaml_path);
+  g_assert_cmpuint (scalars->len, >, 0);
+
+  /* The fast path must agree with the slow one on real data */
+  for (guint i = 0; i < scalars->len; i++)
+    {
+      scalar = g_ptr_array_index (scalars, i);
+      if (strlen (scalar) > 19)
+        continue;
+
+      g_assert_true (
+        modulemd_yaml_scalar_to_uint64 (scalar, strlen (scalar), &value));
+      g_assert_cmpuint (value, ==, g_ascii_strtoull (scalar, NULL, 10));
+    }
+
+  if (!g_test_perf ())
+    return;
+
+  g_test_timer_start ();
+  for (guint n = 0; n < iterations; n++)
+    for (guint i = 0; i < scalars->len; i++)
+      checksum += g_ascii_strtoull (g_ptr_array_index (scalars, i), NULL, 10);
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_timer_start ();
+  for (guint n = 0; n < iterations; n++)
+    for (guint i = 0; i < scalars->len; i++)
+      {
+        scalar = g_ptr_array_index (scalars, i);
+        if (!modulemd_yaml_scalar_to_uint64 (scalar, strlen (scalar), &value))
+          value = g_ascii_strtoull (scalar, NULL, 10);
+        fast_checksum += value;
+      }
+  fast_elapsed = g_test_timer_elapsed ();
+
+  g_assert_cmpuint (checksum, ==, fast_checksum);
+
+  g_test_minimized_result (fast_elapsed * 1000 / iterations,
+                           "Parsed %u numeric scalars in %.3f ms per "
+                           "iteration (g_ascii_strtoull: %.3f ms)",
+                           scalars->len,
+                           fast_elapsed * 1000 / iterations,
+                           elapsed * 1000 / iterations);
+}
+
+
+/* Writes @total bytes to @yaml_string in libyaml-sized chunks and returns how
+ * many times the buffer had to be reallocated along the way.
+ */
+static guint
+write_in_chunks (modulemd_yaml_string *yaml_string, gsize total)
+{
+  unsigned char chunk[1000];
+  gsize written = 0;
+  gsize size;
+  gsize alloc;
+  guint reallocs = 0;
+
+  for (gsize i = 0; i < sizeof (chunk); i++)
+    chunk[i] = 'a' + i % 26;
+
+  while (written < total)
+    {
+      size = MIN (sizeof (chunk), total - written);
+      alloc = yaml_string->alloc;
+      g_assert_cmpint (write_yaml_string (yaml_string, chunk, size), ==, 1);
+      if (yaml_string->alloc != alloc)
+        reallocs++;
+      written += size;
+    }
+
+  return reallocs;
+}
+
+
+static void
+assert_chunks_written (modulemd_yaml_string *yaml_string, gsize total)
+{
+  g_assert_cmpuint (yaml_string->len, ==, total);
+  g_assert_cmpuint (strlen (yaml_string->str), ==, total);
+  for (gsize i = 0; i < total; i++)
+    g_assert_cmpint (yaml_string->str[i], ==, 'a' + (i % 1000) % 26);
+}
+
+
+static void
+test_yaml_util_string_growth (void)
+{
+  const gsize total = 1024 * 1024;
+  g_autoptr (modulemd_yaml_string) grown =
+    g_malloc0_n (1, sizeof (modulemd_yaml_string));
+  g_autoptr (modulemd_yaml_string) reserved =
+    g_malloc0_n (1, sizeof (modulemd_yaml_string));
+  g_autoptr (modulemd_yaml_string) small =
+    g_malloc0_n (1, sizeof (modulemd_yaml_string));
+
+  /* Growing from nothing must double rather than follow every write: 1 MiB
+   * from a 4 KiB start is ten allocations, not a thousand.
+   */
+  g_assert_cmpuint (write_in_chunks (grown, total), <=, 10);
+  assert_chunks_written (grown, total);
+  g_assert_cmpuint (grown->alloc, <, 2 * (total + 1));
+
+  /* A large enough reservation means no reallocation at all */
+  modulemd_yaml_string_reserve (reserved, total);
+  g_assert_cmpuint (reserved->alloc, >, total);
+  g_assert_cmpuint (write_in_chunks (reserved, total), ==, 0);
+  assert_chunks_written (reserved, total);
+
+  /* Shrinking gives back the slack without touching the contents */
+  g_assert_cmpuint (reserved->alloc, >, reserved->len + reserved->len / 8);
+  modulemd_yaml_string_shrink (reserved);
+  g_assert_cmpuint (reserved->alloc, ==, total + 1);
+  assert_chunks_written (reserved, total);
+
+  /* ... but leaves an almost exact fit alone */
+  g_assert_cmpuint (write_in_chunks (small, 4000), ==, 1);
+  g_assert_cmpuint (small->alloc, ==, 4096);
+  modulemd_yaml_string_shrink (small);
+  g_assert_cmpuint (small->alloc, ==, 4096);
+  assert_chunks_written (small, 4000);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  setlocale (LC_ALL, "");
+
+  g_test_init (&argc, &argv, NULL);
+  g_test_bug_base ("https://bugzilla.redhat.com/show_bug.cgi?id=");
+
+  g_test_add_func ("/modulemd/yaml/scalar_to_uint64",
+                   test_yaml_util_scalar_to_uint64);
+
+  g_test_add_func ("/modulemd/yaml/parse_numbers",
+                   test_yaml_util_parse_numbers);
+
+  g_test_add_func ("/modulemd/yaml/scalar_benchmark",
+                   test_yaml_util_scalar_benchmark);
+
+  g_test_add_func ("/modulemd/yaml/string_growth",
+                   test_yaml_util_string_growth);
+
+  return g_test_run ();
+}